@@ -0,0 +1,226 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "CommandContext.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Which queues the two workloads are submitted to.
+enum QueueLayout : uint32_t {
+    ComputeCompute = 0,  // bandwidth kernel on COMPUTE queue #1, ALU kernel on COMPUTE queue #2
+    DirectCompute  = 1,  // bandwidth kernel on the DIRECT queue, ALU kernel on a COMPUTE queue
+    QueueLayoutCount
+};
+
+inline const char* QueueLayoutName(QueueLayout layout)
+{
+    switch (layout)
+    {
+    case QueueLayout::ComputeCompute: return "Compute+Compute";
+    case QueueLayout::DirectCompute:  return "Direct+Compute";
+    default:                          return "Unknown";
+    }
+}
+
+enum Workload : uint32_t {
+    Bandwidth = 0,
+    Alu       = 1,
+    WorkloadCount
+};
+
+// Start/end of one workload on the shared QPC timeline, in seconds.
+struct QueueSpan
+{
+    double begin = 0.0;
+    double end   = 0.0;
+
+    double Seconds() const { return end - begin; }
+};
+
+inline double Makespan(const QueueSpan& a, const QueueSpan& b)
+{
+    return (a.end > b.end ? a.end : b.end) - (a.begin < b.begin ? a.begin : b.begin);
+}
+
+struct AsyncComputeResult
+{
+    QueueSpan alone[WorkloadCount];       // each workload with the GPU to itself
+    QueueSpan serial[WorkloadCount];      // ALU queue fence-waits for the bandwidth queue
+    QueueSpan concurrent[WorkloadCount];  // both submitted at once, no dependency
+
+    double SerialMakespan()     const { return Makespan(serial[Bandwidth], serial[Alu]); }
+    double ConcurrentMakespan() const { return Makespan(concurrent[Bandwidth], concurrent[Alu]); }
+    double Speedup()            const { return SerialMakespan() / ConcurrentMakespan(); }
+
+    // How much longer a workload takes when it shares the GPU with the other one (1.0 = unaffected).
+    double Slowdown(Workload workload) const { return concurrent[workload].Seconds() / alone[workload].Seconds(); }
+
+    // Fraction of the shorter workload hidden behind the longer one: 1.0 = perfect overlap, 0.0 = none.
+    double OverlapFraction() const
+    {
+        double a = alone[Bandwidth].Seconds();
+        double b = alone[Alu].Seconds();
+        double shorter = a < b ? a : b;
+        return shorter > 0.0 ? (a + b - ConcurrentMakespan()) / shorter : 0.0;
+    }
+};
+
+class AsyncCompute : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t ElementCount;
+		uint32_t DispatchThreads;
+		uint32_t Iterations;
+		uint32_t Pad0;
+	};
+
+    static const uint32_t NumThreads = 64;
+    static const uint32_t AluThreads = 1024 * 1024;
+
+    AsyncCompute(HINSTANCE hInstance, uint32_t bandwidthMB, uint32_t bandwidthPasses, uint32_t aluIterations, QueueLayout layout, bool highPriorityAlu) :
+		D3DAppSimplified(hInstance),
+		m_bandwidthElements(bandwidthMB * 1024 * 1024 / 16),
+		m_bandwidthPasses(bandwidthPasses),
+		m_aluIterations(aluIterations),
+		m_layout(layout),
+		m_highPriorityAlu(highPriorityAlu)
+	{
+    }
+
+    void BuildResourcesAndHeaps() override {
+		UINT64 bandwidthBytes = static_cast<UINT64>(m_bandwidthElements) * 16;
+		mBandwidthInput  = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, bandwidthBytes);
+		mBandwidthOutput = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, bandwidthBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mAluOutput       = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>(AluThreads) * 16, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+
+		D3D12_COMMAND_LIST_TYPE bandwidthType = m_layout == QueueLayout::DirectCompute ? D3D12_COMMAND_LIST_TYPE_DIRECT : D3D12_COMMAND_LIST_TYPE_COMPUTE;
+		D3D12_COMMAND_QUEUE_PRIORITY aluPriority = m_highPriorityAlu ? D3D12_COMMAND_QUEUE_PRIORITY_HIGH : D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+		mContexts[Bandwidth].Initialize(Device(), bandwidthType);
+		mContexts[Alu].Initialize(Device(), D3D12_COMMAND_LIST_TYPE_COMPUTE, 2, 1, aluPriority);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		mShaders[Bandwidth] = D3DUtil::CompileShader(L"Shaders\\BandwidthKernel.hlsl", nullptr, "main", "cs_5_0");
+		mShaders[Alu]       = D3DUtil::CompileShader(L"Shaders\\AluKernel.hlsl", nullptr, "main", "cs_5_0");
+	}
+
+    void BuildPSOs() override {
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSOs[Bandwidth] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[Bandwidth].Get());
+		mPSOs[Alu]       = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[Alu].Get());
+    }
+
+	// Both workloads are submitted through their own CommandContext, see Measure().
+    void DoAction() override { }
+
+	AsyncComputeResult Measure()
+	{
+		AsyncComputeResult result;
+
+		// Alone: one workload at a time, each on the queue it will share later.
+		for (uint32_t w = 0; w < WorkloadCount; ++w)
+		{
+			Record(static_cast<Workload>(w));
+			mContexts[w].SubmitAndFlush();
+			result.alone[w] = ReadSpan(static_cast<Workload>(w));
+		}
+
+		// Serial: same two queues, but the ALU queue waits on a fence signaled after the bandwidth work.
+		Record(Bandwidth);
+		Record(Alu);
+		mContexts[Bandwidth].Submit();
+		UINT64 bandwidthDone = mContexts[Bandwidth].Signal();
+		mContexts[Alu].GpuWait(mContexts[Bandwidth].Fence(), bandwidthDone);
+		mContexts[Alu].SubmitAndFlush();
+		mContexts[Bandwidth].CpuWait(bandwidthDone);
+		result.serial[Bandwidth] = ReadSpan(Bandwidth);
+		result.serial[Alu]       = ReadSpan(Alu);
+
+		// Concurrent: no dependency between the queues, the GPU is free to overlap them.
+		Record(Bandwidth);
+		Record(Alu);
+		mContexts[Bandwidth].Submit();
+		mContexts[Alu].Submit();
+		mContexts[Bandwidth].Flush();
+		mContexts[Alu].Flush();
+		result.concurrent[Bandwidth] = ReadSpan(Bandwidth);
+		result.concurrent[Alu]       = ReadSpan(Alu);
+
+		return result;
+	}
+
+	UINT64 BandwidthBytes() const { return static_cast<UINT64>(m_bandwidthElements) * 16 * 2 * m_bandwidthPasses; }
+	bool   TimestampsSupported() const { return mContexts[Bandwidth].TimestampsSupported() && mContexts[Alu].TimestampsSupported(); }
+
+private:
+
+	void Record(Workload workload)
+	{
+		CommandContext& context = mContexts[workload];
+		auto commandList = context.CommandList();
+
+		RootConstants constants = {};
+		uint32_t groups = 0;
+		if (workload == Bandwidth)
+		{
+			groups = (m_bandwidthElements + NumThreads - 1) / NumThreads;
+			groups = groups < MaxGroupsX ? groups : MaxGroupsX;
+			constants = { m_bandwidthElements, groups * NumThreads, m_bandwidthPasses, 0 };
+		}
+		else
+		{
+			groups = AluThreads / NumThreads;
+			constants = { AluThreads, AluThreads, m_aluIterations, 0 };
+		}
+		ID3D12Resource* output = workload == Bandwidth ? mBandwidthOutput.Get() : mAluOutput.Get();
+
+		context.Reset(0, mPSOs[workload].Get());
+		context.Timestamp(0);
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(1, mBandwidthInput->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, output->GetGPUVirtualAddress());
+		commandList->Dispatch(groups, 1, 1);
+		context.Timestamp(1);
+		context.ResolveTimestamps(2);
+
+		// Re-sample right before submission so drift between the two queue clocks stays negligible.
+		context.CalibrateClock();
+	}
+
+	QueueSpan ReadSpan(Workload workload)
+	{
+		CommandContext& context = mContexts[workload];
+		std::vector<UINT64> ticks = context.ReadTimestamps(2);
+		QueueSpan span;
+		span.begin = context.TimestampToCpuSeconds(ticks[0]);
+		span.end   = context.TimestampToCpuSeconds(ticks[1]);
+		return span;
+	}
+
+    ComPtr<ID3DBlob> mShaders[WorkloadCount];
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[WorkloadCount];
+
+	ComPtr<ID3D12Resource> mBandwidthInput;
+	ComPtr<ID3D12Resource> mBandwidthOutput;
+	ComPtr<ID3D12Resource> mAluOutput;
+
+	// Indexed by Workload.
+	CommandContext mContexts[WorkloadCount];
+
+	uint32_t    m_bandwidthElements;
+	uint32_t    m_bandwidthPasses;
+	uint32_t    m_aluIterations;
+	QueueLayout m_layout;
+	bool        m_highPriorityAlu;
+};
@@ -0,0 +1,109 @@
+#include "d3dAppSimplified.h"
+#include "AsyncCompute.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	int bandwidthMB     = 256;
+	int bandwidthPasses = 4;
+	int aluIterations   = 4096;
+	int layout          = QueueLayout::ComputeCompute;
+	int highPriority    = 0;
+
+	// Usage: program.exe <bandwidthMB> <bandwidthPasses> <aluIterations> <layout> <highPriorityAlu>
+	// layout: 0=Compute+Compute, 1=Direct+Compute
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			bandwidthMB = _wtoi(argv[1]);
+		}
+		if (argc >= 3)
+		{
+			bandwidthPasses = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			aluIterations = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			layout = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			highPriority = _wtoi(argv[5]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: bandwidthMB=%d, passes=%d, aluIterations=%d, layout=%d, highPriorityAlu=%d\n",
+			bandwidthMB, bandwidthPasses, aluIterations, layout, highPriority);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (bandwidthMB <= 0 || bandwidthMB > 2048 || bandwidthPasses <= 0 || aluIterations <= 0 ||
+		(layout != QueueLayout::ComputeCompute && layout != QueueLayout::DirectCompute) || (highPriority != 0 && highPriority != 1))
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	QueueLayout queueLayout = static_cast<QueueLayout>(layout);
+
+	AsyncCompute test(hInstance, static_cast<uint32_t>(bandwidthMB), static_cast<uint32_t>(bandwidthPasses),
+		static_cast<uint32_t>(aluIterations), queueLayout, highPriority != 0);
+	test.Initialize();
+
+	if (!test.TimestampsSupported())
+	{
+		OutputDebugStringA("ERROR: Timestamp queries are required on both queues!\n");
+		return 1;
+	}
+
+	// First pass pays for residency and PSO warm-up.
+	test.Measure();
+	AsyncComputeResult result = test.Measure();
+
+	double bandwidthAlone = result.alone[Bandwidth].Seconds();
+	double aluAlone       = result.alone[Alu].Seconds();
+	double bandwidth      = static_cast<double>(test.BandwidthBytes()) / bandwidthAlone / 1024 / 1024 / 1024;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Layout: " << QueueLayoutName(queueLayout) << (highPriority ? " (high priority ALU queue)" : "") << "\n";
+	debugOutput << "Bandwidth kernel alone: " << bandwidthAlone << " seconds (" << bandwidth << " GB/s)\n";
+	debugOutput << "ALU kernel alone:       " << aluAlone << " seconds\n";
+	debugOutput << "Serial makespan:        " << result.SerialMakespan() << " seconds\n";
+	debugOutput << "Concurrent makespan:    " << result.ConcurrentMakespan() << " seconds\n";
+	debugOutput << "Speedup: " << result.Speedup() << "x Overlap: " << result.OverlapFraction() << "\n";
+	debugOutput << "Slowdown when shared (bandwidth/ALU): " << result.Slowdown(Bandwidth) << " / " << result.Slowdown(Alu) << "\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("async_compute_results.csv",
+		"Layout,HighPriorityAlu,BandwidthMB,BandwidthPasses,AluIterations,BandwidthAlone_s,AluAlone_s,BandwidthConcurrent_s,AluConcurrent_s,SerialMakespan_s,ConcurrentMakespan_s,Speedup,Overlap,BandwidthSlowdown,AluSlowdown", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(QueueLayoutName(queueLayout), highPriority, bandwidthMB, bandwidthPasses, aluIterations,
+		bandwidthAlone, aluAlone, result.concurrent[Bandwidth].Seconds(), result.concurrent[Alu].Seconds(),
+		result.SerialMakespan(), result.ConcurrentMakespan(), result.Speedup(), result.OverlapFraction(),
+		result.Slowdown(Bandwidth), result.Slowdown(Alu));
+    return 0;
+}
@@ -0,0 +1,72 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+LAYOUTS = {
+    0: "Compute+Compute",
+    1: "Direct+Compute",
+}
+
+def run_simple_test(tryCount = 3):
+    """Runs the bandwidth/ALU pair on both queue layouts while scaling the ALU work"""
+
+    program = "..\\x64\\Release\\AsyncCompute.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "async_compute_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    bandwidth_mb = 256
+    passes = 4
+    for layout in LAYOUTS:
+        for priority in [0, 1]:
+            for alu_iterations in [256, 1024, 4096, 16384]:
+                print(f"\nRunning {LAYOUTS[layout]} priority {priority} ALU iterations {alu_iterations}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(bandwidth_mb),
+                            str(passes),
+                            str(alu_iterations),
+                            str(layout),
+                            str(priority)
+                        ], capture_output=True, text=True)
+                        print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_async_compute_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = f"{parts[0]}{' (high prio)' if int(parts[1]) else ''}"
+            # ALU share of the serial work, so both workloads' balance is on one axis
+            alu_share = float(parts[6]) / (float(parts[5]) + float(parts[6]))
+            series.setdefault(key, ([], []))
+            series[key][0].append(alu_share)
+            series[key][1].append(float(parts[11]))
+
+    for key, (share, speedup) in sorted(series.items()):
+        plt.plot(share, speedup, marker='o', linestyle='', label=key)
+    plt.axhline(1.0, color='gray', linewidth=0.8)
+    plt.xlabel('ALU Share of Serial Time')
+    plt.ylabel('Serial / Concurrent Makespan')
+    plt.title('Async Compute Overlap')
+    plt.legend()
+    plt.grid(True)
+    plt.savefig('AsyncComputeOverlap.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_async_compute_results("async_compute_results.csv")
@@ -0,0 +1,36 @@
+RWStructuredBuffer<float4> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint ElementCount;      // threads that write a result
+    uint DispatchThreads;   // unused
+    uint Iterations;        // dependent FMA steps per chain
+    uint Pad0;
+}
+
+static const uint NumThreads = 64;
+
+// ALU-bound workload: four independent FMA chains per thread (enough ILP to keep the pipes busy),
+// a single store at the end and no loads at all.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    uint id = groupId.x * NumThreads + threadId.x;
+    float4 a = float4(id, id + 1, id + 2, id + 3) * 1e-6f;
+    float4 b = a + 0.25f;
+    float4 c = a + 0.5f;
+    float4 d = a + 0.75f;
+
+    for (uint i = 0; i < Iterations; ++i)
+    {
+        a = mad(a, 0.9999f, 0.0001f);
+        b = mad(b, 0.9999f, 0.0001f);
+        c = mad(c, 0.9999f, 0.0001f);
+        d = mad(d, 0.9999f, 0.0001f);
+    }
+
+    if (id < ElementCount)
+    {
+        Output[id] = a + b + c + d;
+    }
+}
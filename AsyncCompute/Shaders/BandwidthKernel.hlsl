@@ -0,0 +1,26 @@
+StructuredBuffer<float4>   Input  : register(t0);
+RWStructuredBuffer<float4> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint ElementCount;      // float4 elements
+    uint DispatchThreads;   // grid stride
+    uint Iterations;        // passes over the buffer
+    uint Pad0;
+}
+
+static const uint NumThreads = 64;
+
+// Memory-bound workload: one 16-byte load and one 16-byte store per element and almost no math,
+// repeated 'Iterations' times over a buffer much larger than the last-level cache.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    for (uint pass = 0; pass < Iterations; ++pass)
+    {
+        for (uint id = groupId.x * NumThreads + threadId.x; id < ElementCount; id += DispatchThreads)
+        {
+            Output[id] = Input[id] + (float)pass;
+        }
+    }
+}
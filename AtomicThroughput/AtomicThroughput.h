@@ -0,0 +1,169 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum AtomicOp : uint32_t {
+    AtomicAdd             = 0,
+    AtomicMin             = 1,
+    AtomicMax             = 2,
+    AtomicCompareExchange = 3,
+    AtomicOpCount
+};
+
+enum AtomicMemory : uint32_t {
+    GlobalMemory      = 0,  // RWByteAddressBuffer UAV
+    GroupSharedMemory = 1,  // groupshared array, 1024 entries per group
+    AtomicMemoryCount
+};
+
+inline const char* AtomicOpName(AtomicOp op)
+{
+    switch (op)
+    {
+    case AtomicOp::AtomicAdd:             return "Add";
+    case AtomicOp::AtomicMin:             return "Min";
+    case AtomicOp::AtomicMax:             return "Max";
+    case AtomicOp::AtomicCompareExchange: return "CompareExchange";
+    default:                              return "Unknown";
+    }
+}
+
+inline const char* AtomicMemoryName(AtomicMemory memory)
+{
+    return memory == AtomicMemory::GroupSharedMemory ? "GroupShared" : "Global";
+}
+
+struct AtomicConfig
+{
+    AtomicOp     op        = AtomicOp::AtomicAdd;
+    AtomicMemory memory    = AtomicMemory::GlobalMemory;
+    uint32_t     width     = 32;     // 32 or 64 bits
+    uint32_t     addresses = 1;      // 1 = full contention
+    bool         aggregate = false;  // wave reduction + one atomic per address per wave
+};
+
+class AtomicThroughput : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Addresses;
+		uint32_t Iterations;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t NumThreads      = 256;
+    static const uint32_t GroupSharedSize = 1024;
+
+    AtomicThroughput(HINSTANCE hInstance, const AtomicConfig& config, uint32_t groups, uint32_t iterations) :
+		D3DAppSimplified(hInstance),
+		m_config(config),
+		m_groups(groups),
+		m_iterations(iterations)
+	{
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		UINT64 targetBytes = static_cast<UINT64>(m_config.addresses) * (m_config.width / 8);
+		mTargetBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, targetBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mOutputBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>(ThreadCount()) * sizeof(uint32_t), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		std::vector<std::wstring> defines = {
+			L"OP=" + std::to_wstring(static_cast<uint32_t>(m_config.op)),
+			L"GROUPSHARED=" + std::to_wstring(m_config.memory == AtomicMemory::GroupSharedMemory ? 1 : 0),
+			L"WIDTH64=" + std::to_wstring(m_config.width == 64 ? 1 : 0),
+			L"AGGREGATE=" + std::to_wstring(m_config.aggregate ? 1 : 0)
+		};
+		// 64-bit atomics on raw buffers and groupshared arrive with shader model 6.6.
+		mShaders = D3DUtil::CompileShaderDxc(L"Shaders\\AtomicKernel.hlsl", defines, L"main", m_config.width == 64 ? L"cs_6_6" : L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsUnorderedAccessView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(1);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO           = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		RootConstants constants = { m_config.addresses, m_iterations, 0, 0 };
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootUnorderedAccessView(1, mTargetBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		commandList->Dispatch(m_groups, 1, 1);
+    }
+
+	bool   Supported()   const { return m_supported; }
+	UINT64 ThreadCount() const { return static_cast<UINT64>(m_groups) * NumThreads; }
+	// Logical atomics requested by the threads; with aggregation fewer reach memory.
+	UINT64 OperationCount() const { return ThreadCount() * m_iterations; }
+
+private:
+
+	bool CheckSupport()
+	{
+		D3D_SHADER_MODEL required = m_config.width == 64 ? kShaderModel6_6 : D3D_SHADER_MODEL_6_0;
+		if (QueryHighestShaderModel(Device()) < required)
+		{
+			OutputDebugStringA("Shader model too low for this atomic variant\n");
+			return false;
+		}
+		if (m_config.width == 64)
+		{
+			D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+			if (FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) ||
+				!options1.Int64ShaderOps)
+			{
+				OutputDebugStringA("64-bit shader integer ops not supported\n");
+				return false;
+			}
+			if (m_config.memory == AtomicMemory::GroupSharedMemory)
+			{
+				FeatureDataOptions9 options9 = {};
+				if (FAILED(Device()->CheckFeatureSupport(kFeatureOptions9, &options9, sizeof(options9))) ||
+					!options9.AtomicInt64OnGroupSharedSupported)
+				{
+					OutputDebugStringA("64-bit groupshared atomics not supported\n");
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShaders;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	ComPtr<ID3D12Resource> mTargetBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+
+	AtomicConfig m_config;
+	uint32_t     m_groups;
+	uint32_t     m_iterations;
+	bool         m_supported = false;
+};
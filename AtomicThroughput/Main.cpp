@@ -0,0 +1,120 @@
+#include "d3dAppSimplified.h"
+#include "AtomicThroughput.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	AtomicConfig config;
+	int          addresses  = 1;
+	int          width      = 32;
+	int          aggregate  = 0;
+	int          groups     = 4096;
+	int          iterations = 64;
+
+	// Usage: program.exe <op> <memory> <width> <addresses> <aggregate> <groups> <iterations>
+	// op: 0=Add, 1=Min, 2=Max, 3=CompareExchange   memory: 0=Global, 1=GroupShared   width: 32 or 64
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			config.op = static_cast<AtomicOp>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			config.memory = static_cast<AtomicMemory>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			width = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			addresses = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			aggregate = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			groups = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			iterations = _wtoi(argv[7]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: op=%d, memory=%d, width=%d, addresses=%d, aggregate=%d, groups=%d, iterations=%d\n",
+			static_cast<int>(config.op), static_cast<int>(config.memory), width, addresses, aggregate, groups, iterations);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (config.op >= AtomicOp::AtomicOpCount || config.memory >= AtomicMemory::AtomicMemoryCount)
+	{
+		OutputDebugStringA("ERROR: Unknown atomic op or memory!\n");
+		return 1;
+	}
+	if ((width != 32 && width != 64) || addresses <= 0 || groups <= 0 || iterations <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+	if (aggregate != 0 && config.op == AtomicOp::AtomicCompareExchange)
+	{
+		// A compare-exchange cannot be folded into a wave reduction.
+		OutputDebugStringA("ERROR: Aggregation is not defined for CompareExchange!\n");
+		return 1;
+	}
+	config.width     = static_cast<uint32_t>(width);
+	config.addresses = static_cast<uint32_t>(addresses);
+	config.aggregate = aggregate != 0;
+
+	AtomicThroughput test(hInstance, config, static_cast<uint32_t>(groups), static_cast<uint32_t>(iterations));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Atomic variant not supported on this device!\n");
+		return 1;
+	}
+
+	// First run pays for PSO/driver warm-up; time the second one.
+	test.Dispatch();
+	test.Dispatch();
+	double seconds      = test.GetDuration();
+	double opsPerSecond = test.OperationCount() / seconds;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Op: " << AtomicOpName(config.op) << " Memory: " << AtomicMemoryName(config.memory) << " Width: " << width
+		<< " Addresses: " << addresses << " Aggregate: " << aggregate << "\n";
+	debugOutput << "Atomics: " << test.OperationCount() << " in " << seconds << " seconds\n";
+	debugOutput << "Throughput: " << opsPerSecond / 1e9 << " Gops/s\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("atomic_throughput_results.csv", "Op,OpName,Memory,Width,Addresses,Aggregate,Groups,Iterations,Operations,Seconds,OpsPerSecond", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(config.op), AtomicOpName(config.op), AtomicMemoryName(config.memory), width, addresses, aggregate,
+		groups, iterations, test.OperationCount(), seconds, opsPerSecond);
+    return 0;
+}
@@ -0,0 +1,85 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+OPS = {
+    0: "Add",
+    1: "Min",
+    2: "Max",
+    3: "CompareExchange",
+}
+
+MEMORY = {
+    0: "Global",
+    1: "GroupShared",
+}
+
+def run_simple_test(tryCount = 4):
+    """Sweeps atomic throughput from full contention (one address) to no contention"""
+
+    program = "..\\x64\\Release\\AtomicThroughput.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "atomic_throughput_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    groups = 4096
+    iterations = 64
+    for memory in MEMORY:
+        for width in [32, 64]:
+            for op in OPS:
+                for aggregate in [0, 1]:
+                    if aggregate and op == 3:
+                        continue
+                    for addresses in [1, 4, 16, 64, 256, 1024, 4096, 65536, 1048576]:
+                        print(f"\nRunning {OPS[op]} {MEMORY[memory]} {width}-bit addresses {addresses} aggregate {aggregate}...")
+                        for i in range(tryCount):
+                            time.sleep(0.01)
+                            try:
+                                result = subprocess.run([
+                                    program,
+                                    str(op),
+                                    str(memory),
+                                    str(width),
+                                    str(addresses),
+                                    str(aggregate),
+                                    str(groups),
+                                    str(iterations)
+                                ], capture_output=True, text=True)
+                                print(f"  Run {i+1}: {result.stdout.strip()}")
+                            except Exception as e:
+                                print(f"  Run {i+1}: Error - {e}")
+
+def plot_atomic_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            aggregate = " agg" if parts[5] == "1" else ""
+            key = f"{parts[1]} {parts[2]} {parts[3]}-bit{aggregate}"
+            series.setdefault(key, ([], []))
+            series[key][0].append(int(parts[4]))
+            series[key][1].append(float(parts[10]) / 1e9)
+
+    for key, (addresses, gops) in sorted(series.items()):
+        plt.plot(addresses, gops, marker='o', linestyle='', label=key)
+    plt.xscale('log', base=2)
+    plt.yscale('log')
+    plt.xlabel('Distinct Addresses')
+    plt.ylabel('Throughput (Gatomics/s)')
+    plt.title('Atomic Throughput vs Contention')
+    plt.legend(fontsize=6)
+    plt.grid(True)
+    plt.savefig('AtomicThroughput.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_atomic_results("atomic_throughput_results.csv")
@@ -0,0 +1,133 @@
+// Compiled with DXC. Variants are selected by defines:
+//   OP          0=Add, 1=Min, 2=Max, 3=CompareExchange
+//   GROUPSHARED 0=global RWByteAddressBuffer, 1=groupshared array
+//   WIDTH64     0=32-bit, 1=64-bit (shader model 6.6)
+//   AGGREGATE   1=combine lanes that hit the same address with a wave reduction, one atomic per address per wave
+
+#if WIDTH64
+typedef uint64_t value_t;
+static const uint ValueBytes = 8;
+#else
+typedef uint value_t;
+static const uint ValueBytes = 4;
+#endif
+
+RWByteAddressBuffer        Target : register(u0);
+RWStructuredBuffer<uint>   Output : register(u1);
+
+cbuffer params : register(b0)
+{
+    uint Addresses;     // distinct addresses hit: 1 = every thread on one address
+    uint Iterations;    // atomics per thread
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint NumThreads      = 256;
+static const uint GroupSharedSize = 1024;
+
+#if GROUPSHARED
+groupshared value_t Shared[GroupSharedSize];
+#endif
+
+void Atomic(uint address, value_t value, inout value_t expected)
+{
+#if GROUPSHARED
+  #if OP == 0
+    InterlockedAdd(Shared[address], value);
+  #elif OP == 1
+    InterlockedMin(Shared[address], value);
+  #elif OP == 2
+    InterlockedMax(Shared[address], value);
+  #else
+    value_t original;
+    InterlockedCompareExchange(Shared[address], expected, expected + value, original);
+    expected = original;
+  #endif
+#elif WIDTH64
+  #if OP == 0
+    Target.InterlockedAdd64(address * ValueBytes, value);
+  #elif OP == 1
+    Target.InterlockedMin64(address * ValueBytes, value);
+  #elif OP == 2
+    Target.InterlockedMax64(address * ValueBytes, value);
+  #else
+    value_t original;
+    Target.InterlockedCompareExchange64(address * ValueBytes, expected, expected + value, original);
+    expected = original;
+  #endif
+#else
+  #if OP == 0
+    Target.InterlockedAdd(address * ValueBytes, value);
+  #elif OP == 1
+    Target.InterlockedMin(address * ValueBytes, value);
+  #elif OP == 2
+    Target.InterlockedMax(address * ValueBytes, value);
+  #else
+    value_t original;
+    Target.InterlockedCompareExchange(address * ValueBytes, expected, expected + value, original);
+    expected = original;
+  #endif
+#endif
+}
+
+value_t WaveReduce(value_t value)
+{
+#if OP == 1
+    return WaveActiveMin(value);
+#elif OP == 2
+    return WaveActiveMax(value);
+#else
+    return WaveActiveSum(value);
+#endif
+}
+
+[numthreads(256 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    const uint globalId = groupId.x * NumThreads + threadId.x;
+
+#if GROUPSHARED
+    for (uint i = threadId.x; i < GroupSharedSize; i += NumThreads)
+    {
+        Shared[i] = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+    const uint address = threadId.x % min(Addresses, GroupSharedSize);
+#else
+    const uint address = globalId % Addresses;
+#endif
+
+    value_t expected = 0;
+    for (uint iteration = 0; iteration < Iterations; ++iteration)
+    {
+        // Scrambled values so Min/Max keep updating instead of settling after the first pass.
+        value_t value = (value_t)((globalId * 2654435761u) ^ (iteration * 40503u));
+
+#if AGGREGATE
+        // Waterfall: each pass takes the first active lane's address, reduces over the lanes that share it
+        // and issues a single atomic. One pass with full contention, up to one per lane with none.
+        for (;;)
+        {
+            const uint key = WaveReadLaneFirst(address);
+            if (address == key)
+            {
+                value_t combined = WaveReduce(value);
+                if (WaveIsFirstLane())
+                {
+                    Atomic(key, combined, expected);
+                }
+                break;
+            }
+        }
+#else
+        Atomic(address, value, expected);
+#endif
+    }
+
+#if GROUPSHARED
+    // Publish the groupshared results so the atomics cannot be optimised away.
+    GroupMemoryBarrierWithGroupSync();
+    Output[globalId] = (uint)Shared[threadId.x % GroupSharedSize];
+#endif
+}
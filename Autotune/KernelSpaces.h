@@ -0,0 +1,52 @@
+#pragma once
+
+// The kernels the Autotune project knows how to tune and the parameter space declared for each.
+// Parameter names are the defines of the matching shader in Shaders/. No D3D dependency.
+
+#include "Autotuner.h"
+#include <cstdint>
+
+enum TunableKernel : uint32_t {
+    TunableCopy      = 0,   // Shaders/TunableCopy.hlsl, problem size = floats
+    TunableTranspose = 1,   // Shaders/TunableTranspose.hlsl, problem size = edge of the square image
+    TunableKernelCount
+};
+
+inline const char* TunableKernelName(TunableKernel kernel)
+{
+    return kernel == TunableKernel::TunableTranspose ? "Transpose" : "Copy";
+}
+
+namespace KernelSpaces
+{
+    inline TuningSpace Space(TunableKernel kernel)
+    {
+        TuningSpace space;
+        if (kernel == TunableKernel::TunableTranspose)
+        {
+            // Group of TILE_SIZE x TILE_SIZE / ELEMENTS_PER_THREAD threads, each moving a column strip.
+            space.Add("TILE_SIZE", { 8, 16, 32 })
+                 .Add("ELEMENTS_PER_THREAD", { 1, 2, 4, 8 })
+                 .Add("UNROLL", { 0, 1 })
+                 .Require([](const TuningSpace& s, const TuningConfig& c) {
+                     return s.Value(c, "ELEMENTS_PER_THREAD") <= s.Value(c, "TILE_SIZE") &&
+                            s.Value(c, "TILE_SIZE") * s.Value(c, "TILE_SIZE") / s.Value(c, "ELEMENTS_PER_THREAD") <= 1024;
+                 });
+        }
+        else
+        {
+            space.Add("GROUP_SIZE", { 64, 128, 256, 512, 1024 })
+                 .Add("ELEMENTS_PER_THREAD", { 1, 2, 4, 8 })
+                 .Add("VECTOR_WIDTH", { 1, 2, 4 })
+                 .Add("UNROLL", { 0, 1 });
+        }
+        return space;
+    }
+
+    // The hand-picked configuration the kernel used before tuning: GpuCopy's [numthreads(64,1,1)]
+    // one float per thread, and the smallest transpose tile.
+    inline TuningConfig Baseline(TunableKernel kernel)
+    {
+        return kernel == TunableKernel::TunableTranspose ? TuningConfig{ 8, 1, 0 } : TuningConfig{ 64, 1, 1, 0 };
+    }
+}
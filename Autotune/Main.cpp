@@ -0,0 +1,235 @@
+#include "d3dAppSimplified.h"
+#include "TunableKernels.h"
+#include "KernelSpaces.h"
+#include "Autotuner.h"
+#include "CpuTuningBackend.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+enum TuningBackendKind : int {
+    D3D12Backend = 0,  // TunableKernels: DXC compile + GPU timestamps
+    CpuBackend   = 1,  // CpuTuningBackend: host copy, exercises the search and the database without a GPU
+};
+
+enum TuningMode : int {
+    TuneMode   = 0,  // search, record the winner, save the database
+    ServeMode  = 1,  // use the database record for this kernel/device (nearest problem size), no search
+    CachedMode = 2,  // serve an exact record if there is one, otherwise search and record
+};
+
+static const uint32_t kReportRuns = 8;
+
+static double BestOf(TuningBackend& backend, const TuningConfig& config, uint32_t runs)
+{
+	double best = backend.Measure(config);
+	for (uint32_t r = 1; r < runs; ++r)
+	{
+		best = (std::min)(best, backend.Measure(config));
+	}
+	return best;
+}
+
+static uint64_t ValidateConfig(TunableKernels& backend, const TuningConfig& config) { return backend.Validate(config); }
+
+static uint64_t ValidateConfig(CpuTuningBackend& backend, const TuningConfig& config)
+{
+	backend.Measure(config);
+	return backend.Verify();
+}
+
+// Finds the configuration to use (database or search), times it against the kernel's baseline
+// configuration, prints the summary and appends one row to autotune_results.csv.
+template <typename Backend>
+static int TuneAndReport(Backend& backend, const TuningSpace& space, const char* backendName, const std::string& device,
+	const std::string& deviceCaps, TunableKernel kernel, uint32_t problemSize, uint64_t bytes, TuningMode mode, const TuningOptions& options,
+	const std::string& databasePath)
+{
+	TuningDatabase database;
+	database.Load(databasePath);
+	const TuningRecord* record = mode == TuningMode::TuneMode ? nullptr :
+		database.Lookup(TunableKernelName(kernel), device, problemSize, mode == TuningMode::CachedMode);
+
+	TuningConfig config;
+	TuningResult search;
+	double       tuneSeconds = 0.0;
+	bool         fromDatabase = record != nullptr && space.Parse(record->config, config);
+	if (!fromDatabase)
+	{
+		if (mode == TuningMode::ServeMode)
+		{
+			OutputDebugStringA("ERROR: No usable database record for this kernel and device!\n");
+			return 1;
+		}
+		CpuTimer timer;
+		timer.Start();
+		search = Autotuner::SuccessiveHalving(backend, space, options);
+		tuneSeconds = timer.Stop();
+		if (search.best.empty())
+		{
+			OutputDebugStringA("ERROR: No configuration of the space could be prepared!\n");
+			return 1;
+		}
+		config = search.best;
+		database.Record({ TunableKernelName(kernel), device, problemSize, space.Describe(config), search.seconds });
+		database.Save(databasePath);
+	}
+
+	TuningConfig baseline = KernelSpaces::Baseline(kernel);
+	if (!backend.Prepare(config) || !backend.Prepare(baseline))
+	{
+		OutputDebugStringA("ERROR: Selected or baseline configuration cannot run on this backend!\n");
+		return 1;
+	}
+	double bestSeconds     = BestOf(backend, config, kReportRuns);
+	double baselineSeconds = BestOf(backend, baseline, kReportRuns);
+	uint64_t mismatches    = ValidateConfig(backend, config);
+	double bestGBs         = 2.0 * bytes / bestSeconds / 1e9;
+	double speedup         = baselineSeconds / bestSeconds;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Kernel: " << TunableKernelName(kernel) << " Problem size: " << problemSize << " Backend: " << backendName << " Device: " << device << "\n";
+	if (fromDatabase)
+	{
+		debugOutput << "Configuration from database (recorded for size " << record->problemSize << ")\n";
+	}
+	else
+	{
+		debugOutput << "Searched " << search.prepared << "/" << search.candidates << " configurations in " << search.rounds << " rounds, "
+			<< search.measurements << " runs, " << tuneSeconds << " seconds\n";
+	}
+	debugOutput << "Best: " << space.Describe(config) << " " << bestSeconds << " seconds (" << bestGBs << " GB/s)\n";
+	debugOutput << "Baseline: " << space.Describe(baseline) << " " << baselineSeconds << " seconds (speedup " << speedup << "x)\n";
+	debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("autotune_results.csv",
+		"Kernel,Backend,Device,ProblemSize,Source,Candidates,Prepared,Rounds,Measurements,Tune_s,Config,Best_s,Best_GBs,BaselineConfig,Baseline_s,Speedup,Mismatches", deviceCaps);
+	csv.Row(TunableKernelName(kernel), backendName, device, problemSize, fromDatabase ? "Database" : "Search", search.candidates, search.prepared,
+		search.rounds, search.measurements, tuneSeconds, space.Describe(config), bestSeconds, bestGBs, space.Describe(baseline), baselineSeconds,
+		speedup, mismatches);
+	return mismatches == 0 ? 0 : 1;
+}
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	TunableKernel kernel        = TunableKernel::TunableCopy;
+	int           backend       = TuningBackendKind::D3D12Backend;
+	int           problemSize   = 1 << 24;
+	int           mode          = TuningMode::CachedMode;
+	int           eta           = 2;
+	int           maxCandidates = 0;
+	std::wstring  databasePath  = L"autotune_db.csv";
+	int           cpuThreads    = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <kernel> <backend> <problemSize> <mode> <eta> <maxCandidates> <databasePath> <cpuThreads>
+	// kernel: 0=Copy (problemSize floats, multiple of 4), 1=Transpose (problemSize x problemSize floats)
+	// backend: 0=D3D12, 1=CPU (Copy only)   mode: 0=tune, 1=serve from database, 2=serve exact record or tune
+	// maxCandidates: random sample of the space, 0=all
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			kernel = static_cast<TunableKernel>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			backend = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			problemSize = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			mode = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			eta = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			maxCandidates = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			databasePath = argv[7];
+		}
+		if (argc >= 9)
+		{
+			cpuThreads = _wtoi(argv[8]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: kernel=%d, backend=%d, problemSize=%d, mode=%d, eta=%d, maxCandidates=%d, database=%s, cpuThreads=%d\n",
+			static_cast<int>(kernel), backend, problemSize, mode, eta, maxCandidates, databasePath.c_str(), cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (kernel >= TunableKernel::TunableKernelCount || mode < TuningMode::TuneMode || mode > TuningMode::CachedMode)
+	{
+		OutputDebugStringA("ERROR: Unknown kernel or mode!\n");
+		return 1;
+	}
+	// Copy: whole float4 vectors, at most 1 GB. Transpose: square images up to 16384^2.
+	bool sizeValid = kernel == TunableKernel::TunableCopy ?
+		problemSize > 0 && problemSize % 4 == 0 && problemSize <= (1 << 28) :
+		problemSize > 0 && problemSize <= 16384;
+	if (!sizeValid || eta < 2 || maxCandidates < 0 || cpuThreads <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	TuningOptions options;
+	options.eta           = static_cast<uint32_t>(eta);
+	options.maxCandidates = static_cast<uint32_t>(maxCandidates);
+	std::string database(databasePath.begin(), databasePath.end());
+
+	if (backend == TuningBackendKind::D3D12Backend)
+	{
+		TunableKernels test(hInstance, kernel, static_cast<uint32_t>(problemSize));
+		test.Initialize();
+		if (!test.Supported())
+		{
+			OutputDebugStringA("ERROR: Shader model 6.0 not supported on this device!\n");
+			return 1;
+		}
+		return TuneAndReport(test, test.Space(), "D3D12", QueryAdapterKey(test.Device()), QueryDeviceCaps(test.Device()).Describe(), kernel,
+			static_cast<uint32_t>(problemSize), test.Bytes(), static_cast<TuningMode>(mode), options, database);
+	}
+	else if (backend == TuningBackendKind::CpuBackend && kernel == TunableKernel::TunableCopy)
+	{
+		TuningSpace space = KernelSpaces::Space(kernel);
+		CpuTuningBackend test(space, static_cast<uint64_t>(problemSize), static_cast<uint32_t>(cpuThreads));
+		std::string device = "CPU " + std::to_string(cpuThreads) + " threads";
+		return TuneAndReport(test, space, "CPU", device, "None", kernel, static_cast<uint32_t>(problemSize),
+			static_cast<uint64_t>(problemSize) * sizeof(float), static_cast<TuningMode>(mode), options, database);
+	}
+	else
+	{
+		OutputDebugStringA("ERROR: Unknown backend, or kernel not available on it!\n");
+		return 1;
+	}
+}
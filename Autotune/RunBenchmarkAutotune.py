@@ -0,0 +1,89 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+KERNELS = {
+    0: "Copy",
+    1: "Transpose",
+}
+
+SIZES = {
+    0: [1 << 16, 1 << 18, 1 << 20, 1 << 22, 1 << 24, 1 << 26],
+    1: [256, 512, 1024, 2048, 4096, 8192],
+}
+
+def run_simple_test(backend = 0, eta = 2):
+    """Tunes every kernel at every size (mode 0), then serves each size from the database (mode 1)"""
+
+    program = "..\\x64\\Release\\Autotune.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "autotune_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    # The database is kept between runs on purpose; mode 0 overwrites the records it re-tunes.
+    for mode in [0, 1]:
+        for kernel in KERNELS:
+            # The CPU backend only implements the copy kernel.
+            if backend == 1 and kernel != 0:
+                continue
+            for size in SIZES[kernel]:
+                print(f"\nRunning {KERNELS[kernel]} size {size} mode {mode}...")
+                time.sleep(0.01)
+                try:
+                    result = subprocess.run([
+                        program,
+                        str(kernel),
+                        str(backend),
+                        str(size),
+                        str(mode),
+                        str(eta),
+                        "0",
+                        "autotune_db.csv"
+                    ], capture_output=True, text=True)
+                    if result.returncode != 0:
+                        print(f"  failed (exit {result.returncode})")
+                    else:
+                        print(f"  {result.stdout.strip()}")
+                except Exception as e:
+                    print(f"  Error - {e}")
+
+def plot_autotune_results(filename):
+    results = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = (parts[0], parts[4])
+            results.setdefault(key, []).append((int(parts[3]), float(parts[12]), float(parts[15]), float(parts[9])))
+
+    fig, axes = plt.subplots(1, 3, figsize=(16, 5))
+    for (kernel, source), rows in sorted(results.items()):
+        rows.sort()
+        sizes = [r[0] for r in rows]
+        axes[0].plot(sizes, [r[1] for r in rows], marker='o', label=f"{kernel} {source}")
+        axes[1].plot(sizes, [r[2] for r in rows], marker='o', label=f"{kernel} {source}")
+        if source == "Search":
+            axes[2].plot(sizes, [r[3] for r in rows], marker='o', label=kernel)
+    for ax, title, ylabel in zip(axes, ["Tuned bandwidth", "Speedup over baseline configuration", "Search cost"],
+                                 ["GB/s", "Speedup", "Seconds"]):
+        ax.set_xscale('log', base=2)
+        ax.set_xlabel('Problem size')
+        ax.set_ylabel(ylabel)
+        ax.set_title(title)
+        ax.grid(True)
+        ax.legend(fontsize=7)
+    plt.suptitle('Autotuned Kernels')
+    plt.tight_layout()
+    plt.savefig('Autotune.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_autotune_results("autotune_results.csv")
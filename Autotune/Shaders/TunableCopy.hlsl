@@ -0,0 +1,38 @@
+// Output[i] = Input[i] over Count vectors, with the launch shape left to the autotuner. Compiled
+// with DXC (cs_6_0); the tuned parameters arrive as defines:
+//   GROUP_SIZE           threads per group (the 64 GpuCopy hardcodes, up to 1024)
+//   ELEMENTS_PER_THREAD  vectors per thread, GROUP_SIZE vectors apart so every pass stays coalesced
+//   VECTOR_WIDTH         floats per load/store (1, 2 or 4)
+//   UNROLL               1=[unroll] the per-thread loop, 0=[loop]
+
+#define VECTOR vector<float, VECTOR_WIDTH>
+
+StructuredBuffer<VECTOR>   Input  : register(t0);
+RWStructuredBuffer<VECTOR> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Count;     // vectors
+    uint GroupsX;
+    uint Pad0;
+    uint Pad1;
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint first = (groupId.y * GroupsX + groupId.x) * GROUP_SIZE * ELEMENTS_PER_THREAD + threadId.x;
+#if UNROLL
+    [unroll]
+#else
+    [loop]
+#endif
+    for (uint e = 0; e < ELEMENTS_PER_THREAD; ++e)
+    {
+        uint i = first + e * GROUP_SIZE;
+        if (i < Count)
+        {
+            Output[i] = Input[i];
+        }
+    }
+}
@@ -0,0 +1,58 @@
+// Out[x][y] = In[y][x] for a Width x Height row-major float image, staged through a group-shared
+// tile so both the reads and the writes are row-contiguous. Compiled with DXC (cs_6_0); the tuned
+// parameters arrive as defines:
+//   TILE_SIZE            edge of the square tile one group moves (8, 16 or 32)
+//   ELEMENTS_PER_THREAD  tile rows per thread; the group is TILE_SIZE x TILE_SIZE / ELEMENTS_PER_THREAD
+//   UNROLL               1=[unroll] the per-thread loops, 0=[loop]
+
+StructuredBuffer<float>   Input  : register(t0);
+RWStructuredBuffer<float> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Width;
+    uint Height;
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint RowStep = TILE_SIZE / ELEMENTS_PER_THREAD;
+
+// One column of padding keeps the transposed reads off a single LDS bank.
+groupshared float Tile[TILE_SIZE][TILE_SIZE + 1];
+
+#if UNROLL
+#define LOOP_HINT [unroll]
+#else
+#define LOOP_HINT [loop]
+#endif
+
+[numthreads(TILE_SIZE, RowStep, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint x = groupId.x * TILE_SIZE + threadId.x;
+    LOOP_HINT
+    for (uint e = 0; e < ELEMENTS_PER_THREAD; ++e)
+    {
+        uint row = threadId.y + e * RowStep;
+        uint y   = groupId.y * TILE_SIZE + row;
+        if (x < Width && y < Height)
+        {
+            Tile[row][threadId.x] = Input[y * Width + x];
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Output is Height wide: this group writes rows groupId.x * TILE_SIZE.. of it.
+    uint outX = groupId.y * TILE_SIZE + threadId.x;
+    LOOP_HINT
+    for (uint e = 0; e < ELEMENTS_PER_THREAD; ++e)
+    {
+        uint row  = threadId.y + e * RowStep;
+        uint outY = groupId.x * TILE_SIZE + row;
+        if (outX < Height && outY < Width)
+        {
+            Output[outY * Height + outX] = Tile[threadId.x][row];
+        }
+    }
+}
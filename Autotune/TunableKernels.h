@@ -0,0 +1,171 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "Autotuner.h"
+#include "KernelSpaces.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// D3D12 TuningBackend for the kernels in KernelSpaces.h: Prepare() compiles the shader with the
+// configuration as defines and caches its pipeline state, Measure() times one Dispatch() of it.
+// Input and output buffers are shared by every configuration, so the search only varies the
+// kernel.
+class TunableKernels : public D3DAppSimplified, public TuningBackend
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Param0;    // Copy: vectors       Transpose: width
+		uint32_t Param1;    // Copy: groups in X   Transpose: height
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+
+    TunableKernels(HINSTANCE hInstance, TunableKernel kernel, uint32_t problemSize) :
+		D3DAppSimplified(hInstance),
+		m_kernel(kernel),
+		m_problemSize(problemSize),
+		m_space(KernelSpaces::Space(kernel))
+	{
+		mHostInput.resize(Elements());
+		for (size_t i = 0; i < mHostInput.size(); ++i)
+		{
+			mHostInput[i] = static_cast<float>(i % 65521);
+		}
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = QueryHighestShaderModel(Device()) >= D3D_SHADER_MODEL_6_0;
+
+		mInputBuffer    = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostInput.data(), Bytes());
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, Bytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, Bytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+	// Shaders are compiled per configuration in Prepare().
+    void BuildShadersAndInputLayout() override { }
+
+    void BuildPSOs() override {
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSOs[m_space.Describe(m_config)].Get());
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		if (m_kernel == TunableKernel::TunableTranspose)
+		{
+			uint32_t tiles = DivideRoundUp(m_problemSize, m_space.Value(m_config, "TILE_SIZE"));
+			RootConstants constants = { m_problemSize, m_problemSize, 0, 0 };
+			commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+			commandList->Dispatch(tiles, tiles, 1);
+		}
+		else
+		{
+			uint32_t vectors = m_problemSize / m_space.Value(m_config, "VECTOR_WIDTH");
+			uint32_t groups  = DivideRoundUp(vectors, m_space.Value(m_config, "GROUP_SIZE") * m_space.Value(m_config, "ELEMENTS_PER_THREAD"));
+			RootConstants constants = { vectors, GroupsX(groups), 0, 0 };
+			commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+			DispatchGroups(groups);
+		}
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, Bytes());
+		}
+    }
+
+	bool Prepare(const TuningConfig& config) override
+	{
+		std::string key = m_space.Describe(config);
+		if (mPSOs.count(key) != 0)
+		{
+			return true;
+		}
+		if (!m_space.Valid(config) ||
+			(m_kernel == TunableKernel::TunableCopy && m_problemSize % m_space.Value(config, "VECTOR_WIDTH") != 0))
+		{
+			return false;
+		}
+		ComPtr<ID3DBlob> shader = D3DUtil::CompileShaderDxc(
+			m_kernel == TunableKernel::TunableTranspose ? L"Shaders\\TunableTranspose.hlsl" : L"Shaders\\TunableCopy.hlsl",
+			m_space.Defines(config), L"main", L"cs_6_0");
+		mPSOs[key] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), shader.Get());
+		return true;
+	}
+
+	double Measure(const TuningConfig& config) override
+	{
+		m_config = config;
+		Dispatch();
+		return GetDuration();
+	}
+
+	// Runs a prepared configuration once more with a readback and counts the output elements that
+	// differ from the host copy/transpose.
+	uint64_t Validate(const TuningConfig& config)
+	{
+		SetCopyResults(true);
+		Measure(config);
+		SetCopyResults(false);
+
+		float* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(Bytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint64_t mismatches = 0;
+		for (size_t i = 0; i < Elements(); ++i)
+		{
+			size_t source = i;
+			if (m_kernel == TunableKernel::TunableTranspose)
+			{
+				size_t row = i / m_problemSize;
+				size_t col = i % m_problemSize;
+				source = col * m_problemSize + row;
+			}
+			mismatches += mapped[i] != mHostInput[source] ? 1 : 0;
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+	bool               Supported() const { return m_supported; }
+	const TuningSpace& Space()     const { return m_space; }
+	size_t Elements() const
+	{
+		return m_kernel == TunableKernel::TunableTranspose ? static_cast<size_t>(m_problemSize) * m_problemSize : m_problemSize;
+	}
+	UINT64 Bytes()    const { return Elements() * sizeof(float); }
+
+private:
+
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	std::map<std::string, ComPtr<ID3D12PipelineState>> mPSOs;   // keyed by TuningSpace::Describe
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<float> mHostInput;
+
+	TunableKernel m_kernel;
+	uint32_t      m_problemSize;
+	TuningSpace   m_space;
+	TuningConfig  m_config;
+	bool          m_supported = false;
+};
@@ -0,0 +1,248 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// What separates consecutive dispatches of a chain.
+enum BarrierMode : uint32_t {
+    NoBarrier       = 0,  // baseline: no synchronisation at all, the GPU may overlap the dispatches
+    UavBarrier      = 1,  // D3D12_RESOURCE_BARRIER_TYPE_UAV with a null resource (all UAV accesses)
+    Transition      = 2,  // written buffer UNORDERED_ACCESS -> NON_PIXEL_SHADER_RESOURCE, read buffer back
+    SplitTransition = 3,  // same transitions as BEGIN_ONLY after the write, END_ONLY before the next read
+    Enhanced        = 4,  // ID3D12GraphicsCommandList7::Barrier, global UAV -> UAV access, COMPUTE_SHADING sync
+    EnhancedSplit   = 5,  // enhanced barrier split with D3D12_BARRIER_SYNC_SPLIT
+    BarrierModeCount
+};
+
+inline const char* BarrierModeName(BarrierMode mode)
+{
+    switch (mode)
+    {
+    case BarrierMode::NoBarrier:       return "NoBarrier";
+    case BarrierMode::UavBarrier:      return "UavBarrier";
+    case BarrierMode::Transition:      return "Transition";
+    case BarrierMode::SplitTransition: return "SplitTransition";
+    case BarrierMode::Enhanced:        return "Enhanced";
+    case BarrierMode::EnhancedSplit:   return "EnhancedSplit";
+    default:                           return "Unknown";
+    }
+}
+
+inline bool UsesSrvInput(BarrierMode mode)
+{
+    return mode == BarrierMode::Transition || mode == BarrierMode::SplitTransition;
+}
+
+inline bool IsSplit(BarrierMode mode)
+{
+    return mode == BarrierMode::SplitTransition || mode == BarrierMode::EnhancedSplit;
+}
+
+// Two independent ping-pong chains are interleaved (A0 B0 A1 B1 ...), so that a split barrier of one
+// chain always has the other chain's dispatch between its BEGIN and its END. Every mode records the
+// same dispatches; only what sits between them changes.
+class BarrierCost : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t ElementCount;
+		uint32_t DispatchThreads;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t NumThreads = 64;
+    static const uint32_t ChainCount = 2;
+
+    BarrierCost(HINSTANCE hInstance, uint32_t elements, uint32_t chainLength) :
+		D3DAppSimplified(hInstance),
+		m_elements(elements),
+		m_chainLength(chainLength)
+	{
+    }
+
+    void BuildResourcesAndHeaps() override {
+		std::vector<float> inputData(m_elements, 1.0f);
+		UINT64 byteSize = static_cast<UINT64>(m_elements) * sizeof(float);
+		for (uint32_t c = 0; c < ChainCount; ++c)
+		{
+			for (uint32_t b = 0; b < 2; ++b)
+			{
+				mBuffers[c][b] = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), inputData.data(), byteSize);
+			}
+		}
+		// CreateDefaultBuffer leaves the buffers in GENERIC_READ; like every buffer they decay to COMMON
+		// after the init submission, which is where each DoAction starts from.
+
+		m_enhancedSupported = CheckEnhancedBarrierSupport();
+	}
+
+    void BuildShadersAndInputLayout() override {
+		D3D_SHADER_MACRO uavInput[] = { { "INPUT_SRV", "0" }, { nullptr, nullptr } };
+		D3D_SHADER_MACRO srvInput[] = { { "INPUT_SRV", "1" }, { nullptr, nullptr } };
+		mShaders[0] = D3DUtil::CompileShader(L"Shaders\\ChainKernel.hlsl", uavInput, "main", "cs_5_0");
+		mShaders[1] = D3DUtil::CompileShader(L"Shaders\\ChainKernel.hlsl", srvInput, "main", "cs_5_0");
+	}
+
+    void BuildPSOs() override {
+		CD3DX12_ROOT_PARAMETER slotRootParameter[4];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+		slotRootParameter[3].InitAsUnorderedAccessView(1);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(4, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSOs[0] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[0].Get());
+		mPSOs[1] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[1].Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		bool srvInput = UsesSrvInput(m_mode);
+
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSOs[srvInput ? 1 : 0].Get());
+
+		uint32_t groups = (m_elements + NumThreads - 1) / NumThreads;
+		groups = groups < MaxGroupsX ? groups : MaxGroupsX;
+		RootConstants constants = { m_elements, groups * NumThreads, 0, 0 };
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+
+		// Buffers start every submission in COMMON. Transition modes need explicit starting states:
+		// the first source readable, the first destination writable.
+		if (srvInput)
+		{
+			std::vector<D3D12_RESOURCE_BARRIER> barriers;
+			for (uint32_t c = 0; c < ChainCount; ++c)
+			{
+				barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(mBuffers[c][0].Get(), D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
+				barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(mBuffers[c][1].Get(), D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+			}
+			commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+		}
+
+		for (uint32_t k = 0; k < m_chainLength; ++k)
+		{
+			for (uint32_t c = 0; c < ChainCount; ++c)
+			{
+				ID3D12Resource* source      = mBuffers[c][k & 1].Get();
+				ID3D12Resource* destination = mBuffers[c][(k + 1) & 1].Get();
+				bool last = k + 1 == m_chainLength;
+
+				// Split barriers: finish the one begun after this chain's previous dispatch.
+				if (k > 0 && IsSplit(m_mode))
+				{
+					RecordBarrier(commandList, destination, source, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+				}
+
+				if (srvInput)
+				{
+					commandList->SetComputeRootShaderResourceView(1, source->GetGPUVirtualAddress());
+				}
+				else
+				{
+					commandList->SetComputeRootUnorderedAccessView(3, source->GetGPUVirtualAddress());
+				}
+				commandList->SetComputeRootUnorderedAccessView(2, destination->GetGPUVirtualAddress());
+				commandList->Dispatch(groups, 1, 1);
+
+				if (!last)
+				{
+					RecordBarrier(commandList, source, destination, IsSplit(m_mode) ? D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY : D3D12_RESOURCE_BARRIER_FLAG_NONE);
+				}
+			}
+		}
+    }
+
+	void SetMode(BarrierMode mode) { m_mode = mode; }
+
+	bool Supported(BarrierMode mode) const
+	{
+		return (mode != BarrierMode::Enhanced && mode != BarrierMode::EnhancedSplit) || m_enhancedSupported;
+	}
+
+	// Barrier points in one DoAction: every dispatch except each chain's last one is followed by one.
+	uint32_t BarrierCount() const { return ChainCount * (m_chainLength - 1); }
+
+private:
+
+	// 'source' was just read and will be written next, 'destination' was just written and will be read.
+	void RecordBarrier(ID3D12GraphicsCommandList* commandList, ID3D12Resource* source, ID3D12Resource* destination, D3D12_RESOURCE_BARRIER_FLAGS flags)
+	{
+		switch (m_mode)
+		{
+		case BarrierMode::UavBarrier:
+		{
+			// The next dispatch both reads 'destination' (RAW) and writes 'source' (WAR), so cover all UAVs.
+			auto barrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+			commandList->ResourceBarrier(1, &barrier);
+			break;
+		}
+		case BarrierMode::Transition:
+		case BarrierMode::SplitTransition:
+		{
+			CD3DX12_RESOURCE_BARRIER barriers[2] = {
+				CD3DX12_RESOURCE_BARRIER::Transition(destination, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, flags),
+				CD3DX12_RESOURCE_BARRIER::Transition(source, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, flags)
+			};
+			commandList->ResourceBarrier(2, barriers);
+			break;
+		}
+		case BarrierMode::Enhanced:
+		case BarrierMode::EnhancedSplit:
+			RecordEnhancedBarrier(flags);
+			break;
+		default:
+			break;
+		}
+	}
+
+#ifdef __ID3D12GraphicsCommandList7_INTERFACE_DEFINED__
+	void RecordEnhancedBarrier(D3D12_RESOURCE_BARRIER_FLAGS flags)
+	{
+		D3D12_GLOBAL_BARRIER barrier = {};
+		barrier.SyncBefore   = flags == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY   ? D3D12_BARRIER_SYNC_SPLIT : D3D12_BARRIER_SYNC_COMPUTE_SHADING;
+		barrier.SyncAfter    = flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY ? D3D12_BARRIER_SYNC_SPLIT : D3D12_BARRIER_SYNC_COMPUTE_SHADING;
+		barrier.AccessBefore = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+		barrier.AccessAfter  = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+
+		D3D12_BARRIER_GROUP group = {};
+		group.Type            = D3D12_BARRIER_TYPE_GLOBAL;
+		group.NumBarriers     = 1;
+		group.pGlobalBarriers = &barrier;
+		mCommandList7->Barrier(1, &group);
+	}
+
+	bool CheckEnhancedBarrierSupport()
+	{
+		D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12 = {};
+		if (FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12))) ||
+			!options12.EnhancedBarriersSupported)
+		{
+			return false;
+		}
+		return SUCCEEDED(GraphicsCommandList()->QueryInterface(IID_PPV_ARGS(&mCommandList7)));
+	}
+
+	ComPtr<ID3D12GraphicsCommandList7> mCommandList7;
+#else
+	// Windows SDK without enhanced barriers: those modes report unsupported.
+	void RecordEnhancedBarrier(D3D12_RESOURCE_BARRIER_FLAGS) { }
+	bool CheckEnhancedBarrierSupport() { return false; }
+#endif
+
+    ComPtr<ID3DBlob> mShaders[2];
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[2];  // [0] UAV input, [1] SRV input
+
+	ComPtr<ID3D12Resource> mBuffers[ChainCount][2];
+
+	BarrierMode m_mode = BarrierMode::NoBarrier;
+	uint32_t    m_elements;
+	uint32_t    m_chainLength;
+	bool        m_enhancedSupported = false;
+};
@@ -0,0 +1,98 @@
+#include "d3dAppSimplified.h"
+#include "BarrierCost.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	int         elements    = 65536;
+	int         chainLength = 256;
+	BarrierMode mode        = BarrierMode::UavBarrier;
+
+	// Usage: program.exe <elementsPerDispatch> <chainLength> <mode>
+	// mode: 0=NoBarrier, 1=UavBarrier, 2=Transition, 3=SplitTransition, 4=Enhanced, 5=EnhancedSplit
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			elements = _wtoi(argv[1]);
+		}
+		if (argc >= 3)
+		{
+			chainLength = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			mode = static_cast<BarrierMode>(_wtoi(argv[3]));
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: elements=%d, chainLength=%d, mode=%d\n", elements, chainLength, static_cast<int>(mode));
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (mode >= BarrierMode::BarrierModeCount)
+	{
+		OutputDebugStringA("ERROR: Unknown barrier mode!\n");
+		return 1;
+	}
+	if (elements <= 0 || chainLength < 2)
+	{
+		OutputDebugStringA("ERROR: Need elements > 0 and a chain of at least 2 dispatches!\n");
+		return 1;
+	}
+
+	BarrierCost test(hInstance, static_cast<uint32_t>(elements), static_cast<uint32_t>(chainLength));
+	test.Initialize();
+
+	if (!test.Supported(mode))
+	{
+		OutputDebugStringA("ERROR: Enhanced barriers are not supported on this device/SDK!\n");
+		return 1;
+	}
+
+	// Baseline and barrier mode in the same process, each warmed up once.
+	test.SetMode(BarrierMode::NoBarrier);
+	test.Dispatch();
+	test.Dispatch();
+	double baseline = test.GetDuration();
+
+	test.SetMode(mode);
+	test.Dispatch();
+	test.Dispatch();
+	double duration = test.GetDuration();
+
+	uint32_t barriers     = test.BarrierCount();
+	double   nsPerBarrier = (duration - baseline) * 1e9 / barriers;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Mode: " << BarrierModeName(mode) << " Elements: " << elements << " Chain: " << chainLength << " x " << BarrierCost::ChainCount << "\n";
+	debugOutput << "Baseline (no barriers): " << baseline << " seconds\n";
+	debugOutput << "With barriers:          " << duration << " seconds\n";
+	debugOutput << "Barriers: " << barriers << " Cost: " << nsPerBarrier << " ns/barrier\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("barrier_cost_results.csv", "Mode,ModeName,Elements,ChainLength,Barriers,Baseline_s,Duration_s,NsPerBarrier", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(mode), BarrierModeName(mode), elements, chainLength, barriers, baseline, duration, nsPerBarrier);
+    return 0;
+}
@@ -0,0 +1,68 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+MODES = {
+    1: "UavBarrier",
+    2: "Transition",
+    3: "SplitTransition",
+    4: "Enhanced",
+    5: "EnhancedSplit",
+}
+
+def run_simple_test(tryCount = 4):
+    """Measures the per-barrier drain cost of every barrier type over a range of dispatch sizes"""
+
+    program = "..\\x64\\Release\\BarrierCost.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "barrier_cost_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    chain_length = 256
+    for elements in [64, 1024, 16384, 262144, 1048576, 4194304]:
+        for mode in MODES:
+            print(f"\nRunning {MODES[mode]} elements {elements}...")
+            for i in range(tryCount):
+                time.sleep(0.01)
+                try:
+                    result = subprocess.run([
+                        program,
+                        str(elements),
+                        str(chain_length),
+                        str(mode)
+                    ], capture_output=True, text=True)
+                    print(f"  Run {i+1}: {result.stdout.strip()}")
+                except Exception as e:
+                    print(f"  Run {i+1}: Error - {e}")
+
+def plot_barrier_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            series.setdefault(parts[1], ([], []))
+            series[parts[1]][0].append(int(parts[2]))
+            series[parts[1]][1].append(float(parts[7]))
+
+    for name, (elements, cost) in sorted(series.items()):
+        plt.plot(elements, cost, marker='o', linestyle='', label=name)
+    plt.xscale('log', base=2)
+    plt.xlabel('Elements per Dispatch')
+    plt.ylabel('Cost per Barrier (ns)')
+    plt.title('Barrier Drain Cost vs Dispatch Size')
+    plt.legend()
+    plt.grid(True)
+    plt.savefig('BarrierCost.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_barrier_results("barrier_cost_results.csv")
@@ -0,0 +1,27 @@
+// INPUT_SRV=1: input bound as an SRV (transition-barrier modes), otherwise both buffers are UAVs.
+#if INPUT_SRV
+StructuredBuffer<float>   Input  : register(t0);
+#else
+RWStructuredBuffer<float> Input  : register(u1);
+#endif
+RWStructuredBuffer<float> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint ElementCount;
+    uint DispatchThreads;   // grid stride
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint NumThreads = 64;
+
+// One link of a dependent chain: dispatch k+1 reads what dispatch k wrote.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    for (uint id = groupId.x * NumThreads + threadId.x; id < ElementCount; id += DispatchThreads)
+    {
+        Output[id] = Input[id] * 0.5f + 1.0f;
+    }
+}
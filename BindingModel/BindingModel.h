@@ -0,0 +1,331 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+// How the kernel's b0/t0/u0 get to the shader.
+enum BindingMode : uint32_t {
+    RootDescriptors  = 0,  // CBV/SRV/UAV root descriptors, as D3DAppSimplified/GpuCopy do
+    DescriptorTables = 1,  // three 8-slot CBV/SRV/UAV tables at offsets 0/8/16, as D3DApp does
+    RootConstants    = 2,  // cbuffer contents as root constants, SRV/UAV as root descriptors
+    Bindless         = 3,  // SM6.6 ResourceDescriptorHeap, only heap indices as root constants
+    BindingModeCount
+};
+
+inline const char* BindingModeName(BindingMode mode)
+{
+    switch (mode)
+    {
+    case BindingMode::RootDescriptors:  return "RootDescriptors";
+    case BindingMode::DescriptorTables: return "DescriptorTables";
+    case BindingMode::RootConstants:    return "RootConstants";
+    case BindingMode::Bindless:         return "Bindless";
+    default:                            return "Unknown";
+    }
+}
+
+class BindingModel : public D3DAppSimplified
+{
+public:
+
+	struct ConstBuffer
+	{
+		uint32_t ElementCount;
+		float    Scale;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+	struct BindlessIndices
+	{
+		uint32_t CbvIndex;
+		uint32_t SrvIndex;
+		uint32_t UavIndex;
+		uint32_t Pad0;
+	};
+
+    static const uint32_t NumThreads         = 64;
+    static const uint32_t DescriptorsPerSet  = 8 + 8 + 8;  // same block layout as D3DApp
+    static const uint32_t ConstBufferStride  = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+    BindingModel(HINSTANCE hInstance, BindingMode mode, uint32_t dispatchCount, uint32_t elementsPerDispatch, uint32_t bindingSets) :
+		D3DAppSimplified(hInstance),
+		m_mode(mode),
+		m_dispatchCount(dispatchCount),
+		m_elementsPerDispatch(elementsPerDispatch),
+		m_bindingSets(bindingSets)
+	{
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_bindlessSupported = CheckBindlessSupport();
+
+		// One input/output/constant buffer per binding set; the dispatch loop cycles through the sets so
+		// every dispatch (except with a single set) sees different bindings than the one before.
+		UINT64 bufferBytes = static_cast<UINT64>(m_elementsPerDispatch) * sizeof(float);
+		std::vector<float> inputData(m_elementsPerDispatch);
+		for (uint32_t i = 0; i < m_elementsPerDispatch; ++i)
+		{
+			inputData[i] = static_cast<float>(i);
+		}
+
+		mConstBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_UPLOAD, static_cast<UINT64>(ConstBufferStride) * m_bindingSets,
+			D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ);
+		uint8_t* mapped = nullptr;
+		AssertIfFailed(mConstBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mapped)));
+
+		mInputBuffers.resize(m_bindingSets);
+		mOutputBuffers.resize(m_bindingSets);
+		for (uint32_t set = 0; set < m_bindingSets; ++set)
+		{
+			ConstBuffer cb = { m_elementsPerDispatch, 1.0f + set, 0, 0 };
+			memcpy(mapped + static_cast<size_t>(set) * ConstBufferStride, &cb, sizeof(cb));
+
+			mInputBuffers[set]  = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), inputData.data(), bufferBytes);
+			mOutputBuffers[set] = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, bufferBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		}
+		mConstBuffer->Unmap(0, nullptr);
+
+		BuildDescriptors();
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (m_mode == BindingMode::Bindless)
+		{
+			if (m_bindlessSupported)
+			{
+				mShaders = D3DUtil::CompileShaderDxc(L"Shaders\\BindlessKernel.hlsl", {}, L"main", L"cs_6_6");
+			}
+			return;
+		}
+		mShaders = D3DUtil::CompileShader(L"Shaders\\BindingKernel.hlsl", nullptr, "main", "cs_5_0");
+	}
+
+    void BuildPSOs() override {
+		if (m_mode == BindingMode::Bindless)
+		{
+			if (m_bindlessSupported)
+			{
+				mRootSignature = CreateBindlessRootSignature();
+				mPSO           = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders.Get());
+			}
+			return;
+		}
+
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		CD3DX12_DESCRIPTOR_RANGE cbvTable;
+		CD3DX12_DESCRIPTOR_RANGE srvTable;
+		CD3DX12_DESCRIPTOR_RANGE uavTable;
+
+		switch (m_mode)
+		{
+		case BindingMode::DescriptorTables:
+			cbvTable.Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 8, 0);
+			srvTable.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 8, 0);
+			uavTable.Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 8, 0);
+			slotRootParameter[0].InitAsDescriptorTable(1, &cbvTable);
+			slotRootParameter[1].InitAsDescriptorTable(1, &srvTable);
+			slotRootParameter[2].InitAsDescriptorTable(1, &uavTable);
+			break;
+		case BindingMode::RootConstants:
+			slotRootParameter[0].InitAsConstants(sizeof(ConstBuffer) / sizeof(uint32_t), 0);
+			slotRootParameter[1].InitAsShaderResourceView(0);
+			slotRootParameter[2].InitAsUnorderedAccessView(0);
+			break;
+		default:
+			slotRootParameter[0].InitAsConstantBufferView(0);
+			slotRootParameter[1].InitAsShaderResourceView(0);
+			slotRootParameter[2].InitAsUnorderedAccessView(0);
+			break;
+		}
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO           = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders.Get());
+    }
+
+	// 'dispatchCount' small dispatches, rebinding before each one. Consecutive dispatches that hit the
+	// same set write identical values, so no UAV barriers are needed between them. The CPU time is
+	// the recording of the loop only; the GPU time comes from the timestamps around DoAction.
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		if (m_mode == BindingMode::DescriptorTables || m_mode == BindingMode::Bindless)
+		{
+			ID3D12DescriptorHeap* heaps[] = { mDescriptorHeap.Get() };
+			commandList->SetDescriptorHeaps(_countof(heaps), heaps);
+		}
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+
+		uint32_t groups = (m_elementsPerDispatch + NumThreads - 1) / NumThreads;
+
+		CpuTimer timer;
+		timer.Start();
+		for (uint32_t i = 0; i < m_dispatchCount; ++i)
+		{
+			Bind(commandList, i % m_bindingSets);
+			commandList->Dispatch(groups, 1, 1);
+		}
+		m_recordSeconds = timer.Stop();
+    }
+
+	bool   Supported()     const { return m_mode != BindingMode::Bindless || m_bindlessSupported; }
+	double RecordSeconds() const { return m_recordSeconds; }
+
+private:
+
+	void Bind(ID3D12GraphicsCommandList* commandList, uint32_t set)
+	{
+		D3D12_GPU_VIRTUAL_ADDRESS cbAddress = mConstBuffer->GetGPUVirtualAddress() + static_cast<UINT64>(set) * ConstBufferStride;
+		switch (m_mode)
+		{
+		case BindingMode::RootDescriptors:
+			commandList->SetComputeRootConstantBufferView(0, cbAddress);
+			commandList->SetComputeRootShaderResourceView(1, mInputBuffers[set]->GetGPUVirtualAddress());
+			commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffers[set]->GetGPUVirtualAddress());
+			break;
+		case BindingMode::DescriptorTables:
+			commandList->SetComputeRootDescriptorTable(0, GpuHandle(set, 0));
+			commandList->SetComputeRootDescriptorTable(1, GpuHandle(set, 8));
+			commandList->SetComputeRootDescriptorTable(2, GpuHandle(set, 16));
+			break;
+		case BindingMode::RootConstants:
+		{
+			ConstBuffer cb = { m_elementsPerDispatch, 1.0f + set, 0, 0 };
+			commandList->SetComputeRoot32BitConstants(0, sizeof(cb) / sizeof(uint32_t), &cb, 0);
+			commandList->SetComputeRootShaderResourceView(1, mInputBuffers[set]->GetGPUVirtualAddress());
+			commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffers[set]->GetGPUVirtualAddress());
+			break;
+		}
+		case BindingMode::Bindless:
+		{
+			uint32_t base = set * DescriptorsPerSet;
+			BindlessIndices indices = { base, base + 8, base + 16, 0 };
+			commandList->SetComputeRoot32BitConstants(0, sizeof(indices) / sizeof(uint32_t), &indices, 0);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// One 24-descriptor block per set, CBV at +0, SRV at +8, UAV at +16 (D3DApp's layout). The tables
+	// point at the block; bindless indexes the same descriptors directly.
+	void BuildDescriptors()
+	{
+		D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+		heapDesc.NumDescriptors = DescriptorsPerSet * m_bindingSets;
+		heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		AssertIfFailed(Device()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mDescriptorHeap)));
+
+		for (uint32_t set = 0; set < m_bindingSets; ++set)
+		{
+			D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+			cbvDesc.BufferLocation = mConstBuffer->GetGPUVirtualAddress() + static_cast<UINT64>(set) * ConstBufferStride;
+			cbvDesc.SizeInBytes    = ConstBufferStride;
+			Device()->CreateConstantBufferView(&cbvDesc, CpuHandle(set, 0));
+
+			D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+			srvDesc.Format                     = DXGI_FORMAT_UNKNOWN;
+			srvDesc.ViewDimension              = D3D12_SRV_DIMENSION_BUFFER;
+			srvDesc.Shader4ComponentMapping    = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+			srvDesc.Buffer.FirstElement        = 0;
+			srvDesc.Buffer.NumElements         = m_elementsPerDispatch;
+			srvDesc.Buffer.StructureByteStride = sizeof(float);
+			srvDesc.Buffer.Flags               = D3D12_BUFFER_SRV_FLAG_NONE;
+			Device()->CreateShaderResourceView(mInputBuffers[set].Get(), &srvDesc, CpuHandle(set, 8));
+
+			D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+			uavDesc.Format                     = DXGI_FORMAT_UNKNOWN;
+			uavDesc.ViewDimension              = D3D12_UAV_DIMENSION_BUFFER;
+			uavDesc.Buffer.FirstElement        = 0;
+			uavDesc.Buffer.NumElements         = m_elementsPerDispatch;
+			uavDesc.Buffer.StructureByteStride = sizeof(float);
+			uavDesc.Buffer.Flags               = D3D12_BUFFER_UAV_FLAG_NONE;
+			Device()->CreateUnorderedAccessView(mOutputBuffers[set].Get(), nullptr, &uavDesc, CpuHandle(set, 16));
+		}
+	}
+
+	CD3DX12_CPU_DESCRIPTOR_HANDLE CpuHandle(uint32_t set, uint32_t offset) const
+	{
+		return CD3DX12_CPU_DESCRIPTOR_HANDLE(mDescriptorHeap->GetCPUDescriptorHandleForHeapStart(), set * DescriptorsPerSet + offset, DescriptorSize());
+	}
+
+	CD3DX12_GPU_DESCRIPTOR_HANDLE GpuHandle(uint32_t set, uint32_t offset) const
+	{
+		return CD3DX12_GPU_DESCRIPTOR_HANDLE(mDescriptorHeap->GetGPUDescriptorHandleForHeapStart(), set * DescriptorsPerSet + offset, DescriptorSize());
+	}
+
+	UINT DescriptorSize() const
+	{
+		return Device()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	}
+
+	// ResourceDescriptorHeap needs shader model 6.6 and resource binding tier 3.
+	bool CheckBindlessSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < kShaderModel6_6)
+		{
+			return false;
+		}
+
+		D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+		AssertIfFailed(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)));
+		return options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_3;
+	}
+
+	// HEAP_DIRECTLY_INDEXED is a root signature 1.1 flag, so this one goes through the versioned serializer.
+	ComPtr<ID3D12RootSignature> CreateBindlessRootSignature()
+	{
+		D3D12_ROOT_PARAMETER1 rootParameter = {};
+		rootParameter.ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+		rootParameter.Constants.ShaderRegister = 0;
+		rootParameter.Constants.RegisterSpace  = 0;
+		rootParameter.Constants.Num32BitValues = sizeof(BindlessIndices) / sizeof(uint32_t);
+		rootParameter.ShaderVisibility         = D3D12_SHADER_VISIBILITY_ALL;
+
+		D3D12_VERSIONED_ROOT_SIGNATURE_DESC rootSigDesc = {};
+		rootSigDesc.Version                = D3D_ROOT_SIGNATURE_VERSION_1_1;
+		rootSigDesc.Desc_1_1.NumParameters = 1;
+		rootSigDesc.Desc_1_1.pParameters   = &rootParameter;
+		rootSigDesc.Desc_1_1.Flags         = kRootFlagHeapDirectlyIndexed;
+
+		ComPtr<ID3DBlob> serializedRootSig = nullptr;
+		ComPtr<ID3DBlob> errorBlob = nullptr;
+		HRESULT hr = D3D12SerializeVersionedRootSignature(&rootSigDesc, serializedRootSig.GetAddressOf(), errorBlob.GetAddressOf());
+		if (errorBlob != nullptr)
+		{
+			::OutputDebugStringA((char*)errorBlob->GetBufferPointer());
+		}
+		AssertIfFailed(hr);
+
+		ComPtr<ID3D12RootSignature> rootSignature;
+		AssertIfFailed(Device()->CreateRootSignature(
+			0,
+			serializedRootSig->GetBufferPointer(),
+			serializedRootSig->GetBufferSize(),
+			IID_PPV_ARGS(rootSignature.GetAddressOf())));
+		return rootSignature;
+	}
+
+    ComPtr<ID3DBlob> mShaders;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	ComPtr<ID3D12Resource>              mConstBuffer;
+	std::vector<ComPtr<ID3D12Resource>> mInputBuffers;
+	std::vector<ComPtr<ID3D12Resource>> mOutputBuffers;
+	ComPtr<ID3D12DescriptorHeap>        mDescriptorHeap;
+
+	BindingMode m_mode;
+	uint32_t    m_dispatchCount;
+	uint32_t    m_elementsPerDispatch;
+	uint32_t    m_bindingSets;
+	bool        m_bindlessSupported = false;
+	double      m_recordSeconds     = 0.0;
+};
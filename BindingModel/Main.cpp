@@ -0,0 +1,97 @@
+#include "d3dAppSimplified.h"
+#include "BindingModel.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	BindingMode mode     = BindingMode::RootDescriptors;
+	int dispatchCount    = 4096;
+	int elements         = 4096;
+	int bindingSets      = 8;
+
+	// Usage: program.exe <mode> <dispatchCount> <elementsPerDispatch> <bindingSets>
+	// mode: 0=RootDescriptors, 1=DescriptorTables, 2=RootConstants, 3=Bindless (SM6.6)
+	// bindingSets=1 keeps the same bindings for every dispatch (no changes in between).
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			mode = static_cast<BindingMode>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			dispatchCount = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			elements = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			bindingSets = _wtoi(argv[4]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: mode=%d, dispatches=%d, elements=%d, bindingSets=%d\n", static_cast<int>(mode), dispatchCount, elements, bindingSets);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (mode >= BindingMode::BindingModeCount)
+	{
+		OutputDebugStringA("ERROR: Unknown binding mode!\n");
+		return 1;
+	}
+	if (dispatchCount <= 0 || elements <= 0 || bindingSets <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	BindingModel test(hInstance, mode, static_cast<uint32_t>(dispatchCount), static_cast<uint32_t>(elements), static_cast<uint32_t>(bindingSets));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Bindless needs shader model 6.6 and resource binding tier 3!\n");
+		return 1;
+	}
+
+	// First run pays for PSO/driver warm-up; time the second one.
+	test.Dispatch();
+	test.Dispatch();
+	double gpuSeconds = test.GetDuration();
+	double cpuSeconds = test.RecordSeconds();
+	double gpuNsPerDispatch = gpuSeconds * 1e9 / dispatchCount;
+	double cpuNsPerDispatch = cpuSeconds * 1e9 / dispatchCount;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Binding: " << BindingModeName(mode) << " Dispatches: " << dispatchCount << " Elements: " << elements << " Sets: " << bindingSets << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuNsPerDispatch << " ns/dispatch)\n";
+	debugOutput << "CPU recording: " << cpuSeconds << " seconds (" << cpuNsPerDispatch << " ns/dispatch)\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("binding_model_results.csv", "Mode,ModeName,Dispatches,ElementsPerDispatch,BindingSets,Gpu_s,Cpu_s,GpuNsPerDispatch,CpuNsPerDispatch", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(mode), BindingModeName(mode), dispatchCount, elements, bindingSets, gpuSeconds, cpuSeconds, gpuNsPerDispatch, cpuNsPerDispatch);
+    return 0;
+}
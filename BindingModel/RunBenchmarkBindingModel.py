@@ -0,0 +1,76 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+MODES = {
+    0: "RootDescriptors",
+    1: "DescriptorTables",
+    2: "RootConstants",
+    3: "Bindless",
+}
+
+def run_simple_test(tryCount = 4):
+    """Runs every binding model with and without binding changes between dispatches"""
+
+    program = "..\\x64\\Release\\BindingModel.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "binding_model_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    dispatches = 4096
+    for elements in [64, 4096, 65536]:
+        for sets in [1, 8, 64]:
+            for mode in MODES:
+                print(f"\nRunning {MODES[mode]} elements {elements} sets {sets}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(mode),
+                            str(dispatches),
+                            str(elements),
+                            str(sets)
+                        ], capture_output=True, text=True)
+                        print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_binding_results(filename):
+    gpu = {}
+    cpu = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = (parts[1], int(parts[3]), int(parts[4]))
+            gpu.setdefault(key, []).append(float(parts[7]))
+            cpu.setdefault(key, []).append(float(parts[8]))
+
+    fig, (ax_gpu, ax_cpu) = plt.subplots(1, 2, figsize=(12, 5))
+    for name in MODES.values():
+        keys = sorted(k for k in gpu if k[0] == name and k[2] > 1)
+        if not keys:
+            continue
+        labels = [f"{k[1]}/{k[2]}" for k in keys]
+        ax_gpu.plot(labels, [min(gpu[k]) for k in keys], marker='o', label=name)
+        ax_cpu.plot(labels, [min(cpu[k]) for k in keys], marker='o', label=name)
+    ax_gpu.set_title('GPU ns / dispatch')
+    ax_cpu.set_title('CPU recording ns / dispatch')
+    for ax in (ax_gpu, ax_cpu):
+        ax.set_xlabel('Elements / Binding Sets')
+        ax.grid(True)
+        ax.legend()
+    plt.savefig('BindingModel.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_binding_results("binding_model_results.csv")
@@ -0,0 +1,25 @@
+StructuredBuffer<float>   Input  : register(t0);
+RWStructuredBuffer<float> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint  ElementCount;
+    float Scale;
+    uint  Pad0;
+    uint  Pad1;
+}
+
+static const uint NumThreads = 64;
+
+// Shared by the root-descriptor, descriptor-table and root-constant models: the HLSL is identical,
+// only the root signature behind b0/t0/u0 changes.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    const uint id = groupId.x * NumThreads + threadId.x;
+
+    if (id < ElementCount)
+    {
+        Output[id] = Input[id] * Scale;
+    }
+}
@@ -0,0 +1,36 @@
+// Shader model 6.6 bindless: the only root argument is a set of descriptor heap indices.
+struct BindlessIndices
+{
+    uint CbvIndex;
+    uint SrvIndex;
+    uint UavIndex;
+    uint Pad0;
+};
+
+struct Params
+{
+    uint  ElementCount;
+    float Scale;
+    uint  Pad0;
+    uint  Pad1;
+};
+
+ConstantBuffer<BindlessIndices> Indices : register(b0);
+
+static const uint NumThreads = 64;
+
+// Same work as BindingKernel.hlsl.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    ConstantBuffer<Params>    params = ResourceDescriptorHeap[Indices.CbvIndex];
+    StructuredBuffer<float>   input  = ResourceDescriptorHeap[Indices.SrvIndex];
+    RWStructuredBuffer<float> output = ResourceDescriptorHeap[Indices.UavIndex];
+
+    const uint id = groupId.x * NumThreads + threadId.x;
+
+    if (id < params.ElementCount)
+    {
+        output[id] = input[id] * params.Scale;
+    }
+}
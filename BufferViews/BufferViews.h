@@ -0,0 +1,204 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "ViewFormats.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// Reads `elements` input elements of one ElementFormat through one ViewType in one AccessPattern
+// (Shaders/BufferViews.hlsl) and writes the sum of each element's components. All three views
+// are bound through the same one-entry descriptor table, so only the view itself differs between
+// runs; typed views let the hardware convert the format, the others decode it in the shader.
+class BufferViews : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Count;
+		uint32_t Stride;
+		uint32_t GroupsX;
+		uint32_t Pad0;
+	};
+
+    static const uint32_t NumThreads = 256;
+
+    BufferViews(HINSTANCE hInstance, ViewType view, ElementFormat format, AccessPattern pattern, uint32_t elements, uint32_t stride) :
+		D3DAppSimplified(hInstance),
+		m_view(view),
+		m_format(format),
+		m_pattern(pattern),
+		m_elements(elements),
+		m_stride(stride)
+	{
+		mHostData = ViewFormats::MakeData(format, elements);
+	}
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		mInputBuffer    = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostData.data(), InputBytes());
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, OutputBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, OutputBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+
+		D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+		heapDesc.NumDescriptors = 1;
+		heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		AssertIfFailed(Device()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mDescriptorHeap)));
+
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.ViewDimension           = D3D12_SRV_DIMENSION_BUFFER;
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		switch (m_view)
+		{
+		case ViewType::Typed:
+			srvDesc.Format             = DxgiFormat();
+			srvDesc.Buffer.NumElements = m_elements;
+			break;
+		case ViewType::Structured:
+			srvDesc.Format                     = DXGI_FORMAT_UNKNOWN;
+			srvDesc.Buffer.NumElements         = m_elements;
+			srvDesc.Buffer.StructureByteStride = ViewFormats::ElementBytes(m_format);
+			break;
+		default:
+			srvDesc.Format             = DXGI_FORMAT_R32_TYPELESS;
+			srvDesc.Buffer.NumElements = static_cast<UINT>(InputBytes() / sizeof(uint32_t));
+			srvDesc.Buffer.Flags       = D3D12_BUFFER_SRV_FLAG_RAW;
+			break;
+		}
+		Device()->CreateShaderResourceView(mInputBuffer.Get(), &srvDesc, mDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		mShader = D3DUtil::CompileShaderDxc(L"Shaders\\BufferViews.hlsl", {
+			L"VIEW=" + std::to_wstring(static_cast<uint32_t>(m_view)),
+			L"FORMAT=" + std::to_wstring(static_cast<uint32_t>(m_format)),
+			L"COMPONENTS=" + std::to_wstring(ViewFormats::Components(m_format)),
+			L"WORDS=" + std::to_wstring(ViewFormats::ElementBytes(m_format) / 4),
+			L"PATTERN=" + std::to_wstring(static_cast<uint32_t>(m_pattern))
+		}, L"main", L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_DESCRIPTOR_RANGE srvRange;
+		srvRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsDescriptorTable(1, &srvRange);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShader.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		uint32_t groups  = DivideRoundUp(m_elements, NumThreads);
+		RootConstants constants = { m_elements, m_stride, GroupsX(groups), 0 };
+
+		ID3D12DescriptorHeap* heaps[] = { mDescriptorHeap.Get() };
+		commandList->SetDescriptorHeaps(_countof(heaps), heaps);
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootDescriptorTable(1, mDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		DispatchGroups(groups);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, OutputBytes());
+		}
+    }
+
+	bool   Supported()   const { return m_supported; }
+	UINT64 InputBytes()  const { return static_cast<UINT64>(m_elements) * ViewFormats::ElementBytes(m_format); }
+	UINT64 OutputBytes() const { return static_cast<UINT64>(m_elements) * sizeof(float); }
+
+	// Outputs of the last Dispatch() with SetCopyResults(true) that differ from the host sums. The
+	// 32-bit float and half paths are exact; UNORM conversion may be off by an ulp per component.
+	uint32_t Validate()
+	{
+		std::vector<float> reference = ViewFormats::Reference(m_format, m_pattern, mHostData, m_elements, m_stride);
+		float* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(OutputBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < m_elements; ++i)
+		{
+			mismatches += std::fabs(mapped[i] - reference[i]) > 1e-6f * (std::max)(std::fabs(reference[i]), 1.0f) ? 1 : 0;
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	DXGI_FORMAT DxgiFormat() const
+	{
+		switch (m_format)
+		{
+		case ElementFormat::FormatR32G32Float:       return DXGI_FORMAT_R32G32_FLOAT;
+		case ElementFormat::FormatR32G32B32Float:    return DXGI_FORMAT_R32G32B32_FLOAT;
+		case ElementFormat::FormatR32G32B32A32Float: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		case ElementFormat::FormatR16G16B16A16Float: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+		case ElementFormat::FormatR8G8B8A8Unorm:     return DXGI_FORMAT_R8G8B8A8_UNORM;
+		default:                                     return DXGI_FORMAT_R32_FLOAT;
+		}
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		// Typed buffer loads are optional for some formats (R32G32B32_FLOAT in particular).
+		D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = { DxgiFormat() };
+		if (m_view == ViewType::Typed &&
+			(FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport))) ||
+			 (formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_BUFFER) == 0 || (formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_SHADER_LOAD) == 0))
+		{
+			OutputDebugStringA("Typed buffer loads of this format not supported\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+	ComPtr<ID3D12DescriptorHeap> mDescriptorHeap;
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<uint32_t> mHostData;
+
+	ViewType      m_view;
+	ElementFormat m_format;
+	AccessPattern m_pattern;
+	uint32_t      m_elements;
+	uint32_t      m_stride;
+	bool          m_supported = false;
+};
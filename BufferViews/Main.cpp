@@ -0,0 +1,115 @@
+#include "d3dAppSimplified.h"
+#include "BufferViews.h"
+#include "ViewFormats.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	ViewType      view     = ViewType::Typed;
+	ElementFormat format   = ElementFormat::FormatR32G32B32Float;
+	AccessPattern pattern  = AccessPattern::LinearAccess;
+	int           elements = 1 << 24;
+	int           stride   = 4097;
+	int           validate = 1;
+
+	// Usage: program.exe <view> <format> <pattern> <elements> <stride> <validate>
+	// view: 0=Typed, 1=Structured, 2=Raw
+	// format: 0=R32_FLOAT, 1=R32G32_FLOAT, 2=R32G32B32_FLOAT, 3=R32G32B32A32_FLOAT, 4=R16G16B16A16_FLOAT, 5=R8G8B8A8_UNORM
+	// pattern: 0=Linear, 1=Strided, 2=Random   elements: power of two   stride: odd element stride of the strided pattern
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			view = static_cast<ViewType>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			format = static_cast<ElementFormat>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			pattern = static_cast<AccessPattern>(_wtoi(argv[3]));
+		}
+		if (argc >= 5)
+		{
+			elements = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			stride = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			validate = _wtoi(argv[6]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: view=%d, format=%d, pattern=%d, elements=%d, stride=%d, validate=%d\n",
+			static_cast<int>(view), static_cast<int>(format), static_cast<int>(pattern), elements, stride, validate);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (view >= ViewType::ViewTypeCount || format >= ElementFormat::ElementFormatCount || pattern >= AccessPattern::AccessPatternCount)
+	{
+		OutputDebugStringA("ERROR: Unknown view, format or pattern!\n");
+		return 1;
+	}
+	// 2^26 elements of up to 16 bytes stay inside one buffer and the typed view element limit.
+	if (elements <= 0 || elements > (1 << 26) || (elements & (elements - 1)) != 0 || stride <= 0 || (stride & 1) == 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	BufferViews test(hInstance, view, format, pattern, static_cast<uint32_t>(elements), static_cast<uint32_t>(stride));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: View/format combination not supported on this device!\n");
+		return 1;
+	}
+
+	uint32_t mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		mismatches = validate != 0 ? test.Validate() : 0;
+	});
+	double gpuGBs     = (test.InputBytes() + test.OutputBytes()) / gpuSeconds / 1e9;
+	double elementsPerSecond = elements / gpuSeconds;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "View: " << ViewTypeName(view) << " Format: " << ElementFormatName(format) << " (" << ViewFormats::ElementBytes(format)
+		<< " bytes) Pattern: " << AccessPatternName(pattern) << " Elements: " << elements << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGBs << " GB/s, " << elementsPerSecond / 1e9 << " G elements/s)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("buffer_view_results.csv", "View,Format,ElementBytes,Pattern,Elements,Stride,Gpu_s,Gpu_GBs,GElements_s,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(ViewTypeName(view), ElementFormatName(format), ViewFormats::ElementBytes(format), AccessPatternName(pattern), elements, stride,
+		gpuSeconds, gpuGBs, elementsPerSecond / 1e9, validate, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
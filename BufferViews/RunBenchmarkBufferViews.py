@@ -0,0 +1,94 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+VIEWS = {
+    0: "Typed",
+    1: "Structured",
+    2: "Raw",
+}
+
+FORMATS = {
+    0: "R32_FLOAT",
+    1: "R32G32_FLOAT",
+    2: "R32G32B32_FLOAT",
+    3: "R32G32B32A32_FLOAT",
+    4: "R16G16B16A16_FLOAT",
+    5: "R8G8B8A8_UNORM",
+}
+
+PATTERNS = {
+    0: "Linear",
+    1: "Strided",
+    2: "Random",
+}
+
+def run_simple_test(elements = 1 << 24, tryCount = 3):
+    """Runs every view type over every element format and access pattern"""
+
+    program = "..\\x64\\Release\\BufferViews.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "buffer_view_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for pattern in PATTERNS:
+        for format in FORMATS:
+            for view in VIEWS:
+                print(f"\nRunning {VIEWS[view]} {FORMATS[format]} {PATTERNS[pattern]}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(view),
+                            str(format),
+                            str(pattern),
+                            str(elements),
+                            "4097",
+                            # Validate the first run of each configuration only.
+                            "1" if i == 0 else "0"
+                        ], capture_output=True, text=True)
+                        if result.returncode != 0:
+                            print(f"  Run {i+1}: failed, unsupported or mismatched (exit {result.returncode})")
+                        else:
+                            print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_buffer_view_results(filename):
+    results = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = (parts[3], parts[1])
+            results.setdefault(key, {}).setdefault(parts[0], []).append(float(parts[8]))
+
+    fig, axes = plt.subplots(1, len(PATTERNS), figsize=(15, 5), sharey=False)
+    for ax, pattern in zip(axes, PATTERNS.values()):
+        formats = [f for f in FORMATS.values() if (pattern, f) in results]
+        width = 0.8 / len(VIEWS)
+        for v, view in enumerate(VIEWS.values()):
+            values = [max(results[(pattern, f)].get(view, [0.0])) for f in formats]
+            ax.bar([i + v * width for i in range(len(formats))], values, width=width, label=view)
+        ax.set_xticks([i + 0.4 for i in range(len(formats))])
+        ax.set_xticklabels(formats, rotation=45, ha='right', fontsize=7)
+        ax.set_title(pattern)
+        ax.set_ylabel('G elements/s')
+        ax.grid(True, axis='y')
+    axes[0].legend(fontsize=7)
+    plt.suptitle('Typed vs Structured vs Raw Buffer Loads')
+    plt.tight_layout()
+    plt.savefig('BufferViews.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_buffer_view_results("buffer_view_results.csv")
@@ -0,0 +1,123 @@
+// Out[i] = sum of the components of input element Index(i), with the input read through one kind of
+// buffer view. Compiled with DXC (cs_6_0); variants are selected by defines:
+//   VIEW        0=typed Buffer<floatN> (the DXGI format does the conversion), 1=StructuredBuffer<uintN>,
+//               2=ByteAddressBuffer; 1 and 2 decode the format in the shader
+//   FORMAT      ElementFormat: 0..3 = R32 .. R32G32B32A32_FLOAT, 4=R16G16B16A16_FLOAT, 5=R8G8B8A8_UNORM
+//   COMPONENTS  components of the typed view (1..4)
+//   WORDS       32-bit words per element (1..4)
+//   PATTERN     0=linear, 1=strided ((i * Stride) mod Count), 2=random (hash(i) mod Count)
+//
+// Components are added in the same order as the host reference (ViewFormats::Reference). Validation
+// still allows a 1e-6 relative error, since UNORM conversion may be off by an ulp per component.
+
+#if VIEW == 0
+Buffer<vector<float, COMPONENTS> >      Input : register(t0);
+#elif VIEW == 1
+StructuredBuffer<vector<uint, WORDS> >  Input : register(t0);
+#else
+ByteAddressBuffer                       Input : register(t0);
+#endif
+RWStructuredBuffer<float>               Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Count;     // power of two
+    uint Stride;    // odd
+    uint GroupsX;
+    uint Pad0;
+}
+
+static const uint NumThreads = 256;
+
+uint Hash32(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+uint ElementIndex(uint i)
+{
+#if PATTERN == 1
+    return (i * Stride) & (Count - 1);
+#elif PATTERN == 2
+    return Hash32(i) & (Count - 1);
+#else
+    return i;
+#endif
+}
+
+#if VIEW == 0
+
+float LoadSum(uint index)
+{
+    vector<float, COMPONENTS> value = Input[index];
+    float sum = 0.0f;
+    [unroll]
+    for (uint c = 0; c < COMPONENTS; ++c)
+    {
+        sum += value[c];
+    }
+    return sum;
+}
+
+#else
+
+uint4 LoadWords(uint index)
+{
+#if VIEW == 1
+    vector<uint, WORDS> value = Input[index];
+#elif WORDS == 1
+    vector<uint, WORDS> value = Input.Load(index * 4);
+#elif WORDS == 2
+    vector<uint, WORDS> value = Input.Load2(index * 8);
+#elif WORDS == 3
+    vector<uint, WORDS> value = Input.Load3(index * 12);
+#else
+    vector<uint, WORDS> value = Input.Load4(index * 16);
+#endif
+    uint4 words = 0;
+    [unroll]
+    for (uint w = 0; w < WORDS; ++w)
+    {
+        words[w] = value[w];
+    }
+    return words;
+}
+
+float LoadSum(uint index)
+{
+    uint4 words = LoadWords(index);
+    float sum = 0.0f;
+    [unroll]
+    for (uint c = 0; c < 4; ++c)
+    {
+#if FORMAT == 4
+        sum += f16tof32(words[c / 2] >> (16 * (c % 2)));
+#elif FORMAT == 5
+        sum += (float)((words.x >> (8 * c)) & 0xFF) / 255.0f;
+#else
+        if (c < WORDS)
+        {
+            sum += asfloat(words[c]);
+        }
+#endif
+    }
+    return sum;
+}
+
+#endif
+
+[numthreads(NumThreads, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint i = (groupId.y * GroupsX + groupId.x) * NumThreads + threadId.x;
+    if (i >= Count)
+    {
+        return;
+    }
+    Output[i] = LoadSum(ElementIndex(i));
+}
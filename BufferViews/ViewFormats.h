@@ -0,0 +1,201 @@
+#pragma once
+
+// Host side of the buffer-view benchmark: element formats, the test data, the index each thread
+// reads for every access pattern and the expected per-thread sum of the decoded components. The
+// index hash and the component order match Shaders/BufferViews.hlsl exactly. No D3D dependency.
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+enum ViewType : uint32_t {
+    Typed      = 0,   // Buffer<floatN> over a DXGI format, conversion done by the texture unit
+    Structured = 1,   // StructuredBuffer<uintN>, stride = element size, decoded in the shader
+    Raw        = 2,   // ByteAddressBuffer Load/Load2/Load3/Load4, decoded in the shader
+    ViewTypeCount
+};
+
+enum ElementFormat : uint32_t {
+    FormatR32Float          = 0,   //  4 bytes, 1 component
+    FormatR32G32Float       = 1,   //  8 bytes, 2 components
+    FormatR32G32B32Float    = 2,   // 12 bytes, 3 components
+    FormatR32G32B32A32Float = 3,   // 16 bytes, 4 components
+    FormatR16G16B16A16Float = 4,   //  8 bytes, 4 half components
+    FormatR8G8B8A8Unorm     = 5,   //  4 bytes, 4 unorm8 components
+    ElementFormatCount
+};
+
+enum AccessPattern : uint32_t {
+    LinearAccess  = 0,   // thread i reads element i
+    StridedAccess = 1,   // element (i * stride) mod N: every element once, neighbours far apart
+    RandomAccess  = 2,   // element hash(i) mod N: no locality, some elements read twice
+    AccessPatternCount
+};
+
+inline const char* ViewTypeName(ViewType view)
+{
+    switch (view)
+    {
+    case ViewType::Typed:      return "Typed";
+    case ViewType::Structured: return "Structured";
+    case ViewType::Raw:        return "Raw";
+    default:                   return "Unknown";
+    }
+}
+
+inline const char* ElementFormatName(ElementFormat format)
+{
+    switch (format)
+    {
+    case ElementFormat::FormatR32Float:          return "R32_FLOAT";
+    case ElementFormat::FormatR32G32Float:       return "R32G32_FLOAT";
+    case ElementFormat::FormatR32G32B32Float:    return "R32G32B32_FLOAT";
+    case ElementFormat::FormatR32G32B32A32Float: return "R32G32B32A32_FLOAT";
+    case ElementFormat::FormatR16G16B16A16Float: return "R16G16B16A16_FLOAT";
+    case ElementFormat::FormatR8G8B8A8Unorm:     return "R8G8B8A8_UNORM";
+    default:                                     return "Unknown";
+    }
+}
+
+inline const char* AccessPatternName(AccessPattern pattern)
+{
+    switch (pattern)
+    {
+    case AccessPattern::LinearAccess:  return "Linear";
+    case AccessPattern::StridedAccess: return "Strided";
+    case AccessPattern::RandomAccess:  return "Random";
+    default:                           return "Unknown";
+    }
+}
+
+namespace ViewFormats
+{
+    inline uint32_t ElementBytes(ElementFormat format)
+    {
+        switch (format)
+        {
+        case ElementFormat::FormatR32G32Float:
+        case ElementFormat::FormatR16G16B16A16Float: return 8;
+        case ElementFormat::FormatR32G32B32Float:    return 12;
+        case ElementFormat::FormatR32G32B32A32Float: return 16;
+        default:                                     return 4;
+        }
+    }
+
+    inline uint32_t Components(ElementFormat format)
+    {
+        switch (format)
+        {
+        case ElementFormat::FormatR32Float:       return 1;
+        case ElementFormat::FormatR32G32Float:    return 2;
+        case ElementFormat::FormatR32G32B32Float: return 3;
+        default:                                  return 4;
+        }
+    }
+
+    // lowbias32 integer hash, as in the shader.
+    inline uint32_t Hash32(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // Element thread i reads; `elements` is a power of two and `stride` odd, so the strided pattern
+    // is a permutation.
+    inline uint32_t ElementIndex(AccessPattern pattern, uint32_t i, uint32_t elements, uint32_t stride)
+    {
+        switch (pattern)
+        {
+        case AccessPattern::StridedAccess: return (i * stride) & (elements - 1);
+        case AccessPattern::RandomAccess:  return Hash32(i) & (elements - 1);
+        default:                           return i;
+        }
+    }
+
+    inline float HalfToFloat(uint32_t half)
+    {
+        uint32_t sign     = (half & 0x8000) << 16;
+        uint32_t exponent = (half >> 10) & 0x1F;
+        uint32_t mantissa = half & 0x3FF;
+        // MakeData only produces normal halves.
+        uint32_t bits = exponent == 0 ? sign : sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // elements * ElementBytes() / 4 words of finite values: floats in [-1, 1), normal halves of
+    // magnitude 2^-10 .. 2, any unorm8.
+    inline std::vector<uint32_t> MakeData(ElementFormat format, uint32_t elements)
+    {
+        std::vector<uint32_t> words(static_cast<size_t>(elements) * ElementBytes(format) / 4);
+        std::mt19937 gen(elements);
+        std::uniform_real_distribution<float> floatDist(-1.0f, 1.0f);
+        for (auto& word : words)
+        {
+            if (format == ElementFormat::FormatR16G16B16A16Float)
+            {
+                uint32_t pair = gen();
+                uint32_t lo = (pair & 0x83FF) | ((5 + (pair >> 10) % 11) << 10);
+                uint32_t hi = ((pair >> 16) & 0x83FF) | ((5 + (pair >> 26) % 11) << 10);
+                word = lo | (hi << 16);
+            }
+            else if (format == ElementFormat::FormatR8G8B8A8Unorm)
+            {
+                word = gen();
+            }
+            else
+            {
+                float value = floatDist(gen);
+                memcpy(&word, &value, sizeof(word));
+            }
+        }
+        return words;
+    }
+
+    // Sum of the decoded components of the element at `words`, added in component order.
+    inline float DecodeSum(ElementFormat format, const uint32_t* words)
+    {
+        float sum = 0.0f;
+        switch (format)
+        {
+        case ElementFormat::FormatR16G16B16A16Float:
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                sum += HalfToFloat((words[c / 2] >> (16 * (c % 2))) & 0xFFFF);
+            }
+            break;
+        case ElementFormat::FormatR8G8B8A8Unorm:
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                sum += static_cast<float>((words[0] >> (8 * c)) & 0xFF) / 255.0f;
+            }
+            break;
+        default:
+            for (uint32_t c = 0; c < Components(format); ++c)
+            {
+                float value;
+                memcpy(&value, &words[c], sizeof(value));
+                sum += value;
+            }
+            break;
+        }
+        return sum;
+    }
+
+    inline std::vector<float> Reference(ElementFormat format, AccessPattern pattern, const std::vector<uint32_t>& words, uint32_t elements, uint32_t stride)
+    {
+        std::vector<float> sums(elements);
+        const uint32_t wordsPerElement = ElementBytes(format) / 4;
+        for (uint32_t i = 0; i < elements; ++i)
+        {
+            sums[i] = DecodeSum(format, &words[static_cast<size_t>(ElementIndex(pattern, i, elements, stride)) * wordsPerElement]);
+        }
+        return sums;
+    }
+}
@@ -0,0 +1,345 @@
+#pragma once
+
+// Kernel autotuning: a declared parameter space, a successive-halving search over it and a
+// persistent database of the winners keyed by kernel, device and problem size. Portable (no
+// Windows/D3D12 dependency) so the search and the database can be exercised with the CPU backend
+// in CpuTuningBackend.h on any machine; the D3D12 backends compile each configuration with its
+// parameters as shader defines.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+// One value per parameter of the space, in declaration order.
+typedef std::vector<uint32_t> TuningConfig;
+
+struct TuningParameter
+{
+    std::string           name;     // also the shader define, e.g. GROUP_SIZE
+    std::vector<uint32_t> values;
+};
+
+class TuningSpace
+{
+public:
+
+    TuningSpace& Add(const std::string& name, const std::vector<uint32_t>& values)
+    {
+        mParameters.push_back({ name, values });
+        return *this;
+    }
+
+    // Configurations failing any constraint are never enumerated.
+    TuningSpace& Require(std::function<bool(const TuningSpace&, const TuningConfig&)> constraint)
+    {
+        mConstraints.push_back(constraint);
+        return *this;
+    }
+
+    const std::vector<TuningParameter>& Parameters() const { return mParameters; }
+
+    uint32_t Value(const TuningConfig& config, const std::string& name) const
+    {
+        for (size_t p = 0; p < mParameters.size(); ++p)
+        {
+            if (mParameters[p].name == name)
+            {
+                return config[p];
+            }
+        }
+        return 0;
+    }
+
+    bool Valid(const TuningConfig& config) const
+    {
+        for (const auto& constraint : mConstraints)
+        {
+            if (!constraint(*this, config))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every valid configuration, the first parameter varying slowest.
+    std::vector<TuningConfig> Enumerate() const
+    {
+        std::vector<TuningConfig> configs;
+        TuningConfig config(mParameters.size());
+        std::vector<size_t> index(mParameters.size(), 0);
+        for (;;)
+        {
+            for (size_t p = 0; p < mParameters.size(); ++p)
+            {
+                config[p] = mParameters[p].values[index[p]];
+            }
+            if (Valid(config))
+            {
+                configs.push_back(config);
+            }
+            size_t p = mParameters.size();
+            while (p > 0 && ++index[p - 1] == mParameters[p - 1].values.size())
+            {
+                index[--p] = 0;
+            }
+            if (p == 0)
+            {
+                return configs;
+            }
+        }
+    }
+
+    // "NAME=value;NAME=value", the form stored in the database (no commas, so it is one CSV field).
+    std::string Describe(const TuningConfig& config) const
+    {
+        std::ostringstream text;
+        for (size_t p = 0; p < mParameters.size(); ++p)
+        {
+            text << (p == 0 ? "" : ";") << mParameters[p].name << "=" << config[p];
+        }
+        return text.str();
+    }
+
+    // Inverse of Describe; false if a parameter is missing or the result is not a valid configuration.
+    bool Parse(const std::string& text, TuningConfig& config) const
+    {
+        config.assign(mParameters.size(), 0);
+        std::vector<bool> seen(mParameters.size(), false);
+        std::istringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ';'))
+        {
+            size_t equals = item.find('=');
+            for (size_t p = 0; equals != std::string::npos && p < mParameters.size(); ++p)
+            {
+                if (item.compare(0, equals, mParameters[p].name) == 0 && equals == mParameters[p].name.size())
+                {
+                    config[p] = static_cast<uint32_t>(std::stoul(item.substr(equals + 1)));
+                    seen[p]   = true;
+                }
+            }
+        }
+        return std::find(seen.begin(), seen.end(), false) == seen.end() && Valid(config);
+    }
+
+    // NAME=value defines for D3DUtil::CompileShaderDxc.
+    std::vector<std::wstring> Defines(const TuningConfig& config) const
+    {
+        std::vector<std::wstring> defines;
+        for (size_t p = 0; p < mParameters.size(); ++p)
+        {
+            defines.push_back(std::wstring(mParameters[p].name.begin(), mParameters[p].name.end()) + L"=" + std::to_wstring(config[p]));
+        }
+        return defines;
+    }
+
+private:
+    std::vector<TuningParameter> mParameters;
+    std::vector<std::function<bool(const TuningSpace&, const TuningConfig&)>> mConstraints;
+};
+
+// What the search needs from an execution backend.
+class TuningBackend
+{
+public:
+    virtual ~TuningBackend() {}
+
+    // Builds the variant (compile + pipeline state on the GPU) once, before any Measure() of it;
+    // false drops the candidate.
+    virtual bool   Prepare(const TuningConfig& config) = 0;
+    // Seconds of one run of a prepared variant.
+    virtual double Measure(const TuningConfig& config) = 0;
+};
+
+struct TuningOptions
+{
+    uint32_t eta           = 2;   // 1/eta of the candidates survive each round
+    uint32_t initialRuns   = 1;   // runs per candidate in the first round, multiplied by eta each round
+    uint32_t maxCandidates = 0;   // random sample of the space when non-zero
+    uint32_t seed          = 1;
+};
+
+struct TuningResult
+{
+    TuningConfig best;
+    double       seconds      = 0.0;   // best single run of the winner
+    uint32_t     candidates   = 0;     // sampled from the space
+    uint32_t     prepared     = 0;     // survived Prepare()
+    uint32_t     rounds       = 0;
+    uint32_t     measurements = 0;     // Measure() calls in total
+};
+
+namespace Autotuner
+{
+    // Successive halving: each round every survivor gets `runs` more timed runs and is scored by
+    // its fastest run so far; the best 1/eta go on with eta times the runs, until one is left. Bad
+    // candidates cost a run or two, the contenders get the repetitions that separate them from noise.
+    inline TuningResult SuccessiveHalving(TuningBackend& backend, const TuningSpace& space, const TuningOptions& options)
+    {
+        TuningResult result;
+        std::vector<TuningConfig> candidates = space.Enumerate();
+        if (options.maxCandidates != 0 && candidates.size() > options.maxCandidates)
+        {
+            std::mt19937 gen(options.seed);
+            std::shuffle(candidates.begin(), candidates.end(), gen);
+            candidates.resize(options.maxCandidates);
+        }
+        result.candidates = static_cast<uint32_t>(candidates.size());
+
+        struct Survivor
+        {
+            TuningConfig config;
+            double       best;
+        };
+        std::vector<Survivor> survivors;
+        for (const auto& config : candidates)
+        {
+            if (backend.Prepare(config))
+            {
+                survivors.push_back({ config, (std::numeric_limits<double>::max)() });
+            }
+        }
+        result.prepared = static_cast<uint32_t>(survivors.size());
+        if (survivors.empty())
+        {
+            return result;
+        }
+
+        const uint32_t eta  = (std::max)(2u, options.eta);
+        uint32_t       runs = (std::max)(1u, options.initialRuns);
+        for (;;)
+        {
+            ++result.rounds;
+            for (auto& survivor : survivors)
+            {
+                for (uint32_t r = 0; r < runs; ++r)
+                {
+                    survivor.best = (std::min)(survivor.best, backend.Measure(survivor.config));
+                    ++result.measurements;
+                }
+            }
+            std::stable_sort(survivors.begin(), survivors.end(), [](const Survivor& a, const Survivor& b) { return a.best < b.best; });
+            survivors.resize((survivors.size() + eta - 1) / eta);
+            if (survivors.size() == 1)
+            {
+                break;
+            }
+            runs *= eta;
+        }
+        result.best    = survivors[0].config;
+        result.seconds = survivors[0].best;
+        return result;
+    }
+}
+
+struct TuningRecord
+{
+    std::string kernel;
+    std::string device;        // adapter + driver, or CPU description
+    uint64_t    problemSize = 0;
+    std::string config;        // TuningSpace::Describe
+    double      seconds     = 0.0;
+};
+
+// Best configurations as a CSV file (Kernel,Device,ProblemSize,Config,Seconds), one row per
+// kernel/device/problem size.
+class TuningDatabase
+{
+public:
+
+    // A missing file is an empty database.
+    bool Load(const std::string& path)
+    {
+        mRecords.clear();
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        std::string line;
+        std::getline(file, line);
+        while (std::getline(file, line))
+        {
+            std::vector<std::string> fields;
+            std::istringstream stream(line);
+            std::string field;
+            while (std::getline(stream, field, ','))
+            {
+                fields.push_back(field);
+            }
+            if (fields.size() == 5)
+            {
+                mRecords.push_back({ fields[0], fields[1], std::stoull(fields[2]), fields[3], std::stod(fields[4]) });
+            }
+        }
+        return true;
+    }
+
+    bool Save(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file << "Kernel,Device,ProblemSize,Config,Seconds\n";
+        for (const auto& record : mRecords)
+        {
+            file << record.kernel << "," << record.device << "," << record.problemSize << "," << record.config << "," << record.seconds << "\n";
+        }
+        return file.good();
+    }
+
+    // Replaces the record with the same kernel/device/problem size: a fresh tuning run wins even if
+    // slower, since the old number may come from another driver state or build of the kernel.
+    void Record(TuningRecord record)
+    {
+        std::replace(record.device.begin(), record.device.end(), ',', ' ');
+        for (auto& existing : mRecords)
+        {
+            if (existing.kernel == record.kernel && existing.device == record.device && existing.problemSize == record.problemSize)
+            {
+                existing = record;
+                return;
+            }
+        }
+        mRecords.push_back(record);
+    }
+
+    // The exact kernel/device/problem size record, or else the same kernel and device at the nearest
+    // problem size on a log scale (unless exactOnly); nullptr when the device has none.
+    const TuningRecord* Lookup(const std::string& kernel, const std::string& device, uint64_t problemSize, bool exactOnly = false) const
+    {
+        std::string key = device;
+        std::replace(key.begin(), key.end(), ',', ' ');
+        const TuningRecord* nearest = nullptr;
+        double distance = (std::numeric_limits<double>::max)();
+        for (const auto& record : mRecords)
+        {
+            if (record.kernel != kernel || record.device != key || (exactOnly && record.problemSize != problemSize))
+            {
+                continue;
+            }
+            double d = std::fabs(std::log(static_cast<double>(record.problemSize) + 1.0) - std::log(static_cast<double>(problemSize) + 1.0));
+            if (d < distance)
+            {
+                distance = d;
+                nearest  = &record;
+            }
+        }
+        return nearest;
+    }
+
+    size_t Size() const { return mRecords.size(); }
+
+private:
+    std::vector<TuningRecord> mRecords;
+};
@@ -0,0 +1,131 @@
+// Standalone check of Autotuner.h: the successive-halving search against a synthetic backend with
+// a known winner and end to end against CpuTuningBackend, and a TuningDatabase save/load/lookup
+// round trip. No D3D12, not part of any project; build and run on any machine with, e.g.
+//   g++ -std=c++14 -O2 -pthread AutotunerCheck.cpp -o AutotunerCheck && ./AutotunerCheck
+// Exits with 1 if any check fails.
+
+#include "Autotuner.h"
+#include "CpuTuningBackend.h"
+#include <cstdio>
+#include <cmath>
+
+static int gFailures = 0;
+
+static void Check(bool passed, const char* what)
+{
+    printf("%s: %s\n", passed ? "PASS" : "FAIL", what);
+    gFailures += passed ? 0 : 1;
+}
+
+// Deterministic timings: (256, 4) is the unique fastest configuration and every other one is at
+// least 2x slower, far more than the 2% jitter added per call to stand in for noise.
+class SyntheticBackend : public TuningBackend
+{
+public:
+
+    explicit SyntheticBackend(const TuningSpace& space) : mSpace(space) {}
+
+    bool Prepare(const TuningConfig& config) override
+    {
+        // Drop one configuration, as a failed compile would.
+        return !(mSpace.Value(config, "GROUP_SIZE") == 1024 && mSpace.Value(config, "ELEMENTS_PER_THREAD") == 8);
+    }
+
+    double Measure(const TuningConfig& config) override
+    {
+        double groupSize = std::log2(static_cast<double>(mSpace.Value(config, "GROUP_SIZE")));
+        double perThread = std::log2(static_cast<double>(mSpace.Value(config, "ELEMENTS_PER_THREAD")));
+        double cost      = 1.0 + std::fabs(groupSize - 8.0) + std::fabs(perThread - 2.0);
+        ++mCalls;
+        return cost * (1.0 + 0.01 * (mCalls % 3));
+    }
+
+private:
+    const TuningSpace& mSpace;
+    uint64_t           mCalls = 0;
+};
+
+static void CheckSearch()
+{
+    TuningSpace space;
+    space.Add("GROUP_SIZE", { 64, 128, 256, 512, 1024 })
+         .Add("ELEMENTS_PER_THREAD", { 1, 2, 4, 8 });
+    Check(space.Enumerate().size() == 20, "space enumerates every combination");
+
+    SyntheticBackend backend(space);
+    TuningOptions options;
+    TuningResult result = Autotuner::SuccessiveHalving(backend, space, options);
+    Check(result.candidates == 20 && result.prepared == 19, "a candidate failing Prepare is dropped");
+    Check(result.best == TuningConfig({ 256, 4 }), "successive halving finds the known winner");
+    // 19 -> 10 -> 5 -> 3 -> 2 -> 1 survivors with 1, 2, 4, 8, 16 runs each.
+    Check(result.rounds == 5 && result.measurements == 19 * 1 + 10 * 2 + 5 * 4 + 3 * 8 + 2 * 16, "rounds and measurements follow eta = 2");
+
+    options.maxCandidates = 6;
+    TuningResult sampled = Autotuner::SuccessiveHalving(backend, space, options);
+    Check(sampled.candidates == 6 && space.Valid(sampled.best), "maxCandidates samples the space");
+
+    TuningConfig parsed;
+    Check(space.Parse(space.Describe(result.best), parsed) && parsed == result.best, "Describe and Parse round trip");
+    Check(!space.Parse("GROUP_SIZE=256", parsed), "Parse rejects a missing parameter");
+}
+
+static void CheckCpuBackend()
+{
+    TuningSpace space;
+    space.Add("GROUP_SIZE", { 64, 256 })
+         .Add("ELEMENTS_PER_THREAD", { 1, 4 })
+         .Add("VECTOR_WIDTH", { 1, 4 })
+         .Add("UNROLL", { 0, 1 });
+
+    CpuTuningBackend backend(space, 1 << 20, 4);
+    TuningResult result = Autotuner::SuccessiveHalving(backend, space, TuningOptions());
+    Check(result.prepared == 16 && result.rounds == 4 && space.Valid(result.best) && result.seconds > 0.0,
+        "CpuTuningBackend search completes with a valid winner");
+    backend.Measure(result.best);
+    Check(backend.Verify() == 0, "the winner copies every element");
+
+    // 1M floats divide by every width; an odd count does not divide by 4.
+    CpuTuningBackend odd(space, (1 << 20) + 1, 4);
+    TuningResult oddResult = Autotuner::SuccessiveHalving(odd, space, TuningOptions());
+    Check(oddResult.prepared == 8 && space.Value(oddResult.best, "VECTOR_WIDTH") == 1, "Prepare drops widths that do not divide the size");
+}
+
+static void CheckDatabase()
+{
+    const std::string path = "autotuner_check_db.csv";
+    TuningDatabase database;
+    database.Record({ "Copy", "GPU A, driver 1", 1024,    "GROUP_SIZE=64",  1e-5 });
+    database.Record({ "Copy", "GPU A, driver 1", 1 << 20, "GROUP_SIZE=256", 1e-3 });
+    database.Record({ "Copy", "GPU A, driver 1", 1 << 26, "GROUP_SIZE=512", 1e-1 });
+    database.Record({ "Copy", "GPU B",           1 << 20, "GROUP_SIZE=128", 2e-3 });
+    database.Record({ "Copy", "GPU A, driver 1", 1 << 20, "GROUP_SIZE=1024", 2e-3 });
+    Check(database.Size() == 4, "Record replaces the same kernel/device/size");
+    Check(database.Save(path), "Save");
+
+    TuningDatabase loaded;
+    Check(loaded.Load(path) && loaded.Size() == 4, "Load reads every record back");
+    std::remove(path.c_str());
+
+    const TuningRecord* exact = loaded.Lookup("Copy", "GPU A, driver 1", 1 << 20);
+    Check(exact != nullptr && exact->config == "GROUP_SIZE=1024" && exact->problemSize == (1u << 20), "exact lookup (device with a comma)");
+    const TuningRecord* nearest = loaded.Lookup("Copy", "GPU A, driver 1", 1 << 24);
+    Check(nearest != nullptr && nearest->problemSize == (1u << 26), "nearest lookup on a log scale");
+    const TuningRecord* small = loaded.Lookup("Copy", "GPU A, driver 1", 2000);
+    Check(small != nullptr && small->problemSize == 1024, "nearest lookup below the tuned sizes");
+    Check(loaded.Lookup("Copy", "GPU A, driver 1", 1 << 24, true) == nullptr, "exactOnly misses an untuned size");
+    Check(loaded.Lookup("Copy", "GPU C", 1 << 20) == nullptr && loaded.Lookup("Transpose", "GPU B", 1 << 20) == nullptr,
+        "no record for another device or kernel");
+
+    TuningDatabase missing;
+    Check(!missing.Load("autotuner_check_missing.csv") && missing.Size() == 0, "a missing file is an empty database");
+}
+
+int main()
+{
+    CheckSearch();
+    CheckCpuBackend();
+    CheckDatabase();
+
+    printf("%d check(s) failed\n", gFailures);
+    return gFailures == 0 ? 0 : 1;
+}
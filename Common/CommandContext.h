@@ -0,0 +1,250 @@
+#pragma once
+
+#include <windows.h>
+#include <d3d12.h>
+#include <wrl.h>
+#include "d3dx12.h"
+#include "d3dUtil.h"
+#include <vector>
+
+using Microsoft::WRL::ComPtr;
+
+// A self-contained submission context: one queue of the requested type, a ring of command
+// allocators, one command list, a fence and an optional timestamp query heap.
+// D3DAppSimplified owns a single DIRECT queue; benchmarks that need COPY or COMPUTE queues
+// (or several queues at once) create one of these per queue.
+class CommandContext
+{
+public:
+
+    CommandContext() = default;
+    CommandContext(const CommandContext&) = delete;
+    CommandContext& operator=(const CommandContext&) = delete;
+
+    void Initialize(ID3D12Device* device,
+                    D3D12_COMMAND_LIST_TYPE type,
+                    UINT timestampCount = 2,
+                    UINT allocatorCount = 1,
+                    D3D12_COMMAND_QUEUE_PRIORITY priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL)
+    {
+        mDevice = device;
+        mType   = type;
+
+        D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+        queueDesc.Type     = type;
+        queueDesc.Priority = priority;
+        queueDesc.Flags    = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        AssertIfFailed(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&mQueue)));
+
+        mAllocators.resize(allocatorCount);
+        for (auto& allocator : mAllocators)
+        {
+            AssertIfFailed(device->CreateCommandAllocator(type, IID_PPV_ARGS(allocator.GetAddressOf())));
+        }
+
+        AssertIfFailed(device->CreateCommandList(0, type, mAllocators[0].Get(), nullptr, IID_PPV_ARGS(mCommandList.GetAddressOf())));
+        mCommandList->Close();
+
+        AssertIfFailed(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mFence)));
+        mFenceEvent = CreateEventEx(nullptr, nullptr, 0, EVENT_ALL_ACCESS);
+
+        if (timestampCount > 0)
+        {
+            CreateTimestampHeap(timestampCount);
+        }
+    }
+
+    ~CommandContext()
+    {
+        if (mFenceEvent)
+        {
+            CloseHandle(mFenceEvent);
+            mFenceEvent = nullptr;
+        }
+    }
+
+    // Reset the command list against allocator 'allocatorIndex'. The caller must make sure
+    // the GPU is done with whatever was previously recorded through that allocator.
+    void Reset(UINT allocatorIndex = 0, ID3D12PipelineState* pso = nullptr)
+    {
+        ID3D12CommandAllocator* allocator = mAllocators[allocatorIndex % mAllocators.size()].Get();
+        AssertIfFailed(allocator->Reset());
+        AssertIfFailed(mCommandList->Reset(allocator, pso));
+    }
+
+    void Submit()
+    {
+        AssertIfFailed(mCommandList->Close());
+        ID3D12CommandList* cmdsLists[] = { mCommandList.Get() };
+        mQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+    }
+
+    // Signal the next fence value on this queue and return it.
+    UINT64 Signal()
+    {
+        mCurrentFence++;
+        AssertIfFailed(mQueue->Signal(mFence.Get(), mCurrentFence));
+        return mCurrentFence;
+    }
+
+    // GPU-side wait: this queue stalls until 'fence' reaches 'value'.
+    void GpuWait(ID3D12Fence* fence, UINT64 value)
+    {
+        AssertIfFailed(mQueue->Wait(fence, value));
+    }
+
+    // CPU-side wait for one of this queue's fence values.
+    void CpuWait(UINT64 value)
+    {
+        if (mFence->GetCompletedValue() < value)
+        {
+            AssertIfFailed(mFence->SetEventOnCompletion(value, mFenceEvent));
+            WaitForSingleObject(mFenceEvent, INFINITE);
+        }
+    }
+
+    bool IsComplete(UINT64 value) const { return mFence->GetCompletedValue() >= value; }
+
+    void Flush() { CpuWait(Signal()); }
+
+    void SubmitAndFlush()
+    {
+        Submit();
+        Flush();
+    }
+
+    // Timestamps ------------------------------------------------------------------------------
+
+    bool TimestampsSupported() const { return mTimestampQueryHeap != nullptr; }
+
+    void Timestamp(UINT index)
+    {
+        if (mTimestampQueryHeap)
+        {
+            mCommandList->EndQuery(mTimestampQueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, index);
+        }
+    }
+
+    // Resolves queries [first, first + count) into the same slots of the readback buffer.
+    void ResolveTimestamps(UINT count, UINT first = 0)
+    {
+        if (mTimestampQueryHeap)
+        {
+            mCommandList->ResolveQueryData(mTimestampQueryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, first, count,
+                                           mTimestampReadbackBuffer.Get(), first * sizeof(UINT64));
+        }
+    }
+
+    // Read back resolved ticks. Only valid after the list that resolved them has completed.
+    std::vector<UINT64> ReadTimestamps(UINT count)
+    {
+        std::vector<UINT64> ticks(count, 0);
+        if (!mTimestampQueryHeap)
+        {
+            return ticks;
+        }
+
+        UINT64* data = nullptr;
+        D3D12_RANGE readRange = { 0, count * sizeof(UINT64) };
+        AssertIfFailed(mTimestampReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&data)));
+        memcpy(ticks.data(), data, count * sizeof(UINT64));
+        D3D12_RANGE writeRange = { 0, 0 };
+        mTimestampReadbackBuffer->Unmap(0, &writeRange);
+        return ticks;
+    }
+
+    double ElapsedSeconds(UINT begin, UINT end)
+    {
+        std::vector<UINT64> ticks = ReadTimestamps((begin > end ? begin : end) + 1);
+        return static_cast<double>(ticks[end] - ticks[begin]) / TimestampFrequency();
+    }
+
+    UINT64 TimestampFrequency() const
+    {
+        UINT64 frequency = 1;
+        mQueue->GetTimestampFrequency(&frequency);
+        return frequency;
+    }
+
+    // Samples the queue's GPU clock against QueryPerformanceCounter so that timestamps from
+    // different queues can be placed on one (CPU) timeline. Call shortly before submitting.
+    void CalibrateClock()
+    {
+        LARGE_INTEGER qpcFrequency;
+        QueryPerformanceFrequency(&qpcFrequency);
+        AssertIfFailed(mQueue->GetClockCalibration(&mCalibrationGpuTicks, &mCalibrationCpuTicks));
+        mCalibrationGpuFrequency = static_cast<double>(TimestampFrequency());
+        mCalibrationCpuFrequency = static_cast<double>(qpcFrequency.QuadPart);
+    }
+
+    // GPU ticks -> seconds on the QPC timeline, using the last CalibrateClock().
+    double TimestampToCpuSeconds(UINT64 gpuTicks) const
+    {
+        double gpuDelta = (static_cast<double>(gpuTicks) - static_cast<double>(mCalibrationGpuTicks)) / mCalibrationGpuFrequency;
+        return static_cast<double>(mCalibrationCpuTicks) / mCalibrationCpuFrequency + gpuDelta;
+    }
+
+    ID3D12CommandQueue*        Queue()       const { return mQueue.Get(); }
+    ID3D12CommandAllocator*    Allocator(UINT index = 0) const { return mAllocators[index % mAllocators.size()].Get(); }
+    ID3D12GraphicsCommandList* CommandList() const { return mCommandList.Get(); }
+    ID3D12Fence*               Fence()       const { return mFence.Get(); }
+    UINT64                     LastSignaled() const { return mCurrentFence; }
+    D3D12_COMMAND_LIST_TYPE    Type()        const { return mType; }
+
+private:
+
+    void CreateTimestampHeap(UINT count)
+    {
+        D3D12_QUERY_HEAP_DESC timestampHeapDesc = {};
+        timestampHeapDesc.Count    = count;
+        timestampHeapDesc.NodeMask = 0;
+
+        if (mType == D3D12_COMMAND_LIST_TYPE_COPY)
+        {
+            // Copy queues use their own query heap type and the support is optional.
+            D3D12_FEATURE_DATA_D3D12_OPTIONS3 options3 = {};
+            if (FAILED(mDevice->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS3, &options3, sizeof(options3))) ||
+                !options3.CopyQueueTimestampQueriesSupported)
+            {
+                OutputDebugStringA("Copy queue timestamps are not supported on this device\n");
+                return;
+            }
+            timestampHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_COPY_QUEUE_TIMESTAMP;
+        }
+        else
+        {
+            timestampHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        }
+
+        AssertIfFailed(mDevice->CreateQueryHeap(&timestampHeapDesc, IID_PPV_ARGS(&mTimestampQueryHeap)));
+
+        auto readbackHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
+        auto bufferDesc   = CD3DX12_RESOURCE_DESC::Buffer(count * sizeof(UINT64));
+        AssertIfFailed(mDevice->CreateCommittedResource(
+            &readbackHeap,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr,
+            IID_PPV_ARGS(&mTimestampReadbackBuffer)));
+    }
+
+    ID3D12Device*           mDevice = nullptr;
+    D3D12_COMMAND_LIST_TYPE mType   = D3D12_COMMAND_LIST_TYPE_DIRECT;
+
+    ComPtr<ID3D12CommandQueue>                  mQueue;
+    std::vector<ComPtr<ID3D12CommandAllocator>> mAllocators;
+    ComPtr<ID3D12GraphicsCommandList>           mCommandList;
+
+    ComPtr<ID3D12Fence> mFence;
+    UINT64              mCurrentFence = 0;
+    HANDLE              mFenceEvent   = nullptr;
+
+    ComPtr<ID3D12QueryHeap> mTimestampQueryHeap;
+    ComPtr<ID3D12Resource>  mTimestampReadbackBuffer;
+
+    UINT64 mCalibrationGpuTicks     = 0;
+    UINT64 mCalibrationCpuTicks     = 0;
+    double mCalibrationGpuFrequency = 1.0;
+    double mCalibrationCpuFrequency = 1.0;
+};
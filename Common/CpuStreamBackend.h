@@ -0,0 +1,250 @@
+#pragma once
+
+// CPU implementation of StreamBackend: one worker thread per queue and CPU fences standing in
+// for ID3D12Fence. It runs the exact same schedule as the D3D12 backend so the fence/slot logic in
+// StreamScheduler can be checked (and profiled) without a GPU.
+
+#include "StreamScheduler.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <cstring>
+#include <cmath>
+
+class CpuStreamBackend : public StreamBackend
+{
+public:
+
+    // Same kernel as Streaming/Shaders/StreamCompute.hlsl.
+    static float Kernel(float value, uint32_t iterations)
+    {
+        for (uint32_t i = 0; i < iterations; ++i)
+        {
+            value = value * 0.999f + 0.5f;
+        }
+        return value;
+    }
+
+    CpuStreamBackend(uint64_t totalElements, uint64_t chunkElements, uint32_t slotCount, uint32_t iterations)
+        : mSlotCount(slotCount), mIterations(iterations)
+    {
+        mChunking.totalElements = totalElements;
+        mChunking.chunkElements = chunkElements;
+
+        mHostInput.resize(static_cast<size_t>(totalElements));
+        mHostOutput.resize(static_cast<size_t>(totalElements));
+        for (size_t i = 0; i < mHostInput.size(); ++i)
+        {
+            mHostInput[i] = static_cast<float>(i % 1024) * 0.25f;
+        }
+
+        for (uint32_t s = 0; s < slotCount; ++s)
+        {
+            mUploadStaging.emplace_back(static_cast<size_t>(chunkElements));
+            mDeviceInput.emplace_back(static_cast<size_t>(chunkElements));
+            mDeviceOutput.emplace_back(static_cast<size_t>(chunkElements));
+            mReadbackStaging.emplace_back(static_cast<size_t>(chunkElements));
+        }
+
+        for (uint32_t q = 0; q < QueueCount; ++q)
+        {
+            mQueues[q].worker = std::thread(&CpuStreamBackend::WorkerLoop, this, q);
+        }
+    }
+
+    ~CpuStreamBackend()
+    {
+        for (uint32_t q = 0; q < QueueCount; ++q)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mQueues[q].mutex);
+                mQueues[q].exit = true;
+            }
+            mQueues[q].wake.notify_all();
+            mQueues[q].worker.join();
+        }
+    }
+
+    uint32_t ChunkCount() const override { return mChunking.Count(); }
+    uint32_t SlotCount()  const override { return mSlotCount; }
+    uint64_t TotalBytes() const override { return mChunking.totalElements * sizeof(float); }
+
+    void Upload(uint32_t slot, uint32_t chunk) override
+    {
+        // Host -> staging happens on the submitting thread, as it does with a mapped upload heap.
+        size_t count = static_cast<size_t>(mChunking.Elements(chunk));
+        memcpy(mUploadStaging[slot].data(), mHostInput.data() + mChunking.Offset(chunk), count * sizeof(float));
+
+        Enqueue(StreamQueue::Upload, [this, slot, count]() {
+            memcpy(mDeviceInput[slot].data(), mUploadStaging[slot].data(), count * sizeof(float));
+        });
+    }
+
+    void Compute(uint32_t slot, uint32_t chunk) override
+    {
+        size_t count = static_cast<size_t>(mChunking.Elements(chunk));
+        Enqueue(StreamQueue::Compute, [this, slot, count]() {
+            const float* in  = mDeviceInput[slot].data();
+            float*       out = mDeviceOutput[slot].data();
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = Kernel(in[i], mIterations);
+            }
+        });
+    }
+
+    void Readback(uint32_t slot, uint32_t chunk) override
+    {
+        size_t count = static_cast<size_t>(mChunking.Elements(chunk));
+        Enqueue(StreamQueue::Readback, [this, slot, count]() {
+            memcpy(mReadbackStaging[slot].data(), mDeviceOutput[slot].data(), count * sizeof(float));
+        });
+    }
+
+    void Retire(uint32_t slot, uint32_t chunk) override
+    {
+        size_t count = static_cast<size_t>(mChunking.Elements(chunk));
+        memcpy(mHostOutput.data() + mChunking.Offset(chunk), mReadbackStaging[slot].data(), count * sizeof(float));
+    }
+
+    uint64_t Signal(StreamQueue queue) override
+    {
+        Queue& q = mQueues[Index(queue)];
+        uint64_t value = ++q.lastSignaled;
+        Enqueue(queue, [&q, value]() {
+            {
+                std::lock_guard<std::mutex> lock(q.fenceMutex);
+                q.completed = value;
+            }
+            q.fenceChanged.notify_all();
+        }, false);
+        return value;
+    }
+
+    void QueueWait(StreamQueue waiter, StreamQueue signaller, uint64_t value) override
+    {
+        Queue& s = mQueues[Index(signaller)];
+        Enqueue(waiter, [&s, value]() { WaitFence(s, value); }, false);
+    }
+
+    void HostWait(StreamQueue queue, uint64_t value) override
+    {
+        WaitFence(mQueues[Index(queue)], value);
+    }
+
+    void BeginRun() override
+    {
+        for (uint32_t q = 0; q < QueueCount; ++q)
+        {
+            std::lock_guard<std::mutex> lock(mQueues[q].mutex);
+            mQueues[q].busySeconds = 0.0;
+        }
+    }
+
+    double BusySeconds(StreamQueue queue) const override
+    {
+        const Queue& q = mQueues[Index(queue)];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        return q.busySeconds;
+    }
+
+    // Compares the host output with the kernel applied on the host; returns the mismatch count.
+    uint64_t Verify() const
+    {
+        uint64_t mismatches = 0;
+        for (size_t i = 0; i < mHostInput.size(); ++i)
+        {
+            float expected = Kernel(mHostInput[i], mIterations);
+            if (std::fabs(mHostOutput[i] - expected) > 1e-4f * (std::max)(1.0f, std::fabs(expected)))
+            {
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+
+private:
+
+    static const uint32_t QueueCount = static_cast<uint32_t>(StreamQueue::Count);
+
+    struct Queue
+    {
+        std::thread                        worker;
+        mutable std::mutex                 mutex;
+        std::condition_variable            wake;
+        std::deque<std::function<void()>>  work;
+        bool                               exit = false;
+        double                             busySeconds = 0.0;
+
+        // CPU fence
+        std::mutex              fenceMutex;
+        std::condition_variable fenceChanged;
+        uint64_t                completed    = 0;
+        uint64_t                lastSignaled = 0;
+    };
+
+    static uint32_t Index(StreamQueue queue) { return static_cast<uint32_t>(queue); }
+
+    static void WaitFence(Queue& q, uint64_t value)
+    {
+        std::unique_lock<std::mutex> lock(q.fenceMutex);
+        q.fenceChanged.wait(lock, [&q, value]() { return q.completed >= value; });
+    }
+
+    // 'timed' work counts towards the queue's busy time; fence signals/waits do not.
+    void Enqueue(StreamQueue queue, std::function<void()> work, bool timed = true)
+    {
+        Queue& q = mQueues[Index(queue)];
+        std::function<void()> item = work;
+        if (timed)
+        {
+            item = [&q, work]() {
+                auto start = std::chrono::steady_clock::now();
+                work();
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::lock_guard<std::mutex> lock(q.mutex);
+                q.busySeconds += seconds;
+            };
+        }
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.work.push_back(item);
+        }
+        q.wake.notify_one();
+    }
+
+    void WorkerLoop(uint32_t index)
+    {
+        Queue& q = mQueues[index];
+        for (;;)
+        {
+            std::function<void()> item;
+            {
+                std::unique_lock<std::mutex> lock(q.mutex);
+                q.wake.wait(lock, [&q]() { return q.exit || !q.work.empty(); });
+                if (q.work.empty())
+                {
+                    return;
+                }
+                item = q.work.front();
+                q.work.pop_front();
+            }
+            item();
+        }
+    }
+
+    StreamChunking mChunking;
+    uint32_t       mSlotCount;
+    uint32_t       mIterations;
+
+    std::vector<float> mHostInput;
+    std::vector<float> mHostOutput;
+    std::vector<std::vector<float>> mUploadStaging;
+    std::vector<std::vector<float>> mDeviceInput;
+    std::vector<std::vector<float>> mDeviceOutput;
+    std::vector<std::vector<float>> mReadbackStaging;
+
+    Queue mQueues[QueueCount];
+};
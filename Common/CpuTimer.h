@@ -0,0 +1,35 @@
+#pragma once
+
+#include <windows.h>
+
+// QueryPerformanceCounter based wall-clock timer for the CPU side of a measurement
+// (command recording, submission, fence waits, memcpy into mapped heaps).
+class CpuTimer
+{
+public:
+
+    CpuTimer()
+    {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        mFrequency = static_cast<double>(frequency.QuadPart);
+    }
+
+    void Start() { mStart = Now(); }
+
+    // Seconds elapsed since the last Start().
+    double Stop() const { return static_cast<double>(Now() - mStart) / mFrequency; }
+
+    double ToSeconds(LONGLONG ticks) const { return static_cast<double>(ticks) / mFrequency; }
+
+    static LONGLONG Now()
+    {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return counter.QuadPart;
+    }
+
+private:
+    double   mFrequency = 1.0;
+    LONGLONG mStart     = 0;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+// CPU implementation of TuningBackend: a multithreaded host copy with the parameters of
+// Autotune/Shaders/TunableCopy.hlsl, indexed the same way (GROUP_SIZE lanes, each copying
+// ELEMENTS_PER_THREAD vectors of VECTOR_WIDTH floats GROUP_SIZE vectors apart). The timings are
+// real but mean little for the GPU; the point is to run the search and the database end to end
+// without a device.
+
+#include "Autotuner.h"
+#include "ParallelFor.h"
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+
+class CpuTuningBackend : public TuningBackend
+{
+public:
+
+    CpuTuningBackend(const TuningSpace& space, uint64_t elements, uint32_t threads)
+        : mSpace(space), mThreads(threads), mInput(static_cast<size_t>(elements)), mOutput(static_cast<size_t>(elements))
+    {
+        for (size_t i = 0; i < mInput.size(); ++i)
+        {
+            mInput[i] = static_cast<float>(i % 4093) * 0.5f;
+        }
+    }
+
+    bool Prepare(const TuningConfig& config) override
+    {
+        // Same restriction as the GPU kernel: whole vectors only.
+        return mInput.size() % mSpace.Value(config, "VECTOR_WIDTH") == 0;
+    }
+
+    double Measure(const TuningConfig& config) override
+    {
+        const uint32_t groupSize = mSpace.Value(config, "GROUP_SIZE");
+        const uint32_t perThread = mSpace.Value(config, "ELEMENTS_PER_THREAD");
+        const uint32_t width     = mSpace.Value(config, "VECTOR_WIDTH");
+        const bool     unroll    = mSpace.Value(config, "UNROLL") != 0;
+        const size_t   vectors   = mInput.size() / width;
+        const size_t   perGroup  = static_cast<size_t>(groupSize) * perThread;
+        const size_t   groups    = (vectors + perGroup - 1) / perGroup;
+
+        auto start = std::chrono::steady_clock::now();
+        ParallelFor(groups, mThreads, [&](uint32_t, size_t begin, size_t end)
+        {
+            for (size_t group = begin; group < end; ++group)
+            {
+                for (uint32_t e = 0; e < perThread; ++e)
+                {
+                    size_t first = group * perGroup + static_cast<size_t>(e) * groupSize;
+                    size_t last  = (std::min)(vectors, first + groupSize);
+                    size_t lane  = first;
+                    if (unroll)
+                    {
+                        for (; lane + 4 <= last; lane += 4)
+                        {
+                            memcpy(&mOutput[lane * width], &mInput[lane * width], 4 * width * sizeof(float));
+                        }
+                    }
+                    for (; lane < last; ++lane)
+                    {
+                        memcpy(&mOutput[lane * width], &mInput[lane * width], width * sizeof(float));
+                    }
+                }
+            }
+        }, 1);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Output elements differing from the input after the last Measure().
+    uint64_t Verify() const
+    {
+        uint64_t mismatches = 0;
+        for (size_t i = 0; i < mInput.size(); ++i)
+        {
+            mismatches += mOutput[i] != mInput[i] ? 1 : 0;
+        }
+        return mismatches;
+    }
+
+private:
+    const TuningSpace& mSpace;
+    uint32_t           mThreads;
+    std::vector<float> mInput;
+    std::vector<float> mOutput;
+};
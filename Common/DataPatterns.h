@@ -0,0 +1,122 @@
+#pragma once
+
+// Input fills for the bandwidth benchmarks, from trivially compressible to incompressible, plus
+// captured data loaded from disk. Memory systems with delta/colour compression move the first
+// few patterns for a fraction of their nominal size, so the same copy can report very different
+// bandwidth depending on what it copies. No D3D dependency.
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <random>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+enum DataPattern : uint32_t {
+    ZeroPattern       = 0,   // all 0.0f
+    ConstantPattern   = 1,   // one non-zero value everywhere
+    GradientPattern   = 2,   // smooth ramp over the 2D image
+    LowEntropyPattern = 3,   // runs of 1..64 elements drawn from four values
+    RandomPattern     = 4,   // magnitude * cos(phi), the historical GpuCopy input
+    CapturedPattern   = 5,   // raw float32 file, repeated to fill the image
+    DataPatternCount
+};
+
+inline const char* DataPatternName(DataPattern pattern)
+{
+    switch (pattern)
+    {
+    case DataPattern::ZeroPattern:       return "Zero";
+    case DataPattern::ConstantPattern:   return "Constant";
+    case DataPattern::GradientPattern:   return "Gradient";
+    case DataPattern::LowEntropyPattern: return "LowEntropy";
+    case DataPattern::RandomPattern:     return "Random";
+    case DataPattern::CapturedPattern:   return "Captured";
+    default:                             return "Unknown";
+    }
+}
+
+namespace DataPatterns
+{
+    // Reads a headerless little-endian float32 file; false if it is missing or empty.
+    inline bool LoadCaptured(const std::wstring& path, std::vector<float>& values)
+    {
+#if defined(_WIN32)
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+#else
+        std::ifstream file(std::string(path.begin(), path.end()), std::ios::binary | std::ios::ate);
+#endif
+        if (!file.is_open())
+        {
+            return false;
+        }
+        std::streamoff bytes = file.tellg();
+        values.resize(static_cast<size_t>(bytes) / sizeof(float));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(float));
+        return !values.empty() && file.good();
+    }
+
+    // width * height floats of the pattern, row-major. `captured` is only used by CapturedPattern.
+    inline std::vector<float> MakeFloats(DataPattern pattern, uint32_t width, uint32_t height, const std::vector<float>& captured)
+    {
+        std::vector<float> values(static_cast<size_t>(width) * height, 0.0f);
+        switch (pattern)
+        {
+        case DataPattern::ConstantPattern:
+            for (auto& value : values)
+            {
+                value = 0.75f;
+            }
+            break;
+        case DataPattern::GradientPattern:
+            for (uint32_t y = 0; y < height; ++y)
+            {
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    values[static_cast<size_t>(y) * width + x] = static_cast<float>(x + y) / static_cast<float>(width + height);
+                }
+            }
+            break;
+        case DataPattern::LowEntropyPattern:
+        {
+            const float levels[4] = { 0.0f, 0.25f, 0.5f, 1.0f };
+            std::mt19937 gen(12345);
+            std::uniform_int_distribution<uint32_t> runDist(1, 64);
+            size_t i = 0;
+            while (i < values.size())
+            {
+                float  level = levels[gen() & 3];
+                size_t end   = (std::min)(values.size(), i + runDist(gen));
+                for (; i < end; ++i)
+                {
+                    values[i] = level;
+                }
+            }
+            break;
+        }
+        case DataPattern::RandomPattern:
+        {
+            std::random_device rd;
+            std::mt19937 gen(rd());
+            std::uniform_real_distribution<float> magnitudeDist(1.0f, 10.0f);
+            std::uniform_real_distribution<float> angleDist(0.0f, 6.28318530718f);
+            for (auto& value : values)
+            {
+                value = magnitudeDist(gen) * cosf(angleDist(gen));
+            }
+            break;
+        }
+        case DataPattern::CapturedPattern:
+            for (size_t i = 0; !captured.empty() && i < values.size(); ++i)
+            {
+                values[i] = captured[i % captured.size()];
+            }
+            break;
+        default:
+            break;
+        }
+        return values;
+    }
+}
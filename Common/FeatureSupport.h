@@ -0,0 +1,163 @@
+#pragma once
+
+#include <d3d12.h>
+#include <dxgi1_4.h>
+#include <wrl.h>
+#include <string>
+#include <cstdio>
+
+// D3D12 symbols newer than the Windows SDK headers we build against. Enum values and feature-data
+// structs are mirrored here, and only here, so every project compiles with either SDK; on runtimes
+// that do not know them CheckFeatureSupport fails and the feature reads as unsupported. Interfaces
+// cannot be mirrored, so code using them is guarded with #ifdef __<Interface>_INTERFACE_DEFINED__
+// (BarrierCost's ID3D12GraphicsCommandList7). Anything the SDK headers have is used directly.
+static const D3D_SHADER_MODEL kShaderModel6_6   = static_cast<D3D_SHADER_MODEL>(0x66);
+static const D3D12_FEATURE    kFeatureOptions9  = static_cast<D3D12_FEATURE>(37);
+static const D3D12_FEATURE    kFeatureOptions11 = static_cast<D3D12_FEATURE>(40);
+
+// GPU_UPLOAD heaps (Agility SDK 1.613).
+static const D3D12_HEAP_TYPE kHeapTypeGpuUpload = static_cast<D3D12_HEAP_TYPE>(5);
+static const D3D12_FEATURE   kFeatureOptions16  = static_cast<D3D12_FEATURE>(45);
+
+// SM 6.6 ResourceDescriptorHeap indexing.
+static const D3D12_ROOT_SIGNATURE_FLAGS kRootFlagHeapDirectlyIndexed = static_cast<D3D12_ROOT_SIGNATURE_FLAGS>(0x400);
+
+struct FeatureDataOptions9
+{
+    BOOL MeshShaderPipelineStatsSupported;
+    BOOL MeshShaderSupportsFullRangeRenderTargetArrayIndex;
+    BOOL AtomicInt64OnTypedResourceSupported;
+    BOOL AtomicInt64OnGroupSharedSupported;
+    BOOL DerivativesInMeshAndAmplificationShadersSupported;
+    UINT WaveMMATier;
+};
+
+struct FeatureDataOptions11
+{
+    BOOL AtomicInt64OnDescriptorHeapResourceSupported;
+};
+
+struct FeatureDataOptions16
+{
+    BOOL DynamicDepthBiasSupported;
+    BOOL GPUUploadHeapSupported;
+};
+
+// Highest shader model the device/runtime pair supports. The runtime rejects models it does not
+// know with E_INVALIDARG, so walk down from the newest one we care about.
+inline D3D_SHADER_MODEL QueryHighestShaderModel(ID3D12Device* device)
+{
+    const UINT models[] = { 0x66, 0x65, 0x64, 0x63, 0x62, 0x61, 0x60 };
+    for (UINT model : models)
+    {
+        D3D12_FEATURE_DATA_SHADER_MODEL shaderModel = { static_cast<D3D_SHADER_MODEL>(model) };
+        if (SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel))))
+        {
+            return shaderModel.HighestShaderModel;
+        }
+    }
+    return D3D_SHADER_MODEL_5_1;
+}
+
+// "VEN_xxxx&DEV_xxxx&SUBSYS_xxxxxxxx&REV_xx DRV_a.b.c.d" of the adapter the device was created on:
+// the identity a tuned configuration or a result row is valid for.
+inline std::string QueryAdapterKey(ID3D12Device* device)
+{
+    Microsoft::WRL::ComPtr<IDXGIFactory4> factory;
+    Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+    DXGI_ADAPTER_DESC1 desc = {};
+    if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory))) ||
+        FAILED(factory->EnumAdapterByLuid(device->GetAdapterLuid(), IID_PPV_ARGS(&adapter))) ||
+        FAILED(adapter->GetDesc1(&desc)))
+    {
+        return "Unknown";
+    }
+    // The UMD version; left at 0 if the query fails.
+    LARGE_INTEGER driver = {};
+    adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driver);
+
+    char key[128];
+    snprintf(key, sizeof(key), "VEN_%04X&DEV_%04X&SUBSYS_%08X&REV_%02X DRV_%u.%u.%u.%u", desc.VendorId, desc.DeviceId, desc.SubSysId, desc.Revision,
+        HIWORD(driver.HighPart), LOWORD(driver.HighPart), HIWORD(driver.LowPart), LOWORD(driver.LowPart));
+    return key;
+}
+
+// Shader capabilities a result depends on, recorded next to every result row (ResultsCsv's
+// DeviceCaps column) so numbers from different devices/drivers can be told apart.
+struct DeviceCaps
+{
+    D3D_SHADER_MODEL ShaderModel            = D3D_SHADER_MODEL_5_1;
+    bool             WaveOps                = false;
+    UINT             WaveLaneCountMin       = 0;
+    UINT             WaveLaneCountMax       = 0;
+    bool             Native16BitOps         = false;  // float16_t/int16_t (SM 6.2, -enable-16bit-types)
+    bool             Int64Ops               = false;
+    bool             AtomicInt64Typed       = false;
+    bool             AtomicInt64Groupshared = false;
+    bool             AtomicInt64Heap        = false;
+
+    // [WaveSize(lanes)] needs SM 6.6 and a lane count the device can run. Inferred from the caps
+    // only: nothing is compiled or dispatched (WaveOps records the lane count a kernel really ran with).
+    bool SupportsWaveSize(UINT lanes) const
+    {
+        return ShaderModel >= kShaderModel6_6 && WaveOps && lanes >= WaveLaneCountMin && lanes <= WaveLaneCountMax;
+    }
+
+    // "SM6_6;Wave32-64;WaveSizeRange32-64;Fp16;Int64;AtomicInt64Typed;...": ';'-separated, so it fits in one CSV field.
+    // WaveSizeRange is the lane range [WaveSize] may request per SupportsWaveSize, not a tested fact.
+    std::string Describe() const
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "SM%u_%u", (static_cast<UINT>(ShaderModel) >> 4) & 0xF, static_cast<UINT>(ShaderModel) & 0xF);
+        std::string caps = text;
+        if (WaveOps)
+        {
+            snprintf(text, sizeof(text), ";Wave%u-%u", WaveLaneCountMin, WaveLaneCountMax);
+            caps += text;
+        }
+        if (SupportsWaveSize(WaveLaneCountMin))
+        {
+            snprintf(text, sizeof(text), ";WaveSizeRange%u-%u", WaveLaneCountMin, WaveLaneCountMax);
+            caps += text;
+        }
+        caps += Native16BitOps ? ";Fp16" : "";
+        caps += Int64Ops ? ";Int64" : "";
+        caps += AtomicInt64Typed ? ";AtomicInt64Typed" : "";
+        caps += AtomicInt64Groupshared ? ";AtomicInt64Groupshared" : "";
+        caps += AtomicInt64Heap ? ";AtomicInt64Heap" : "";
+        return caps;
+    }
+};
+
+// Queries that fail (older runtimes) leave the capability off.
+inline DeviceCaps QueryDeviceCaps(ID3D12Device* device)
+{
+    DeviceCaps caps;
+    caps.ShaderModel = QueryHighestShaderModel(device);
+
+    D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+    if (SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))))
+    {
+        caps.WaveOps          = options1.WaveOps != FALSE;
+        caps.WaveLaneCountMin = options1.WaveLaneCountMin;
+        caps.WaveLaneCountMax = options1.WaveLaneCountMax;
+        caps.Int64Ops         = options1.Int64ShaderOps != FALSE;
+    }
+    D3D12_FEATURE_DATA_D3D12_OPTIONS4 options4 = {};
+    if (SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS4, &options4, sizeof(options4))))
+    {
+        caps.Native16BitOps = options4.Native16BitShaderOpsSupported != FALSE && caps.ShaderModel >= D3D_SHADER_MODEL_6_2;
+    }
+    FeatureDataOptions9 options9 = {};
+    if (SUCCEEDED(device->CheckFeatureSupport(kFeatureOptions9, &options9, sizeof(options9))))
+    {
+        caps.AtomicInt64Typed       = options9.AtomicInt64OnTypedResourceSupported != FALSE;
+        caps.AtomicInt64Groupshared = options9.AtomicInt64OnGroupSharedSupported != FALSE;
+    }
+    FeatureDataOptions11 options11 = {};
+    if (SUCCEEDED(device->CheckFeatureSupport(kFeatureOptions11, &options11, sizeof(options11))))
+    {
+        caps.AtomicInt64Heap = options11.AtomicInt64OnDescriptorHeapResourceSupported != FALSE;
+    }
+    return caps;
+}
@@ -20,8 +20,12 @@ public:
 
     bool Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue)
     {
-        // Load GPA DLL
-        mGPAModule = LoadLibraryA("C:\\Users\\kimwang2\\Desktop\\GPU_Graphics_Performacne_Test\\GPUPerfAPI\\bin\\GPUPerfAPIDX12-x64.dll");
+        // Load GPA DLL; next to the executable / on the PATH first, then the checked-in copy
+        mGPAModule = LoadLibraryA("GPUPerfAPIDX12-x64.dll");
+        if (!mGPAModule)
+        {
+            mGPAModule = LoadLibraryA("C:\\Users\\kimwang2\\Desktop\\GPU_Graphics_Performacne_Test\\GPUPerfAPI\\bin\\GPUPerfAPIDX12-x64.dll");
+        }
         if (!mGPAModule)
         {
             OutputDebugStringA("Failed to load GPUPerfAPI DLL\n");
@@ -52,9 +56,9 @@ public:
             return false;
         }
 
-        // Open context for D3D12
+        // Open context for D3D12; GPA takes the device as the API context
         GpaOpenContextFlags flags = kGpaOpenContextDefaultBit;
-        status = mGpaFuncTable->GpaOpenContext(commandQueue, flags, &mGpaContextId);
+        status = mGpaFuncTable->GpaOpenContext(device, flags, &mGpaContextId);
         if (status != kGpaStatusOk)
         {
             OutputDebugStringA("GpaOpenContext failed\n");
@@ -202,6 +206,32 @@ public:
 
     }
 
+    bool GetDeviceGeneration(GpaHwGeneration& generation)
+    {
+        if (!mInitialized) return false;
+
+        GpaStatus status = mGpaFuncTable->GpaGetDeviceGeneration(mGpaContextId, &generation);
+        return status == kGpaStatusOk;
+    }
+
+    // Total wave slots of the device (all SIMDs of all CUs)
+    bool GetDeviceMaxWaveSlots(GpaUInt32& maxWaveSlots)
+    {
+        if (!mInitialized) return false;
+
+        GpaStatus status = mGpaFuncTable->GpaGetDeviceMaxWaveSlots(mGpaContextId, &maxWaveSlots);
+        return status == kGpaStatusOk;
+    }
+
+    // VGPRs of one SIMD lane, shared by the waves resident on that SIMD
+    bool GetDeviceMaxVgprs(GpaUInt32& maxVgprs)
+    {
+        if (!mInitialized) return false;
+
+        GpaStatus status = mGpaFuncTable->GpaGetDeviceMaxVgprs(mGpaContextId, &maxVgprs);
+        return status == kGpaStatusOk;
+    }
+
     GpaUInt32 GetNumRequiredPasses()
     {
         if (!mInitialized || !mGpaSessionId) return 0;
@@ -214,8 +244,9 @@ public:
 private:
     void CacheCounterInfo()
     {
-        GpaUInt32 numCounters;
-        mGpaFuncTable->GpaGetNumCounters(mGpaSessionId, &numCounters);
+        // Counters belong to a session; there is none until CreateSession()
+        GpaUInt32 numCounters = 0;
+        if (!mGpaSessionId || mGpaFuncTable->GpaGetNumCounters(mGpaSessionId, &numCounters) != kGpaStatusOk) return;
 
         for (GpaUInt32 i = 0; i < numCounters; ++i)
         {
@@ -0,0 +1,15 @@
+#pragma once
+
+// Stateless 64-bit hash for generating reproducible synthetic inputs (keys, index patterns, sparse
+// matrices) from an element index or seed. No D3D dependency.
+
+#include <cstdint>
+
+// splitmix64 finaliser
+inline uint64_t Hash64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
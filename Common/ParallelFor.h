@@ -0,0 +1,42 @@
+#pragma once
+
+// Minimal static-partition parallel loop for host-side reference implementations and baselines.
+// Threads are spawned per call, so it is only meant for ranges large enough to hide ~100us of
+// thread start-up.
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+inline uint32_t HardwareThreadCount()
+{
+    uint32_t count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+// Splits [0, count) into `threads` contiguous ranges and calls fn(worker, begin, end) for each,
+// worker 0 on the calling thread. Ranges start on multiples of `alignment` elements so SIMD loops
+// see aligned splits.
+template <typename Fn>
+void ParallelFor(size_t count, uint32_t threads, Fn fn, size_t alignment = 64)
+{
+    threads = (std::max)(1u, threads);
+    size_t chunk = (count + threads - 1) / threads;
+    chunk = (chunk + alignment - 1) / alignment * alignment;
+
+    std::vector<std::thread> workers;
+    for (uint32_t worker = 1; worker < threads; ++worker)
+    {
+        size_t begin = (std::min)(count, chunk * worker);
+        size_t end   = (std::min)(count, begin + chunk);
+        workers.emplace_back(fn, worker, begin, end);
+    }
+    fn(0u, static_cast<size_t>(0), (std::min)(count, chunk));
+
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+}
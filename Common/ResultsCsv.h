@@ -0,0 +1,62 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+
+// Appends benchmark rows to a CSV file, writing the header only when the file is new/empty.
+// Same behaviour as the inline writer in LinearCopy/Main.cpp, shared by the other benchmarks.
+class ResultsCsv
+{
+public:
+
+    ResultsCsv(const std::string& path, const std::string& header) : mFile(path, std::ios::app)
+    {
+        if (mFile.is_open())
+        {
+            mFile.seekp(0, std::ios::end);
+            if (mFile.tellp() == 0)
+            {
+                mFile << header << "\n";
+            }
+        }
+    }
+
+    // Same, with a trailing DeviceCaps column (DeviceCaps::Describe()) in the header and in every row.
+    ResultsCsv(const std::string& path, const std::string& header, const std::string& deviceCaps) :
+        ResultsCsv(path, header + ",DeviceCaps")
+    {
+        mSuffix = "," + deviceCaps;
+    }
+
+    bool IsOpen() const { return mFile.is_open(); }
+
+    template <typename... Values>
+    void Row(const Values&... values)
+    {
+        if (!mFile.is_open())
+        {
+            return;
+        }
+        WriteFields(values...);
+        mFile << mSuffix << "\n";
+        mFile.flush();
+    }
+
+private:
+
+    template <typename Last>
+    void WriteFields(const Last& last)
+    {
+        mFile << last;
+    }
+
+    template <typename First, typename... Rest>
+    void WriteFields(const First& first, const Rest&... rest)
+    {
+        mFile << first << ",";
+        WriteFields(rest...);
+    }
+
+    std::ofstream mFile;
+    std::string   mSuffix;
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+// Portable (no Windows/D3D12 dependency) so the scheduling logic can be exercised with the
+// CPU backend in CpuStreamBackend.h on any machine.
+
+#include <cstdint>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+enum class StreamQueue : uint32_t
+{
+    Upload   = 0,
+    Compute  = 1,
+    Readback = 2,
+    Count    = 3
+};
+
+// Busy time of a queue whose backend cannot measure it (e.g. no timestamps on the COPY queue).
+const double StreamUnknownSeconds = -1.0;
+
+// Splits a dataset of 'totalElements' into fixed-size chunks; the last one may be short.
+struct StreamChunking
+{
+    uint64_t totalElements = 0;
+    uint64_t chunkElements = 1;
+
+    uint32_t Count() const { return static_cast<uint32_t>((totalElements + chunkElements - 1) / chunkElements); }
+    uint64_t Offset(uint32_t chunk) const { return chunk * chunkElements; }
+    uint64_t Elements(uint32_t chunk) const { return (std::min)(chunkElements, totalElements - Offset(chunk)); }
+};
+
+// What the scheduler needs from an execution backend. Upload/Compute/Readback enqueue work on
+// their queue and return immediately; Signal/QueueWait are the GPU-side fence primitives and
+// HostWait blocks the calling (submission) thread.
+class StreamBackend
+{
+public:
+    virtual ~StreamBackend() {}
+
+    virtual uint32_t ChunkCount() const = 0;
+    virtual uint32_t SlotCount()  const = 0;
+    virtual uint64_t TotalBytes() const = 0;
+
+    // Host chunk -> staging slot -> device input slot.
+    virtual void Upload(uint32_t slot, uint32_t chunk) = 0;
+    // Device input slot -> kernel -> device output slot.
+    virtual void Compute(uint32_t slot, uint32_t chunk) = 0;
+    // Device output slot -> readback staging slot.
+    virtual void Readback(uint32_t slot, uint32_t chunk) = 0;
+    // Host: readback staging slot -> host output chunk. Only called once the readback has completed.
+    virtual void Retire(uint32_t slot, uint32_t chunk) = 0;
+
+    virtual uint64_t Signal(StreamQueue queue) = 0;
+    virtual void     QueueWait(StreamQueue waiter, StreamQueue signaller, uint64_t value) = 0;
+    virtual void     HostWait(StreamQueue queue, uint64_t value) = 0;
+
+    // Called around a run so backends can reset/collect per-queue busy time.
+    virtual void   BeginRun() {}
+    virtual void   EndRun() {}
+    // Seconds the queue spent executing work during the last run, StreamUnknownSeconds when unknown.
+    virtual double BusySeconds(StreamQueue queue) const = 0;
+};
+
+struct StreamRunResult
+{
+    double seconds = 0.0;
+    double busySeconds[static_cast<uint32_t>(StreamQueue::Count)] = {};
+
+    double ThroughputGBs(uint64_t bytes) const { return seconds > 0.0 ? bytes / seconds / 1024 / 1024 / 1024 : 0.0; }
+
+    bool BusyKnown() const
+    {
+        return busySeconds[0] >= 0.0 && busySeconds[1] >= 0.0 && busySeconds[2] >= 0.0;
+    }
+
+    // Time of the busiest queue: the best a perfectly overlapped pipeline could do.
+    // StreamUnknownSeconds unless every queue's busy time is known.
+    double BoundSeconds() const
+    {
+        if (!BusyKnown())
+        {
+            return StreamUnknownSeconds;
+        }
+        return (std::max)(busySeconds[0], (std::max)(busySeconds[1], busySeconds[2]));
+    }
+};
+
+// Overlap efficiency: 1.0 when the pipelined run is as fast as its slowest stage, 0.0 when it is no
+// faster than the serialized baseline. Negative if pipelining made things worse. Returns false, and
+// leaves 'efficiency' alone, when the serialized run's bound is unknown.
+inline bool StreamOverlapEfficiency(const StreamRunResult& serialized, const StreamRunResult& pipelined, double& efficiency)
+{
+    double bound = serialized.BoundSeconds();
+    if (bound < 0.0)
+    {
+        return false;
+    }
+    double headroom = serialized.seconds - bound;
+    efficiency = headroom > 0.0 ? (serialized.seconds - pipelined.seconds) / headroom : 0.0;
+    return true;
+}
+
+class StreamScheduler
+{
+public:
+
+    // Pipelined: chunk N+1 uploads while chunk N computes and chunk N-1 reads back, with one
+    // staging/device slot per chunk in flight (SlotCount() == 3 is classic triple buffering).
+    // Serialized: identical work and slots, but each upload (including its host memcpy into the
+    // staging slot) starts only after the previous chunk has been read back and retired.
+    static StreamRunResult Run(StreamBackend& backend, bool serialized)
+    {
+        const uint32_t chunkCount = backend.ChunkCount();
+        const uint32_t slotCount  = (std::max)(1u, backend.SlotCount());
+
+        std::vector<uint64_t> readbackFence(chunkCount, 0);
+        std::vector<bool>     retired(chunkCount, false);
+
+        backend.BeginRun();
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            const uint32_t slot = chunk % slotCount;
+
+            // Reusing a slot: everything chunk - slotCount did with it (upload, compute, readback)
+            // is finished once its readback fence passes, since the queues are chained by fences.
+            if (chunk >= slotCount && !retired[chunk - slotCount])
+            {
+                const uint32_t previous = chunk - slotCount;
+                backend.HostWait(StreamQueue::Readback, readbackFence[previous]);
+                backend.Retire(slot, previous);
+                retired[previous] = true;
+            }
+
+            // A GPU-side wait alone would still let Upload's memcpy overlap the previous chunk.
+            if (serialized && chunk > 0 && !retired[chunk - 1])
+            {
+                const uint32_t previous = chunk - 1;
+                backend.HostWait(StreamQueue::Readback, readbackFence[previous]);
+                backend.Retire(previous % slotCount, previous);
+                retired[previous] = true;
+            }
+            backend.Upload(slot, chunk);
+            uint64_t uploadFence = backend.Signal(StreamQueue::Upload);
+
+            backend.QueueWait(StreamQueue::Compute, StreamQueue::Upload, uploadFence);
+            backend.Compute(slot, chunk);
+            uint64_t computeFence = backend.Signal(StreamQueue::Compute);
+
+            backend.QueueWait(StreamQueue::Readback, StreamQueue::Compute, computeFence);
+            backend.Readback(slot, chunk);
+            readbackFence[chunk] = backend.Signal(StreamQueue::Readback);
+        }
+
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            if (!retired[chunk])
+            {
+                backend.HostWait(StreamQueue::Readback, readbackFence[chunk]);
+                backend.Retire(chunk % slotCount, chunk);
+            }
+        }
+
+        StreamRunResult result;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        backend.EndRun();
+        for (uint32_t q = 0; q < static_cast<uint32_t>(StreamQueue::Count); ++q)
+        {
+            result.busySeconds[q] = backend.BusySeconds(static_cast<StreamQueue>(q));
+        }
+        return result;
+    }
+};
@@ -0,0 +1,188 @@
+// Standalone check of StreamScheduler.h: the order in which the pipelined and serialized schedules
+// reuse slots and retire chunks, recorded by a synchronous backend; an end-to-end run against
+// CpuStreamBackend; and the bound/overlap arithmetic, including unknown busy times. No D3D12, not
+// part of any project; build and run on any machine with, e.g.
+//   g++ -std=c++14 -O2 -pthread StreamSchedulerCheck.cpp -o StreamSchedulerCheck && ./StreamSchedulerCheck
+// Exits with 1 if any check fails.
+
+#include "StreamScheduler.h"
+#include "CpuStreamBackend.h"
+#include <cstdio>
+#include <string>
+
+static int gFailures = 0;
+
+static void Check(bool passed, const char* what)
+{
+    printf("%s: %s\n", passed ? "PASS" : "FAIL", what);
+    gFailures += passed ? 0 : 1;
+}
+
+// Runs every call immediately and logs it, so the schedule's ordering can be inspected. Each queue's
+// fence completes as soon as it is signalled, as it would on an idle GPU.
+class RecordingBackend : public StreamBackend
+{
+public:
+
+    struct Event
+    {
+        char     stage;   // 'U'pload, 'C'ompute, 'R'eadback or re'T'ire
+        uint32_t slot;
+        uint32_t chunk;
+    };
+
+    RecordingBackend(uint32_t chunkCount, uint32_t slotCount) : mChunkCount(chunkCount), mSlotCount(slotCount) {}
+
+    uint32_t ChunkCount() const override { return mChunkCount; }
+    uint32_t SlotCount()  const override { return mSlotCount; }
+    uint64_t TotalBytes() const override { return mChunkCount * sizeof(float); }
+
+    void Upload(uint32_t slot, uint32_t chunk) override   { mEvents.push_back({ 'U', slot, chunk }); }
+    void Compute(uint32_t slot, uint32_t chunk) override  { mEvents.push_back({ 'C', slot, chunk }); }
+    void Readback(uint32_t slot, uint32_t chunk) override { mEvents.push_back({ 'R', slot, chunk }); }
+    void Retire(uint32_t slot, uint32_t chunk) override   { mEvents.push_back({ 'T', slot, chunk }); }
+
+    uint64_t Signal(StreamQueue queue) override { return ++mSignaled[static_cast<uint32_t>(queue)]; }
+    void     QueueWait(StreamQueue, StreamQueue, uint64_t) override {}
+    void     HostWait(StreamQueue queue, uint64_t value) override
+    {
+        mWaitedPastSignal |= value > mSignaled[static_cast<uint32_t>(queue)];
+    }
+
+    double BusySeconds(StreamQueue) const override { return StreamUnknownSeconds; }
+
+    const std::vector<Event>& Events() const { return mEvents; }
+    bool WaitedPastSignal() const { return mWaitedPastSignal; }
+
+    // Index of the first event with this stage and chunk, or the event count if there is none.
+    size_t Find(char stage, uint32_t chunk) const
+    {
+        for (size_t i = 0; i < mEvents.size(); ++i)
+        {
+            if (mEvents[i].stage == stage && mEvents[i].chunk == chunk)
+            {
+                return i;
+            }
+        }
+        return mEvents.size();
+    }
+
+private:
+    uint32_t           mChunkCount;
+    uint32_t           mSlotCount;
+    uint64_t           mSignaled[static_cast<uint32_t>(StreamQueue::Count)] = {};
+    std::vector<Event> mEvents;
+    bool               mWaitedPastSignal = false;
+};
+
+// Every chunk goes through U, C, R and T exactly once, in that order and in one slot, and a slot is
+// only uploaded into again after the chunk that last used it has been retired.
+static bool ScheduleIsConsistent(const RecordingBackend& backend)
+{
+    const std::vector<RecordingBackend::Event>& events = backend.Events();
+    if (events.size() != 4 * backend.ChunkCount() || backend.WaitedPastSignal())
+    {
+        return false;
+    }
+    for (uint32_t chunk = 0; chunk < backend.ChunkCount(); ++chunk)
+    {
+        size_t u = backend.Find('U', chunk);
+        size_t c = backend.Find('C', chunk);
+        size_t r = backend.Find('R', chunk);
+        size_t t = backend.Find('T', chunk);
+        if (!(u < c && c < r && r < t && t < events.size()))
+        {
+            return false;
+        }
+        uint32_t slot = events[u].slot;
+        if (events[c].slot != slot || events[r].slot != slot || events[t].slot != slot || slot != chunk % backend.SlotCount())
+        {
+            return false;
+        }
+        if (chunk >= backend.SlotCount() && backend.Find('T', chunk - backend.SlotCount()) > u)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void CheckSchedule()
+{
+    RecordingBackend pipelined(7, 3);
+    StreamScheduler::Run(pipelined, false);
+    Check(ScheduleIsConsistent(pipelined), "pipelined: stages in order, slots reused only after retire");
+    Check(pipelined.Find('U', 2) < pipelined.Find('T', 0), "pipelined: uploads run ahead of retires");
+
+    RecordingBackend serialized(7, 3);
+    StreamScheduler::Run(serialized, true);
+    Check(ScheduleIsConsistent(serialized), "serialized: stages in order, slots reused only after retire");
+    bool oneAtATime = true;
+    for (uint32_t chunk = 1; chunk < serialized.ChunkCount(); ++chunk)
+    {
+        oneAtATime &= serialized.Find('T', chunk - 1) < serialized.Find('U', chunk);
+    }
+    Check(oneAtATime, "serialized: each upload starts after the previous chunk is retired");
+
+    RecordingBackend single(4, 1);
+    StreamScheduler::Run(single, false);
+    Check(ScheduleIsConsistent(single), "one slot: consistent schedule");
+
+    RecordingBackend empty(0, 3);
+    StreamRunResult emptyResult = StreamScheduler::Run(empty, false);
+    Check(empty.Events().empty() && !emptyResult.BusyKnown(), "no chunks: no work, busy times unknown");
+}
+
+static void CheckCpuBackend()
+{
+    StreamChunking chunking;
+    chunking.totalElements = 1000;
+    chunking.chunkElements = 300;
+    Check(chunking.Count() == 4 && chunking.Offset(3) == 900 && chunking.Elements(3) == 100, "the last chunk is short");
+
+    // 1M floats in 100000-element chunks: the last of the 11 chunks is short.
+    CpuStreamBackend backend(1 << 20, 100000, 3, 8);
+    StreamRunResult pipelined = StreamScheduler::Run(backend, false);
+    Check(backend.ChunkCount() == 11 && backend.Verify() == 0, "pipelined run computes every element");
+    StreamRunResult serialized = StreamScheduler::Run(backend, true);
+    Check(backend.Verify() == 0, "serialized run computes every element");
+    Check(pipelined.BusyKnown() && serialized.BusyKnown() && serialized.BoundSeconds() > 0.0 && serialized.BoundSeconds() <= serialized.seconds,
+        "CPU busy times are known and bound the run");
+    double efficiency = 0.0;
+    Check(StreamOverlapEfficiency(serialized, pipelined, efficiency), "overlap efficiency is known for the CPU backend");
+}
+
+static void CheckOverlapArithmetic()
+{
+    StreamRunResult serialized;
+    serialized.seconds        = 10.0;
+    serialized.busySeconds[0] = 2.0;
+    serialized.busySeconds[1] = 5.0;
+    serialized.busySeconds[2] = 1.0;
+    Check(serialized.BoundSeconds() == 5.0, "the bound is the busiest queue");
+
+    StreamRunResult pipelined;
+    double efficiency = -2.0;
+    pipelined.seconds = 5.0;
+    Check(StreamOverlapEfficiency(serialized, pipelined, efficiency) && efficiency == 1.0, "running at the bound is 1.0");
+    pipelined.seconds = 10.0;
+    Check(StreamOverlapEfficiency(serialized, pipelined, efficiency) && efficiency == 0.0, "no faster than serialized is 0.0");
+    pipelined.seconds = 12.5;
+    Check(StreamOverlapEfficiency(serialized, pipelined, efficiency) && efficiency == -0.5, "slower than serialized is negative");
+
+    // A COPY queue without timestamps: its busy time, the bound and the efficiency are unknown rather than 0.
+    serialized.busySeconds[2] = StreamUnknownSeconds;
+    efficiency = 0.25;
+    Check(!serialized.BusyKnown() && serialized.BoundSeconds() < 0.0, "an unknown busy time makes the bound unknown");
+    Check(!StreamOverlapEfficiency(serialized, pipelined, efficiency) && efficiency == 0.25, "an unknown bound makes the efficiency unknown");
+}
+
+int main()
+{
+    CheckSchedule();
+    CheckCpuBackend();
+    CheckOverlapArithmetic();
+
+    printf("%d check(s) failed\n", gFailures);
+    return gFailures == 0 ? 0 : 1;
+}
@@ -9,6 +9,8 @@
 #include "d3dUtil.h"
 #include <string>
 #include <cassert>
+#include <cstdint>
+#include <algorithm>
 #include <DirectXMath.h>
 #if defined(DEBUG) || defined(_DEBUG)
 #define _CRTDBG_MAP_ALLOC
@@ -96,7 +98,27 @@ public:
 
         return gpuDuration;
     }
-    
+
+    // DoAction records the copy of a benchmark's results into its readback buffer only while
+    // CopyResults() is set.
+    void SetCopyResults(bool copyResults) { mCopyResults = copyResults; }
+    bool CopyResults() const { return mCopyResults; }
+
+    // Runs DoAction twice. The first run copies the results back when `copyResults` is set and is
+    // followed by `afterWarmUp`, which reads and validates them; it also warms up the PSO, caches
+    // and clocks. The second run never copies, so the readback is not part of the measurement, and
+    // its GPU time is returned.
+    template <typename AfterWarmUp>
+    double RunWarmedAndTimed(bool copyResults, AfterWarmUp afterWarmUp)
+    {
+        SetCopyResults(copyResults);
+        Dispatch();
+        afterWarmUp();
+        SetCopyResults(false);
+        Dispatch();
+        return GetDuration();
+    }
+
     ID3D12Device* Device() const
     {
         return md3dDevice.Get();
@@ -107,6 +129,35 @@ public:
         return mCommandList.Get();
     }
 
+    ID3D12CommandQueue* CommandQueue() const
+    {
+        return mCommandQueue.Get();
+    }
+
+    // A dispatch holds at most 65535 groups per dimension. DispatchGroups spills larger counts into
+    // Y; the kernels linearise the group id as y * GroupsX + x and skip the overhang of the last row.
+    static const uint32_t MaxGroupsX = 65535;
+
+    static uint32_t DivideRoundUp(uint32_t value, uint32_t divisor) { return (value + divisor - 1) / divisor; }
+
+    // X dimension DispatchGroups uses for `groups` groups; kernels need it to linearise the group id.
+    static uint32_t GroupsX(uint32_t groups) { return (std::min)((std::max)(groups, 1u), MaxGroupsX); }
+
+protected:
+
+    // Records a dispatch of `groups` groups (at least one) on GraphicsCommandList().
+    void DispatchGroups(uint32_t groups)
+    {
+        uint32_t groupsX = GroupsX(groups);
+        mCommandList->Dispatch(groupsX, DivideRoundUp((std::max)(groups, 1u), groupsX), 1);
+    }
+
+    void UavBarrier()
+    {
+        D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+        mCommandList->ResourceBarrier(1, &barrier);
+    }
+
 private:
 
 	void CreateSwapChainDepthBufferAndView()
@@ -331,6 +382,8 @@ private:
     Microsoft::WRL::ComPtr<ID3D12Resource>  mTimestampQueryReadbackBuffer;
     UINT64 mTimestampQueryBufferSize = 2 * sizeof(UINT64); // For two timestamps
 
+    bool mCopyResults = false;
+
     
 	static const int SwapChainBufferCount = 2;
 	int mCurrBackBuffer = -1;
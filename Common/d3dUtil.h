@@ -5,6 +5,7 @@
 #include <fstream>
 #include <comdef.h> // For _com_error
 #include <vector>
+#include <dxcapi.h>
 
 //#define AssertIfFailed(x) assert(SUCCEEDED(x))
 #define AssertIfFailed(x)                                         \
@@ -49,6 +50,78 @@ namespace D3DUtil
         return byteCode;
     }
 
+    // DXC path for shader model 6.x (wave intrinsics, 16-bit types, ResourceDescriptorHeap, ...), which
+    // FXC cannot target. dxcompiler.dll is loaded on first use so projects that only use CompileShader
+    // do not need it next to the executable.
+    inline ComPtr<ID3DBlob> CompileShaderDxc(
+        const std::wstring& filename,
+        const std::vector<std::wstring>& defines,
+        const std::wstring& entrypoint,
+        const std::wstring& target,
+        const std::vector<std::wstring>& extraArguments = {})
+    {
+        static DxcCreateInstanceProc createInstance = nullptr;
+        if (createInstance == nullptr)
+        {
+            HMODULE dxcModule = LoadLibraryW(L"dxcompiler.dll");
+            if (dxcModule != nullptr)
+            {
+                createInstance = reinterpret_cast<DxcCreateInstanceProc>(GetProcAddress(dxcModule, "DxcCreateInstance"));
+            }
+            if (createInstance == nullptr)
+            {
+                OutputDebugStringA("dxcompiler.dll not found, cannot compile shader model 6 shaders\n");
+                AssertIfFailed(HRESULT_FROM_WIN32(ERROR_MOD_NOT_FOUND));
+            }
+        }
+
+        ComPtr<IDxcUtils> utils;
+        ComPtr<IDxcCompiler3> compiler;
+        ComPtr<IDxcIncludeHandler> includeHandler;
+        AssertIfFailed(createInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils)));
+        AssertIfFailed(createInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler)));
+        AssertIfFailed(utils->CreateDefaultIncludeHandler(&includeHandler));
+
+        ComPtr<IDxcBlobEncoding> source;
+        AssertIfFailed(utils->LoadFile(filename.c_str(), nullptr, &source));
+
+        std::vector<LPCWSTR> arguments = { filename.c_str(), L"-E", entrypoint.c_str(), L"-T", target.c_str() };
+#if defined(DEBUG) || defined(_DEBUG)
+        arguments.push_back(DXC_ARG_DEBUG);
+        arguments.push_back(DXC_ARG_SKIP_OPTIMIZATIONS);
+#endif
+        for (const auto& define : defines)
+        {
+            arguments.push_back(L"-D");
+            arguments.push_back(define.c_str());
+        }
+        for (const auto& argument : extraArguments)
+        {
+            arguments.push_back(argument.c_str());
+        }
+
+        DxcBuffer sourceBuffer = { source->GetBufferPointer(), source->GetBufferSize(), DXC_CP_ACP };
+        ComPtr<IDxcResult> result;
+        AssertIfFailed(compiler->Compile(&sourceBuffer, arguments.data(), static_cast<UINT32>(arguments.size()), includeHandler.Get(), IID_PPV_ARGS(&result)));
+
+        ComPtr<IDxcBlobUtf8> errors;
+        result->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&errors), nullptr);
+        if (errors != nullptr && errors->GetStringLength() > 0)
+            OutputDebugStringA(errors->GetStringPointer());
+
+        HRESULT status = S_OK;
+        AssertIfFailed(result->GetStatus(&status));
+        AssertIfFailed(status);
+
+        // Copy into an ID3DBlob so callers (CreateComputePSO, ...) treat both compilers the same.
+        ComPtr<IDxcBlob> object;
+        AssertIfFailed(result->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&object), nullptr));
+        ComPtr<ID3DBlob> byteCode;
+        AssertIfFailed(D3DCreateBlob(object->GetBufferSize(), byteCode.GetAddressOf()));
+        memcpy(byteCode->GetBufferPointer(), object->GetBufferPointer(), object->GetBufferSize());
+        return byteCode;
+    }
+
     static Microsoft::WRL::ComPtr<ID3DBlob> LoadBinary(const std::wstring& filename)
     {
 		std::ifstream fin(filename, std::ios::binary);
@@ -118,6 +191,119 @@ namespace D3DUtil
 		return defaultBuffer;
     }
 
+	// Texture2D counterpart of CreateDefaultBuffer: one mip, tightly packed rows in initData (the upload
+	// pitch alignment is handled by UpdateSubresources), left in finalState. A non-default layout
+	// needs the heap flags that go with it (ROW_MAJOR: shared cross-adapter).
+	inline ComPtr<ID3D12Resource> CreateDefaultTexture2D(
+		ID3D12Device* device,
+		ID3D12GraphicsCommandList* cmdList,
+		const void* initData,
+		UINT width,
+		UINT height,
+		DXGI_FORMAT format,
+		UINT bytesPerPixel,
+		D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE,
+		D3D12_RESOURCE_STATES finalState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+		D3D12_TEXTURE_LAYOUT layout = D3D12_TEXTURE_LAYOUT_UNKNOWN,
+		D3D12_HEAP_FLAGS heapFlags = D3D12_HEAP_FLAG_NONE)
+	{
+		ComPtr<ID3D12Resource> texture;
+		ComPtr<ID3D12Resource> uploadBuffer;
+		D3D12_HEAP_PROPERTIES defaultHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+		D3D12_HEAP_PROPERTIES uploadHeap  = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+		D3D12_RESOURCE_DESC   textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(format, width, height, 1, 1, 1, 0, flags, layout);
+		AssertIfFailed(device->CreateCommittedResource(
+			&defaultHeap,
+			heapFlags,
+			&textureDesc,
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			nullptr,
+			IID_PPV_ARGS(texture.GetAddressOf())));
+
+		D3D12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(GetRequiredIntermediateSize(texture.Get(), 0, 1));
+		AssertIfFailed(device->CreateCommittedResource(
+			&uploadHeap,
+			D3D12_HEAP_FLAG_NONE,
+			&uploadDesc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
+
+		g_uploadBuffers.push_back(uploadBuffer);
+
+		D3D12_SUBRESOURCE_DATA subResourceData = {};
+		subResourceData.pData      = initData;
+		subResourceData.RowPitch   = static_cast<LONG_PTR>(width) * bytesPerPixel;
+		subResourceData.SlicePitch = subResourceData.RowPitch * height;
+
+		UpdateSubresources<1>(cmdList, texture.Get(), uploadBuffer.Get(), 0, 0, 1, &subResourceData);
+
+		D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(texture.Get(), D3D12_RESOURCE_STATE_COPY_DEST, finalState);
+		cmdList->ResourceBarrier(1, &barrier);
+		return texture;
+	}
+
+	inline ComPtr<ID3D12Resource> CreateBuffer(
+		ID3D12Device* device,
+		D3D12_HEAP_TYPE heapType,
+		UINT64 byteSize,
+		D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE,
+		D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COMMON)
+	{
+		ComPtr<ID3D12Resource> buffer;
+		D3D12_HEAP_PROPERTIES heapProps  = CD3DX12_HEAP_PROPERTIES(heapType);
+		D3D12_RESOURCE_DESC   bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize, flags);
+		AssertIfFailed(device->CreateCommittedResource(
+			&heapProps,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			initialState,
+			nullptr,
+			IID_PPV_ARGS(buffer.GetAddressOf())));
+		return buffer;
+	}
+
+	inline ComPtr<ID3D12RootSignature> CreateRootSignature(
+		ID3D12Device* device,
+		const CD3DX12_ROOT_SIGNATURE_DESC& rootSigDesc)
+	{
+		ComPtr<ID3DBlob> serializedRootSig = nullptr;
+		ComPtr<ID3DBlob> errorBlob = nullptr;
+		HRESULT hr = D3D12SerializeRootSignature(&rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, serializedRootSig.GetAddressOf(), errorBlob.GetAddressOf());
+		if (errorBlob != nullptr)
+		{
+			::OutputDebugStringA((char*)errorBlob->GetBufferPointer());
+		}
+		AssertIfFailed(hr);
+
+		ComPtr<ID3D12RootSignature> rootSignature;
+		AssertIfFailed(device->CreateRootSignature(
+			0,
+			serializedRootSig->GetBufferPointer(),
+			serializedRootSig->GetBufferSize(),
+			IID_PPV_ARGS(rootSignature.GetAddressOf())));
+		return rootSignature;
+	}
+
+	inline ComPtr<ID3D12PipelineState> CreateComputePSO(
+		ID3D12Device* device,
+		ID3D12RootSignature* rootSignature,
+		ID3DBlob* shader)
+	{
+		D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {};
+		computePsoDesc.pRootSignature = rootSignature;
+		computePsoDesc.CS =
+		{
+			reinterpret_cast<BYTE*>(shader->GetBufferPointer()),
+			shader->GetBufferSize()
+		};
+		computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+		ComPtr<ID3D12PipelineState> pso;
+		AssertIfFailed(device->CreateComputePipelineState(&computePsoDesc, IID_PPV_ARGS(&pso)));
+		return pso;
+	}
+
 	std::wstring StringToWString(const std::string& str) {
 		return std::wstring(str.begin(), str.end());
 	}
@@ -0,0 +1,217 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "CommandContext.h"
+#include "CpuTimer.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Fixed costs that dominate small transfers, each measured 'count' times.
+enum OverheadTest : uint32_t {
+    EmptyDispatch     = 0,  // Dispatch(1,1,1) of an empty kernel, back to back in one command list
+    RootArguments     = 1,  // CBV/SRV/UAV root descriptors re-set before every dispatch (GpuCopy::DoAction pattern)
+    ExecuteLatency    = 2,  // ExecuteCommandLists + Signal -> CPU sees the fence, one small list per submission
+    ResetClose        = 3,  // ID3D12GraphicsCommandList::Reset + Close of an empty list (CPU only)
+    OverheadTestCount
+};
+
+inline const char* OverheadTestName(OverheadTest test)
+{
+    switch (test)
+    {
+    case OverheadTest::EmptyDispatch:  return "EmptyDispatch";
+    case OverheadTest::RootArguments:  return "RootArguments";
+    case OverheadTest::ExecuteLatency: return "ExecuteLatency";
+    case OverheadTest::ResetClose:     return "ResetClose";
+    default:                           return "Unknown";
+    }
+}
+
+struct OverheadResult
+{
+    double gpuNsPerOp = 0.0;  // GPU timestamps, 0 when the test has no GPU-side component
+    double cpuNsPerOp = 0.0;  // QPC around the CPU-side work being measured
+};
+
+class DispatchOverhead : public D3DAppSimplified
+{
+public:
+
+	struct ConstBuffer
+	{
+		uint32_t ElementCount;
+		uint32_t Pad0;
+		uint32_t Pad1;
+		uint32_t Pad2;
+	};
+
+    DispatchOverhead(HINSTANCE hInstance, uint32_t count, D3D12_COMMAND_LIST_TYPE queueType) :
+		D3DAppSimplified(hInstance),
+		m_count(count),
+		m_queueType(queueType)
+	{
+    }
+
+    void BuildResourcesAndHeaps() override {
+		// Two sets of bindings so RootArguments really changes the root descriptors every time.
+		for (uint32_t set = 0; set < 2; ++set)
+		{
+			ConstBuffer cb = { 0, 0, 0, 0 };
+			mConstBuffer[set] = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_UPLOAD, 256, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ);
+			void* mapped = nullptr;
+			AssertIfFailed(mConstBuffer[set]->Map(0, nullptr, &mapped));
+			memcpy(mapped, &cb, sizeof(cb));
+			mConstBuffer[set]->Unmap(0, nullptr);
+
+			mInputBuffer[set]  = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, 256);
+			mOutputBuffer[set] = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, 256, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		}
+
+		// ExecuteLatency needs a begin/end pair per submission.
+		mContext.Initialize(Device(), m_queueType, 2 * m_count);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		mShaders = D3DUtil::CompileShader(L"Shaders\\EmptyKernel.hlsl", nullptr, "main", "cs_5_0");
+	}
+
+    void BuildPSOs() override {
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstantBufferView(0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO           = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders.Get());
+    }
+
+	// Every test drives mContext directly so that it controls exactly what lands in each list.
+    void DoAction() override { }
+
+	OverheadResult Run(OverheadTest test)
+	{
+		switch (test)
+		{
+		case OverheadTest::EmptyDispatch:  return RunDispatches(false);
+		case OverheadTest::RootArguments:  return RunDispatches(true);
+		case OverheadTest::ExecuteLatency: return RunExecuteLatency();
+		case OverheadTest::ResetClose:     return RunResetClose();
+		default:                           return OverheadResult();
+		}
+	}
+
+private:
+
+	void SetRootArguments(ID3D12GraphicsCommandList* commandList, uint32_t set)
+	{
+		commandList->SetComputeRootConstantBufferView(0, mConstBuffer[set]->GetGPUVirtualAddress());
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer[set]->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer[set]->GetGPUVirtualAddress());
+	}
+
+	// 'count' dispatches between two timestamps; CPU time is the recording of those dispatches.
+	OverheadResult RunDispatches(bool changeRootArguments)
+	{
+		auto commandList = mContext.CommandList();
+		mContext.Reset(0, mPSO.Get());
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		SetRootArguments(commandList, 0);
+		mContext.Timestamp(0);
+
+		CpuTimer timer;
+		timer.Start();
+		for (uint32_t i = 0; i < m_count; ++i)
+		{
+			if (changeRootArguments)
+			{
+				SetRootArguments(commandList, i & 1);
+			}
+			commandList->Dispatch(1, 1, 1);
+		}
+		double cpuSeconds = timer.Stop();
+
+		mContext.Timestamp(1);
+		mContext.ResolveTimestamps(2);
+		mContext.SubmitAndFlush();
+
+		OverheadResult result;
+		result.gpuNsPerOp = mContext.ElapsedSeconds(0, 1) * 1e9 / m_count;
+		result.cpuNsPerOp = cpuSeconds * 1e9 / m_count;
+		return result;
+	}
+
+	// One closed list with a single dispatch per submission. CPU time runs from ExecuteCommandLists to
+	// the CPU observing the fence; GPU time is what the dispatch itself took inside the list, so the
+	// difference is the submission/signal/wake-up round trip.
+	OverheadResult RunExecuteLatency()
+	{
+		auto commandList = mContext.CommandList();
+		ID3D12CommandList* cmdsLists[] = { commandList };
+
+		double cpuSeconds = 0.0;
+		for (uint32_t i = 0; i < m_count; ++i)
+		{
+			mContext.Reset(0, mPSO.Get());
+			commandList->SetComputeRootSignature(mRootSignature.Get());
+			SetRootArguments(commandList, 0);
+			mContext.Timestamp(2 * i);
+			commandList->Dispatch(1, 1, 1);
+			mContext.Timestamp(2 * i + 1);
+			mContext.ResolveTimestamps(2, 2 * i);
+			AssertIfFailed(commandList->Close());
+
+			CpuTimer timer;
+			timer.Start();
+			mContext.Queue()->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+			mContext.Flush();
+			cpuSeconds += timer.Stop();
+		}
+
+		std::vector<UINT64> ticks = mContext.ReadTimestamps(2 * m_count);
+		double gpuTicks = 0.0;
+		for (uint32_t i = 0; i < m_count; ++i)
+		{
+			gpuTicks += static_cast<double>(ticks[2 * i + 1] - ticks[2 * i]);
+		}
+
+		OverheadResult result;
+		result.gpuNsPerOp = gpuTicks / mContext.TimestampFrequency() * 1e9 / m_count;
+		result.cpuNsPerOp = cpuSeconds * 1e9 / m_count;
+		return result;
+	}
+
+	// The allocator is reset once; each iteration is a bare Reset + Close of the same list.
+	OverheadResult RunResetClose()
+	{
+		auto commandList = mContext.CommandList();
+		ID3D12CommandAllocator* allocator = mContext.Allocator(0);
+		AssertIfFailed(allocator->Reset());
+
+		CpuTimer timer;
+		timer.Start();
+		for (uint32_t i = 0; i < m_count; ++i)
+		{
+			commandList->Reset(allocator, mPSO.Get());
+			commandList->Close();
+		}
+		double cpuSeconds = timer.Stop();
+
+		OverheadResult result;
+		result.cpuNsPerOp = cpuSeconds * 1e9 / m_count;
+		return result;
+	}
+
+    ComPtr<ID3DBlob> mShaders;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	ComPtr<ID3D12Resource> mConstBuffer[2];
+	ComPtr<ID3D12Resource> mInputBuffer[2];
+	ComPtr<ID3D12Resource> mOutputBuffer[2];
+
+	CommandContext mContext;
+
+	uint32_t                m_count;
+	D3D12_COMMAND_LIST_TYPE m_queueType;
+};
@@ -0,0 +1,85 @@
+#include "d3dAppSimplified.h"
+#include "DispatchOverhead.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	OverheadTest test  = OverheadTest::EmptyDispatch;
+	int          count = 1000;
+	int          queue = 0;
+
+	// Usage: program.exe <test> <count> <queue>
+	// test:  0=EmptyDispatch, 1=RootArguments, 2=ExecuteLatency, 3=ResetClose
+	// queue: 0=DIRECT, 1=COMPUTE
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			test = static_cast<OverheadTest>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			count = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			queue = _wtoi(argv[3]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: test=%d, count=%d, queue=%d\n", static_cast<int>(test), count, queue);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (test >= OverheadTest::OverheadTestCount)
+	{
+		OutputDebugStringA("ERROR: Unknown overhead test!\n");
+		return 1;
+	}
+	if (count <= 0)
+	{
+		OutputDebugStringA("ERROR: Count must be positive!\n");
+		return 1;
+	}
+
+	D3D12_COMMAND_LIST_TYPE queueType = queue == 1 ? D3D12_COMMAND_LIST_TYPE_COMPUTE : D3D12_COMMAND_LIST_TYPE_DIRECT;
+	const char* queueName = queue == 1 ? "COMPUTE" : "DIRECT";
+
+	DispatchOverhead app(hInstance, static_cast<uint32_t>(count), queueType);
+	app.Initialize();
+
+	// First run pays for PSO/driver warm-up; time the second one.
+	app.Run(test);
+	OverheadResult result = app.Run(test);
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Test: " << OverheadTestName(test) << " on " << queueName << " queue, count " << count << "\n";
+	debugOutput << "GPU: " << result.gpuNsPerOp << " ns/op\n";
+	debugOutput << "CPU: " << result.cpuNsPerOp << " ns/op\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("dispatch_overhead_results.csv", "Test,TestName,Queue,Count,GpuNsPerOp,CpuNsPerOp", QueryDeviceCaps(app.Device()).Describe());
+	csv.Row(static_cast<int>(test), OverheadTestName(test), queueName, count, result.gpuNsPerOp, result.cpuNsPerOp);
+    return 0;
+}
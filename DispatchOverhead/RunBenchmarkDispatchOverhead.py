@@ -0,0 +1,76 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+TESTS = {
+    0: "EmptyDispatch",
+    1: "RootArguments",
+    2: "ExecuteLatency",
+    3: "ResetClose",
+}
+
+QUEUES = {
+    0: "DIRECT",
+    1: "COMPUTE",
+}
+
+def run_simple_test(tryCount = 4):
+    """Measures every fixed-cost test on both queue types"""
+
+    program = "..\\x64\\Release\\DispatchOverhead.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "dispatch_overhead_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for test in TESTS:
+        # ExecuteLatency does one round trip per op, keep it short
+        count = 200 if test == 2 else 10000
+        for queue in QUEUES:
+            print(f"\nRunning {TESTS[test]} on {QUEUES[queue]}...")
+            for i in range(tryCount):
+                time.sleep(0.01)
+                try:
+                    result = subprocess.run([
+                        program,
+                        str(test),
+                        str(count),
+                        str(queue)
+                    ], capture_output=True, text=True)
+                    print(f"  Run {i+1}: {result.stdout.strip()}")
+                except Exception as e:
+                    print(f"  Run {i+1}: Error - {e}")
+
+def plot_overhead_results(filename):
+    gpu = {}
+    cpu = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = f"{parts[1]}\n{parts[2]}"
+            gpu.setdefault(key, []).append(float(parts[4]))
+            cpu.setdefault(key, []).append(float(parts[5]))
+
+    keys = sorted(gpu.keys())
+    x = range(len(keys))
+    plt.bar([i - 0.2 for i in x], [min(gpu[k]) for k in keys], width=0.4, label='GPU (timestamps)')
+    plt.bar([i + 0.2 for i in x], [min(cpu[k]) for k in keys], width=0.4, label='CPU (QPC)')
+    plt.xticks(list(x), keys, fontsize=7)
+    plt.yscale('log')
+    plt.ylabel('ns / op (best run)')
+    plt.title('Dispatch and Submission Overhead')
+    plt.legend()
+    plt.grid(True, axis='y')
+    plt.savefig('DispatchOverhead.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_overhead_results("dispatch_overhead_results.csv")
@@ -0,0 +1,25 @@
+StructuredBuffer<float>   Input  : register(t0);
+RWStructuredBuffer<float> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint ElementCount;  // always 0: the kernel touches its bindings but does no memory work
+    uint Pad0;
+    uint Pad1;
+    uint Pad2;
+}
+
+static const uint NumThreads = 64;
+
+// Same bindings as LinearCopy.hlsl so that root-argument changes are consumed by a real shader,
+// but with ElementCount == 0 every thread exits immediately and a dispatch costs only its fixed overhead.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    const uint id = groupId.x * NumThreads + threadId.x;
+
+    if (id < ElementCount)
+    {
+        Output[id] = Input[id];
+    }
+}
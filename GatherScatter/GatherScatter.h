@@ -0,0 +1,187 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "IndexPatterns.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum AccessMode : uint32_t {
+    LinearAccess  = 0,
+    GatherAccess  = 1,
+    ScatterAccess = 2,
+    AccessModeCount
+};
+
+inline const char* AccessModeName(AccessMode mode)
+{
+    switch (mode)
+    {
+    case AccessMode::LinearAccess:  return "Linear";
+    case AccessMode::GatherAccess:  return "Gather";
+    case AccessMode::ScatterAccess: return "Scatter";
+    default:                        return "Unknown";
+    }
+}
+
+// Gather or scatter of `elements` 32-bit values through an index buffer (Shaders/GatherScatter.hlsl).
+// The linear copy of the same buffers is built alongside: SetRunBaseline(true) makes Dispatch() time
+// it instead, so both numbers come from one process and one set of allocations. In[i] = i, which
+// lets the host check every output against the index stream.
+class GatherScatter : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Count;
+		uint32_t GroupsX;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t NumThreads = 256;
+
+    GatherScatter(HINSTANCE hInstance, AccessMode mode, IndexPattern pattern, uint32_t elements, uint32_t locality) :
+		D3DAppSimplified(hInstance),
+		m_mode(mode),
+		m_pattern(pattern),
+		m_elements(elements)
+	{
+		mHostIndices = IndexPatterns::Make(pattern, elements, locality);
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		std::vector<uint32_t> input(m_elements);
+		for (uint32_t i = 0; i < m_elements; ++i)
+		{
+			input[i] = i;
+		}
+		mInputBuffer  = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), input.data(), Bytes());
+		mIndexBuffer  = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostIndices.data(), Bytes());
+		mOutputBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, Bytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, Bytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		mShaders[0] = D3DUtil::CompileShaderDxc(L"Shaders\\GatherScatter.hlsl", { L"MODE=0" }, L"main", L"cs_6_0");
+		mShaders[1] = D3DUtil::CompileShaderDxc(L"Shaders\\GatherScatter.hlsl", { L"MODE=" + std::to_wstring(static_cast<uint32_t>(m_mode)) },
+			L"main", L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[4];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsShaderResourceView(1);
+		slotRootParameter[3].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(4, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		for (int i = 0; i < 2; ++i)
+		{
+			mPSOs[i] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[i].Get());
+		}
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		uint32_t groups  = DivideRoundUp(m_elements, NumThreads);
+		RootConstants constants = { m_elements, GroupsX(groups), 0, 0 };
+
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSOs[m_runBaseline ? 0 : 1].Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootShaderResourceView(2, mIndexBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(3, mOutputBuffer->GetGPUVirtualAddress());
+		DispatchGroups(groups);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, Bytes());
+		}
+    }
+
+	void SetRunBaseline(bool runBaseline) { m_runBaseline = runBaseline; }
+
+	bool   Supported() const { return m_supported; }
+	UINT64 Bytes()     const { return static_cast<UINT64>(m_elements) * sizeof(uint32_t); }
+	// Bytes the kernel has to move at minimum: the copy reads and writes every element once, gather
+	// and scatter also read the index.
+	UINT64 UsefulBytes(bool baseline) const { return Bytes() * (baseline || m_mode == AccessMode::LinearAccess ? 2 : 3); }
+	const std::vector<uint32_t>& HostIndices() const { return mHostIndices; }
+
+	// Mismatching elements of the last Dispatch() with SetCopyResults(true). Gather: Out[i] must be
+	// Idx[i]. Scatter: Out[Idx[i]] must be one of the i that target it. Copy: Out[i] must be i.
+	uint32_t Validate()
+	{
+		uint32_t* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(Bytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < m_elements; ++i)
+		{
+			switch (m_runBaseline ? AccessMode::LinearAccess : m_mode)
+			{
+			case AccessMode::GatherAccess:
+				mismatches += mapped[i] != mHostIndices[i] ? 1 : 0;
+				break;
+			case AccessMode::ScatterAccess:
+			{
+				uint32_t writer = mapped[mHostIndices[i]];
+				mismatches += writer >= m_elements || mHostIndices[writer] != mHostIndices[i] ? 1 : 0;
+				break;
+			}
+			default:
+				mismatches += mapped[i] != i ? 1 : 0;
+				break;
+			}
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShaders[2];
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[2];   // [0] linear copy baseline, [1] the selected mode
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mIndexBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<uint32_t> mHostIndices;
+
+	AccessMode   m_mode;
+	IndexPattern m_pattern;
+	uint32_t     m_elements;
+	bool         m_runBaseline = false;
+	bool         m_supported   = false;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+// Index streams for the gather/scatter kernels and a coalescing model of what they cost. No D3D
+// dependency.
+
+#include "Hash.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+enum IndexPattern : uint32_t {
+    RandomIndices      = 0,  // random permutation of [0, N)
+    BlockRandomIndices = 1,  // identity, with every block of `locality` elements shuffled in place
+    SortedIndices      = 2,  // N random draws from [0, N), sorted: monotonic with gaps and repeats
+    DuplicateIndices   = 3,  // random draws from N / locality targets: each is hit ~locality times
+    IndexPatternCount
+};
+
+inline const char* IndexPatternName(IndexPattern pattern)
+{
+    switch (pattern)
+    {
+    case IndexPattern::RandomIndices:      return "Random";
+    case IndexPattern::BlockRandomIndices: return "BlockRandom";
+    case IndexPattern::SortedIndices:      return "Sorted";
+    case IndexPattern::DuplicateIndices:   return "Duplicates";
+    default:                               return "Unknown";
+    }
+}
+
+namespace IndexPatterns
+{
+    // Fisher-Yates over [begin, end) with a deterministic hash stream.
+    inline void Shuffle(std::vector<uint32_t>& indices, size_t begin, size_t end, uint64_t seed)
+    {
+        for (size_t i = end - begin; i > 1; --i)
+        {
+            size_t j = static_cast<size_t>(Hash64(seed + i) % i);
+            std::swap(indices[begin + i - 1], indices[begin + j]);
+        }
+    }
+
+    inline std::vector<uint32_t> Make(IndexPattern pattern, uint32_t count, uint32_t locality)
+    {
+        std::vector<uint32_t> indices(count);
+        locality = (std::max)(locality, 1u);
+        switch (pattern)
+        {
+        case IndexPattern::RandomIndices:
+        case IndexPattern::BlockRandomIndices:
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                indices[i] = i;
+            }
+            size_t block = pattern == IndexPattern::RandomIndices ? count : locality;
+            for (size_t begin = 0; begin < count; begin += block)
+            {
+                Shuffle(indices, begin, (std::min)(begin + block, static_cast<size_t>(count)), begin * 0x632BE59BD9B4E019ull);
+            }
+            break;
+        }
+        case IndexPattern::SortedIndices:
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                indices[i] = static_cast<uint32_t>(Hash64(i) % count);
+            }
+            std::sort(indices.begin(), indices.end());
+            break;
+        default:
+        {
+            uint32_t targets = (std::max)(count / locality, 1u);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                indices[i] = static_cast<uint32_t>(Hash64(i) % targets);
+            }
+            break;
+        }
+        }
+        return indices;
+    }
+
+    struct Coalescing
+    {
+        double linesPerWave;      // distinct cache lines one wave's accesses touch
+        double lineUtilization;   // distinct requested bytes / bytes of the lines touched, per wave
+        double footprintLines;    // distinct lines over the whole stream (what an infinite cache fetches)
+    };
+
+    // Every `waveSize` consecutive indices are one wave-wide access of `elementBytes` each; a
+    // linear access touches waveSize * elementBytes / lineBytes lines and uses all of them. Lanes
+    // that hit the same element share one request, so duplicates do not add to the utilization.
+    // Elements larger than a line count as one line each.
+    inline Coalescing Model(const std::vector<uint32_t>& indices, uint32_t elementBytes, uint32_t lineBytes, uint32_t waveSize)
+    {
+        const uint32_t elementsPerLine = (std::max)(1u, lineBytes / (std::max)(1u, elementBytes));
+        const uint32_t usedBytes       = (std::min)(elementBytes, lineBytes);
+        uint64_t waveLines    = 0;
+        uint64_t waveElements = 0;
+        uint64_t waves        = 0;
+        std::vector<uint32_t> elements;
+        elements.reserve(waveSize);
+        for (size_t begin = 0; begin < indices.size(); begin += waveSize)
+        {
+            size_t end = (std::min)(begin + waveSize, indices.size());
+            elements.assign(indices.begin() + begin, indices.begin() + end);
+            std::sort(elements.begin(), elements.end());
+            elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+            // Sorted elements give sorted lines, so each new line is a change from the previous one.
+            for (size_t i = 0; i < elements.size(); ++i)
+            {
+                waveLines += i == 0 || elements[i] / elementsPerLine != elements[i - 1] / elementsPerLine ? 1 : 0;
+            }
+            waveElements += elements.size();
+            ++waves;
+        }
+
+        std::vector<bool> touched;
+        uint64_t footprint = 0;
+        for (uint32_t index : indices)
+        {
+            size_t line = index / elementsPerLine;
+            if (line >= touched.size())
+            {
+                touched.resize((std::max)(line + 1, touched.size() * 2), false);
+            }
+            footprint += touched[line] ? 0 : 1;
+            touched[line] = true;
+        }
+
+        Coalescing result;
+        result.linesPerWave    = waves == 0 ? 0.0 : static_cast<double>(waveLines) / waves;
+        result.lineUtilization = waveLines == 0 ? 0.0 : static_cast<double>(waveElements) * usedBytes / (static_cast<double>(waveLines) * lineBytes);
+        result.footprintLines  = static_cast<double>(footprint);
+        return result;
+    }
+}
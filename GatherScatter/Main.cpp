@@ -0,0 +1,134 @@
+#include "d3dAppSimplified.h"
+#include "GatherScatter.h"
+#include "IndexPatterns.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	AccessMode   mode      = AccessMode::GatherAccess;
+	IndexPattern pattern   = IndexPattern::RandomIndices;
+	int          elements  = 1 << 24;
+	int          locality  = 256;
+	int          lineBytes = 128;
+	int          waveSize  = 64;
+	int          validate  = 1;
+
+	// Usage: program.exe <mode> <pattern> <elements> <locality> <lineBytes> <waveSize> <validate>
+	// mode: 0=Linear, 1=Gather, 2=Scatter   pattern: 0=Random, 1=BlockRandom, 2=Sorted, 3=Duplicates
+	// locality: BlockRandom shuffle window / Duplicates hits per target   lineBytes, waveSize: coalescing model
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			mode = static_cast<AccessMode>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			pattern = static_cast<IndexPattern>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			elements = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			locality = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			lineBytes = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			waveSize = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			validate = _wtoi(argv[7]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: mode=%d, pattern=%d, elements=%d, locality=%d, lineBytes=%d, waveSize=%d, validate=%d\n",
+			static_cast<int>(mode), static_cast<int>(pattern), elements, locality, lineBytes, waveSize, validate);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (mode >= AccessMode::AccessModeCount || pattern >= IndexPattern::IndexPatternCount)
+	{
+		OutputDebugStringA("ERROR: Unknown mode or pattern!\n");
+		return 1;
+	}
+	if (elements <= 0 || elements > (1 << 29) || locality <= 0 || lineBytes < 4 || (lineBytes & (lineBytes - 1)) != 0 || waveSize <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	GatherScatter test(hInstance, mode, pattern, static_cast<uint32_t>(elements), static_cast<uint32_t>(locality));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: GatherScatter needs shader model 6.0!\n");
+		return 1;
+	}
+
+	uint32_t mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		mismatches = validate != 0 ? test.Validate() : 0;
+	});
+	double gpuGBs     = test.UsefulBytes(false) / gpuSeconds / 1e9;
+
+	test.SetRunBaseline(true);
+	test.Dispatch();
+	test.Dispatch();
+	double copySeconds = test.GetDuration();
+	double copyGBs     = test.UsefulBytes(true) / copySeconds / 1e9;
+
+	// Coalescing of the indexed side (gather reads, scatter writes); linear access uses every line.
+	IndexPatterns::Coalescing model = { static_cast<double>(waveSize) * sizeof(uint32_t) / lineBytes, 1.0,
+		static_cast<double>(test.Bytes()) / lineBytes };
+	if (mode != AccessMode::LinearAccess)
+	{
+		model = IndexPatterns::Model(test.HostIndices(), sizeof(uint32_t), static_cast<uint32_t>(lineBytes), static_cast<uint32_t>(waveSize));
+	}
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Mode: " << AccessModeName(mode) << " Pattern: " << IndexPatternName(pattern) << " Elements: " << elements
+		<< " Locality: " << locality << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGBs << " GB/s effective, " << gpuGBs / copyGBs * 100.0 << "% of linear copy)\n";
+	debugOutput << "Linear copy: " << copySeconds << " seconds (" << copyGBs << " GB/s)\n";
+	debugOutput << "Model (" << lineBytes << "B lines, " << waveSize << "-wide waves): " << model.linesPerWave << " lines/wave, "
+		<< model.lineUtilization * 100.0 << "% line utilization, footprint " << model.footprintLines << " lines\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("gather_scatter_results.csv", "Mode,Pattern,Elements,Locality,Gpu_s,Gpu_GBs,Copy_s,Copy_GBs,FractionOfCopy,LineBytes,WaveSize,LinesPerWave,LineUtilization,FootprintLines,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(AccessModeName(mode), IndexPatternName(pattern), elements, locality, gpuSeconds, gpuGBs, copySeconds, copyGBs, gpuGBs / copyGBs,
+		lineBytes, waveSize, model.linesPerWave, model.lineUtilization, model.footprintLines, validate, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+MODES = {
+    1: "Gather",
+    2: "Scatter",
+}
+
+PATTERNS = {
+    0: "Random",
+    1: "BlockRandom",
+    2: "Sorted",
+    3: "Duplicates",
+}
+
+# BlockRandom shuffle windows / Duplicates hits per target; Random and Sorted ignore it.
+LOCALITIES = [32, 256, 4096, 65536, 1048576]
+
+def run_simple_test(elements = 1 << 24, tryCount = 3):
+    """Runs gather and scatter over every index pattern, sweeping the locality window where it applies"""
+
+    program = "..\\x64\\Release\\GatherScatter.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "gather_scatter_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for mode in MODES:
+        for pattern in PATTERNS:
+            localities = LOCALITIES if pattern in (1, 3) else [1]
+            for locality in localities:
+                print(f"\nRunning {MODES[mode]} {PATTERNS[pattern]} locality {locality}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(mode),
+                            str(pattern),
+                            str(elements),
+                            str(locality),
+                            "128",
+                            "64",
+                            # Validate the first run of each configuration only.
+                            "1" if i == 0 else "0"
+                        ], capture_output=True, text=True)
+                        if result.returncode != 0:
+                            print(f"  Run {i+1}: failed or mismatched (exit {result.returncode})")
+                        else:
+                            print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_gather_scatter_results(filename):
+    measured = {}
+    model = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            label = f"{parts[0]} {parts[1]}" + (f" {parts[3]}" if parts[1] in ("BlockRandom", "Duplicates") else "")
+            measured.setdefault(label, []).append(float(parts[8]) * 100.0)
+            model[label] = float(parts[12]) * 100.0
+
+    labels = list(measured)
+    x = range(len(labels))
+    plt.bar([i - 0.2 for i in x], [max(measured[l]) for l in labels], width=0.4, label='Measured (% of linear copy GB/s)')
+    plt.bar([i + 0.2 for i in x], [model[l] for l in labels], width=0.4, label='Modelled cache-line utilization (%)')
+    plt.xticks(x, labels, rotation=60, ha='right', fontsize=6)
+    plt.ylabel('%')
+    plt.title('Gather/Scatter vs Linear Copy')
+    plt.legend(fontsize=7)
+    plt.grid(True, axis='y')
+    plt.tight_layout()
+    plt.savefig('GatherScatter.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_gather_scatter_results("gather_scatter_results.csv")
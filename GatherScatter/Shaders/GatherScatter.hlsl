@@ -0,0 +1,35 @@
+// Index-driven memory access. Compiled with DXC (cs_6_0); the kernel is selected by MODE:
+//   0  Out[i] = In[i]          linear copy, the baseline
+//   1  Out[i] = In[Idx[i]]     gather
+//   2  Out[Idx[i]] = In[i]     scatter (with duplicate indices the last writer wins, in no defined order)
+
+StructuredBuffer<uint>   In     : register(t0);
+StructuredBuffer<uint>   Idx    : register(t1);
+RWStructuredBuffer<uint> Out    : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Count;
+    uint GroupsX;
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint NumThreads = 256;
+
+[numthreads(NumThreads, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint i = (groupId.y * GroupsX + groupId.x) * NumThreads + threadId.x;
+    if (i >= Count)
+    {
+        return;
+    }
+#if MODE == 0
+    Out[i] = In[i];
+#elif MODE == 1
+    Out[i] = In[Idx[i]];
+#else
+    Out[Idx[i]] = In[i];
+#endif
+}
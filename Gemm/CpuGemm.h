@@ -0,0 +1,199 @@
+#pragma once
+
+// Multithreaded, cache-blocked SIMD host GEMM (row-major C = A * B, fp32): the reference the GPU
+// kernels are validated against and the host baseline they are reported next to. Rows are split
+// across threads; each thread walks KBlock x NBlock panels of B (sized for L2) over its rows with
+// a 4-row register tile. AVX2 (+FMA) when the build enables it (the x64 configurations set
+// /arch:AVX2), SSE2 on other x86/x64 builds, scalar elsewhere. Also holds the fp16 conversions for
+// the half-precision variants. No D3D dependency.
+
+#include "ParallelFor.h"
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GEMM_SIMD_X86 1
+#endif
+
+namespace CpuGemm
+{
+    static const size_t RowTile = 4;
+    static const size_t KBlock  = 256;
+    static const size_t NBlock  = 256;
+
+    // IEEE binary16 conversions, round to nearest even; enough for the host side of the fp16 runs.
+    inline uint16_t FloatToHalf(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        uint32_t sign     = (bits >> 16) & 0x8000;
+        int32_t  exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+        uint32_t mantissa = bits & 0x7FFFFF;
+
+        if (((bits >> 23) & 0xFF) == 0xFF)
+        {
+            return static_cast<uint16_t>(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0));
+        }
+        if (exponent >= 31)
+        {
+            return static_cast<uint16_t>(sign | 0x7C00);
+        }
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+            {
+                return static_cast<uint16_t>(sign);
+            }
+            mantissa |= 0x800000;
+            uint32_t shift = static_cast<uint32_t>(14 - exponent);
+            uint32_t half  = mantissa >> shift;
+            uint32_t rest  = mantissa & ((1u << shift) - 1);
+            uint32_t mid   = 1u << (shift - 1);
+            half += (rest > mid || (rest == mid && (half & 1))) ? 1 : 0;
+            return static_cast<uint16_t>(sign | half);
+        }
+        uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        uint32_t rest = mantissa & 0x1FFF;
+        half += (rest > 0x1000 || (rest == 0x1000 && (half & 1))) ? 1 : 0;   // may carry into the exponent, which is correct
+        return static_cast<uint16_t>(half);
+    }
+
+    inline float HalfToFloat(uint16_t half)
+    {
+        uint32_t sign     = static_cast<uint32_t>(half & 0x8000) << 16;
+        uint32_t exponent = (half >> 10) & 0x1F;
+        uint32_t mantissa = half & 0x3FF;
+        uint32_t bits;
+        if (exponent == 0x1F)
+        {
+            bits = sign | 0x7F800000 | (mantissa << 13);
+        }
+        else if (exponent != 0)
+        {
+            bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+        }
+        else if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // Subnormal: normalise the mantissa.
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0)
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+        }
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+#if GEMM_SIMD_X86
+#if defined(__AVX2__)
+    struct Lanes
+    {
+        typedef __m256 V;
+        static const size_t Width = 8;
+        static V    Zero()                  { return _mm256_setzero_ps(); }
+        static V    Set(float v)            { return _mm256_set1_ps(v); }
+        static V    Load(const float* p)    { return _mm256_loadu_ps(p); }
+        static void Store(float* p, V v)    { _mm256_storeu_ps(p, v); }
+#if defined(__FMA__) || defined(_MSC_VER)
+        static V    Fma(V a, V b, V c)      { return _mm256_fmadd_ps(a, b, c); }   // /arch:AVX2 implies FMA3
+#else
+        static V    Fma(V a, V b, V c)      { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+    };
+#else
+    struct Lanes
+    {
+        typedef __m128 V;
+        static const size_t Width = 4;
+        static V    Zero()                  { return _mm_setzero_ps(); }
+        static V    Set(float v)            { return _mm_set1_ps(v); }
+        static V    Load(const float* p)    { return _mm_loadu_ps(p); }
+        static void Store(float* p, V v)    { _mm_storeu_ps(p, v); }
+        static V    Fma(V a, V b, V c)      { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    };
+#endif
+#else
+    struct Lanes
+    {
+        typedef float V;
+        static const size_t Width = 1;
+        static V    Zero()                  { return 0.0f; }
+        static V    Set(float v)            { return v; }
+        static V    Load(const float* p)    { return *p; }
+        static void Store(float* p, V v)    { *p = v; }
+        static V    Fma(V a, V b, V c)      { return a * b + c; }
+    };
+#endif
+
+    // c[rows x (jEnd - jBegin)] += a[rows x (kEnd - kBegin)] * b[(kEnd - kBegin) x (jEnd - jBegin)],
+    // Lanes::Width columns of up to RowTile rows at a time, accumulators kept in registers.
+    inline void Panel(const float* a, const float* b, float* c, size_t rows, size_t N, size_t K,
+        size_t kBegin, size_t kEnd, size_t jBegin, size_t jEnd)
+    {
+        const size_t W = Lanes::Width;
+        size_t j = jBegin;
+        for (; j + W <= jEnd; j += W)
+        {
+            typename Lanes::V acc[RowTile];
+            for (size_t r = 0; r < rows; ++r)
+            {
+                acc[r] = Lanes::Load(c + r * N + j);
+            }
+            for (size_t k = kBegin; k < kEnd; ++k)
+            {
+                typename Lanes::V bv = Lanes::Load(b + k * N + j);
+                for (size_t r = 0; r < rows; ++r)
+                {
+                    acc[r] = Lanes::Fma(Lanes::Set(a[r * K + k]), bv, acc[r]);
+                }
+            }
+            for (size_t r = 0; r < rows; ++r)
+            {
+                Lanes::Store(c + r * N + j, acc[r]);
+            }
+        }
+        for (; j < jEnd; ++j)
+        {
+            for (size_t r = 0; r < rows; ++r)
+            {
+                float sum = c[r * N + j];
+                for (size_t k = kBegin; k < kEnd; ++k)
+                {
+                    sum += a[r * K + k] * b[k * N + j];
+                }
+                c[r * N + j] = sum;
+            }
+        }
+    }
+
+    // c (M x N) = a (M x K) * b (K x N), all row-major.
+    inline void Multiply(const float* a, const float* b, float* c, size_t M, size_t N, size_t K, uint32_t threads)
+    {
+        ParallelFor(M, threads, [&](uint32_t, size_t begin, size_t end) {
+            std::fill(c + begin * N, c + end * N, 0.0f);
+            for (size_t kb = 0; kb < K; kb += KBlock)
+            {
+                size_t kEnd = (std::min)(kb + KBlock, K);
+                for (size_t jb = 0; jb < N; jb += NBlock)
+                {
+                    size_t jEnd = (std::min)(jb + NBlock, N);
+                    for (size_t i = begin; i < end; i += RowTile)
+                    {
+                        Panel(a + i * K, b, c + i * N, (std::min)(RowTile, end - i), N, K, kb, kEnd, jb, jEnd);
+                    }
+                }
+            }
+        }, RowTile);
+    }
+}
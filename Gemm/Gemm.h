@@ -0,0 +1,284 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuGemm.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <cfloat>
+
+enum GemmAlgorithm : uint32_t {
+    NaiveGemm       = 0,  // one C element per thread, operands from memory
+    GroupSharedGemm = 1,  // 16x16 tiles staged in groupshared memory
+    RegisterBlocked = 2,  // 64x64 tile per group, 4x4 per thread
+    GemmAlgorithmCount
+};
+
+enum GemmPrecision : uint32_t {
+    GemmFp32 = 0,
+    GemmFp16 = 1,   // native 16-bit storage and (packed) math
+    GemmPrecisionCount
+};
+
+inline const char* GemmAlgorithmName(GemmAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case GemmAlgorithm::NaiveGemm:       return "Naive";
+    case GemmAlgorithm::GroupSharedGemm: return "GroupSharedTiled";
+    case GemmAlgorithm::RegisterBlocked: return "RegisterBlocked";
+    default:                             return "Unknown";
+    }
+}
+
+inline const char* GemmPrecisionName(GemmPrecision precision)
+{
+    return precision == GemmPrecision::GemmFp16 ? "Fp16" : "Fp32";
+}
+
+// C (M x N) = A (M x K) * B (K x N), row-major, with one of the kernels in Shaders/Gemm.hlsl. The
+// same class measures the FMA peak of the precision (PeakFma) so results can be reported as a
+// fraction of it: SetRunPeak(true) makes Dispatch() time that kernel instead of the GEMM.
+class Gemm : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t M;
+		uint32_t N;
+		uint32_t K;
+		uint32_t Iterations;
+	};
+
+    static const uint32_t TileSize       = 16;
+    static const uint32_t BlockSize      = 64;
+    static const uint32_t PeakThreads    = 1024 * 1024;
+    static const uint32_t PeakGroupSize  = 256;
+    static const uint32_t PeakIterations = 4096;
+    static const uint32_t PeakChains     = 8;
+    static const uint32_t PeakLanes      = 4;
+
+    Gemm(HINSTANCE hInstance, GemmAlgorithm algorithm, GemmPrecision precision, uint32_t m, uint32_t n, uint32_t k) :
+		D3DAppSimplified(hInstance),
+		m_algorithm(algorithm),
+		m_precision(precision),
+		m_m(m),
+		m_n(n),
+		m_k(k)
+	{
+		// Multiples of 1/8 in [-1, 1]: exact in fp16, so both precisions multiply the same values.
+		mHostA.resize(static_cast<size_t>(m_m) * m_k);
+		mHostB.resize(static_cast<size_t>(m_k) * m_n);
+		for (size_t i = 0; i < mHostA.size(); ++i)
+		{
+			mHostA[i] = static_cast<float>(static_cast<int>((static_cast<uint32_t>(i) * 2654435761u) >> 7) % 17 - 8) / 8.0f;
+		}
+		for (size_t i = 0; i < mHostB.size(); ++i)
+		{
+			mHostB[i] = static_cast<float>(static_cast<int>((static_cast<uint32_t>(i) * 2246822519u) >> 9) % 17 - 8) / 8.0f;
+		}
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		std::vector<uint8_t> a = Upload(mHostA);
+		std::vector<uint8_t> b = Upload(mHostB);
+		mA = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), a.data(), a.size());
+		mB = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), b.data(), b.size());
+		mC = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, OutputBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mPeakOutput = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>(PeakThreads) * PeakLanes * ElementBytes(),
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, OutputBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		bool half = m_precision == GemmPrecision::GemmFp16;
+		std::vector<std::wstring> defines = {
+			L"ALGORITHM=" + std::to_wstring(static_cast<uint32_t>(m_algorithm)),
+			L"HALF=" + std::to_wstring(half ? 1 : 0)
+		};
+		std::vector<std::wstring> arguments;
+		if (half)
+		{
+			arguments.push_back(L"-enable-16bit-types");
+		}
+		const wchar_t* target = half ? L"cs_6_2" : L"cs_6_0";
+		mGemmShader = D3DUtil::CompileShaderDxc(L"Shaders\\Gemm.hlsl", defines, L"main", target, arguments);
+		mPeakShader = D3DUtil::CompileShaderDxc(L"Shaders\\Gemm.hlsl", defines, L"PeakFma", target, arguments);
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[5];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsShaderResourceView(1);
+		slotRootParameter[3].InitAsUnorderedAccessView(0);
+		slotRootParameter[4].InitAsUnorderedAccessView(1);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(5, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mGemmPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mGemmShader.Get());
+		mPeakPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mPeakShader.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetComputeRootShaderResourceView(1, mA->GetGPUVirtualAddress());
+		commandList->SetComputeRootShaderResourceView(2, mB->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(3, mC->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(4, mPeakOutput->GetGPUVirtualAddress());
+
+		if (m_runPeak)
+		{
+			RootConstants constants = { 0, 0, 0, PeakIterations };
+			commandList->SetPipelineState(mPeakPSO.Get());
+			commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+			commandList->Dispatch(PeakThreads / PeakGroupSize, 1, 1);
+			return;
+		}
+
+		uint32_t tile = m_algorithm == GemmAlgorithm::RegisterBlocked ? BlockSize : TileSize;
+		RootConstants constants = { m_m, m_n, m_k, 0 };
+		commandList->SetPipelineState(mGemmPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->Dispatch(DivideRoundUp(m_n, tile), DivideRoundUp(m_m, tile), 1);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mC.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mC.Get(), 0, OutputBytes());
+		}
+    }
+
+	void SetRunPeak(bool runPeak) { m_runPeak = runPeak; }
+
+	bool   Supported()   const { return m_supported; }
+	UINT   WaveMMATier() const { return m_waveMMATier; }
+	double Flops()       const { return 2.0 * m_m * m_n * m_k; }
+	double PeakFlops()   const { return 2.0 * PeakThreads * PeakIterations * PeakChains * PeakLanes; }
+	const std::vector<float>& HostA() const { return mHostA; }
+	const std::vector<float>& HostB() const { return mHostB; }
+
+	// C from the last Dispatch() with SetCopyResults(true), widened to fp32.
+	void ReadResults(std::vector<float>& c)
+	{
+		size_t count = static_cast<size_t>(m_m) * m_n;
+		uint8_t* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(OutputBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		c.resize(count);
+		if (m_precision == GemmPrecision::GemmFp16)
+		{
+			const uint16_t* halves = reinterpret_cast<const uint16_t*>(mapped);
+			for (size_t i = 0; i < count; ++i)
+			{
+				c[i] = CpuGemm::HalfToFloat(halves[i]);
+			}
+		}
+		else
+		{
+			memcpy(c.data(), mapped, count * sizeof(float));
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+	}
+
+	// Largest accepted |GPU - host| for an output whose K products have magnitudes summing to
+	// `absSum`. Every rounding of the accumulation is at most epsilon times that sum; the worst case
+	// adds K of them, but they have random signs and grow like sqrt(K).
+	double Tolerance(double absSum) const
+	{
+		double epsilon = m_precision == GemmPrecision::GemmFp16 ? 1.0 / 1024.0 : 1.0 / 8388608.0;
+		return std::sqrt(static_cast<double>(m_k)) * epsilon * absSum + FLT_MIN;
+	}
+
+private:
+
+	UINT64 ElementBytes() const { return m_precision == GemmPrecision::GemmFp16 ? sizeof(uint16_t) : sizeof(float); }
+	UINT64 OutputBytes()  const { return static_cast<UINT64>(m_m) * m_n * ElementBytes(); }
+
+	std::vector<uint8_t> Upload(const std::vector<float>& values) const
+	{
+		std::vector<uint8_t> bytes(values.size() * ElementBytes());
+		if (m_precision == GemmPrecision::GemmFp16)
+		{
+			uint16_t* halves = reinterpret_cast<uint16_t*>(bytes.data());
+			for (size_t i = 0; i < values.size(); ++i)
+			{
+				halves[i] = CpuGemm::FloatToHalf(values[i]);
+			}
+		}
+		else
+		{
+			memcpy(bytes.data(), values.data(), bytes.size());
+		}
+		return bytes;
+	}
+
+	bool CheckSupport()
+	{
+		// Wave-matrix (WaveMMA) support is recorded for the results, but no shader model that
+		// shipped exposes it, so there is no kernel for it.
+		FeatureDataOptions9 options9 = {};
+		if (SUCCEEDED(Device()->CheckFeatureSupport(kFeatureOptions9, &options9, sizeof(options9))))
+		{
+			m_waveMMATier = options9.WaveMMATier;
+		}
+
+		D3D_SHADER_MODEL required = m_precision == GemmPrecision::GemmFp16 ? D3D_SHADER_MODEL_6_2 : D3D_SHADER_MODEL_6_0;
+		if (QueryHighestShaderModel(Device()) < required)
+		{
+			OutputDebugStringA(m_precision == GemmPrecision::GemmFp16 ? "Shader model 6.2 not supported\n" : "Shader model 6.0 not supported\n");
+			return false;
+		}
+		if (m_precision == GemmPrecision::GemmFp16)
+		{
+			D3D12_FEATURE_DATA_D3D12_OPTIONS4 options4 = {};
+			if (FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS4, &options4, sizeof(options4))) ||
+				!options4.Native16BitShaderOpsSupported)
+			{
+				OutputDebugStringA("Native 16-bit shader operations not supported\n");
+				return false;
+			}
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mGemmShader;
+    ComPtr<ID3DBlob> mPeakShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mGemmPSO;
+	ComPtr<ID3D12PipelineState> mPeakPSO;
+
+	ComPtr<ID3D12Resource> mA;
+	ComPtr<ID3D12Resource> mB;
+	ComPtr<ID3D12Resource> mC;
+	ComPtr<ID3D12Resource> mPeakOutput;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<float> mHostA;
+	std::vector<float> mHostB;
+
+	GemmAlgorithm m_algorithm;
+	GemmPrecision m_precision;
+	uint32_t      m_m;
+	uint32_t      m_n;
+	uint32_t      m_k;
+	UINT          m_waveMMATier = 0;
+	bool          m_runPeak     = false;
+	bool          m_supported   = false;
+};
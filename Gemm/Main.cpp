@@ -0,0 +1,162 @@
+#include "d3dAppSimplified.h"
+#include "Gemm.h"
+#include "CpuGemm.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	GemmAlgorithm algorithm  = GemmAlgorithm::RegisterBlocked;
+	GemmPrecision precision  = GemmPrecision::GemmFp32;
+	int           m          = 2048;
+	int           n          = 2048;
+	int           k          = 2048;
+	int           validate   = 1;
+	int           cpuThreads = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <algorithm> <precision> <M> <N> <K> <validate> <cpuThreads>
+	// algorithm: 0=Naive, 1=GroupSharedTiled, 2=RegisterBlocked   precision: 0=Fp32, 1=Fp16
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			algorithm = static_cast<GemmAlgorithm>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			precision = static_cast<GemmPrecision>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			m = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			n = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			k = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			validate = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			cpuThreads = _wtoi(argv[7]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: algorithm=%d, precision=%d, M=%d, N=%d, K=%d, validate=%d, cpuThreads=%d\n",
+			static_cast<int>(algorithm), static_cast<int>(precision), m, n, k, validate, cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (algorithm >= GemmAlgorithm::GemmAlgorithmCount || precision >= GemmPrecision::GemmPrecisionCount)
+	{
+		OutputDebugStringA("ERROR: Unknown algorithm or precision!\n");
+		return 1;
+	}
+	// Every matrix has to fit in one 2 GB buffer.
+	const uint64_t maxElements = 1ull << 29;
+	if (m <= 0 || n <= 0 || k <= 0 || m > 65536 || n > 65536 || k > 65536 || cpuThreads <= 0 ||
+		static_cast<uint64_t>(m) * k > maxElements || static_cast<uint64_t>(k) * n > maxElements || static_cast<uint64_t>(m) * n > maxElements)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	Gemm test(hInstance, algorithm, precision, static_cast<uint32_t>(m), static_cast<uint32_t>(n), static_cast<uint32_t>(k));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA(precision == GemmPrecision::GemmFp16 ? "ERROR: Fp16 GEMM needs shader model 6.2 with native 16-bit operations!\n"
+			: "ERROR: GEMM needs shader model 6.0!\n");
+		return 1;
+	}
+
+	// ALU ceiling of this precision, warmed up like the GEMM.
+	test.SetRunPeak(true);
+	double peakSeconds = test.RunWarmedAndTimed(false, []() {});
+	double peakTflops  = test.PeakFlops() / peakSeconds / 1e12;
+	test.SetRunPeak(false);
+
+	double cpuSeconds = 0.0;
+	double maxError   = 0.0;
+	int    mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		if (validate == 0)
+		{
+			return;
+		}
+		std::vector<float> gpu;
+		test.ReadResults(gpu);
+
+		std::vector<float> host(static_cast<size_t>(m) * n);
+		CpuTimer timer;
+		timer.Start();
+		CpuGemm::Multiply(test.HostA().data(), test.HostB().data(), host.data(), m, n, k, static_cast<uint32_t>(cpuThreads));
+		cpuSeconds = timer.Stop();
+
+		// Per-output sum of |a_ik * b_kj|, from the same multiply on |A| and |B|.
+		std::vector<float> absA(test.HostA().size());
+		std::vector<float> absB(test.HostB().size());
+		std::transform(test.HostA().begin(), test.HostA().end(), absA.begin(), [](float v) { return std::fabs(v); });
+		std::transform(test.HostB().begin(), test.HostB().end(), absB.begin(), [](float v) { return std::fabs(v); });
+		std::vector<float> absSum(host.size());
+		CpuGemm::Multiply(absA.data(), absB.data(), absSum.data(), m, n, k, static_cast<uint32_t>(cpuThreads));
+
+		for (size_t i = 0; i < host.size(); ++i)
+		{
+			double error = std::fabs(static_cast<double>(gpu[i]) - host[i]);
+			maxError = (std::max)(maxError, error);
+			mismatches += error > test.Tolerance(absSum[i]) || error != error ? 1 : 0;
+		}
+	});
+	double gpuTflops  = test.Flops() / gpuSeconds / 1e12;
+	double cpuGflops  = cpuSeconds > 0.0 ? test.Flops() / cpuSeconds / 1e9 : 0.0;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Algorithm: " << GemmAlgorithmName(algorithm) << " Precision: " << GemmPrecisionName(precision)
+		<< " M=" << m << " N=" << n << " K=" << k << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuTflops << " TFLOPS, " << gpuTflops / peakTflops * 100.0 << "% of FMA peak)\n";
+	debugOutput << "FMA peak: " << peakTflops << " TFLOPS\n";
+	debugOutput << "Wave matrix tier: " << test.WaveMMATier() << " (no kernel)\n";
+	if (validate != 0)
+	{
+		debugOutput << "CPU (" << cpuThreads << " threads): " << cpuSeconds << " seconds (" << cpuGflops << " GFLOPS)\n";
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (max error " << maxError
+			<< ", " << mismatches << " outputs beyond sqrt(K) * eps * sum |a*b|)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("gemm_results.csv", "Algorithm,AlgorithmName,Precision,M,N,K,Gpu_s,GpuTflops,PeakTflops,FractionOfPeak,WaveMMATier,CpuThreads,Cpu_s,CpuGflops,Validated,MaxError,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(algorithm), GemmAlgorithmName(algorithm), GemmPrecisionName(precision), m, n, k,
+		gpuSeconds, gpuTflops, peakTflops, gpuTflops / peakTflops, test.WaveMMATier(), cpuThreads, cpuSeconds, cpuGflops, validate, maxError, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
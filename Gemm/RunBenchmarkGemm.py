@@ -0,0 +1,92 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+ALGORITHMS = {
+    0: "Naive",
+    1: "GroupSharedTiled",
+    2: "RegisterBlocked",
+}
+
+PRECISIONS = {
+    0: "Fp32",
+    1: "Fp16",
+}
+
+# (M, N, K): square sizes, then skinny shapes (tall-skinny, short-wide and small-K panels).
+SHAPES = [(n, n, n) for n in [256, 512, 1024, 2048, 4096]] + [
+    (16384, 64, 1024),
+    (64, 16384, 1024),
+    (4096, 4096, 64),
+    (8192, 8192, 16),
+    (1024, 1024, 16384),
+]
+
+def run_simple_test(tryCount = 3):
+    """Sweeps every GEMM kernel over square and skinny shapes in both precisions"""
+
+    program = "..\\x64\\Release\\Gemm.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "gemm_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for precision in PRECISIONS:
+        for algorithm in ALGORITHMS:
+            for (m, n, k) in SHAPES:
+                print(f"\nRunning {ALGORITHMS[algorithm]} {PRECISIONS[precision]} {m}x{n}x{k}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(algorithm),
+                            str(precision),
+                            str(m),
+                            str(n),
+                            str(k),
+                            # Validate the first run of each configuration only.
+                            "1" if i == 0 else "0"
+                        ], capture_output=True, text=True)
+                        if result.returncode != 0:
+                            print(f"  Run {i+1}: failed, unsupported or mismatched (exit {result.returncode})")
+                        else:
+                            print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_gemm_results(filename):
+    series = {}
+    shapes = []
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            shape = f"{parts[3]}x{parts[4]}x{parts[5]}"
+            if shape not in shapes:
+                shapes.append(shape)
+            key = f"{parts[1]} {parts[2]}"
+            series.setdefault(key, {}).setdefault(shape, []).append(float(parts[9]) * 100.0)
+
+    x = range(len(shapes))
+    for key, runs in sorted(series.items()):
+        plt.plot(x, [max(runs[s]) if s in runs else float('nan') for s in shapes], marker='o', label=key)
+    plt.xticks(x, shapes, rotation=45, ha='right', fontsize=7)
+    plt.xlabel('M x N x K')
+    plt.ylabel('% of FMA peak (best run)')
+    plt.title('GEMM Throughput vs ALU Peak')
+    plt.legend(fontsize=7)
+    plt.grid(True)
+    plt.tight_layout()
+    plt.savefig('Gemm.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_gemm_results("gemm_results.csv")
@@ -0,0 +1,199 @@
+// Row-major C (M x N) = A (M x K) * B (K x N). Compiled with DXC; variants are selected by defines:
+//   ALGORITHM  0=naive (one C element per thread, operands straight from memory)
+//              1=groupshared-tiled (16x16 tiles of A and B staged per K step)
+//              2=register-blocked (64x64 C tile per group, 4x4 per thread from 16-deep tiles)
+//   HALF       0=fp32, 1=fp16 storage and math (cs_6_2, -enable-16bit-types); the 4-wide
+//              accumulators of the register-blocked kernel become packed half2 FMAs
+//
+// PeakFma is the ALU ceiling the GEMM kernels are reported against: independent FMA chains in the
+// same precision and vector width, no memory traffic besides one store per thread.
+
+#if HALF
+typedef float16_t  elem_t;
+typedef float16_t4 elem4_t;
+#else
+typedef float      elem_t;
+typedef float4     elem4_t;
+#endif
+
+StructuredBuffer<elem_t>   A      : register(t0);
+StructuredBuffer<elem_t>   B      : register(t1);
+RWStructuredBuffer<elem_t> C      : register(u0);
+RWStructuredBuffer<elem4_t> Peak  : register(u1);
+
+cbuffer params : register(b0)
+{
+    uint M;
+    uint N;
+    uint K;
+    uint Iterations;   // PeakFma: dependent FMA steps per chain
+}
+
+static const uint TileSize  = 16;   // naive/tiled: 16x16 threads, one C element each
+static const uint BlockM    = 64;   // register-blocked: C tile per group
+static const uint BlockN    = 64;
+static const uint BlockK    = 16;
+static const uint ThreadM   = 4;    // C elements per thread and dimension
+static const uint ThreadN   = 4;
+
+elem_t LoadA(uint row, uint k)
+{
+    return row < M && k < K ? A[row * K + k] : (elem_t)0;
+}
+
+elem_t LoadB(uint k, uint column)
+{
+    return k < K && column < N ? B[k * N + column] : (elem_t)0;
+}
+
+#if ALGORITHM == 0
+
+[numthreads(TileSize, TileSize, 1)]
+void main(uint3 dispatchId : SV_DispatchThreadID)
+{
+    uint row    = dispatchId.y;
+    uint column = dispatchId.x;
+    if (row >= M || column >= N)
+    {
+        return;
+    }
+    elem_t acc = 0;
+    for (uint k = 0; k < K; ++k)
+    {
+        acc = mad(A[row * K + k], B[k * N + column], acc);
+    }
+    C[row * N + column] = acc;
+}
+
+#elif ALGORITHM == 1
+
+groupshared elem_t sA[TileSize][TileSize];
+groupshared elem_t sB[TileSize][TileSize];
+
+[numthreads(TileSize, TileSize, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 dispatchId : SV_DispatchThreadID)
+{
+    uint row    = dispatchId.y;
+    uint column = dispatchId.x;
+    elem_t acc = 0;
+
+    for (uint k0 = 0; k0 < K; k0 += TileSize)
+    {
+        sA[threadId.y][threadId.x] = LoadA(row, k0 + threadId.x);
+        sB[threadId.y][threadId.x] = LoadB(k0 + threadId.y, column);
+        GroupMemoryBarrierWithGroupSync();
+
+        [unroll]
+        for (uint k = 0; k < TileSize; ++k)
+        {
+            acc = mad(sA[threadId.y][k], sB[k][threadId.x], acc);
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (row < M && column < N)
+    {
+        C[row * N + column] = acc;
+    }
+}
+
+#else
+
+// A is stored transposed (k-major) so a thread's ThreadM rows are adjacent, like its ThreadN
+// columns of B: every inner step is two short groupshared reads and ThreadM vector FMAs.
+groupshared elem_t sA[BlockK * BlockM];
+groupshared elem_t sB[BlockK * BlockN];
+
+[numthreads(TileSize, TileSize, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    const uint thread = threadId.y * TileSize + threadId.x;
+    const uint row0   = groupId.y * BlockM;
+    const uint col0   = groupId.x * BlockN;
+
+    // Tile loads: every thread brings in 4 of the 64x16 A elements and 4 of the 16x64 B elements.
+    const uint aRow = thread / (BlockK / 4);
+    const uint aK   = (thread % (BlockK / 4)) * 4;
+    const uint bK   = thread / (BlockN / 4);
+    const uint bCol = (thread % (BlockN / 4)) * 4;
+
+    elem4_t acc[ThreadM];
+    [unroll]
+    for (uint i = 0; i < ThreadM; ++i)
+    {
+        acc[i] = (elem4_t)0;
+    }
+
+    for (uint k0 = 0; k0 < K; k0 += BlockK)
+    {
+        [unroll]
+        for (uint j = 0; j < 4; ++j)
+        {
+            sA[(aK + j) * BlockM + aRow] = LoadA(row0 + aRow, k0 + aK + j);
+            sB[bK * BlockN + bCol + j]   = LoadB(k0 + bK, col0 + bCol + j);
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        [unroll]
+        for (uint k = 0; k < BlockK; ++k)
+        {
+            uint aBase = k * BlockM + threadId.y * ThreadM;
+            uint bBase = k * BlockN + threadId.x * ThreadN;
+            elem4_t b = elem4_t(sB[bBase], sB[bBase + 1], sB[bBase + 2], sB[bBase + 3]);
+            [unroll]
+            for (uint i = 0; i < ThreadM; ++i)
+            {
+                acc[i] = mad((elem4_t)sA[aBase + i], b, acc[i]);
+            }
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    [unroll]
+    for (uint i = 0; i < ThreadM; ++i)
+    {
+        uint row = row0 + threadId.y * ThreadM + i;
+        [unroll]
+        for (uint j = 0; j < ThreadN; ++j)
+        {
+            uint column = col0 + threadId.x * ThreadN + j;
+            if (row < M && column < N)
+            {
+                C[row * N + column] = acc[i][j];
+            }
+        }
+    }
+}
+
+#endif
+
+static const uint PeakThreads = 256;
+static const uint PeakChains  = 8;
+
+[numthreads(PeakThreads, 1, 1)]
+void PeakFma(uint3 dispatchId : SV_DispatchThreadID)
+{
+    elem4_t chains[PeakChains];
+    [unroll]
+    for (uint c = 0; c < PeakChains; ++c)
+    {
+        chains[c] = (elem4_t)((elem_t)((dispatchId.x + c) & 0xFF) * (elem_t)0.001);
+    }
+
+    for (uint i = 0; i < Iterations; ++i)
+    {
+        [unroll]
+        for (uint c = 0; c < PeakChains; ++c)
+        {
+            chains[c] = mad(chains[c], (elem4_t)(elem_t)0.999, (elem4_t)(elem_t)0.001);
+        }
+    }
+
+    elem4_t sum = 0;
+    [unroll]
+    for (uint c = 0; c < PeakChains; ++c)
+    {
+        sum += chains[c];
+    }
+    Peak[dispatchId.x] = sum;
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "LdsBankModel.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Times one groupshared access pattern (Shaders/GroupShared.hlsl) and the conflict-free baseline
+// of the same width and mix (stride 1) with the same PSO; only the offset table differs, so the
+// ratio of the two times is the measured conflict multiplier. Both tables live in one buffer and
+// SetBaseline() picks which one the next Dispatch() reads.
+class GroupShared : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Iterations;
+		uint32_t TableBase;
+		uint32_t GroupsX;
+		uint32_t Pad0;
+	};
+
+    static const uint32_t NumThreads = 256;
+    static const uint32_t LdsWords   = 8192;
+
+    GroupShared(HINSTANCE hInstance, LdsPattern pattern, uint32_t stride, uint32_t width, LdsMix mix, uint32_t iterations, uint32_t groups) :
+		D3DAppSimplified(hInstance),
+		m_pattern(pattern),
+		m_stride(stride),
+		m_width(width),
+		m_mix(mix),
+		m_iterations(iterations),
+		m_groups(groups)
+	{
+		mOffsets = LdsBankModel::MakeOffsets(pattern, stride, NumThreads, Elements());
+		std::vector<uint32_t> baseline = LdsBankModel::MakeOffsets(LdsPattern::LdsStrided, 1, NumThreads, Elements());
+		mTable = mOffsets;
+		mTable.insert(mTable.end(), baseline.begin(), baseline.end());
+	}
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		mOffsetBuffer   = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mTable.data(), mTable.size() * sizeof(uint32_t));
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, OutputBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, OutputBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		mShader = D3DUtil::CompileShaderDxc(L"Shaders\\GroupShared.hlsl", {
+			L"WIDTH=" + std::to_wstring(m_width),
+			L"MIX=" + std::to_wstring(static_cast<uint32_t>(m_mix))
+		}, L"main", L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShader.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		RootConstants constants = { m_iterations, m_baseline ? NumThreads : 0, m_groups, 0 };
+
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(1, mOffsetBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		// Main keeps the group count within the 65535 limit of one dimension.
+		commandList->Dispatch(m_groups, 1, 1);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, OutputBytes());
+		}
+    }
+
+	// Runs the stride-1 baseline instead of the pattern.
+	void SetBaseline(bool baseline) { m_baseline = baseline; }
+
+	bool     Supported() const { return m_supported; }
+	uint32_t WaveSize()  const { return m_waveSize; }
+	uint32_t Elements()  const { return LdsWords / m_width; }
+	const std::vector<uint32_t>& Offsets() const { return mOffsets; }
+	UINT64   OutputBytes() const { return static_cast<UINT64>(m_groups) * NumThreads * sizeof(uint32_t); }
+	// Bytes moved through the LDS by the access loop (the fill and the final read are not counted).
+	double   LdsBytes() const
+	{
+		return static_cast<double>(m_groups) * NumThreads * m_iterations * m_width * 4 * (m_mix == LdsMix::ReadWriteMix ? 2 : 1);
+	}
+
+	// Outputs of the last Dispatch() with SetCopyResults(true) that differ from the host sums. Only
+	// the read mix has a deterministic result; the write mixes race on shared elements.
+	uint32_t Validate()
+	{
+		if (m_mix != LdsMix::ReadMix)
+		{
+			return 0;
+		}
+		std::vector<uint32_t> reference(NumThreads);
+		for (uint32_t t = 0; t < NumThreads; ++t)
+		{
+			uint32_t acc = 0;
+			for (uint32_t i = 0; i < m_iterations; ++i)
+			{
+				uint32_t index = (mOffsets[t] + 32 * i) & (Elements() - 1);
+				for (uint32_t k = 0; k < m_width; ++k)
+				{
+					acc += index * m_width + k;
+				}
+			}
+			reference[t] = acc + (t & (Elements() - 1)) * m_width;
+		}
+
+		uint32_t* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(OutputBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t mismatches = 0;
+		for (uint64_t i = 0; i < static_cast<uint64_t>(m_groups) * NumThreads; ++i)
+		{
+			mismatches += mapped[i] != reference[i % NumThreads] ? 1 : 0;
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		// The model groups lanes into waves; without wave ops the waves are assumed to be 64 wide.
+		D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+		m_waveSize = SUCCEEDED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) &&
+			options1.WaveOps && options1.WaveLaneCountMin != 0 ? options1.WaveLaneCountMin : 64;
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	ComPtr<ID3D12Resource> mOffsetBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<uint32_t> mOffsets;  // the pattern's offsets
+	std::vector<uint32_t> mTable;    // pattern offsets followed by the baseline offsets
+
+	LdsPattern m_pattern;
+	uint32_t   m_stride;
+	uint32_t   m_width;
+	LdsMix     m_mix;
+	uint32_t   m_iterations;
+	uint32_t   m_groups;
+	uint32_t   m_waveSize  = 64;
+	bool       m_baseline  = false;
+	bool       m_supported = false;
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <set>
+#include <random>
+#include <algorithm>
+
+// Access patterns of the groupshared (LDS) benchmark and the bank-conflict model that predicts
+// their cost. Portable: the offset tables are what Shaders/GroupShared.hlsl reads, so the model
+// sees exactly the addresses the GPU does.
+
+enum LdsPattern : uint32_t {
+    LdsStrided = 0,  // thread t accesses element t * stride
+    LdsBroadcast,    // every thread accesses element 0
+    LdsRandom,       // every thread accesses a random element (fixed seed)
+    LdsPatternCount
+};
+
+inline const char* LdsPatternName(LdsPattern pattern)
+{
+    switch (pattern)
+    {
+    case LdsPattern::LdsStrided:   return "Strided";
+    case LdsPattern::LdsBroadcast: return "Broadcast";
+    case LdsPattern::LdsRandom:    return "Random";
+    default:                       return "Unknown";
+    }
+}
+
+enum LdsMix : uint32_t {
+    ReadMix = 0,    // loads only
+    WriteMix,       // stores only
+    ReadWriteMix,   // a load and a store to the same element per iteration
+    LdsMixCount
+};
+
+inline const char* LdsMixName(LdsMix mix)
+{
+    switch (mix)
+    {
+    case LdsMix::ReadMix:      return "Read";
+    case LdsMix::WriteMix:     return "Write";
+    case LdsMix::ReadWriteMix: return "ReadWrite";
+    default:                   return "Unknown";
+    }
+}
+
+namespace LdsBankModel
+{
+    // Element offset (in elements of `width` 32-bit words) of every thread of a group. `elements`
+    // is the power-of-two element count of the groupshared array; offsets wrap inside it.
+    inline std::vector<uint32_t> MakeOffsets(LdsPattern pattern, uint32_t stride, uint32_t threads, uint32_t elements, uint32_t seed = 12345)
+    {
+        std::vector<uint32_t> offsets(threads, 0);
+        std::mt19937 rng(seed);
+        for (uint32_t t = 0; t < threads; ++t)
+        {
+            switch (pattern)
+            {
+            case LdsPattern::LdsStrided: offsets[t] = (t * stride) & (elements - 1); break;
+            case LdsPattern::LdsRandom:  offsets[t] = static_cast<uint32_t>(rng()) & (elements - 1); break;
+            default:                     offsets[t] = 0; break;
+            }
+        }
+        return offsets;
+    }
+
+    // Cycles one wave needs for one access of `width` words per lane. The LDS moves `banks` words
+    // per cycle, so a wave is served in phases of banks / width lanes; within a phase the cycle
+    // count is the largest number of distinct words that fall into one bank (the same word is
+    // broadcast, not conflicted).
+    inline uint32_t WaveCycles(const uint32_t* offsets, uint32_t lanes, uint32_t width, uint32_t banks)
+    {
+        uint32_t lanesPerPhase = (std::max)(banks / width, 1u);
+        uint32_t cycles = 0;
+        std::vector<std::set<uint32_t> > words(banks);
+        for (uint32_t first = 0; first < lanes; first += lanesPerPhase)
+        {
+            for (auto& bank : words)
+            {
+                bank.clear();
+            }
+            for (uint32_t lane = first; lane < (std::min)(first + lanesPerPhase, lanes); ++lane)
+            {
+                for (uint32_t k = 0; k < width; ++k)
+                {
+                    uint32_t word = offsets[lane] * width + k;
+                    words[word % banks].insert(word);
+                }
+            }
+            size_t degree = 1;
+            for (const auto& bank : words)
+            {
+                degree = (std::max)(degree, bank.size());
+            }
+            cycles += static_cast<uint32_t>(degree);
+        }
+        return cycles;
+    }
+
+    // Cycles of the whole group relative to a conflict-free access of the same width.
+    inline double ConflictMultiplier(const std::vector<uint32_t>& offsets, uint32_t width, uint32_t waveSize, uint32_t banks = 32)
+    {
+        uint32_t lanesPerPhase = (std::max)(banks / width, 1u);
+        uint64_t cycles = 0;
+        uint64_t ideal  = 0;
+        for (size_t first = 0; first < offsets.size(); first += waveSize)
+        {
+            uint32_t lanes = static_cast<uint32_t>((std::min)(offsets.size() - first, static_cast<size_t>(waveSize)));
+            cycles += WaveCycles(offsets.data() + first, lanes, width, banks);
+            ideal  += (lanes + lanesPerPhase - 1) / lanesPerPhase;
+        }
+        return ideal == 0 ? 1.0 : static_cast<double>(cycles) / ideal;
+    }
+
+    // Bytes per clock per CU the model expects: one word per bank per cycle, divided by the conflicts.
+    inline double PredictedBytesPerClock(double multiplier, uint32_t banks = 32) { return banks * 4.0 / multiplier; }
+}
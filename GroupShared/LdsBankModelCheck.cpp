@@ -0,0 +1,77 @@
+// Standalone check of LdsBankModel.h: offset generation and the predicted conflict multipliers
+// for patterns whose cost is known. No D3D12, not part of the GroupShared project; build and run
+// on any machine with, e.g.
+//   g++ -std=c++14 -O2 LdsBankModelCheck.cpp -o LdsBankModelCheck && ./LdsBankModelCheck
+// Exits with 1 if any check fails.
+
+#include "LdsBankModel.h"
+#include <cstdio>
+#include <cmath>
+
+static int gFailures = 0;
+
+static void Check(bool passed, const char* what)
+{
+    printf("%s: %s\n", passed ? "PASS" : "FAIL", what);
+    gFailures += passed ? 0 : 1;
+}
+
+// Same sizes as GroupShared.h: 256 threads over a 32KB array.
+static const uint32_t kThreads  = 256;
+static const uint32_t kLdsWords = 8192;
+
+static double Multiplier(LdsPattern pattern, uint32_t stride, uint32_t width, uint32_t waveSize)
+{
+    std::vector<uint32_t> offsets = LdsBankModel::MakeOffsets(pattern, stride, kThreads, kLdsWords / width);
+    return LdsBankModel::ConflictMultiplier(offsets, width, waveSize);
+}
+
+static void CheckMultiplier(LdsPattern pattern, uint32_t stride, uint32_t width, uint32_t waveSize, double expected)
+{
+    double multiplier = Multiplier(pattern, stride, width, waveSize);
+    char what[128];
+    snprintf(what, sizeof(what), "%s stride %u width %u wave %u: multiplier %g (expected %g)",
+        LdsPatternName(pattern), stride, width, waveSize, multiplier, expected);
+    Check(std::fabs(multiplier - expected) < 1e-9, what);
+}
+
+int main()
+{
+    // Offsets: strided wraps inside the array, broadcast is all zero, random is seeded and in range.
+    std::vector<uint32_t> strided = LdsBankModel::MakeOffsets(LdsPattern::LdsStrided, 3, kThreads, kLdsWords);
+    Check(strided[0] == 0 && strided[1] == 3 && strided[255] == 765, "strided offsets are t * stride");
+    std::vector<uint32_t> wrapped = LdsBankModel::MakeOffsets(LdsPattern::LdsStrided, 64, kThreads, 1024);
+    Check(wrapped[16] == 0 && wrapped[17] == 64, "strided offsets wrap inside the array");
+    std::vector<uint32_t> broadcast = LdsBankModel::MakeOffsets(LdsPattern::LdsBroadcast, 1, kThreads, kLdsWords);
+    Check(std::count(broadcast.begin(), broadcast.end(), 0u) == static_cast<long>(kThreads), "broadcast offsets are all 0");
+    std::vector<uint32_t> random = LdsBankModel::MakeOffsets(LdsPattern::LdsRandom, 1, kThreads, kLdsWords);
+    Check(random == LdsBankModel::MakeOffsets(LdsPattern::LdsRandom, 1, kThreads, kLdsWords) &&
+        *std::max_element(random.begin(), random.end()) < kLdsWords, "random offsets are reproducible and in range");
+
+    // 32 banks of 4 bytes: a power-of-two stride s puts min(s, 32) lanes of a phase in one bank,
+    // an odd stride hits every bank once, and a broadcast is served in one cycle.
+    for (uint32_t waveSize : { 32u, 64u })
+    {
+        CheckMultiplier(LdsPattern::LdsStrided, 1, 1, waveSize, 1.0);
+        CheckMultiplier(LdsPattern::LdsStrided, 2, 1, waveSize, 2.0);
+        CheckMultiplier(LdsPattern::LdsStrided, 4, 1, waveSize, 4.0);
+        CheckMultiplier(LdsPattern::LdsStrided, 32, 1, waveSize, 32.0);
+        CheckMultiplier(LdsPattern::LdsStrided, 64, 1, waveSize, 32.0);
+        for (uint32_t odd : { 3u, 5u, 7u, 33u })
+        {
+            CheckMultiplier(LdsPattern::LdsStrided, odd, 1, waveSize, 1.0);
+        }
+        CheckMultiplier(LdsPattern::LdsBroadcast, 1, 1, waveSize, 1.0);
+    }
+
+    // Wider accesses are served in phases of 32 / width lanes, so stride 1 stays conflict-free.
+    CheckMultiplier(LdsPattern::LdsStrided, 1, 2, 32, 1.0);
+    CheckMultiplier(LdsPattern::LdsStrided, 1, 4, 32, 1.0);
+    CheckMultiplier(LdsPattern::LdsStrided, 2, 4, 32, 2.0);
+
+    Check(std::fabs(LdsBankModel::PredictedBytesPerClock(1.0) - 128.0) < 1e-9 &&
+        std::fabs(LdsBankModel::PredictedBytesPerClock(32.0) - 4.0) < 1e-9, "predicted bytes/clock/CU scale with the multiplier");
+
+    printf("%d check(s) failed\n", gFailures);
+    return gFailures == 0 ? 0 : 1;
+}
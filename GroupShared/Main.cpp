@@ -0,0 +1,146 @@
+#include "d3dAppSimplified.h"
+#include "GroupShared.h"
+#include "LdsBankModel.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	LdsPattern pattern      = LdsPattern::LdsStrided;
+	int        stride       = 1;
+	int        width        = 1;
+	LdsMix     mix          = LdsMix::ReadMix;
+	int        iterations   = 4096;
+	int        groups       = 4096;
+	int        validate     = 1;
+	int        clockMHz     = 0;
+	int        computeUnits = 0;
+
+	// Usage: program.exe <pattern> <stride> <width> <mix> <iterations> <groups> <validate> <clockMHz> <computeUnits>
+	// pattern: 0=Strided, 1=Broadcast, 2=Random   stride: elements between threads (1..64, Strided only)
+	// width: 32-bit words per access (1, 2, 4)   mix: 0=Read, 1=Write, 2=ReadWrite
+	// clockMHz/computeUnits: shader clock and CU count of the device; 0 leaves bytes/clock/CU out
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			pattern = static_cast<LdsPattern>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			stride = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			width = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			mix = static_cast<LdsMix>(_wtoi(argv[4]));
+		}
+		if (argc >= 6)
+		{
+			iterations = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			groups = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			validate = _wtoi(argv[7]);
+		}
+		if (argc >= 9)
+		{
+			clockMHz = _wtoi(argv[8]);
+		}
+		if (argc >= 10)
+		{
+			computeUnits = _wtoi(argv[9]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: pattern=%d, stride=%d, width=%d, mix=%d, iterations=%d, groups=%d, validate=%d, clockMHz=%d, computeUnits=%d\n",
+			static_cast<int>(pattern), stride, width, static_cast<int>(mix), iterations, groups, validate, clockMHz, computeUnits);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (pattern >= LdsPattern::LdsPatternCount || mix >= LdsMix::LdsMixCount)
+	{
+		OutputDebugStringA("ERROR: Unknown pattern or mix!\n");
+		return 1;
+	}
+	if (stride < 1 || stride > 64 || (width != 1 && width != 2 && width != 4) || iterations <= 0 ||
+		groups <= 0 || groups > static_cast<int>(GroupShared::MaxGroupsX) || clockMHz < 0 || computeUnits < 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	GroupShared test(hInstance, pattern, static_cast<uint32_t>(stride), static_cast<uint32_t>(width), mix, static_cast<uint32_t>(iterations),
+		static_cast<uint32_t>(groups));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Shader model 6.0 not supported on this device!\n");
+		return 1;
+	}
+
+	uint32_t mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		mismatches = validate != 0 ? test.Validate() : 0;
+	});
+	// The baseline uses the same PSO, so it needs no warm-up of its own.
+	test.SetBaseline(true);
+	test.Dispatch();
+	double baselineSeconds = test.GetDuration();
+
+	double measured   = gpuSeconds / baselineSeconds;
+	double predicted  = LdsBankModel::ConflictMultiplier(test.Offsets(), static_cast<uint32_t>(width), test.WaveSize());
+	double gpuGBs     = test.LdsBytes() / gpuSeconds / 1e9;
+	double bytesPerClock = clockMHz != 0 && computeUnits != 0 ? test.LdsBytes() / gpuSeconds / (clockMHz * 1e6) / computeUnits : 0.0;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Pattern: " << LdsPatternName(pattern) << " Stride: " << stride << " Width: " << width * 4 << " bytes Mix: " << LdsMixName(mix)
+		<< " Wave: " << test.WaveSize() << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGBs << " GB/s";
+	if (bytesPerClock != 0.0)
+	{
+		debugOutput << ", " << bytesPerClock << " bytes/clock/CU";
+	}
+	debugOutput << "), baseline " << baselineSeconds << " seconds\n";
+	debugOutput << "Conflict multiplier: " << measured << " measured, " << predicted << " predicted ("
+		<< LdsBankModel::PredictedBytesPerClock(predicted) << " bytes/clock/CU)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("groupshared_results.csv", "Device,Pattern,Stride,WidthBytes,Mix,WaveSize,Gpu_s,Baseline_s,Gpu_GBs,BytesPerClockCU,"
+		"MeasuredMultiplier,PredictedMultiplier,PredictedBytesPerClockCU,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(QueryAdapterKey(test.Device()), LdsPatternName(pattern), stride, width * 4, LdsMixName(mix), test.WaveSize(), gpuSeconds,
+		baselineSeconds, gpuGBs, bytesPerClock, measured, predicted, LdsBankModel::PredictedBytesPerClock(predicted), validate, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+PATTERNS = {
+    0: "Strided",
+    1: "Broadcast",
+    2: "Random",
+}
+
+MIXES = {
+    0: "Read",
+    1: "Write",
+    2: "ReadWrite",
+}
+
+WIDTHS = [1, 2, 4]
+STRIDES = list(range(1, 65))
+
+# Shader clock (MHz) and CU count of the device under test; 0 leaves bytes/clock/CU out.
+CLOCK_MHZ = 0
+COMPUTE_UNITS = 0
+
+def run_simple_test(tryCount = 3, iterations = 4096, groups = 4096):
+    """Every stride for every width and mix, plus the broadcast and random patterns"""
+
+    program = "..\\x64\\Release\\GroupShared.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "groupshared_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for mix in MIXES:
+        for width in WIDTHS:
+            for pattern in PATTERNS:
+                # Only the strided pattern uses the stride argument.
+                for stride in (STRIDES if pattern == 0 else [1]):
+                    print(f"\nRunning {PATTERNS[pattern]} stride {stride} width {width * 4} bytes {MIXES[mix]}...")
+                    for i in range(tryCount):
+                        time.sleep(0.01)
+                        try:
+                            result = subprocess.run([
+                                program,
+                                str(pattern),
+                                str(stride),
+                                str(width),
+                                str(mix),
+                                str(iterations),
+                                str(groups),
+                                # Validate the first run of each configuration only.
+                                "1" if i == 0 else "0",
+                                str(CLOCK_MHZ),
+                                str(COMPUTE_UNITS)
+                            ], capture_output=True, text=True)
+                            if result.returncode != 0:
+                                print(f"  Run {i+1}: failed (exit {result.returncode})")
+                            else:
+                                print(f"  Run {i+1}: {result.stdout.strip()}")
+                        except Exception as e:
+                            print(f"  Run {i+1}: Error - {e}")
+
+def plot_groupshared_results(filename):
+    strided = {}
+    others = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = (parts[4], int(parts[3]))
+            # The smallest measured multiplier of the repeated runs.
+            measured, predicted, bytesPerClock = float(parts[10]), float(parts[11]), float(parts[9])
+            if parts[1] == "Strided":
+                points = strided.setdefault(key, {})
+                best = points.get(int(parts[2]), (measured, predicted, bytesPerClock))
+                points[int(parts[2])] = (min(best[0], measured), predicted, max(best[2], bytesPerClock))
+            else:
+                best = others.get((parts[1],) + key, (measured, predicted))
+                others[(parts[1],) + key] = (min(best[0], measured), predicted)
+
+    fig, axes = plt.subplots(1, len(MIXES), figsize=(16, 5), sharey=True)
+    for ax, mix in zip(axes, MIXES.values()):
+        for (m, widthBytes), points in sorted(strided.items()):
+            if m != mix:
+                continue
+            strides = sorted(points.keys())
+            line, = ax.plot(strides, [points[s][0] for s in strides], marker='o', markersize=3, label=f"{widthBytes} B measured")
+            ax.plot(strides, [points[s][1] for s in strides], linestyle='--', color=line.get_color(), label=f"{widthBytes} B model")
+        for (pattern, m, widthBytes), (measured, predicted) in sorted(others.items()):
+            if m == mix:
+                print(f"{pattern} {widthBytes} B {mix}: measured {measured:.2f}, predicted {predicted:.2f}")
+        ax.set_xlabel('Stride (elements)')
+        ax.set_ylabel('Conflict multiplier')
+        ax.set_title(mix)
+        ax.grid(True)
+        ax.legend(fontsize=6)
+    plt.suptitle('Groupshared Bank Conflicts: Measured vs Model')
+    plt.tight_layout()
+    plt.savefig('GroupShared.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_groupshared_results("groupshared_results.csv")
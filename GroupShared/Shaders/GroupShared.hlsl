@@ -0,0 +1,81 @@
+// Groupshared (LDS) access loop. Every thread reads its element offset from Offsets (generated by
+// LdsBankModel::MakeOffsets) and accesses element (offset + 32 * i) mod Elements for Iterations
+// iterations; the per-iteration shift is a whole number of bank rows, so the bank pattern of the
+// wave is the same in every iteration. Compiled with DXC (cs_6_0); variants are selected by defines:
+//   WIDTH  32-bit words per access (1, 2 or 4: uint, uint2, uint4 elements)
+//   MIX    0=read, 1=write, 2=read then write the same element
+//
+// Elements hold their own word addresses, so the read-only sum has an exact host reference.
+
+#define GROUP_SIZE 256
+
+typedef vector<uint, WIDTH> Element;
+
+static const uint Elements = 8192 / WIDTH;  // 32 KB
+
+StructuredBuffer<uint>   Offsets : register(t0);
+RWStructuredBuffer<uint> Output  : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Iterations;
+    uint TableBase;  // first entry of this run's offsets in Offsets
+    uint GroupsX;
+    uint Pad0;
+}
+
+groupshared Element Scratch[Elements];
+
+Element WordAddresses(uint e)
+{
+    Element value;
+    [unroll]
+    for (uint k = 0; k < WIDTH; ++k)
+    {
+        value[k] = e * WIDTH + k;
+    }
+    return value;
+}
+
+uint Sum(Element value)
+{
+    uint sum = 0;
+    [unroll]
+    for (uint k = 0; k < WIDTH; ++k)
+    {
+        sum += value[k];
+    }
+    return sum;
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    for (uint e = threadId.x; e < Elements; e += GROUP_SIZE)
+    {
+        Scratch[e] = WordAddresses(e);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    uint base = Offsets[TableBase + threadId.x];
+    uint acc  = 0;
+    [loop]
+    for (uint i = 0; i < Iterations; ++i)
+    {
+        uint index = (base + 32 * i) & (Elements - 1);
+#if MIX == 0
+        acc += Sum(Scratch[index]);
+#elif MIX == 1
+        Scratch[index] = WordAddresses(i);
+#else
+        Element value = Scratch[index];
+        acc += Sum(value);
+        Scratch[index] = value + 1;
+#endif
+    }
+
+    // Keeps the stores of the write mixes alive.
+    GroupMemoryBarrierWithGroupSync();
+    acc += Scratch[threadId.x & (Elements - 1)][0];
+    Output[(groupId.y * GroupsX + groupId.x) * GROUP_SIZE + threadId.x] = acc;
+}
@@ -0,0 +1,316 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "CommandContext.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+enum HostTransferPath : uint32_t {
+    // host -> device
+    UploadHeapStaged      = 0,  // memcpy into an UPLOAD heap, CopyBufferRegion into VRAM
+    WriteCombineStaged    = 1,  // memcpy into a CUSTOM write-combined L0 heap, CopyBufferRegion into VRAM
+    GpuUploadDirect       = 2,  // memcpy straight into GPU_UPLOAD (ReBAR) VRAM, no GPU copy
+    ExistingHeapUpload    = 3,  // GPU copies straight out of host memory opened as an existing heap
+    // device -> host
+    ReadbackHeapStaged    = 4,  // CopyBufferRegion into a READBACK heap, memcpy out
+    WriteCombineReadback  = 5,  // CopyBufferRegion into a CUSTOM write-combined heap, memcpy out (uncached reads)
+    ExistingHeapReadback  = 6,  // GPU copies straight into host memory opened as an existing heap
+    HostTransferPathCount
+};
+
+enum HostMemory : uint32_t {
+    Pageable = 0,   // ordinary heap allocation
+    Pinned   = 1,   // VirtualAlloc + VirtualLock'ed pages
+};
+
+inline const char* HostTransferPathName(HostTransferPath path)
+{
+    switch (path)
+    {
+    case HostTransferPath::UploadHeapStaged:     return "UploadHeapStaged";
+    case HostTransferPath::WriteCombineStaged:   return "WriteCombineStaged";
+    case HostTransferPath::GpuUploadDirect:      return "GpuUploadDirect";
+    case HostTransferPath::ExistingHeapUpload:   return "ExistingHeapUpload";
+    case HostTransferPath::ReadbackHeapStaged:   return "ReadbackHeapStaged";
+    case HostTransferPath::WriteCombineReadback: return "WriteCombineReadback";
+    case HostTransferPath::ExistingHeapReadback: return "ExistingHeapReadback";
+    default:                                     return "Unknown";
+    }
+}
+
+inline bool IsUploadPath(HostTransferPath path) { return path <= HostTransferPath::ExistingHeapUpload; }
+
+// Existing-heap paths never touch a separate host buffer, so the pageable/pinned choice is moot.
+inline bool UsesHostMemcpy(HostTransferPath path)
+{
+    return path != HostTransferPath::ExistingHeapUpload && path != HostTransferPath::ExistingHeapReadback;
+}
+
+class HostTransfer : public D3DAppSimplified
+{
+public:
+
+	struct Timing
+	{
+		double gpuSeconds  = 0.0;   // GPU timestamps around the copy, 0 when there is no GPU work
+		double wallSeconds = 0.0;   // QPC around memcpy + submit + fence wait
+		bool   gpuValid    = false;
+	};
+
+    HostTransfer(HINSTANCE hInstance, UINT64 maxBytes, D3D12_COMMAND_LIST_TYPE queueType) :
+		D3DAppSimplified(hInstance),
+		m_maxBytes(AlignUp(maxBytes, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT)),
+		m_queueType(queueType)
+	{
+    }
+
+	~HostTransfer()
+	{
+		UnmapAll();
+		// Release the placed resources before their backing memory.
+		mExistingBuffer.Reset();
+		mExistingHeap.Reset();
+		if (mExistingMemory)
+		{
+			VirtualFree(mExistingMemory, 0, MEM_RELEASE);
+		}
+		if (mPinnedMemory)
+		{
+			VirtualUnlock(mPinnedMemory, static_cast<SIZE_T>(m_maxBytes));
+			VirtualFree(mPinnedMemory, 0, MEM_RELEASE);
+		}
+	}
+
+    void BuildResourcesAndHeaps() override {
+		mDeviceBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, m_maxBytes);
+
+		mUploadBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_UPLOAD, m_maxBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, m_maxBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+		mWriteCombineUploadBuffer   = CreateCustomBuffer(D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE, D3D12_MEMORY_POOL_L0);
+		mWriteCombineReadbackBuffer = CreateCustomBuffer(D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE, D3D12_MEMORY_POOL_L0);
+
+		FeatureDataOptions16 options16 = {};
+		if (SUCCEEDED(Device()->CheckFeatureSupport(kFeatureOptions16, &options16, sizeof(options16))) && options16.GPUUploadHeapSupported)
+		{
+			mGpuUploadBuffer = D3DUtil::CreateBuffer(Device(), kHeapTypeGpuUpload, m_maxBytes);
+		}
+		else
+		{
+			OutputDebugStringA("GPU_UPLOAD heap (ReBAR) not supported, skipping GpuUploadDirect\n");
+		}
+
+		BuildHostMemory();
+		BuildExistingHeap();
+		MapAll();
+
+		mContext.Initialize(Device(), m_queueType);
+	}
+
+	// No shaders: every path here is a copy.
+    void BuildShadersAndInputLayout() override { }
+
+    void BuildPSOs() override { }
+
+	// Transfers are recorded on mContext rather than through D3DAppSimplified::Dispatch so the
+	// wall time does not include the swap-chain Present issued by SubmitAndFlushCommandQueue.
+    void DoAction() override { }
+
+	bool IsSupported(HostTransferPath path, HostMemory host) const
+	{
+		if (UsesHostMemcpy(path) && host == HostMemory::Pinned && mPinnedMemory == nullptr)
+		{
+			return false;
+		}
+		switch (path)
+		{
+		case HostTransferPath::GpuUploadDirect:      return mGpuUploadBuffer != nullptr;
+		case HostTransferPath::ExistingHeapUpload:
+		case HostTransferPath::ExistingHeapReadback: return mExistingBuffer != nullptr;
+		default:                                     return true;
+		}
+	}
+
+	Timing Measure(HostTransferPath path, HostMemory host, UINT64 bytes)
+	{
+		Timing timing;
+		uint8_t* hostMemory = (host == HostMemory::Pinned) ? mPinnedMemory : mPageableMemory.data();
+
+		ID3D12Resource* src = nullptr;
+		ID3D12Resource* dst = nullptr;
+		uint8_t*        mapped = nullptr;
+		switch (path)
+		{
+		case HostTransferPath::UploadHeapStaged:     src = mUploadBuffer.Get();               dst = mDeviceBuffer.Get(); mapped = mUploadMapped;               break;
+		case HostTransferPath::WriteCombineStaged:   src = mWriteCombineUploadBuffer.Get();   dst = mDeviceBuffer.Get(); mapped = mWriteCombineUploadMapped;   break;
+		case HostTransferPath::GpuUploadDirect:      mapped = mGpuUploadMapped;                                                                                break;
+		case HostTransferPath::ExistingHeapUpload:   src = mExistingBuffer.Get();             dst = mDeviceBuffer.Get();                                       break;
+		case HostTransferPath::ReadbackHeapStaged:   src = mDeviceBuffer.Get(); dst = mReadbackBuffer.Get();             mapped = mReadbackMapped;             break;
+		case HostTransferPath::WriteCombineReadback: src = mDeviceBuffer.Get(); dst = mWriteCombineReadbackBuffer.Get(); mapped = mWriteCombineReadbackMapped; break;
+		case HostTransferPath::ExistingHeapReadback: src = mDeviceBuffer.Get(); dst = mExistingBuffer.Get();                                                   break;
+		default:
+			assert(false && "Unknown transfer path");
+			return timing;
+		}
+
+		// Record up front so that neither timer includes command recording.
+		bool hasGpuCopy = (src != nullptr);
+		if (hasGpuCopy)
+		{
+			auto commandList = mContext.CommandList();
+			mContext.Reset();
+			mContext.Timestamp(0);
+			commandList->CopyBufferRegion(dst, 0, src, 0, bytes);
+			mContext.Timestamp(1);
+			mContext.ResolveTimestamps(2);
+		}
+
+		CpuTimer timer;
+		timer.Start();
+		if (IsUploadPath(path) && mapped)
+		{
+			memcpy(mapped, hostMemory, static_cast<size_t>(bytes));
+		}
+		if (hasGpuCopy)
+		{
+			mContext.SubmitAndFlush();
+		}
+		if (!IsUploadPath(path) && mapped)
+		{
+			memcpy(hostMemory, mapped, static_cast<size_t>(bytes));
+		}
+		timing.wallSeconds = timer.Stop();
+
+		if (hasGpuCopy && mContext.TimestampsSupported())
+		{
+			timing.gpuSeconds = mContext.ElapsedSeconds(0, 1);
+			timing.gpuValid   = true;
+		}
+		return timing;
+	}
+
+	UINT64 MaxBytes() const { return m_maxBytes; }
+
+private:
+
+	static UINT64 AlignUp(UINT64 value, UINT64 alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+	ComPtr<ID3D12Resource> CreateCustomBuffer(D3D12_CPU_PAGE_PROPERTY pageProperty, D3D12_MEMORY_POOL pool)
+	{
+		ComPtr<ID3D12Resource> buffer;
+		auto heapProps  = CD3DX12_HEAP_PROPERTIES(pageProperty, pool);
+		auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(m_maxBytes);
+		AssertIfFailed(Device()->CreateCommittedResource(
+			&heapProps,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			IID_PPV_ARGS(buffer.GetAddressOf())));
+		return buffer;
+	}
+
+	void BuildHostMemory()
+	{
+		mPageableMemory.resize(static_cast<size_t>(m_maxBytes));
+		for (size_t i = 0; i < mPageableMemory.size(); ++i)
+		{
+			mPageableMemory[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+		}
+
+		// VirtualLock is bounded by the working set, so grow it before locking.
+		SIZE_T lockBytes = static_cast<SIZE_T>(m_maxBytes);
+		SIZE_T minWorkingSet = 0, maxWorkingSet = 0;
+		GetProcessWorkingSetSize(GetCurrentProcess(), &minWorkingSet, &maxWorkingSet);
+		SetProcessWorkingSetSize(GetCurrentProcess(), minWorkingSet + lockBytes, maxWorkingSet + 2 * lockBytes);
+
+		mPinnedMemory = static_cast<uint8_t*>(VirtualAlloc(nullptr, lockBytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+		if (mPinnedMemory && !VirtualLock(mPinnedMemory, lockBytes))
+		{
+			OutputDebugStringA("VirtualLock failed, skipping pinned host memory\n");
+			VirtualFree(mPinnedMemory, 0, MEM_RELEASE);
+			mPinnedMemory = nullptr;
+		}
+		if (mPinnedMemory)
+		{
+			memcpy(mPinnedMemory, mPageableMemory.data(), lockBytes);
+		}
+	}
+
+	// Host memory the GPU can address directly. The runtime pins the pages for the lifetime of the heap.
+	void BuildExistingHeap()
+	{
+		ComPtr<ID3D12Device3> device3;
+		if (FAILED(Device()->QueryInterface(IID_PPV_ARGS(&device3))))
+		{
+			OutputDebugStringA("ID3D12Device3 unavailable, skipping existing-heap paths\n");
+			return;
+		}
+
+		mExistingMemory = VirtualAlloc(nullptr, static_cast<SIZE_T>(m_maxBytes), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+		if (!mExistingMemory || FAILED(device3->OpenExistingHeapFromAddress(mExistingMemory, IID_PPV_ARGS(&mExistingHeap))))
+		{
+			OutputDebugStringA("OpenExistingHeapFromAddress failed, skipping existing-heap paths\n");
+			return;
+		}
+		memcpy(mExistingMemory, mPageableMemory.data(), static_cast<size_t>(m_maxBytes));
+
+		auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(m_maxBytes, D3D12_RESOURCE_FLAG_ALLOW_CROSS_ADAPTER);
+		AssertIfFailed(Device()->CreatePlacedResource(
+			mExistingHeap.Get(),
+			0,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			IID_PPV_ARGS(&mExistingBuffer)));
+	}
+
+	// Persistently mapped for the lifetime of the benchmark, as production upload rings are.
+	void MapAll()
+	{
+		D3D12_RANGE noRead = { 0, 0 };
+		AssertIfFailed(mUploadBuffer->Map(0, &noRead, reinterpret_cast<void**>(&mUploadMapped)));
+		AssertIfFailed(mWriteCombineUploadBuffer->Map(0, &noRead, reinterpret_cast<void**>(&mWriteCombineUploadMapped)));
+		AssertIfFailed(mReadbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mReadbackMapped)));
+		AssertIfFailed(mWriteCombineReadbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mWriteCombineReadbackMapped)));
+		if (mGpuUploadBuffer)
+		{
+			AssertIfFailed(mGpuUploadBuffer->Map(0, &noRead, reinterpret_cast<void**>(&mGpuUploadMapped)));
+		}
+	}
+
+	void UnmapAll()
+	{
+		if (mUploadMapped)               mUploadBuffer->Unmap(0, nullptr);
+		if (mWriteCombineUploadMapped)   mWriteCombineUploadBuffer->Unmap(0, nullptr);
+		if (mReadbackMapped)             mReadbackBuffer->Unmap(0, nullptr);
+		if (mWriteCombineReadbackMapped) mWriteCombineReadbackBuffer->Unmap(0, nullptr);
+		if (mGpuUploadMapped)            mGpuUploadBuffer->Unmap(0, nullptr);
+	}
+
+	ComPtr<ID3D12Resource> mDeviceBuffer;
+	ComPtr<ID3D12Resource> mUploadBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+	ComPtr<ID3D12Resource> mWriteCombineUploadBuffer;
+	ComPtr<ID3D12Resource> mWriteCombineReadbackBuffer;
+	ComPtr<ID3D12Resource> mGpuUploadBuffer;
+	ComPtr<ID3D12Heap>     mExistingHeap;
+	ComPtr<ID3D12Resource> mExistingBuffer;
+
+	uint8_t* mUploadMapped               = nullptr;
+	uint8_t* mWriteCombineUploadMapped   = nullptr;
+	uint8_t* mReadbackMapped             = nullptr;
+	uint8_t* mWriteCombineReadbackMapped = nullptr;
+	uint8_t* mGpuUploadMapped            = nullptr;
+
+	std::vector<uint8_t> mPageableMemory;
+	uint8_t*             mPinnedMemory   = nullptr;
+	void*                mExistingMemory = nullptr;
+
+	CommandContext mContext;
+
+	UINT64                  m_maxBytes;
+	D3D12_COMMAND_LIST_TYPE m_queueType;
+};
@@ -0,0 +1,130 @@
+#include "d3dAppSimplified.h"
+#include "HostTransfer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	INT64 minKB      = 4;
+	INT64 maxKB      = 256 * 1024;
+	int   queue      = 1;
+	int   iterations = 5;
+
+	// Usage: program.exe <minKB> <maxKB> <queue> <iterations>
+	// queue: 0=DIRECT, 1=COPY. Sizes are swept in powers of two from minKB to maxKB.
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			minKB = _wtoi64(argv[1]);
+		}
+		if (argc >= 3)
+		{
+			maxKB = _wtoi64(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			queue = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			iterations = _wtoi(argv[4]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: minKB=%lld, maxKB=%lld, queue=%d, iterations=%d\n", minKB, maxKB, queue, iterations);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	// Signed until checked: a negative size would wrap to a huge UINT64.
+	if (minKB <= 0 || maxKB < minKB || iterations <= 0 || (queue != 0 && queue != 1))
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+	UINT64 minBytes = static_cast<UINT64>(minKB) * 1024;
+	UINT64 maxBytes = static_cast<UINT64>(maxKB) * 1024;
+
+	D3D12_COMMAND_LIST_TYPE queueType = (queue == 0) ? D3D12_COMMAND_LIST_TYPE_DIRECT : D3D12_COMMAND_LIST_TYPE_COPY;
+	const char* queueName = (queue == 0) ? "DIRECT" : "COPY";
+
+	HostTransfer test(hInstance, maxBytes, queueType);
+	test.Initialize();
+
+	ResultsCsv csv("host_transfer_results.csv",
+		"Direction,Path,HostMemory,Queue,Bytes,GpuTime_s,WallTime_s,GpuBandwidth_GBs,WallBandwidth_GBs", QueryDeviceCaps(test.Device()).Describe());
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+
+	for (uint32_t p = 0; p < HostTransferPath::HostTransferPathCount; ++p)
+	{
+		HostTransferPath path = static_cast<HostTransferPath>(p);
+		for (uint32_t h = 0; h <= HostMemory::Pinned; ++h)
+		{
+			HostMemory host = static_cast<HostMemory>(h);
+			if (!UsesHostMemcpy(path) && host == HostMemory::Pinned)
+			{
+				continue;
+			}
+			if (!test.IsSupported(path, host))
+			{
+				debugOutput << HostTransferPathName(path) << ": not supported\n";
+				continue;
+			}
+
+			const char* hostName = !UsesHostMemcpy(path) ? "ExistingHeap" : (host == HostMemory::Pinned ? "Pinned" : "Pageable");
+			for (UINT64 bytes = minBytes; bytes <= test.MaxBytes(); bytes *= 2)
+			{
+				// Warm up once, then average.
+				test.Measure(path, host, bytes);
+				double gpuSeconds  = 0.0;
+				double wallSeconds = 0.0;
+				bool   gpuValid    = false;
+				for (int i = 0; i < iterations; ++i)
+				{
+					HostTransfer::Timing timing = test.Measure(path, host, bytes);
+					gpuSeconds  += timing.gpuSeconds;
+					wallSeconds += timing.wallSeconds;
+					gpuValid     = timing.gpuValid;
+				}
+				gpuSeconds  /= iterations;
+				wallSeconds /= iterations;
+
+				double gpuBandwidth  = gpuValid ? (bytes / gpuSeconds / 1024 / 1024 / 1024) : 0.0;
+				double wallBandwidth = bytes / wallSeconds / 1024 / 1024 / 1024;
+
+				csv.Row(IsUploadPath(path) ? "Upload" : "Readback", HostTransferPathName(path), hostName, queueName,
+					bytes, gpuSeconds, wallSeconds, gpuBandwidth, wallBandwidth);
+
+				if (bytes * 2 > test.MaxBytes())
+				{
+					debugOutput << HostTransferPathName(path) << " (" << hostName << ", " << bytes << " bytes): "
+						<< gpuBandwidth << " GB/s GPU, " << wallBandwidth << " GB/s wall\n";
+				}
+			}
+		}
+	}
+
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+    return 0;
+}
@@ -0,0 +1,59 @@
+import subprocess
+import os
+import matplotlib.pyplot as plt
+
+def run_simple_test():
+    """Sweeps every host transfer path on the DIRECT and COPY queues"""
+
+    program = "..\\x64\\Release\\HostTransfer.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "host_transfer_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for queue in [0, 1]:
+        print(f"\nRunning queue {queue}...")
+        try:
+            result = subprocess.run([
+                program,
+                str(4),              # min KB
+                str(256 * 1024),     # max KB
+                str(queue),
+                str(5)
+            ], capture_output=True, text=True)
+            print(result.stdout.strip())
+        except Exception as e:
+            print(f"Error - {e}")
+
+def plot_host_transfer_results(filename, column, label, output):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = f"{parts[1]} / {parts[2]} / {parts[3]}"
+            series.setdefault(key, ([], []))
+            series[key][0].append(int(parts[4]) / 1024)
+            series[key][1].append(float(parts[column]))
+
+    plt.figure(figsize=(12, 7))
+    for key, (size, bandwidth) in sorted(series.items()):
+        plt.plot(size, bandwidth, marker='o', label=key)
+    plt.xscale('log', base=2)
+    plt.xlabel('Transfer Size (KB)')
+    plt.ylabel(label)
+    plt.title('Host <-> Device Transfer Bandwidth')
+    plt.legend(fontsize='small')
+    plt.grid(True)
+    plt.savefig(output)   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_host_transfer_results("host_transfer_results.csv", 8, 'Wall Bandwidth (GB/s)', 'HostTransferWall.pdf')
+    plot_host_transfer_results("host_transfer_results.csv", 7, 'GPU Bandwidth (GB/s)', 'HostTransferGpu.pdf')
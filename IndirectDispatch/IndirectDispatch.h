@@ -0,0 +1,232 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "CpuTimer.h"
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+enum DispatchMode : uint32_t {
+    CpuRecorded   = 0,  // CPU walks the workload list: root constants + Dispatch per surviving workload
+    Indirect      = 1,  // producer kernel writes one command per workload (culled = 0 groups), ExecuteIndirect(maxCount)
+    IndirectCount = 2,  // producer appends surviving workloads only, ExecuteIndirect with a count buffer
+    DispatchModeCount
+};
+
+inline const char* DispatchModeName(DispatchMode mode)
+{
+    switch (mode)
+    {
+    case DispatchMode::CpuRecorded:   return "CpuRecorded";
+    case DispatchMode::Indirect:      return "Indirect";
+    case DispatchMode::IndirectCount: return "IndirectCount";
+    default:                          return "Unknown";
+    }
+}
+
+class IndirectDispatch : public D3DAppSimplified
+{
+public:
+
+	struct Workload
+	{
+		uint32_t Offset;
+		uint32_t Count;
+	};
+
+	// Layout of one command in the argument buffer: root constants (b0), then D3D12_DISPATCH_ARGUMENTS.
+	struct IndirectCommand
+	{
+		uint32_t SegmentOffset;
+		uint32_t SegmentCount;
+		D3D12_DISPATCH_ARGUMENTS Dispatch;
+	};
+
+	struct ProducerConstants
+	{
+		uint32_t WorkloadCount;
+		uint32_t Compact;
+	};
+
+    static const uint32_t NumThreads = 64;
+
+    IndirectDispatch(HINSTANCE hInstance, uint32_t workloadCount, uint32_t maxElements, uint32_t cullPercent, DispatchMode mode) :
+		D3DAppSimplified(hInstance),
+		m_workloadCount(workloadCount),
+		m_maxElements(maxElements),
+		m_cullPercent(cullPercent),
+		m_mode(mode)
+	{
+    }
+
+    void BuildResourcesAndHeaps() override {
+		// Variable-sized segments packed back to back; culled ones keep their slot with Count = 0.
+		std::mt19937 gen(1234);
+		std::uniform_int_distribution<uint32_t> sizeDist(1, m_maxElements);
+		std::uniform_int_distribution<uint32_t> cullDist(0, 99);
+		mWorkloads.resize(m_workloadCount);
+		uint32_t offset = 0;
+		for (auto& workload : mWorkloads)
+		{
+			uint32_t size = sizeDist(gen);
+			workload.Offset = offset;
+			workload.Count  = cullDist(gen) < m_cullPercent ? 0 : size;
+			offset += size;
+			if (workload.Count > 0)
+			{
+				++m_activeWorkloads;
+				m_activeElements += workload.Count;
+			}
+		}
+		m_totalElements = offset;
+
+		std::vector<float> inputData(m_totalElements, 1.0f);
+		UINT64 byteSize = static_cast<UINT64>(m_totalElements) * sizeof(float);
+		mInputBuffer    = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), inputData.data(), byteSize);
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, byteSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mWorkloadBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mWorkloads.data(), mWorkloads.size() * sizeof(Workload));
+
+		mArgumentBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>(m_workloadCount) * sizeof(IndirectCommand), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mCountBuffer    = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, sizeof(uint32_t), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		uint32_t zero   = 0;
+		mZeroBuffer     = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), &zero, sizeof(zero));
+	}
+
+    void BuildShadersAndInputLayout() override {
+		mSegmentShader  = D3DUtil::CompileShader(L"Shaders\\SegmentKernel.hlsl", nullptr, "main", "cs_5_0");
+		mProducerShader = D3DUtil::CompileShader(L"Shaders\\ArgumentProducer.hlsl", nullptr, "main", "cs_5_0");
+	}
+
+    void BuildPSOs() override {
+		{
+			CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+			slotRootParameter[0].InitAsConstants(2, 0);
+			slotRootParameter[1].InitAsShaderResourceView(0);
+			slotRootParameter[2].InitAsUnorderedAccessView(0);
+			CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+			mSegmentRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+			mSegmentPSO           = D3DUtil::CreateComputePSO(Device(), mSegmentRootSignature.Get(), mSegmentShader.Get());
+		}
+		{
+			CD3DX12_ROOT_PARAMETER slotRootParameter[4];
+			slotRootParameter[0].InitAsConstants(sizeof(ProducerConstants) / sizeof(uint32_t), 0);
+			slotRootParameter[1].InitAsShaderResourceView(0);
+			slotRootParameter[2].InitAsUnorderedAccessView(0);
+			slotRootParameter[3].InitAsUnorderedAccessView(1);
+			CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(4, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+			mProducerRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+			mProducerPSO           = D3DUtil::CreateComputePSO(Device(), mProducerRootSignature.Get(), mProducerShader.Get());
+		}
+
+		// Root constants for the segment, then the dispatch itself. Changing root arguments requires the
+		// root signature to be part of the command signature.
+		D3D12_INDIRECT_ARGUMENT_DESC arguments[2] = {};
+		arguments[0].Type                             = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+		arguments[0].Constant.RootParameterIndex      = 0;
+		arguments[0].Constant.DestOffsetIn32BitValues = 0;
+		arguments[0].Constant.Num32BitValuesToSet     = 2;
+		arguments[1].Type                             = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+
+		D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+		signatureDesc.ByteStride       = sizeof(IndirectCommand);
+		signatureDesc.NumArgumentDescs = _countof(arguments);
+		signatureDesc.pArgumentDescs   = arguments;
+		AssertIfFailed(Device()->CreateCommandSignature(&signatureDesc, mSegmentRootSignature.Get(), IID_PPV_ARGS(&mCommandSignature)));
+    }
+
+	// GPU time covers everything the mode needs on the GPU: for the indirect modes that includes the
+	// producer dispatch and its barriers. CPU time is the recording of this function.
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		CpuTimer timer;
+		timer.Start();
+
+		if (m_mode == DispatchMode::CpuRecorded)
+		{
+			commandList->SetComputeRootSignature(mSegmentRootSignature.Get());
+			commandList->SetPipelineState(mSegmentPSO.Get());
+			commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+			commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+			for (const auto& workload : mWorkloads)
+			{
+				if (workload.Count == 0)
+				{
+					continue;
+				}
+				commandList->SetComputeRoot32BitConstants(0, 2, &workload, 0);
+				commandList->Dispatch((workload.Count + NumThreads - 1) / NumThreads, 1, 1);
+			}
+			m_recordSeconds = timer.Stop();
+			return;
+		}
+
+		bool compact = m_mode == DispatchMode::IndirectCount;
+
+		// Producer: the count buffer is reset by a copy, then written with atomics.
+		if (compact)
+		{
+			commandList->CopyBufferRegion(mCountBuffer.Get(), 0, mZeroBuffer.Get(), 0, sizeof(uint32_t));
+			auto toUav = CD3DX12_RESOURCE_BARRIER::Transition(mCountBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+			commandList->ResourceBarrier(1, &toUav);
+		}
+
+		ProducerConstants constants = { m_workloadCount, compact ? 1u : 0u };
+		commandList->SetComputeRootSignature(mProducerRootSignature.Get());
+		commandList->SetPipelineState(mProducerPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(constants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(1, mWorkloadBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mArgumentBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(3, mCountBuffer->GetGPUVirtualAddress());
+		commandList->Dispatch((m_workloadCount + NumThreads - 1) / NumThreads, 1, 1);
+
+		// Arguments (and count) were implicitly promoted to UNORDERED_ACCESS by the producer.
+		D3D12_RESOURCE_BARRIER toIndirect[2] = {
+			CD3DX12_RESOURCE_BARRIER::Transition(mArgumentBuffer.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT),
+			CD3DX12_RESOURCE_BARRIER::Transition(mCountBuffer.Get(),    D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT)
+		};
+		commandList->ResourceBarrier(compact ? 2 : 1, toIndirect);
+
+		// Consumer: ExecuteIndirect sets the segment root constants per command, SRV/UAV stay bound.
+		commandList->SetComputeRootSignature(mSegmentRootSignature.Get());
+		commandList->SetPipelineState(mSegmentPSO.Get());
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		commandList->ExecuteIndirect(mCommandSignature.Get(), m_workloadCount,
+			mArgumentBuffer.Get(), 0,
+			compact ? mCountBuffer.Get() : nullptr, 0);
+
+		m_recordSeconds = timer.Stop();
+    }
+
+	double   RecordSeconds()   const { return m_recordSeconds; }
+	uint32_t ActiveWorkloads() const { return m_activeWorkloads; }
+	UINT64   ActiveElements()  const { return m_activeElements; }
+
+private:
+
+    ComPtr<ID3DBlob> mSegmentShader;
+    ComPtr<ID3DBlob> mProducerShader;
+	ComPtr<ID3D12RootSignature>    mSegmentRootSignature;
+	ComPtr<ID3D12RootSignature>    mProducerRootSignature;
+	ComPtr<ID3D12PipelineState>    mSegmentPSO;
+	ComPtr<ID3D12PipelineState>    mProducerPSO;
+	ComPtr<ID3D12CommandSignature> mCommandSignature;
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mWorkloadBuffer;
+	ComPtr<ID3D12Resource> mArgumentBuffer;
+	ComPtr<ID3D12Resource> mCountBuffer;
+	ComPtr<ID3D12Resource> mZeroBuffer;
+
+	std::vector<Workload> mWorkloads;
+
+	uint32_t     m_workloadCount;
+	uint32_t     m_maxElements;
+	uint32_t     m_cullPercent;
+	DispatchMode m_mode;
+	uint32_t     m_totalElements   = 0;
+	uint32_t     m_activeWorkloads = 0;
+	UINT64       m_activeElements  = 0;
+	double       m_recordSeconds   = 0.0;
+};
@@ -0,0 +1,91 @@
+#include "d3dAppSimplified.h"
+#include "IndirectDispatch.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	int          workloads   = 4096;
+	int          maxElements = 1024;
+	int          cullPercent = 50;
+	DispatchMode mode        = DispatchMode::CpuRecorded;
+
+	// Usage: program.exe <workloads> <maxElements> <cullPercent> <mode>
+	// mode: 0=CpuRecorded, 1=Indirect, 2=IndirectCount
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			workloads = _wtoi(argv[1]);
+		}
+		if (argc >= 3)
+		{
+			maxElements = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			cullPercent = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			mode = static_cast<DispatchMode>(_wtoi(argv[4]));
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: workloads=%d, maxElements=%d, cullPercent=%d, mode=%d\n", workloads, maxElements, cullPercent, static_cast<int>(mode));
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (mode >= DispatchMode::DispatchModeCount)
+	{
+		OutputDebugStringA("ERROR: Unknown dispatch mode!\n");
+		return 1;
+	}
+	if (workloads <= 0 || maxElements <= 0 || cullPercent < 0 || cullPercent > 100)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	IndirectDispatch test(hInstance, static_cast<uint32_t>(workloads), static_cast<uint32_t>(maxElements), static_cast<uint32_t>(cullPercent), mode);
+	test.Initialize();
+
+	// First run pays for PSO/driver warm-up; time the second one.
+	test.Dispatch();
+	test.Dispatch();
+	double gpuSeconds = test.GetDuration();
+	double cpuSeconds = test.RecordSeconds();
+	double gpuNsPerWorkload = gpuSeconds * 1e9 / workloads;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Mode: " << DispatchModeName(mode) << " Workloads: " << workloads << " (active " << test.ActiveWorkloads() << ") Max elements: " << maxElements << "\n";
+	debugOutput << "Active elements: " << test.ActiveElements() << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuNsPerWorkload << " ns/workload)\n";
+	debugOutput << "CPU recording: " << cpuSeconds << " seconds\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("indirect_dispatch_results.csv", "Mode,ModeName,Workloads,ActiveWorkloads,MaxElements,CullPercent,ActiveElements,Gpu_s,Cpu_s,GpuNsPerWorkload", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(mode), DispatchModeName(mode), workloads, test.ActiveWorkloads(), maxElements, cullPercent,
+		test.ActiveElements(), gpuSeconds, cpuSeconds, gpuNsPerWorkload);
+    return 0;
+}
@@ -0,0 +1,70 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+MODES = {
+    0: "CpuRecorded",
+    1: "Indirect",
+    2: "IndirectCount",
+}
+
+def run_simple_test(tryCount = 4):
+    """Compares CPU-recorded and GPU-driven dispatch over many small variable-sized workloads"""
+
+    program = "..\\x64\\Release\\IndirectDispatch.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "indirect_dispatch_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    max_elements = 1024
+    for workloads in [256, 1024, 4096, 16384, 65536]:
+        for cull in [0, 50, 90]:
+            for mode in MODES:
+                print(f"\nRunning {MODES[mode]} workloads {workloads} cull {cull}%...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(workloads),
+                            str(max_elements),
+                            str(cull),
+                            str(mode)
+                        ], capture_output=True, text=True)
+                        print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_indirect_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = f"{parts[1]} cull {parts[5]}%"
+            series.setdefault(key, ([], []))
+            series[key][0].append(int(parts[2]))
+            series[key][1].append(float(parts[7]) * 1e3)
+
+    for key, (workloads, gpu_ms) in sorted(series.items()):
+        plt.plot(workloads, gpu_ms, marker='o', linestyle='', label=key)
+    plt.xscale('log', base=2)
+    plt.yscale('log')
+    plt.xlabel('Workloads')
+    plt.ylabel('GPU Time (ms)')
+    plt.title('CPU-Recorded vs ExecuteIndirect Dispatch')
+    plt.legend(fontsize=7)
+    plt.grid(True)
+    plt.savefig('IndirectDispatch.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_indirect_results("indirect_dispatch_results.csv")
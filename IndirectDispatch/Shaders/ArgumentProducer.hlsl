@@ -0,0 +1,54 @@
+struct Workload
+{
+    uint Offset;
+    uint Count;     // 0 = culled
+};
+
+// Must match IndirectDispatch::IndirectCommand and the command signature: root constants, then dispatch.
+struct IndirectCommand
+{
+    uint  SegmentOffset;
+    uint  SegmentCount;
+    uint3 Groups;
+};
+
+StructuredBuffer<Workload>          Workloads : register(t0);
+RWStructuredBuffer<IndirectCommand> Commands  : register(u0);
+RWByteAddressBuffer                 Count     : register(u1);
+
+cbuffer params : register(b0)
+{
+    uint WorkloadCount;
+    uint Compact;   // 1: append surviving workloads and count them, 0: one command per workload
+}
+
+static const uint NumThreads = 64;
+
+// GPU side of the culling/compaction pattern: decide per workload and write its dispatch arguments.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    const uint id = groupId.x * NumThreads + threadId.x;
+    if (id >= WorkloadCount)
+    {
+        return;
+    }
+
+    Workload workload = Workloads[id];
+
+    IndirectCommand command;
+    command.SegmentOffset = workload.Offset;
+    command.SegmentCount  = workload.Count;
+    command.Groups        = uint3((workload.Count + NumThreads - 1) / NumThreads, 1, 1);
+
+    if (Compact == 0)
+    {
+        Commands[id] = command;
+    }
+    else if (workload.Count > 0)
+    {
+        uint slot;
+        Count.InterlockedAdd(0, 1, slot);
+        Commands[slot] = command;
+    }
+}
@@ -0,0 +1,23 @@
+StructuredBuffer<float>   Input  : register(t0);
+RWStructuredBuffer<float> Output : register(u0);
+
+// Root constants; with ExecuteIndirect they come from the argument buffer.
+cbuffer params : register(b0)
+{
+    uint SegmentOffset;
+    uint SegmentCount;
+}
+
+static const uint NumThreads = 64;
+
+// One small variable-sized workload: a segment of the shared buffers.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    const uint id = groupId.x * NumThreads + threadId.x;
+
+    if (id < SegmentCount)
+    {
+        Output[SegmentOffset + id] = Input[SegmentOffset + id] * 2.0f + 1.0f;
+    }
+}
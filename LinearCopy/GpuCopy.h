@@ -1,5 +1,6 @@
 #pragma once
 #include "d3dAppSimplified.h"
+#include "DataPatterns.h"
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -23,29 +24,22 @@ public:
 		uint32_t StrideO;
 	};
 
-    GpuCopy(HINSTANCE hInstance, uint32_t width, uint32_t height, uint32_t strideO, uint32_t strideI, ShaderType shadertype) :
+    GpuCopy(HINSTANCE hInstance, uint32_t width, uint32_t height, uint32_t strideO, uint32_t strideI, ShaderType shadertype,
+		DataPattern pattern = DataPattern::RandomPattern, const std::vector<float>& captured = std::vector<float>()) :
 		D3DAppSimplified(hInstance), 
         m_width(width), 
 		m_height(height),
 		m_strideI(strideI), 
 		m_strideO(strideO), 
-		m_shaderType(shadertype) 
+		m_shaderType(shadertype),
+		m_pattern(pattern),
+		m_captured(captured)
 	{ 
     }
 
     void BuildResourcesAndHeaps() override {
-        std::vector<float> inputVectors(m_height * m_width);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> magnitudeDist(1.0f, 10.0f);
-        std::uniform_real_distribution<float> angleDist(0.0f, DirectX::XM_2PI);
-		for (auto& value : inputVectors)
-		{
-			float magnitude = magnitudeDist(gen);
-			float theta = angleDist(gen);        // azimuthal angle
-			float phi = angleDist(gen);          // polar angle
-			value = magnitude * cosf(phi);
-		}
+		// Compressible patterns let the memory system move less than the nominal byte count.
+		std::vector<float> inputVectors = DataPatterns::MakeFloats(m_pattern, m_width, m_height, m_captured);
 
         mDefaultBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), inputVectors.data(), inputVectors.size() * sizeof(float));
 
@@ -179,5 +173,7 @@ public:
 	uint32_t m_strideI;
 	uint32_t m_strideO;
 	ShaderType m_shaderType;
+	DataPattern m_pattern;
+	std::vector<float> m_captured;
 };
 
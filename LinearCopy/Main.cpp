@@ -1,6 +1,8 @@
 #include "d3dApp.h"
 #include "d3dAppSimplified.h"
 #include "GpuCopy.h"
+#include "DataPatterns.h"
+#include "FeatureSupport.h"
 #include <iostream>
 #include <sstream>
 #include <d3dUtil.h>
@@ -20,11 +22,14 @@ int WINAPI WinMain(
 	int    strideI   = 1024;
 	int    strideO   = 1024;
 	ShaderType shaderType = ShaderType::Linear;
+	DataPattern pattern  = DataPattern::RandomPattern;
+	std::wstring capturePath;
 	double bandwidth = 0;
 
 	// Get command line arguments using Windows API
-	// Usage: program.exe <width> <height> <strideI> <strideO> <shaderType>
+	// Usage: program.exe <width> <height> <strideI> <strideO> <shaderType> <pattern> <capturePath>
 	// shaderType: 0=Linear, 1=Tiled, etc.
+	// pattern: 0=Zero, 1=Constant, 2=Gradient, 3=LowEntropy, 4=Random, 5=Captured (raw float32 file at capturePath)
 	int argc;
 	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
 
@@ -51,11 +56,19 @@ int WINAPI WinMain(
 			int shaderTypeInt = _wtoi(argv[5]);
 			shaderType = static_cast<ShaderType>(shaderTypeInt);
 		}
+		if (argc >= 7)
+		{
+			pattern = static_cast<DataPattern>(_wtoi(argv[6]));
+		}
+		if (argc >= 8)
+		{
+			capturePath = argv[7];
+		}
 
 		// Show parsed arguments in debug output
 		wchar_t buffer[512];
-		swprintf_s(buffer, L"Params: width=%d, height=%d, strideI=%d, strideO=%d, shaderType=%d\n",
-			width, height, strideI, strideO, static_cast<int>(shaderType));
+		swprintf_s(buffer, L"Params: width=%d, height=%d, strideI=%d, strideO=%d, shaderType=%d, pattern=%d\n",
+			width, height, strideI, strideO, static_cast<int>(shaderType), static_cast<int>(pattern));
 		OutputDebugStringW(buffer);
 
 		LocalFree(argv);  // Free memory allocated by CommandLineToArgvW
@@ -65,9 +78,17 @@ int WINAPI WinMain(
 		OutputDebugStringA("Failed to parse command line, using defaults\n");
 		assert(true);
 	}
+
+	std::vector<float> captured;
+	if (pattern >= DataPattern::DataPatternCount ||
+		(pattern == DataPattern::CapturedPattern && !DataPatterns::LoadCaptured(capturePath, captured)))
+	{
+		OutputDebugStringA("ERROR: Unknown data pattern or unreadable capture file!\n");
+		return 1;
+	}
 	
 	GpuCopy test(hInstance, static_cast<uint32_t>(width), static_cast<uint32_t>(height), 
-		static_cast<uint32_t>(strideO), static_cast<uint32_t>(strideI), shaderType);
+		static_cast<uint32_t>(strideO), static_cast<uint32_t>(strideI), shaderType, pattern, captured);
 	test.Initialize();
 	test.Dispatch();
 	double duration = test.GetDuration();
@@ -76,7 +97,7 @@ int WINAPI WinMain(
 
 	std::ostringstream debugOutput;
 	debugOutput << "**************************Summary**************************\n";
-	debugOutput << "Height: " << test.m_height << " Width: " << test.m_width << "\n";
+	debugOutput << "Height: " << test.m_height << " Width: " << test.m_width << " Pattern: " << DataPatternName(pattern) << "\n";
 	debugOutput << "Total Bytes Copied: " << bytesCopy << " bytes\n";
 	debugOutput << "GPU Linear Copy Bandwidth: " << bandwidth << " GB/s\n";
 	debugOutput << "GPU Linear Copy Duration:  " << duration << " seconds\n";
@@ -89,9 +110,10 @@ int WINAPI WinMain(
 		// Write header if file is empty
 		csvfile.seekp(0, std::ios::end);
 		if (csvfile.tellp() == 0) {
-			csvfile << "Width ,Height, StrideI, StrideO, Bandwidth_GBs\n";
+			csvfile << "Width ,Height, StrideI, StrideO, Bandwidth_GBs, ShaderType, Pattern, DeviceCaps\n";
 		}
-		csvfile << width << "," << height << "," << strideI << "," << strideO << "," << bandwidth << "\n";
+		csvfile << width << "," << height << "," << strideI << "," << strideO << "," << bandwidth << ","
+			<< static_cast<int>(shaderType) << "," << DataPatternName(pattern) << "," << QueryDeviceCaps(test.Device()).Describe() << "\n";
 		csvfile.close();
 	}
     return 0;
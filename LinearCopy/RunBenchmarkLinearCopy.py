@@ -2,8 +2,18 @@ import subprocess
 import os
 import time
 import matplotlib.pyplot as plt 
-def run_simple_test(tryCount = 8):
-    """Simple version that just runs all sizes"""
+
+PATTERNS = {
+    0: "Zero",
+    1: "Constant",
+    2: "Gradient",
+    3: "LowEntropy",
+    4: "Random",
+    5: "Captured",
+}
+
+def run_simple_test(tryCount = 8, patterns = [0, 1, 2, 3, 4], capturePath = None):
+    """Runs all sizes once per data pattern; pass capturePath to add the captured-data pattern"""
     
     program = "..\\x64\\Release\\GpuCopy.exe"
     
@@ -15,46 +25,55 @@ def run_simple_test(tryCount = 8):
     if os.path.exists(csv_file):
         os.remove(csv_file)        
 
+    if capturePath is not None:
+        patterns = patterns + [5]
 
-    for size in range(8, 1024, 128):
-        print(f"\nRunning size {size}...")
-        
-        # Run 8 times for each size
-        for i in range(tryCount):
-            time.sleep(0.01)
-            try:
-                result = subprocess.run([
-                    program,
-                    str(size),
-                    str(size),
-                    str(size),
-                    str(size),
-                    str(0)
-                ], capture_output=True, text=True)
-                print(f"  Run {i+1}: {result.stdout.strip()}")
-            except Exception as e:
-                print(f"  Run {i+1}: Error - {e}")
+    for pattern in patterns:
+        for size in range(8, 1024, 128):
+            print(f"\nRunning size {size} {PATTERNS[pattern]}...")
+            
+            # Run 8 times for each size
+            for i in range(tryCount):
+                time.sleep(0.01)
+                try:
+                    result = subprocess.run([
+                        program,
+                        str(size),
+                        str(size),
+                        str(size),
+                        str(size),
+                        str(0),
+                        str(pattern),
+                        capturePath if capturePath is not None else ""
+                    ], capture_output=True, text=True)
+                    print(f"  Run {i+1}: {result.stdout.strip()}")
+                except Exception as e:
+                    print(f"  Run {i+1}: Error - {e}")
 
 def plot_bandwidth_results(filename):
-    #read from navi48_bandwidth_resutls.
-    size = []
-    bandwidth = []
+    # One line per data pattern; rows from older runs without the pattern column count as Random.
+    results = {}
     with open(filename, "r") as f:
         # skip first line
         f.readline()
         lines = f.readlines()
         for line in lines:
             parts = line.strip().split(',')
-            size.append(int(parts[0]))
-            bandwidth.append(float(parts[4]))
+            pattern = parts[6] if len(parts) > 6 else "Random"
+            results.setdefault(pattern, {}).setdefault(int(parts[0]), []).append(float(parts[4]))
         
-    print(size)
-    print(bandwidth)
     # plot using matplotlib
-    plt.plot(size, bandwidth, marker='o')
+    for pattern in PATTERNS.values():
+        if pattern not in results:
+            continue
+        size = sorted(results[pattern].keys())
+        bandwidth = [max(results[pattern][s]) for s in size]
+        print(pattern, size, bandwidth)
+        plt.plot(size, bandwidth, marker='o', label=pattern)
     plt.xlabel('Size')
     plt.ylabel('Bandwidth (GB/s)')
-    plt.title('LinearCopy Bandwidth Results')
+    plt.title('LinearCopy Bandwidth Results by Data Pattern')
+    plt.legend()
     plt.grid(True)
     plt.savefig('LinearCopyBandwidth.pdf')   # PDF format
     plt.show() 
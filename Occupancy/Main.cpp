@@ -0,0 +1,140 @@
+#include "d3dAppSimplified.h"
+#include "Occupancy.h"
+#include "OccupancyModel.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	OccupancyMode mode       = OccupancyMode::BandwidthMode;
+	int           groupSize  = 64;
+	int           ldsBytes   = 0;
+	int           pressure   = 4;
+	int           count      = 1 << 22;
+	int           iterations = 256;
+	int           validate   = 1;
+	int           waveSize   = 0;
+
+	// Usage: program.exe <mode> <groupSize> <ldsBytes> <pressure> <count> <iterations> <validate> <waveSize>
+	// mode: 0=Bandwidth, 1=ALU   groupSize: 32..1024, multiple of 32   ldsBytes: groupshared bytes per group (0..32768)
+	// pressure: live float4 accumulators per thread (1..64)   count: input float4s (Bandwidth) or threads (ALU), power of two
+	// iterations: multiply-adds per chain (ALU)   waveSize: 0 = smallest wave size the device reports
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			mode = static_cast<OccupancyMode>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			groupSize = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			ldsBytes = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			pressure = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			count = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			iterations = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			validate = _wtoi(argv[7]);
+		}
+		if (argc >= 9)
+		{
+			waveSize = _wtoi(argv[8]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: mode=%d, groupSize=%d, ldsBytes=%d, pressure=%d, count=%d, iterations=%d, validate=%d, waveSize=%d\n",
+			static_cast<int>(mode), groupSize, ldsBytes, pressure, count, iterations, validate, waveSize);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (mode >= OccupancyMode::OccupancyModeCount)
+	{
+		OutputDebugStringA("ERROR: Unknown mode!\n");
+		return 1;
+	}
+	// 32 KB is the D3D12 groupshared limit per group; 2^24 float4s keep the input at 256 MB.
+	if (groupSize < 32 || groupSize > 1024 || groupSize % 32 != 0 || ldsBytes < 0 || ldsBytes > 32768 || ldsBytes % 4 != 0 ||
+		pressure < 1 || pressure > 64 || count <= 0 || count > (1 << 24) || (count & (count - 1)) != 0 || iterations <= 0 ||
+		(waveSize != 0 && waveSize != 32 && waveSize != 64))
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	Occupancy test(hInstance, mode, static_cast<uint32_t>(groupSize), static_cast<uint32_t>(ldsBytes), static_cast<uint32_t>(pressure),
+		static_cast<uint32_t>(count), static_cast<uint32_t>(iterations), static_cast<uint32_t>(waveSize));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Shader model 6.0 not supported on this device!\n");
+		return 1;
+	}
+
+	bool              fromGpa      = test.QueryLimits();
+	const char*       limitsSource = fromGpa ? "GpaTotals+AssumedPerCu" : "Assumed";
+	OccupancyEstimate estimate     = test.Estimate();
+	const OccupancyLimits& limits = test.Limits();
+
+	uint32_t mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		mismatches = validate != 0 ? test.Validate() : 0;
+	});
+	double gpuGBs     = (test.InputBytes() + test.OutputBytes()) / gpuSeconds / 1e9;
+	double gpuGFlops  = test.Flops() / gpuSeconds / 1e9;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Mode: " << OccupancyModeName(mode) << " Group: " << groupSize << " LDS: " << ldsBytes << " bytes Pressure: " << pressure
+		<< " float4 (~" << test.EstimatedVgprs() << " VGPRs) Wave: " << test.WaveSize() << "\n";
+	debugOutput << "Limits (" << (fromGpa ? "VGPRs and CU count from GPA, the rest assumed for the generation" : "assumed")
+		<< "): " << limits.WavesPerSimd << " waves x " << limits.SimdsPerCu << " SIMDs, "
+		<< limits.VgprsPerLane << " VGPRs/lane, " << limits.LdsBytesPerCu << " LDS bytes/CU, " << limits.ComputeUnits << " CUs\n";
+	debugOutput << "Occupancy: " << estimate.Occupancy * 100.0 << "% (" << estimate.GroupsPerCu << " groups, " << estimate.WavesPerCu
+		<< " waves per CU, limited by " << OccupancyLimiterName(estimate.Limiter) << ")\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGBs << " GB/s, " << gpuGFlops << " GFLOP/s)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("occupancy_results.csv", "Device,Mode,GroupSize,LdsBytes,Pressure,EstimatedVgprs,WaveSize,Limits,WavesPerGroup,GroupsPerCu,"
+		"WavesPerCu,Occupancy,Limiter,Gpu_s,Gpu_GBs,Gpu_GFlops,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(QueryAdapterKey(test.Device()), OccupancyModeName(mode), groupSize, ldsBytes, pressure, test.EstimatedVgprs(), test.WaveSize(),
+		limitsSource, estimate.WavesPerGroup, estimate.GroupsPerCu, estimate.WavesPerCu, estimate.Occupancy,
+		OccupancyLimiterName(estimate.Limiter), gpuSeconds, gpuGBs, gpuGFlops, validate, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
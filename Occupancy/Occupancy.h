@@ -0,0 +1,266 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "DataPatterns.h"
+#include "GPAWrapper.h"
+#include "OccupancyModel.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+enum OccupancyMode : uint32_t {
+    BandwidthMode = 0,  // every thread loads VGPR_PRESSURE float4s before summing them (loads in flight)
+    AluMode,            // every thread runs VGPR_PRESSURE independent FMA chains
+    OccupancyModeCount
+};
+
+inline const char* OccupancyModeName(OccupancyMode mode)
+{
+    switch (mode)
+    {
+    case OccupancyMode::BandwidthMode: return "Bandwidth";
+    case OccupancyMode::AluMode:       return "ALU";
+    default:                           return "Unknown";
+    }
+}
+
+// One point of the occupancy sweep (Shaders/Occupancy.hlsl): a group size, a groupshared
+// allocation and a number of float4 accumulators that stay live in VGPRs, all compiled in through
+// defines. The theoretical occupancy of the point comes from OccupancyModel. GPA only reports
+// device totals, so the per-CU limits are always assumed: from a table per hardware generation when
+// GPA knows the device, from OccupancyModel::AssumedLimits otherwise.
+class Occupancy : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Count;
+		uint32_t Threads;
+		uint32_t GroupsX;
+		uint32_t Iterations;
+	};
+
+    // VGPRs the kernel needs besides the accumulators (indices, addresses, loop state). Only an
+    // estimate: the real count is in the driver's ISA (Radeon GPU Analyzer shows it).
+    static const uint32_t BaseVgprs  = 12;
+
+    Occupancy(HINSTANCE hInstance, OccupancyMode mode, uint32_t groupSize, uint32_t ldsBytes, uint32_t pressure, uint32_t count,
+		uint32_t iterations, uint32_t waveSize) :
+		D3DAppSimplified(hInstance),
+		m_mode(mode),
+		m_groupSize(groupSize),
+		m_ldsBytes(ldsBytes),
+		m_pressure(pressure),
+		m_count(count),
+		m_iterations(iterations),
+		m_waveSize(waveSize)
+	{
+		if (mode == OccupancyMode::BandwidthMode)
+		{
+			mHostData = DataPatterns::MakeFloats(DataPattern::RandomPattern, count * 4, 1, {});
+		}
+	}
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		// The ALU mode reads nothing; it still binds a (minimal) input so the root signature is shared.
+		std::vector<float> dummy(4, 0.0f);
+		const std::vector<float>& input = mHostData.empty() ? dummy : mHostData;
+		mInputBuffer    = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), input.data(), input.size() * sizeof(float));
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, OutputBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, OutputBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		mShader = D3DUtil::CompileShaderDxc(L"Shaders\\Occupancy.hlsl", {
+			L"MODE=" + std::to_wstring(static_cast<uint32_t>(m_mode)),
+			L"GROUP_SIZE=" + std::to_wstring(m_groupSize),
+			L"LDS_BYTES=" + std::to_wstring(m_ldsBytes),
+			L"VGPR_PRESSURE=" + std::to_wstring(m_pressure)
+		}, L"main", L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShader.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		uint32_t groups  = DivideRoundUp(Threads(), m_groupSize);
+		RootConstants constants = { m_count, Threads(), GroupsX(groups), m_iterations };
+
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		DispatchGroups(groups);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, OutputBytes());
+		}
+    }
+
+	// Takes the VGPR file and CU count from GPA (AMD only) and the rest of the CU limits from the table
+	// below; false means OccupancyModel::AssumedLimits are used instead.
+	bool QueryLimits()
+	{
+		GPAWrapper gpa;
+		GpaHwGeneration generation = kGpaHwGenerationNone;
+		GpaUInt32 waveSlots = 0;
+		GpaUInt32 vgprs     = 0;
+		m_limits = OccupancyModel::AssumedLimits(m_waveSize);
+		if (!gpa.Initialize(Device(), CommandQueue()) || !gpa.GetDeviceGeneration(generation) ||
+			!gpa.GetDeviceMaxWaveSlots(waveSlots) || !gpa.GetDeviceMaxVgprs(vgprs) || waveSlots == 0 || vgprs == 0)
+		{
+			OutputDebugStringA("GPA device limits not available, using assumed limits\n");
+			return false;
+		}
+
+		// GPA reports device totals; waves per SIMD, SIMDs per CU, LDS and the group limit are assumed
+		// from the generation.
+		uint32_t nativeWaveSize = 32;
+		switch (generation)
+		{
+		case kGpaHwGenerationGfx6:
+		case kGpaHwGenerationGfx7:
+		case kGpaHwGenerationGfx8:
+		case kGpaHwGenerationGfx9:
+			m_limits = { m_waveSize, 10, 4, vgprs, 4, 64 * 1024, 16, 0 };
+			nativeWaveSize = 64;
+			break;
+		case kGpaHwGenerationCdna:
+		case kGpaHwGenerationCdna2:
+		case kGpaHwGenerationCdna3:
+			m_limits = { m_waveSize, 8, 4, vgprs, 8, 64 * 1024, 16, 0 };
+			nativeWaveSize = 64;
+			break;
+		case kGpaHwGenerationGfx10:
+			m_limits = { m_waveSize, 20, 2, vgprs, 8, 64 * 1024, 32, 0 };
+			break;
+		case kGpaHwGenerationGfx103:
+		case kGpaHwGenerationGfx11:
+		case kGpaHwGenerationGfx12:
+			m_limits = { m_waveSize, 16, 2, vgprs, 8, 64 * 1024, 32, 0 };
+			break;
+		default:
+			OutputDebugStringA("Unknown GPA hardware generation, using assumed limits\n");
+			return false;
+		}
+		// A wave wider than the SIMD takes several lanes' worth of the VGPR file.
+		if (m_waveSize > nativeWaveSize)
+		{
+			m_limits.VgprsPerLane = m_limits.VgprsPerLane * nativeWaveSize / m_waveSize;
+		}
+		m_limits.ComputeUnits = waveSlots / (m_limits.WavesPerSimd * m_limits.SimdsPerCu);
+		return true;
+	}
+
+	OccupancyEstimate Estimate() const { return OccupancyModel::Estimate(m_limits, m_groupSize, m_ldsBytes, EstimatedVgprs()); }
+
+	bool     Supported()      const { return m_supported; }
+	uint32_t WaveSize()       const { return m_waveSize; }
+	uint32_t EstimatedVgprs() const { return BaseVgprs + 4 * m_pressure; }
+	const OccupancyLimits& Limits() const { return m_limits; }
+	uint32_t Threads()        const { return m_mode == OccupancyMode::BandwidthMode ? DivideRoundUp(m_count, m_pressure) : m_count; }
+	UINT64   InputBytes()     const { return m_mode == OccupancyMode::BandwidthMode ? static_cast<UINT64>(m_count) * 4 * sizeof(float) : 0; }
+	UINT64   OutputBytes()    const { return static_cast<UINT64>(Threads()) * 4 * sizeof(float); }
+	// One multiply-add (2 flops) per component, accumulator and iteration.
+	double   Flops()          const { return m_mode == OccupancyMode::AluMode ? 2.0 * 4 * m_pressure * m_iterations * static_cast<double>(m_count) : 0.0; }
+
+	// Outputs of the last Dispatch() with SetCopyResults(true) that differ from the host sums. Only
+	// the bandwidth mode is checked; the FMA chains depend on the device's fused multiply-add.
+	uint32_t Validate()
+	{
+		if (m_mode != OccupancyMode::BandwidthMode)
+		{
+			return 0;
+		}
+		uint32_t threads = Threads();
+		float* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(OutputBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t mismatches = 0;
+		for (uint32_t t = 0; t < threads; ++t)
+		{
+			for (uint32_t c = 0; c < 4; ++c)
+			{
+				// Same order as the shader: accumulator 0 plus the others in turn, missing elements as 0.
+				float reference = mHostData[static_cast<size_t>(t) * 4 + c];
+				for (uint32_t j = 1; j < m_pressure; ++j)
+				{
+					uint64_t i = t + static_cast<uint64_t>(j) * threads;
+					reference += i < m_count ? mHostData[i * 4 + c] : 0.0f;
+				}
+				float value = mapped[static_cast<size_t>(t) * 4 + c];
+				mismatches += std::fabs(value - reference) > 1e-5f * (std::max)(std::fabs(reference), 1.0f) ? 1 : 0;
+			}
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		// Without an explicit wave size the waves are assumed to be as narrow as the device allows.
+		D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+		if (m_waveSize == 0)
+		{
+			m_waveSize = SUCCEEDED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) &&
+				options1.WaveOps && options1.WaveLaneCountMin != 0 ? options1.WaveLaneCountMin : 64;
+		}
+		m_limits = OccupancyModel::AssumedLimits(m_waveSize);
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<float> mHostData;
+	OccupancyLimits    m_limits = {};
+
+	OccupancyMode m_mode;
+	uint32_t      m_groupSize;
+	uint32_t      m_ldsBytes;
+	uint32_t      m_pressure;
+	uint32_t      m_count;
+	uint32_t      m_iterations;
+	uint32_t      m_waveSize;
+	bool          m_supported = false;
+};
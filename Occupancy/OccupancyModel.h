@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+
+// Theoretical occupancy of one compute kernel: how many of a CU's wave slots can be resident at
+// once given the kernel's group size, groupshared allocation and VGPR count. No D3D or GPA
+// dependency; Occupancy.h fills OccupancyLimits from GPA (or the assumed defaults below).
+
+enum OccupancyLimiter : uint32_t {
+    WaveSlotLimit = 0,  // every wave slot of the CU is used
+    VgprLimit,          // the VGPR file of a SIMD runs out first
+    LdsLimit,           // groupshared memory of the CU runs out first
+    GroupLimit,         // the per-CU workgroup limit, or whole groups no longer fit the free slots;
+                        // 0 groups per CU means the kernel does not fit at all (the driver would spill)
+    OccupancyLimiterCount
+};
+
+inline const char* OccupancyLimiterName(OccupancyLimiter limiter)
+{
+    switch (limiter)
+    {
+    case OccupancyLimiter::WaveSlotLimit: return "WaveSlots";
+    case OccupancyLimiter::VgprLimit:     return "VGPR";
+    case OccupancyLimiter::LdsLimit:      return "LDS";
+    case OccupancyLimiter::GroupLimit:    return "Groups";
+    default:                              return "Unknown";
+    }
+}
+
+struct OccupancyLimits
+{
+    uint32_t WaveSize;         // lanes per wave
+    uint32_t WavesPerSimd;     // wave slots of one SIMD
+    uint32_t SimdsPerCu;
+    uint32_t VgprsPerLane;     // VGPR file of one SIMD lane, shared by its resident waves
+    uint32_t VgprGranule;      // VGPRs are allocated per wave in multiples of this
+    uint32_t LdsBytesPerCu;
+    uint32_t MaxGroupsPerCu;
+    uint32_t ComputeUnits;     // 0 when unknown; only used for reporting
+};
+
+struct OccupancyEstimate
+{
+    uint32_t         WavesPerGroup;
+    uint32_t         GroupsPerCu;
+    uint32_t         WavesPerCu;
+    double           Occupancy;  // WavesPerCu / wave slots of the CU, 0..1
+    OccupancyLimiter Limiter;
+};
+
+namespace OccupancyModel
+{
+    // Limits of a CU when GPA is not available (non-AMD devices): 16 waves on each of 4 SIMDs with a
+    // 512-entry VGPR file per lane, which is close to both RDNA CUs and NVIDIA SMs.
+    inline OccupancyLimits AssumedLimits(uint32_t waveSize)
+    {
+        return { waveSize, 16, 4, 512, 8, 64 * 1024, 32, 0 };
+    }
+
+    inline uint32_t RoundUp(uint32_t value, uint32_t granule) { return (value + granule - 1) / granule * granule; }
+
+    // Groups are resident on one CU as a whole and their waves are spread evenly over its SIMDs.
+    inline OccupancyEstimate Estimate(const OccupancyLimits& limits, uint32_t groupSize, uint32_t ldsBytes, uint32_t vgprs)
+    {
+        OccupancyEstimate estimate = {};
+        estimate.WavesPerGroup = (groupSize + limits.WaveSize - 1) / limits.WaveSize;
+
+        uint32_t slotsPerCu    = limits.WavesPerSimd * limits.SimdsPerCu;
+        uint32_t allocated     = RoundUp((std::max)(vgprs, 1u), limits.VgprGranule);
+        uint32_t wavesByVgpr   = (std::min)(limits.WavesPerSimd, limits.VgprsPerLane / allocated) * limits.SimdsPerCu;
+
+        uint32_t groupsBySlots = slotsPerCu / estimate.WavesPerGroup;
+        uint32_t groupsByVgpr  = wavesByVgpr / estimate.WavesPerGroup;
+        uint32_t groupsByLds   = ldsBytes == 0 ? groupsBySlots : limits.LdsBytesPerCu / ldsBytes;
+        // Single-wave groups need no barrier resource, so the per-CU group limit does not apply to them.
+        uint32_t groupsByLimit = estimate.WavesPerGroup == 1 ? groupsBySlots : limits.MaxGroupsPerCu;
+
+        estimate.GroupsPerCu = (std::min)((std::min)(groupsBySlots, groupsByVgpr), (std::min)(groupsByLds, groupsByLimit));
+        estimate.WavesPerCu  = estimate.GroupsPerCu * estimate.WavesPerGroup;
+        estimate.Occupancy   = static_cast<double>(estimate.WavesPerCu) / slotsPerCu;
+
+        if (estimate.WavesPerCu == slotsPerCu)
+        {
+            estimate.Limiter = OccupancyLimiter::WaveSlotLimit;
+        }
+        else if (estimate.GroupsPerCu == groupsByVgpr && wavesByVgpr < slotsPerCu)
+        {
+            estimate.Limiter = OccupancyLimiter::VgprLimit;
+        }
+        else if (estimate.GroupsPerCu == groupsByLds && ldsBytes != 0)
+        {
+            estimate.Limiter = OccupancyLimiter::LdsLimit;
+        }
+        else
+        {
+            estimate.Limiter = OccupancyLimiter::GroupLimit;
+        }
+        return estimate;
+    }
+}
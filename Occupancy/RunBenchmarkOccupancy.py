@@ -0,0 +1,104 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+MODES = {
+    0: "Bandwidth",
+    1: "ALU",
+}
+
+GROUP_SIZES = [32, 64, 128, 256, 512, 1024]
+LDS_BYTES = [0, 4096, 8192, 16384, 32768]
+PRESSURES = [1, 2, 4, 8, 16, 32, 64]
+
+COUNTS = {
+    0: 1 << 22,
+    1: 1 << 20,
+}
+
+def sweep_points():
+    """One axis at a time around the default point (group 64, no LDS, 4 accumulators)"""
+    points = set()
+    for groupSize in GROUP_SIZES:
+        points.add((groupSize, 0, 4))
+    for ldsBytes in LDS_BYTES:
+        points.add((256, ldsBytes, 4))
+    for pressure in PRESSURES:
+        points.add((64, 0, pressure))
+        points.add((256, 0, pressure))
+    return sorted(points)
+
+def run_simple_test(tryCount = 3, iterations = 256):
+    """Runs every sweep point in both modes"""
+
+    program = "..\\x64\\Release\\Occupancy.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "occupancy_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for mode in MODES:
+        for groupSize, ldsBytes, pressure in sweep_points():
+            print(f"\nRunning {MODES[mode]} group {groupSize} LDS {ldsBytes} pressure {pressure}...")
+            for i in range(tryCount):
+                time.sleep(0.01)
+                try:
+                    result = subprocess.run([
+                        program,
+                        str(mode),
+                        str(groupSize),
+                        str(ldsBytes),
+                        str(pressure),
+                        str(COUNTS[mode]),
+                        str(iterations),
+                        # Validate the first run of each configuration only.
+                        "1" if i == 0 else "0"
+                    ], capture_output=True, text=True)
+                    if result.returncode != 0:
+                        print(f"  Run {i+1}: failed (exit {result.returncode})")
+                    else:
+                        print(f"  Run {i+1}: {result.stdout.strip()}")
+                except Exception as e:
+                    print(f"  Run {i+1}: Error - {e}")
+
+def plot_occupancy_results(filename):
+    results = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = (parts[1], int(parts[2]), int(parts[3]), int(parts[4]))
+            value = float(parts[14]) if parts[1] == "Bandwidth" else float(parts[15])
+            best = results.get(key, (float(parts[11]), parts[12], 0.0))
+            results[key] = (best[0], best[1], max(best[2], value))
+
+    fig, axes = plt.subplots(1, len(MODES), figsize=(14, 5))
+    for ax, mode in zip(axes, MODES.values()):
+        byLimiter = {}
+        for (m, groupSize, ldsBytes, pressure), (occupancy, limiter, value) in results.items():
+            if m != mode:
+                continue
+            byLimiter.setdefault(limiter, []).append((occupancy, value, f"{groupSize}/{ldsBytes}/{pressure}"))
+        for limiter, points in sorted(byLimiter.items()):
+            ax.scatter([p[0] for p in points], [p[1] for p in points], label=f"limited by {limiter}")
+            for occupancy, value, label in points:
+                ax.annotate(label, (occupancy, value), fontsize=5)
+        ax.set_xlabel('Theoretical occupancy')
+        ax.set_ylabel('GB/s' if mode == "Bandwidth" else 'GFLOP/s')
+        ax.set_title(f"{mode} (labels: group/LDS bytes/accumulators)")
+        ax.grid(True)
+        ax.legend(fontsize=6)
+    plt.suptitle('Achieved Throughput vs Theoretical Occupancy')
+    plt.tight_layout()
+    plt.savefig('Occupancy.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_occupancy_results("occupancy_results.csv")
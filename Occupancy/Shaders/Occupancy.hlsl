@@ -0,0 +1,81 @@
+// One point of the occupancy sweep. Compiled with DXC (cs_6_0); the point is selected by defines:
+//   MODE           0=bandwidth: thread t loads Input[t + j * Threads] for every accumulator j before
+//                  adding them up, so VGPR_PRESSURE loads are in flight per thread
+//                  1=ALU: thread t runs VGPR_PRESSURE independent multiply-add chains for Iterations
+//   GROUP_SIZE     threads per group (32..1024)
+//   LDS_BYTES      groupshared allocation per group (0..32768); all of it is written so it stays allocated
+//   VGPR_PRESSURE  float4 accumulators live at the same time (4 VGPRs each)
+//
+// Out[t] = acc[0] + acc[1] + ... in order, so the bandwidth mode has an exact host reference.
+
+StructuredBuffer<float4>   Input  : register(t0);
+RWStructuredBuffer<float4> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Count;       // input float4s (bandwidth) or threads (ALU)
+    uint Threads;     // threads that produce an output
+    uint GroupsX;
+    uint Iterations;  // multiply-adds per chain (ALU)
+}
+
+#if LDS_BYTES > 0
+static const uint LdsWords = LDS_BYTES / 4;
+groupshared uint Scratch[LdsWords];
+#endif
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint t = (groupId.y * GroupsX + groupId.x) * GROUP_SIZE + threadId.x;
+
+#if LDS_BYTES > 0
+    for (uint w = threadId.x; w < LdsWords; w += GROUP_SIZE)
+    {
+        Scratch[w] = w;
+    }
+    GroupMemoryBarrierWithGroupSync();
+#endif
+
+    if (t >= Threads)
+    {
+        return;
+    }
+
+    float4 acc[VGPR_PRESSURE];
+#if MODE == 0
+    [unroll]
+    for (uint j = 0; j < VGPR_PRESSURE; ++j)
+    {
+        uint i = t + j * Threads;
+        acc[j] = i < Count ? Input[i] : float4(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+#else
+    [unroll]
+    for (uint j = 0; j < VGPR_PRESSURE; ++j)
+    {
+        acc[j] = float4(t, j, t ^ j, 1.0f) * 1e-7f;
+    }
+    [loop]
+    for (uint n = 0; n < Iterations; ++n)
+    {
+        [unroll]
+        for (uint k = 0; k < VGPR_PRESSURE; ++k)
+        {
+            acc[k] = mad(acc[k], 0.9999f, 1e-4f);
+        }
+    }
+#endif
+
+    float4 sum = acc[0];
+    [unroll]
+    for (uint s = 1; s < VGPR_PRESSURE; ++s)
+    {
+        sum += acc[s];
+    }
+#if LDS_BYTES > 0
+    // Never true (the scratch holds word indices), but the compiler cannot know that.
+    sum.w += Scratch[(t * 7) % LdsWords] == 0xFFFFFFFFu ? 1.0f : 0.0f;
+#endif
+    Output[t] = sum;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+// Parallel LSD radix sort on the host, 8-bit digits like the GPU kernels: per-thread digit counts,
+// offsets prefixed digit-major then thread-major (which keeps the sort stable), then every thread
+// scatters its own chunk. Validates the GPU sort and serves as the host baseline. No D3D dependency.
+
+#include "Hash.h"
+#include "ParallelFor.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+enum KeyDistribution : uint32_t {
+    UniformKeys   = 0,  // hashed, every bit random
+    FewUniqueKeys = 1,  // 16 distinct random values
+    PreSortedKeys = 2,  // ascending
+    SegmentedKeys = 3,  // top byte = segment (256 ascending segments), random below: sorting the
+                        // whole array is a segmented sort of the low bits
+    KeyDistributionCount
+};
+
+inline const char* KeyDistributionName(KeyDistribution distribution)
+{
+    switch (distribution)
+    {
+    case KeyDistribution::UniformKeys:   return "Uniform";
+    case KeyDistribution::FewUniqueKeys: return "FewUnique";
+    case KeyDistribution::PreSortedKeys: return "PreSorted";
+    case KeyDistribution::SegmentedKeys: return "Segmented";
+    default:                             return "Unknown";
+    }
+}
+
+namespace CpuRadixSort
+{
+    static const uint32_t RadixBits = 8;
+    static const uint32_t Radix     = 1u << RadixBits;
+
+    // Key i of `count` for the given distribution, in the low `keyBits` bits.
+    inline uint64_t MakeKey(KeyDistribution distribution, uint64_t i, uint64_t count, uint32_t keyBits)
+    {
+        uint64_t mask = keyBits == 64 ? ~0ull : ((1ull << keyBits) - 1);
+        switch (distribution)
+        {
+        case KeyDistribution::FewUniqueKeys:
+            return Hash64(Hash64(i) % 16) & mask;
+        case KeyDistribution::PreSortedKeys:
+            return i & mask;
+        case KeyDistribution::SegmentedKeys:
+        {
+            uint64_t segment = i * 256 / (count == 0 ? 1 : count);
+            return ((segment << (keyBits - 8)) | (Hash64(i) & (mask >> 8))) & mask;
+        }
+        default:
+            return Hash64(i) & mask;
+        }
+    }
+
+    // Sorts keys (and payloads, if non-empty) in place; allocates one scratch copy of each.
+    template <typename Key>
+    void Sort(std::vector<Key>& keys, std::vector<uint32_t>& payloads, uint32_t threads)
+    {
+        const size_t count  = keys.size();
+        const bool   carry  = !payloads.empty();
+        const uint32_t passes = static_cast<uint32_t>(sizeof(Key)) * 8 / RadixBits;
+
+        std::vector<Key>      keysOut(count);
+        std::vector<uint32_t> payloadsOut(carry ? count : 0);
+        std::vector<size_t>   offsets(static_cast<size_t>(threads) * Radix);
+
+        for (uint32_t pass = 0; pass < passes; ++pass)
+        {
+            const uint32_t shift = pass * RadixBits;
+            std::fill(offsets.begin(), offsets.end(), 0);
+
+            ParallelFor(count, threads, [&](uint32_t worker, size_t begin, size_t end) {
+                size_t* counts = &offsets[static_cast<size_t>(worker) * Radix];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    ++counts[(keys[i] >> shift) & (Radix - 1)];
+                }
+            });
+
+            size_t running = 0;
+            for (uint32_t digit = 0; digit < Radix; ++digit)
+            {
+                for (uint32_t worker = 0; worker < threads; ++worker)
+                {
+                    size_t& slot = offsets[static_cast<size_t>(worker) * Radix + digit];
+                    size_t c = slot;
+                    slot = running;
+                    running += c;
+                }
+            }
+
+            ParallelFor(count, threads, [&](uint32_t worker, size_t begin, size_t end) {
+                size_t* next = &offsets[static_cast<size_t>(worker) * Radix];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    size_t destination = next[(keys[i] >> shift) & (Radix - 1)]++;
+                    keysOut[destination] = keys[i];
+                    if (carry)
+                    {
+                        payloadsOut[destination] = payloads[i];
+                    }
+                }
+            });
+
+            keys.swap(keysOut);
+            if (carry)
+            {
+                payloads.swap(payloadsOut);
+            }
+        }
+    }
+}
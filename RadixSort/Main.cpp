@@ -0,0 +1,156 @@
+#include "d3dAppSimplified.h"
+#include "RadixSort.h"
+#include "CpuRadixSort.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+// Runs the host sort on a copy of the input and compares it with the GPU output; returns mismatches.
+template <typename Key>
+int ValidateAndTimeHost(RadixSort& test, bool payload, uint32_t cpuThreads, bool validate, double& cpuSeconds)
+{
+	const std::vector<uint32_t>& words = test.HostKeyWords();
+	size_t count = words.size() * sizeof(uint32_t) / sizeof(Key);
+
+	std::vector<Key> keys(count);
+	memcpy(keys.data(), words.data(), count * sizeof(Key));
+	std::vector<uint32_t> payloads(payload ? count : 0);
+	for (size_t i = 0; i < payloads.size(); ++i)
+	{
+		payloads[i] = static_cast<uint32_t>(i);
+	}
+
+	CpuTimer timer;
+	timer.Start();
+	CpuRadixSort::Sort(keys, payloads, cpuThreads);
+	cpuSeconds = timer.Stop();
+
+	if (!validate)
+	{
+		return 0;
+	}
+	std::vector<uint32_t> gpuKeyWords;
+	std::vector<uint32_t> gpuPayloads;
+	test.ReadResults(gpuKeyWords, gpuPayloads);
+
+	int mismatches = 0;
+	const Key* gpuKeys = reinterpret_cast<const Key*>(gpuKeyWords.data());
+	for (size_t i = 0; i < count; ++i)
+	{
+		// The sort is stable, so payloads (original indices) must match too.
+		mismatches += gpuKeys[i] != keys[i] || (payload && gpuPayloads[i] != payloads[i]) ? 1 : 0;
+	}
+	return mismatches;
+}
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	int             keyBits      = 32;
+	int             payload      = 0;
+	KeyDistribution distribution = KeyDistribution::UniformKeys;
+	int             keys         = 1 << 24;
+	int             validate     = 1;
+	int             cpuThreads   = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <keyBits> <payload> <distribution> <keys> <validate> <cpuThreads>
+	// keyBits: 32 or 64   payload: 0/1   distribution: 0=Uniform, 1=FewUnique, 2=PreSorted, 3=Segmented
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			keyBits = _wtoi(argv[1]);
+		}
+		if (argc >= 3)
+		{
+			payload = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			distribution = static_cast<KeyDistribution>(_wtoi(argv[3]));
+		}
+		if (argc >= 5)
+		{
+			keys = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			validate = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			cpuThreads = _wtoi(argv[6]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: keyBits=%d, payload=%d, distribution=%d, keys=%d, validate=%d, cpuThreads=%d\n",
+			keyBits, payload, static_cast<int>(distribution), keys, validate, cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (distribution >= KeyDistribution::KeyDistributionCount)
+	{
+		OutputDebugStringA("ERROR: Unknown key distribution!\n");
+		return 1;
+	}
+	// Key, payload and their readback buffers are each limited to 2 GB.
+	if ((keyBits != 32 && keyBits != 64) || keys <= 0 || keys > (1 << (keyBits == 64 ? 28 : 29)) || cpuThreads <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	RadixSort test(hInstance, static_cast<uint32_t>(keyBits), payload != 0, distribution, static_cast<uint32_t>(keys));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Radix sort needs shader model 6.0 with 16-128 lane waves!\n");
+		return 1;
+	}
+
+	double cpuSeconds = 0.0;
+	int    mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		mismatches = keyBits == 64
+			? ValidateAndTimeHost<uint64_t>(test, payload != 0, static_cast<uint32_t>(cpuThreads), validate != 0, cpuSeconds)
+			: ValidateAndTimeHost<uint32_t>(test, payload != 0, static_cast<uint32_t>(cpuThreads), validate != 0, cpuSeconds);
+	});
+	double gpuMkeys   = keys / gpuSeconds / 1e6;
+	double cpuMkeys   = keys / cpuSeconds / 1e6;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Keys: " << keys << " x " << keyBits << "-bit" << (payload ? " + payload" : "") << " Distribution: " << KeyDistributionName(distribution)
+		<< " Passes: " << test.DigitPasses() << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuMkeys << " Mkeys/s)\n";
+	debugOutput << "CPU (" << cpuThreads << " threads): " << cpuSeconds << " seconds (" << cpuMkeys << " Mkeys/s)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("radix_sort_results.csv", "KeyBits,Payload,Distribution,Keys,Passes,Gpu_s,GpuMkeysPerSecond,CpuThreads,Cpu_s,CpuMkeysPerSecond,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(keyBits, payload, KeyDistributionName(distribution), keys, test.DigitPasses(), gpuSeconds, gpuMkeys,
+		cpuThreads, cpuSeconds, cpuMkeys, validate, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuRadixSort.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Onesweep-style LSD radix sort (Shaders/RadixSort.hlsl). One read of the keys builds the digit
+// histograms of all passes, then each 8-bit digit pass is a single chained-scan dispatch. The
+// unsorted keys stay untouched in an SRV buffer: pass 0 reads them, later passes ping-pong between
+// two UAV buffers and the sorted result always ends in the second one (the pass count is even).
+class RadixSort : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Count;
+		uint32_t GroupsX;
+		uint32_t Partitions;
+		uint32_t Pass;
+	};
+
+    static const uint32_t NumThreads          = 256;
+    static const uint32_t Radix               = 256;
+    static const uint32_t TileSize            = 256 * 16;
+    static const uint32_t HistogramGroups     = 1024;
+
+    RadixSort(HINSTANCE hInstance, uint32_t keyBits, bool payload, KeyDistribution distribution, uint32_t keys) :
+		D3DAppSimplified(hInstance),
+		m_keyBits(keyBits),
+		m_payload(payload),
+		m_distribution(distribution),
+		m_count(keys)
+	{
+		mHostKeys.resize(static_cast<size_t>(m_count) * KeyWords());
+		for (uint32_t i = 0; i < m_count; ++i)
+		{
+			uint64_t key = CpuRadixSort::MakeKey(m_distribution, i, m_count, m_keyBits);
+			memcpy(&mHostKeys[static_cast<size_t>(i) * KeyWords()], &key, KeyBytes());
+		}
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		UINT64 keyBytes     = static_cast<UINT64>(m_count) * KeyBytes();
+		UINT64 payloadBytes = static_cast<UINT64>(m_count) * sizeof(uint32_t);
+		mKeys = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostKeys.data(), keyBytes);
+		for (int i = 0; i < 2; ++i)
+		{
+			mKeysPingPong[i] = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, keyBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+			if (m_payload)
+			{
+				mPayloadPingPong[i] = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, payloadBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+			}
+		}
+		mHistogram = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>(HistogramWords()) * sizeof(uint32_t),
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mLookback  = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>(LookbackWords()) * sizeof(uint32_t),
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		// Separate readbacks for keys and payloads, so each stays within the 2 GB buffer limit on its own.
+		mKeyReadback = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, keyBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+		if (m_payload)
+		{
+			mPayloadReadback = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, payloadBytes, D3D12_RESOURCE_FLAG_NONE,
+				D3D12_RESOURCE_STATE_COPY_DEST);
+		}
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		std::vector<std::wstring> defines = {
+			L"KEY64=" + std::to_wstring(m_keyBits == 64 ? 1 : 0),
+			L"PAYLOAD=" + std::to_wstring(m_payload ? 1 : 0)
+		};
+		const wchar_t* entryPoints[KernelCount] = { L"InitState", L"GlobalHistogram", L"ScanHistogram", L"Onesweep" };
+		for (int i = 0; i < KernelCount; ++i)
+		{
+			mShaders[i] = D3DUtil::CompileShaderDxc(L"Shaders\\RadixSort.hlsl", defines, entryPoints[i], L"cs_6_0");
+		}
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[8];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		for (UINT i = 0; i < 6; ++i)
+		{
+			slotRootParameter[2 + i].InitAsUnorderedAccessView(i);
+		}
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(8, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		for (int i = 0; i < KernelCount; ++i)
+		{
+			mPSOs[i] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[i].Get());
+		}
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetComputeRootShaderResourceView(1, mKeys->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(6, mHistogram->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(7, mLookback->GetGPUVirtualAddress());
+		BindPass(0);
+
+		uint32_t initWords = (std::max)(LookbackWords(), HistogramWords());
+		SetConstantsAndDispatch(mPSOs[InitState].Get(), DivideRoundUp(initWords, NumThreads), LookbackWords());
+		UavBarrier();
+		SetConstantsAndDispatch(mPSOs[GlobalHistogram].Get(), (std::min)(Partitions(), HistogramGroups), 0);
+		UavBarrier();
+		SetConstantsAndDispatch(mPSOs[ScanHistogram].Get(), DigitPasses(), 0);
+		UavBarrier();
+
+		for (uint32_t pass = 0; pass < DigitPasses(); ++pass)
+		{
+			BindPass(pass);
+			SetConstantsAndDispatch(mPSOs[Onesweep].Get(), Partitions(), pass);
+			UavBarrier();
+		}
+
+		if (CopyResults())
+		{
+			UINT64 keyBytes = static_cast<UINT64>(m_count) * KeyBytes();
+			std::vector<D3D12_RESOURCE_BARRIER> barriers;
+			barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(mKeysPingPong[1].Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE));
+			if (m_payload)
+			{
+				barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(mPayloadPingPong[1].Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE));
+			}
+			commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+			commandList->CopyBufferRegion(mKeyReadback.Get(), 0, mKeysPingPong[1].Get(), 0, keyBytes);
+			if (m_payload)
+			{
+				commandList->CopyBufferRegion(mPayloadReadback.Get(), 0, mPayloadPingPong[1].Get(), 0, static_cast<UINT64>(m_count) * sizeof(uint32_t));
+			}
+		}
+    }
+
+	bool     Supported()   const { return m_supported; }
+	uint32_t DigitPasses() const { return m_keyBits / 8; }
+	uint32_t Partitions()  const { return (std::max)(DivideRoundUp(m_count, TileSize), 1u); }
+	const std::vector<uint32_t>& HostKeyWords() const { return mHostKeys; }
+
+	// Sorted keys (as 32-bit words) and payloads from the last Dispatch() with SetCopyResults(true).
+	void ReadResults(std::vector<uint32_t>& keyWords, std::vector<uint32_t>& payloads)
+	{
+		size_t keyBytes     = static_cast<size_t>(m_count) * KeyBytes();
+		size_t payloadBytes = m_payload ? static_cast<size_t>(m_count) * sizeof(uint32_t) : 0;
+		D3D12_RANGE writeRange = { 0, 0 };
+		uint8_t* mapped = nullptr;
+		D3D12_RANGE keyRange = { 0, keyBytes };
+		AssertIfFailed(mKeyReadback->Map(0, &keyRange, reinterpret_cast<void**>(&mapped)));
+		keyWords.resize(keyBytes / sizeof(uint32_t));
+		memcpy(keyWords.data(), mapped, keyBytes);
+		mKeyReadback->Unmap(0, &writeRange);
+		payloads.resize(payloadBytes / sizeof(uint32_t));
+		if (payloadBytes != 0)
+		{
+			D3D12_RANGE payloadRange = { 0, payloadBytes };
+			AssertIfFailed(mPayloadReadback->Map(0, &payloadRange, reinterpret_cast<void**>(&mapped)));
+			memcpy(payloads.data(), mapped, payloadBytes);
+			mPayloadReadback->Unmap(0, &writeRange);
+		}
+	}
+
+private:
+
+	enum Kernel { InitState = 0, GlobalHistogram, ScanHistogram, Onesweep, KernelCount };
+
+	uint32_t KeyWords()       const { return m_keyBits / 32; }
+	uint32_t KeyBytes()       const { return m_keyBits / 8; }
+	uint32_t HistogramWords() const { return DigitPasses() * Radix + DigitPasses(); }
+	uint32_t LookbackWords()  const { return DigitPasses() * Partitions() * Radix; }
+
+	// Pass 0 writes buffer 0, odd passes 0 -> 1, even passes 1 -> 0.
+	void BindPass(uint32_t pass)
+	{
+		auto commandList = GraphicsCommandList();
+		uint32_t source      = pass % 2 == 1 ? 0 : 1;
+		uint32_t destination = pass % 2 == 1 ? 1 : 0;
+		commandList->SetComputeRootUnorderedAccessView(2, mKeysPingPong[source]->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(3, mKeysPingPong[destination]->GetGPUVirtualAddress());
+		// Without payloads the shader never touches u2/u3, but root descriptors must still be set.
+		ID3D12Resource* payloadSource      = m_payload ? mPayloadPingPong[source].Get()      : mHistogram.Get();
+		ID3D12Resource* payloadDestination = m_payload ? mPayloadPingPong[destination].Get() : mHistogram.Get();
+		commandList->SetComputeRootUnorderedAccessView(4, payloadSource->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(5, payloadDestination->GetGPUVirtualAddress());
+	}
+
+	void SetConstantsAndDispatch(ID3D12PipelineState* pso, uint32_t groups, uint32_t pass)
+	{
+		auto commandList = GraphicsCommandList();
+		RootConstants constants = { m_count, GroupsX(groups), Partitions(), pass };
+		commandList->SetPipelineState(pso);
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		DispatchGroups(groups);
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		// The ranking keeps per-wave digit counts for at most 16 waves and ballots up to 128 lanes.
+		D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+		if (FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) ||
+			!options1.WaveOps || options1.WaveLaneCountMin < 16 || options1.WaveLaneCountMax > 128)
+		{
+			OutputDebugStringA("Wave operations with 16-128 lanes not supported\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShaders[KernelCount];
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[KernelCount];
+
+	ComPtr<ID3D12Resource> mKeys;
+	ComPtr<ID3D12Resource> mKeysPingPong[2];
+	ComPtr<ID3D12Resource> mPayloadPingPong[2];
+	ComPtr<ID3D12Resource> mHistogram;
+	ComPtr<ID3D12Resource> mLookback;
+	ComPtr<ID3D12Resource> mKeyReadback;
+	ComPtr<ID3D12Resource> mPayloadReadback;
+
+	std::vector<uint32_t> mHostKeys;
+
+	uint32_t        m_keyBits;
+	bool            m_payload;
+	KeyDistribution m_distribution;
+	uint32_t        m_count;
+	bool            m_supported = false;
+};
@@ -0,0 +1,76 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+DISTRIBUTIONS = {
+    0: "Uniform",
+    1: "FewUnique",
+    2: "PreSorted",
+    3: "Segmented",
+}
+
+def run_simple_test(tryCount = 4):
+    """Sweeps radix sort over key widths, payloads, distributions and sizes"""
+
+    program = "..\\x64\\Release\\RadixSort.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "radix_sort_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for key_bits in [32, 64]:
+        for payload in [0, 1]:
+            for distribution in DISTRIBUTIONS:
+                for exponent in range(12, 27, 2):
+                    keys = 1 << exponent
+                    print(f"\nRunning {key_bits}-bit payload {payload} {DISTRIBUTIONS[distribution]} keys {keys}...")
+                    for i in range(tryCount):
+                        time.sleep(0.01)
+                        try:
+                            result = subprocess.run([
+                                program,
+                                str(key_bits),
+                                str(payload),
+                                str(distribution),
+                                str(keys),
+                                # Validate the first run of each configuration only.
+                                "1" if i == 0 else "0"
+                            ], capture_output=True, text=True)
+                            if result.returncode != 0:
+                                print(f"  Run {i+1}: failed or mismatched (exit {result.returncode})")
+                            else:
+                                print(f"  Run {i+1}: {result.stdout.strip()}")
+                        except Exception as e:
+                            print(f"  Run {i+1}: Error - {e}")
+
+def plot_radix_sort_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            payload = " kv" if parts[1] == "1" else ""
+            key = f"{parts[0]}-bit{payload} {parts[2]}"
+            series.setdefault(key, {}).setdefault(int(parts[3]), []).append(float(parts[6]))
+
+    for key, runs in sorted(series.items()):
+        sizes = sorted(runs)
+        plt.plot(sizes, [max(runs[n]) for n in sizes], marker='o', label=key)
+    plt.xscale('log', base=2)
+    plt.xlabel('Keys')
+    plt.ylabel('Mkeys/s (best run)')
+    plt.title('Onesweep Radix Sort Throughput')
+    plt.legend(fontsize=6)
+    plt.grid(True)
+    plt.savefig('RadixSort.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_radix_sort_results("radix_sort_results.csv")
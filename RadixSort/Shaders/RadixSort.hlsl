@@ -0,0 +1,284 @@
+// Onesweep-style LSD radix sort, 8-bit digits. Compiled with DXC (cs_6_0). Variants are selected by
+// defines:
+//   KEY64    0=32-bit keys (4 digit passes), 1=64-bit keys as uint2 {low, high} (8 digit passes)
+//   PAYLOAD  1=carry a 32-bit value (the key's original index) along with every key
+//
+// Entry points, in dispatch order:
+//   InitState        zero the histograms, partition counters and look-back state of every pass
+//   GlobalHistogram  digit counts of every pass in one read of the keys
+//   ScanHistogram    one group per pass turns the counts into exclusive digit offsets
+//   Onesweep         one dispatch per digit pass: rank a tile, look back per digit, scatter
+
+#if KEY64
+typedef uint2 key_t;
+static const uint DigitPasses = 8;
+#else
+typedef uint key_t;
+static const uint DigitPasses = 4;
+#endif
+
+StructuredBuffer<key_t>                Keys        : register(t0);  // unsorted input, never written
+RWStructuredBuffer<key_t>              KeysIn      : register(u0);
+RWStructuredBuffer<key_t>              KeysOut     : register(u1);
+RWStructuredBuffer<uint>               PayloadIn   : register(u2);
+RWStructuredBuffer<uint>               PayloadOut  : register(u3);
+// [pass * 256 + digit] digit counts, then offsets; [DigitPasses * 256 + pass] partition counters.
+RWStructuredBuffer<uint>               Histogram   : register(u4);
+// [(pass * Partitions + partition) * 256 + digit]: flag in the top two bits, count below.
+globallycoherent RWStructuredBuffer<uint> Lookback : register(u5);
+
+cbuffer params : register(b0)
+{
+    uint Count;       // keys
+    uint GroupsX;
+    uint Partitions;  // tiles of TileSize keys
+    uint Pass;        // digit pass of this Onesweep dispatch; InitState: words to clear
+}
+
+static const uint NumThreads     = 256;
+static const uint RadixBits      = 8;
+static const uint Radix          = 1 << RadixBits;
+static const uint ItemsPerThread = 16;
+static const uint TileSize       = NumThreads * ItemsPerThread;
+static const uint MaxWaves       = NumThreads / 16;   // host requires WaveLaneCountMin >= 16
+static const uint FlagAggregate  = 1u << 30;
+static const uint FlagInclusive  = 2u << 30;
+static const uint FlagMask       = 3u << 30;
+static const uint CountMask      = ~FlagMask;
+
+uint GroupIndex(uint3 groupId)
+{
+    return groupId.y * GroupsX + groupId.x;
+}
+
+uint Digit(key_t key, uint pass)
+{
+    uint shift = pass * RadixBits;
+#if KEY64
+    uint word = shift >= 32 ? key.y : key.x;
+    return (word >> (shift & 31)) & (Radix - 1);
+#else
+    return (key >> shift) & (Radix - 1);
+#endif
+}
+
+[numthreads(NumThreads, 1, 1)]
+void InitState(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint index = GroupIndex(groupId) * NumThreads + threadId.x;
+    if (index < DigitPasses * Radix + DigitPasses)
+    {
+        Histogram[index] = 0;
+    }
+    if (index < Pass)
+    {
+        Lookback[index] = 0;
+    }
+}
+
+groupshared uint sHistogram[DigitPasses * Radix];
+
+[numthreads(NumThreads, 1, 1)]
+void GlobalHistogram(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    const uint threadIndex = threadId.x;
+    const uint group       = GroupIndex(groupId);
+
+    for (uint i = threadIndex; i < DigitPasses * Radix; i += NumThreads)
+    {
+        sHistogram[i] = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Grid-stride over the keys; this dispatch uses one group per GroupsX column only.
+    for (uint index = group * NumThreads + threadIndex; index < Count; index += GroupsX * NumThreads)
+    {
+        key_t key = Keys[index];
+        [unroll]
+        for (uint pass = 0; pass < DigitPasses; ++pass)
+        {
+            InterlockedAdd(sHistogram[pass * Radix + Digit(key, pass)], 1);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint i = threadIndex; i < DigitPasses * Radix; i += NumThreads)
+    {
+        if (sHistogram[i] != 0)
+        {
+            InterlockedAdd(Histogram[i], sHistogram[i]);
+        }
+    }
+}
+
+groupshared uint sWaveTotals[MaxWaves];
+
+[numthreads(Radix, 1, 1)]
+void ScanHistogram(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    const uint digit = threadId.x;
+    const uint index = groupId.x * Radix + digit;
+    const uint count = Histogram[index];
+
+    uint laneCount = WaveGetLaneCount();
+    uint waveIndex = digit / laneCount;
+    uint prefix    = WavePrefixSum(count);
+    uint waveTotal = WaveActiveSum(count);
+    if (WaveIsFirstLane())
+    {
+        sWaveTotals[waveIndex] = waveTotal;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint w = 0; w < waveIndex; ++w)
+    {
+        prefix += sWaveTotals[w];
+    }
+    Histogram[index] = prefix;
+}
+
+groupshared uint sPartition;
+groupshared uint sWaveCounts[MaxWaves * Radix];
+groupshared uint sDigitBase[Radix];
+
+// Mask of the lanes below this one, for ballots of up to 128 lanes.
+uint4 LanesBelowMask()
+{
+    uint lane = WaveGetLaneIndex();
+    uint4 mask;
+    [unroll]
+    for (uint i = 0; i < 4; ++i)
+    {
+        uint low = i * 32;
+        mask[i] = lane >= low + 32 ? 0xFFFFFFFF : (lane <= low ? 0 : (1u << (lane - low)) - 1);
+    }
+    return mask;
+}
+
+uint CountBits4(uint4 v)
+{
+    return countbits(v.x) + countbits(v.y) + countbits(v.z) + countbits(v.w);
+}
+
+[numthreads(NumThreads, 1, 1)]
+void Onesweep(uint3 threadId : SV_GroupThreadID)
+{
+    const uint threadIndex = threadId.x;
+    const uint laneCount   = WaveGetLaneCount();
+    const uint waveIndex   = threadIndex / laneCount;
+    const uint waveCount   = NumThreads / laneCount;
+
+    // Partitions are handed out in launch order so every partition's predecessors are running.
+    if (threadIndex == 0)
+    {
+        InterlockedAdd(Histogram[DigitPasses * Radix + Pass], 1, sPartition);
+    }
+    GroupMemoryBarrierWithGroupSync();
+    const uint partition = sPartition;
+    if (partition >= Partitions)
+    {
+        return;
+    }
+    const uint tileStart = partition * TileSize;
+
+    // Stable rank of every key among the keys of the tile with the same digit. Rows are ranked in
+    // order; inside a row a wave finds the lanes sharing its digit with eight ballots (a
+    // multi-split), and the per-wave counts are prefixed in wave order.
+    key_t keys[ItemsPerThread];
+    uint  digits[ItemsPerThread];
+    uint  ranks[ItemsPerThread];
+    uint  digitTotal = 0;   // thread d: keys of the tile with digit d so far
+    const uint4 lanesBelow = LanesBelowMask();
+
+    [unroll]
+    for (uint k = 0; k < ItemsPerThread; ++k)
+    {
+        uint index = tileStart + k * NumThreads + threadIndex;
+        bool valid = index < Count;
+        keys[k]    = valid ? (Pass == 0 ? Keys[index] : KeysIn[index]) : (key_t)0;
+        digits[k]  = Digit(keys[k], Pass);
+
+        uint4 match = WaveActiveBallot(valid);
+        [unroll]
+        for (uint bit = 0; bit < RadixBits; ++bit)
+        {
+            uint4 ballot = WaveActiveBallot(valid && ((digits[k] >> bit) & 1) != 0);
+            match &= ((digits[k] >> bit) & 1) != 0 ? ballot : ~ballot;
+        }
+        uint rankInWave = CountBits4(match & lanesBelow);
+
+        for (uint i = threadIndex; i < waveCount * Radix; i += NumThreads)
+        {
+            sWaveCounts[i] = 0;
+        }
+        GroupMemoryBarrierWithGroupSync();
+        if (valid && rankInWave == 0)
+        {
+            sWaveCounts[waveIndex * Radix + digits[k]] = CountBits4(match);
+        }
+        GroupMemoryBarrierWithGroupSync();
+        for (uint w = 0; w < waveCount; ++w)
+        {
+            uint c = sWaveCounts[w * Radix + threadIndex];
+            sWaveCounts[w * Radix + threadIndex] = digitTotal;
+            digitTotal += c;
+        }
+        GroupMemoryBarrierWithGroupSync();
+        ranks[k] = sWaveCounts[waveIndex * Radix + digits[k]] + rankInWave;
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    // Decoupled look-back, one digit per thread: publish this tile's count, then add up the counts
+    // of the predecessors until one of them has published its inclusive prefix.
+    {
+        const uint digit = threadIndex;
+        const uint passBase = Pass * Partitions * Radix;
+        uint prefix = 0;
+        if (partition == 0)
+        {
+            Lookback[passBase + digit] = FlagInclusive | digitTotal;
+        }
+        else
+        {
+            Lookback[passBase + partition * Radix + digit] = FlagAggregate | digitTotal;
+            uint predecessor = partition - 1;
+            [allow_uav_condition]
+            for (;;)
+            {
+                uint value;
+                InterlockedOr(Lookback[passBase + predecessor * Radix + digit], 0, value);
+                uint flag = value & FlagMask;
+                if (flag == 0)
+                {
+                    continue;
+                }
+                prefix += value & CountMask;
+                if (flag == FlagInclusive)
+                {
+                    break;
+                }
+                --predecessor;
+            }
+            uint previous;
+            InterlockedExchange(Lookback[passBase + partition * Radix + digit], FlagInclusive | (prefix + digitTotal), previous);
+        }
+        sDigitBase[digit] = Histogram[Pass * Radix + digit] + prefix;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Scatter straight from registers. (A full onesweep stages the tile in groupshared memory to
+    // coalesce the writes; 64-bit keys with payloads do not fit in 32 KB.)
+    [unroll]
+    for (uint k = 0; k < ItemsPerThread; ++k)
+    {
+        uint index = tileStart + k * NumThreads + threadIndex;
+        if (index < Count)
+        {
+            uint destination = sDigitBase[digits[k]] + ranks[k];
+            KeysOut[destination] = keys[k];
+#if PAYLOAD
+            PayloadOut[destination] = Pass == 0 ? index : PayloadIn[index];
+#endif
+        }
+    }
+}
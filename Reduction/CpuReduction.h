@@ -0,0 +1,253 @@
+#pragma once
+
+// Multithreaded SIMD host reduction: the correctness reference for the GPU kernels and the host
+// baseline they are compared against. Uses AVX2 when the build enables it (/arch:AVX2, set by the
+// x64 configurations), SSE2 on any other x86/x64 build and plain scalar code elsewhere. No D3D
+// dependency.
+
+#include "ParallelFor.h"
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define REDUCTION_SIMD_X86 1
+#endif
+
+enum ReduceOp : uint32_t {
+    ReduceSum = 0,
+    ReduceMin = 1,
+    ReduceMax = 2,
+    ReduceOpCount
+};
+
+enum ReduceType : uint32_t {
+    ReduceFloat = 0,
+    ReduceInt   = 1,
+    ReduceTypeCount
+};
+
+inline const char* ReduceOpName(ReduceOp op)
+{
+    switch (op)
+    {
+    case ReduceOp::ReduceSum: return "Sum";
+    case ReduceOp::ReduceMin: return "Min";
+    case ReduceOp::ReduceMax: return "Max";
+    default:                  return "Unknown";
+    }
+}
+
+inline const char* ReduceTypeName(ReduceType type)
+{
+    return type == ReduceType::ReduceInt ? "Int" : "Float";
+}
+
+namespace CpuReduction
+{
+    // Same identities as Reduction/Shaders/Reduction.hlsl.
+    inline float   Identity(ReduceOp op, float)   { return op == ReduceSum ? 0.0f : (op == ReduceMin ? FLT_MAX : -FLT_MAX); }
+    inline int32_t Identity(ReduceOp op, int32_t) { return op == ReduceSum ? 0 : (op == ReduceMin ? INT_MAX : INT_MIN); }
+
+    inline float Combine(ReduceOp op, float a, float b)
+    {
+        return op == ReduceSum ? a + b : (op == ReduceMin ? (a < b ? a : b) : (a > b ? a : b));
+    }
+
+    // Integer sums wrap like the GPU's 32-bit adds instead of overflowing.
+    inline int32_t Combine(ReduceOp op, int32_t a, int32_t b)
+    {
+        return op == ReduceSum ? static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b))
+                               : (op == ReduceMin ? (a < b ? a : b) : (a > b ? a : b));
+    }
+
+#if REDUCTION_SIMD_X86
+#if defined(__AVX2__)
+    struct FloatLanes
+    {
+        typedef __m256 V;
+        static const size_t Width = 8;
+        static V    Set(float v)          { return _mm256_set1_ps(v); }
+        static V    Load(const float* p)  { return _mm256_loadu_ps(p); }
+        static void Store(float* p, V v)  { _mm256_storeu_ps(p, v); }
+        static V    Combine(ReduceOp op, V a, V b)
+        {
+            return op == ReduceSum ? _mm256_add_ps(a, b) : (op == ReduceMin ? _mm256_min_ps(a, b) : _mm256_max_ps(a, b));
+        }
+    };
+
+    struct IntLanes
+    {
+        typedef __m256i V;
+        static const size_t Width = 8;
+        static V    Set(int32_t v)          { return _mm256_set1_epi32(v); }
+        static V    Load(const int32_t* p)  { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void Store(int32_t* p, V v)  { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static V    Combine(ReduceOp op, V a, V b)
+        {
+            return op == ReduceSum ? _mm256_add_epi32(a, b) : (op == ReduceMin ? _mm256_min_epi32(a, b) : _mm256_max_epi32(a, b));
+        }
+    };
+#else
+    struct FloatLanes
+    {
+        typedef __m128 V;
+        static const size_t Width = 4;
+        static V    Set(float v)          { return _mm_set1_ps(v); }
+        static V    Load(const float* p)  { return _mm_loadu_ps(p); }
+        static void Store(float* p, V v)  { _mm_storeu_ps(p, v); }
+        static V    Combine(ReduceOp op, V a, V b)
+        {
+            return op == ReduceSum ? _mm_add_ps(a, b) : (op == ReduceMin ? _mm_min_ps(a, b) : _mm_max_ps(a, b));
+        }
+    };
+
+    // SSE2 has no pminsd/pmaxsd (SSE4.1), so min/max select through a compare mask.
+    struct IntLanes
+    {
+        typedef __m128i V;
+        static const size_t Width = 4;
+        static V    Set(int32_t v)          { return _mm_set1_epi32(v); }
+        static V    Load(const int32_t* p)  { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void Store(int32_t* p, V v)  { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static V    Select(V mask, V a, V b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+        static V    Combine(ReduceOp op, V a, V b)
+        {
+            return op == ReduceSum ? _mm_add_epi32(a, b)
+                                   : (op == ReduceMin ? Select(_mm_cmplt_epi32(a, b), a, b) : Select(_mm_cmpgt_epi32(a, b), a, b));
+        }
+    };
+#endif
+
+    // Four independent accumulators hide the add/min/max latency; the op is a constant at every
+    // call site so the selects fold away after inlining.
+    template <typename Lanes, typename T>
+    T ReduceSpan(ReduceOp op, const T* data, size_t count)
+    {
+        const size_t W = Lanes::Width;
+        typename Lanes::V acc0 = Lanes::Set(Identity(op, T()));
+        typename Lanes::V acc1 = acc0;
+        typename Lanes::V acc2 = acc0;
+        typename Lanes::V acc3 = acc0;
+
+        size_t i = 0;
+        for (; i + 4 * W <= count; i += 4 * W)
+        {
+            acc0 = Lanes::Combine(op, acc0, Lanes::Load(data + i));
+            acc1 = Lanes::Combine(op, acc1, Lanes::Load(data + i + W));
+            acc2 = Lanes::Combine(op, acc2, Lanes::Load(data + i + 2 * W));
+            acc3 = Lanes::Combine(op, acc3, Lanes::Load(data + i + 3 * W));
+        }
+        for (; i + W <= count; i += W)
+        {
+            acc0 = Lanes::Combine(op, acc0, Lanes::Load(data + i));
+        }
+        acc0 = Lanes::Combine(op, Lanes::Combine(op, acc0, acc1), Lanes::Combine(op, acc2, acc3));
+
+        T lanes[W];
+        Lanes::Store(lanes, acc0);
+        T result = Identity(op, T());
+        for (size_t lane = 0; lane < W; ++lane)
+        {
+            result = Combine(op, result, lanes[lane]);
+        }
+        for (; i < count; ++i)
+        {
+            result = Combine(op, result, data[i]);
+        }
+        return result;
+    }
+
+    inline float   ReduceSpan(ReduceOp op, const float* data, size_t count)   { return ReduceSpan<FloatLanes>(op, data, count); }
+    inline int32_t ReduceSpan(ReduceOp op, const int32_t* data, size_t count) { return ReduceSpan<IntLanes>(op, data, count); }
+#else
+    template <typename T>
+    T ReduceSpan(ReduceOp op, const T* data, size_t count)
+    {
+        T result = Identity(op, T());
+        for (size_t i = 0; i < count; ++i)
+        {
+            result = Combine(op, result, data[i]);
+        }
+        return result;
+    }
+#endif
+
+    // Elements per SIMD span. Float sums are accumulated span by span so no single accumulator sees
+    // more than BlockSize / lanes additions, which keeps 2^28-element sums within tolerance.
+    static const size_t BlockSize = 16384;
+
+    // Reduces `count` elements on `threads` threads. Partials are combined in the same order every
+    // run, so repeated runs with the same thread count agree bit for bit.
+    template <typename T>
+    T Reduce(ReduceOp op, const T* data, size_t count, uint32_t threads)
+    {
+        // ParallelFor runs at least one worker.
+        threads = (std::max)(threads, 1u);
+        std::vector<T> partials(threads, Identity(op, T()));
+        ParallelFor(count, threads, [&](uint32_t worker, size_t begin, size_t end) {
+            T partial = Identity(op, T());
+            for (size_t block = begin; block < end; block += BlockSize)
+            {
+                partial = Combine(op, partial, ReduceSpan(op, data + block, (std::min)(BlockSize, end - block)));
+            }
+            partials[worker] = partial;
+        });
+
+        T result = Identity(op, T());
+        for (T partial : partials)
+        {
+            result = Combine(op, result, partial);
+        }
+        return result;
+    }
+
+    // Reduces raw 32-bit words interpreted as `type`; returns the result's bit pattern so callers can
+    // compare it with what the GPU wrote.
+    inline uint32_t ReduceBits(ReduceOp op, ReduceType type, const uint32_t* words, size_t count, uint32_t threads)
+    {
+        uint32_t bits = 0;
+        if (type == ReduceType::ReduceInt)
+        {
+            int32_t result = Reduce(op, reinterpret_cast<const int32_t*>(words), count, threads);
+            memcpy(&bits, &result, sizeof(bits));
+        }
+        else
+        {
+            float result = Reduce(op, reinterpret_cast<const float*>(words), count, threads);
+            memcpy(&bits, &result, sizeof(bits));
+        }
+        return bits;
+    }
+
+    inline double BitsToDouble(ReduceType type, uint32_t bits)
+    {
+        if (type == ReduceType::ReduceInt)
+        {
+            int32_t value;
+            memcpy(&value, &bits, sizeof(value));
+            return static_cast<double>(value);
+        }
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return static_cast<double>(value);
+    }
+
+    // Integer results and min/max must match exactly; float sums are order dependent and are
+    // accepted within a relative tolerance.
+    inline bool Matches(ReduceOp op, ReduceType type, uint32_t gpuBits, uint32_t cpuBits)
+    {
+        if (type == ReduceType::ReduceInt || op != ReduceOp::ReduceSum)
+        {
+            return gpuBits == cpuBits;
+        }
+        double gpu = BitsToDouble(type, gpuBits);
+        double cpu = BitsToDouble(type, cpuBits);
+        return std::fabs(gpu - cpu) <= 1e-4 * (std::max)(1.0, std::fabs(cpu));
+    }
+}
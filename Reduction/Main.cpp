@@ -0,0 +1,123 @@
+#include "d3dAppSimplified.h"
+#include "Reduction.h"
+#include "CpuReduction.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	ReduceAlgorithm algorithm  = ReduceAlgorithm::WaveIntrinsic;
+	ReduceOp        op         = ReduceOp::ReduceSum;
+	ReduceType      type       = ReduceType::ReduceFloat;
+	int             elements   = 1 << 24;
+	int             cpuThreads = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <algorithm> <op> <type> <elements> <cpuThreads>
+	// algorithm: 0=MultiPassNaive, 1=GroupSharedTree, 2=WaveIntrinsic, 3=AtomicSinglePass, 4=DecoupledLookback, 5=ReadCeiling
+	// op: 0=Sum, 1=Min, 2=Max   type: 0=Float, 1=Int
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			algorithm = static_cast<ReduceAlgorithm>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			op = static_cast<ReduceOp>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			type = static_cast<ReduceType>(_wtoi(argv[3]));
+		}
+		if (argc >= 5)
+		{
+			elements = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			cpuThreads = _wtoi(argv[5]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: algorithm=%d, op=%d, type=%d, elements=%d, cpuThreads=%d\n",
+			static_cast<int>(algorithm), static_cast<int>(op), static_cast<int>(type), elements, cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (algorithm >= ReduceAlgorithm::ReduceAlgorithmCount || op >= ReduceOp::ReduceOpCount || type >= ReduceType::ReduceTypeCount)
+	{
+		OutputDebugStringA("ERROR: Unknown algorithm, op or type!\n");
+		return 1;
+	}
+	if (elements <= 0 || cpuThreads <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	Reduction test(hInstance, algorithm, op, type, static_cast<uint32_t>(elements));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Reduction needs shader model 6.0 with wave operations!\n");
+		return 1;
+	}
+
+	// First run pays for PSO/driver warm-up; time the second one.
+	test.Dispatch();
+	test.Dispatch();
+	double gpuSeconds = test.GetDuration();
+	double gpuGBs     = test.InputBytes() / gpuSeconds / 1e9;
+
+	// Host reference, also warmed once so page faults on the input are not timed.
+	const std::vector<uint32_t>& hostData = test.HostData();
+	CpuReduction::ReduceBits(op, type, hostData.data(), hostData.size(), static_cast<uint32_t>(cpuThreads));
+	CpuTimer timer;
+	timer.Start();
+	uint32_t cpuBits = CpuReduction::ReduceBits(op, type, hostData.data(), hostData.size(), static_cast<uint32_t>(cpuThreads));
+	double cpuSeconds = timer.Stop();
+	double cpuGBs     = test.InputBytes() / cpuSeconds / 1e9;
+
+	uint32_t gpuBits = test.HasResult() ? test.ResultBits() : cpuBits;
+	bool     match   = CpuReduction::Matches(op, type, gpuBits, cpuBits);
+	double   gpuValue = CpuReduction::BitsToDouble(type, gpuBits);
+	double   cpuValue = CpuReduction::BitsToDouble(type, cpuBits);
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Algorithm: " << ReduceAlgorithmName(algorithm) << " Op: " << ReduceOpName(op) << " Type: " << ReduceTypeName(type)
+		<< " Elements: " << elements << " Passes: " << test.Passes() << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGBs << " GB/s)\n";
+	debugOutput << "CPU (" << cpuThreads << " threads): " << cpuSeconds << " seconds (" << cpuGBs << " GB/s)\n";
+	if (test.HasResult())
+	{
+		debugOutput << "Result: GPU " << gpuValue << " CPU " << cpuValue << (match ? " (match)" : " (MISMATCH)") << "\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("reduction_results.csv", "Algorithm,AlgorithmName,Op,Type,Elements,Passes,Gpu_s,Gpu_GBs,CpuThreads,Cpu_s,Cpu_GBs,GpuResult,CpuResult,Match", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(algorithm), ReduceAlgorithmName(algorithm), ReduceOpName(op), ReduceTypeName(type), elements, test.Passes(),
+		gpuSeconds, gpuGBs, cpuThreads, cpuSeconds, cpuGBs, gpuValue, cpuValue, match ? 1 : 0);
+    return match ? 0 : 1;
+}
@@ -0,0 +1,305 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuReduction.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum ReduceAlgorithm : uint32_t {
+    MultiPassNaive    = 0,  // one element per thread, interleaved addressing, log256(N) passes
+    GroupSharedTree   = 1,  // grid-stride accumulate + sequential-addressing tree, then a final pass
+    WaveIntrinsic     = 2,  // grid-stride accumulate + WaveActive*, then a final pass
+    AtomicSinglePass  = 3,  // one atomic per group into the result
+    DecoupledLookback = 4,  // one pass, partitions chained through look-back
+    ReadCeiling       = 5,  // LinearCopy's read pattern with no arithmetic: the bandwidth bound
+    ReduceAlgorithmCount
+};
+
+inline const char* ReduceAlgorithmName(ReduceAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case ReduceAlgorithm::MultiPassNaive:    return "MultiPassNaive";
+    case ReduceAlgorithm::GroupSharedTree:   return "GroupSharedTree";
+    case ReduceAlgorithm::WaveIntrinsic:     return "WaveIntrinsic";
+    case ReduceAlgorithm::AtomicSinglePass:  return "AtomicSinglePass";
+    case ReduceAlgorithm::DecoupledLookback: return "DecoupledLookback";
+    case ReduceAlgorithm::ReadCeiling:       return "ReadCeiling";
+    default:                                 return "Unknown";
+    }
+}
+
+// Reduces `elements` 32-bit values with one of the kernels in Shaders/Reduction.hlsl. Everything a
+// variant needs per run (state reset, all passes, the 4-byte copy of the result to a readback
+// buffer) is recorded in DoAction, so GetDuration() is the full cost of producing the answer.
+class Reduction : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Count;
+		uint32_t GroupsX;
+		uint32_t GroupCount;
+		uint32_t Sentinel;
+	};
+
+    static const uint32_t NumThreads        = 256;
+    static const uint32_t ItemsPerThread    = 16;   // look-back tile and grid-stride target
+    static const uint32_t StateHeaderSize   = 16;
+    static const uint32_t PartitionSize     = 16;
+    static const uint32_t SentinelBits      = 0x7FFFFFFF;  // NaN / INT_MAX, never generated
+
+    Reduction(HINSTANCE hInstance, ReduceAlgorithm algorithm, ReduceOp op, ReduceType type, uint32_t elements) :
+		D3DAppSimplified(hInstance),
+		m_algorithm(algorithm),
+		m_op(op),
+		m_type(type),
+		m_elements(elements)
+	{
+		// Deterministic pseudo-random input: floats in [0, 1), ints in [-512, 511].
+		mHostData.resize(m_elements);
+		for (uint32_t i = 0; i < m_elements; ++i)
+		{
+			uint32_t hash = i * 2654435761u;
+			if (m_type == ReduceType::ReduceInt)
+			{
+				int32_t value = static_cast<int32_t>((hash >> 12) & 0x3FF) - 512;
+				memcpy(&mHostData[i], &value, sizeof(value));
+			}
+			else
+			{
+				float value = static_cast<float>((hash >> 8) & 0xFFFF) / 65536.0f;
+				memcpy(&mHostData[i], &value, sizeof(value));
+			}
+		}
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		mInputBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostData.data(), static_cast<UINT64>(m_elements) * sizeof(uint32_t));
+
+		// Ping-pong partials; the first pass of the naive variant produces the most of them.
+		UINT64 partialBytes = static_cast<UINT64>((std::max)(DivideRoundUp(m_elements, NumThreads), 1u)) * sizeof(uint32_t);
+		for (auto& partials : mPartials)
+		{
+			partials = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, partialBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		}
+		mStateBuffer    = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, StateHeaderSize + static_cast<UINT64>(LookbackPartitions()) * PartitionSize,
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, sizeof(uint32_t), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		mShaders[0] = D3DUtil::CompileShaderDxc(L"Shaders\\Reduction.hlsl", Defines(false), L"main", L"cs_6_0");
+		if (IsMultiPass())
+		{
+			mShaders[1] = D3DUtil::CompileShaderDxc(L"Shaders\\Reduction.hlsl", Defines(true), L"main", L"cs_6_0");
+		}
+		if (NeedsStateReset())
+		{
+			mResetShader = D3DUtil::CompileShaderDxc(L"Shaders\\Reduction.hlsl", Defines(false), L"ResetState", L"cs_6_0");
+		}
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[5];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+		slotRootParameter[3].InitAsUnorderedAccessView(1);
+		slotRootParameter[4].InitAsUnorderedAccessView(2);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(5, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		for (int i = 0; i < 2; ++i)
+		{
+			if (mShaders[i])
+			{
+				mPSOs[i] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[i].Get());
+			}
+		}
+		if (mResetShader)
+		{
+			mResetPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mResetShader.Get());
+		}
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(3, mStateBuffer->GetGPUVirtualAddress());
+
+		ID3D12Resource* resultBuffer = mStateBuffer.Get();
+		m_passes = 0;
+
+		if (NeedsStateReset())
+		{
+			uint32_t partitions = m_algorithm == ReduceAlgorithm::DecoupledLookback ? LookbackPartitions() : 0;
+			RootConstants constants = { 0, 0, partitions, 0 };
+			commandList->SetPipelineState(mResetPSO.Get());
+			commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+			commandList->SetComputeRootUnorderedAccessView(2, mPartials[0]->GetGPUVirtualAddress());
+			commandList->SetComputeRootUnorderedAccessView(4, mPartials[1]->GetGPUVirtualAddress());
+			commandList->Dispatch((std::max)(DivideRoundUp(partitions, NumThreads), 1u), 1, 1);
+			UavBarrier();
+		}
+
+		if (IsMultiPass())
+		{
+			// Passes alternate between the two partial buffers until one value is left.
+			uint32_t count  = m_elements;
+			uint32_t target = 0;
+			do
+			{
+				uint32_t groups = PassGroups(count);
+				RootConstants constants = { count, GroupsX(groups), groups, 0 };
+				commandList->SetPipelineState(mPSOs[m_passes == 0 ? 0 : 1].Get());
+				commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+				commandList->SetComputeRootUnorderedAccessView(2, mPartials[target]->GetGPUVirtualAddress());
+				commandList->SetComputeRootUnorderedAccessView(4, mPartials[target ^ 1]->GetGPUVirtualAddress());
+				DispatchGroups(groups);
+				UavBarrier();
+
+				resultBuffer = mPartials[target].Get();
+				target ^= 1;
+				count = groups;
+				++m_passes;
+			} while (count > 1);
+		}
+		else
+		{
+			uint32_t groups = SinglePassGroups();
+			RootConstants constants = { m_elements, GroupsX(groups), groups, SentinelBits };
+			commandList->SetPipelineState(mPSOs[0].Get());
+			commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+			commandList->SetComputeRootUnorderedAccessView(2, mPartials[0]->GetGPUVirtualAddress());
+			commandList->SetComputeRootUnorderedAccessView(4, mPartials[1]->GetGPUVirtualAddress());
+			DispatchGroups(groups);
+			m_passes = 1;
+		}
+
+		if (m_algorithm != ReduceAlgorithm::ReadCeiling)
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(resultBuffer,
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, resultBuffer, 0, sizeof(uint32_t));
+		}
+    }
+
+	bool     Supported()  const { return m_supported; }
+	uint32_t Passes()     const { return m_passes; }
+	bool     HasResult()  const { return m_algorithm != ReduceAlgorithm::ReadCeiling; }
+	UINT64   InputBytes() const { return static_cast<UINT64>(m_elements) * sizeof(uint32_t); }
+	const std::vector<uint32_t>& HostData() const { return mHostData; }
+
+	// Bit pattern of the reduced value written by the last Dispatch().
+	uint32_t ResultBits()
+	{
+		uint32_t* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, sizeof(uint32_t) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t bits = *mapped;
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return bits;
+	}
+
+private:
+
+	bool IsMultiPass() const
+	{
+		return m_algorithm == ReduceAlgorithm::MultiPassNaive ||
+			m_algorithm == ReduceAlgorithm::GroupSharedTree ||
+			m_algorithm == ReduceAlgorithm::WaveIntrinsic;
+	}
+
+	bool NeedsStateReset() const
+	{
+		return m_algorithm == ReduceAlgorithm::AtomicSinglePass || m_algorithm == ReduceAlgorithm::DecoupledLookback;
+	}
+
+	uint32_t LookbackPartitions() const
+	{
+		return (std::max)(DivideRoundUp(m_elements, NumThreads * ItemsPerThread), 1u);
+	}
+
+	// Naive: one element per thread. Grid-stride variants: about ItemsPerThread elements per thread,
+	// capped at one dispatch row so the next pass fits in a handful of groups.
+	uint32_t PassGroups(uint32_t count) const
+	{
+		if (m_algorithm == ReduceAlgorithm::MultiPassNaive)
+		{
+			return (std::max)(DivideRoundUp(count, NumThreads), 1u);
+		}
+		return (std::min)((std::max)(DivideRoundUp(count, NumThreads * ItemsPerThread), 1u), MaxGroupsX);
+	}
+
+	uint32_t SinglePassGroups() const
+	{
+		switch (m_algorithm)
+		{
+		case ReduceAlgorithm::DecoupledLookback: return LookbackPartitions();
+		case ReduceAlgorithm::ReadCeiling:       return (std::max)(DivideRoundUp(m_elements, NumThreads), 1u);
+		default:                                 return PassGroups(m_elements);
+		}
+	}
+
+	std::vector<std::wstring> Defines(bool sourcePartials) const
+	{
+		return {
+			L"ALGORITHM=" + std::to_wstring(static_cast<uint32_t>(m_algorithm)),
+			L"OP=" + std::to_wstring(static_cast<uint32_t>(m_op)),
+			L"TYPE_INT=" + std::to_wstring(m_type == ReduceType::ReduceInt ? 1 : 0),
+			L"SOURCE_PARTIALS=" + std::to_wstring(sourcePartials ? 1 : 0)
+		};
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+		if (FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) || !options1.WaveOps)
+		{
+			OutputDebugStringA("Wave operations not supported\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShaders[2];
+    ComPtr<ID3DBlob> mResetShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[2];    // [0] reads the input, [1] reads partials
+	ComPtr<ID3D12PipelineState> mResetPSO;
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mPartials[2];
+	ComPtr<ID3D12Resource> mStateBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<uint32_t> mHostData;
+
+	ReduceAlgorithm m_algorithm;
+	ReduceOp        m_op;
+	ReduceType      m_type;
+	uint32_t        m_elements;
+	uint32_t        m_passes    = 0;
+	bool            m_supported = false;
+};
@@ -0,0 +1,97 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+ALGORITHMS = {
+    0: "MultiPassNaive",
+    1: "GroupSharedTree",
+    2: "WaveIntrinsic",
+    3: "AtomicSinglePass",
+    4: "DecoupledLookback",
+    5: "ReadCeiling",
+}
+
+OPS = {
+    0: "Sum",
+    1: "Min",
+    2: "Max",
+}
+
+TYPES = {
+    0: "Float",
+    1: "Int",
+}
+
+def run_simple_test(tryCount = 4):
+    """Runs every reduction variant over a range of sizes next to the read-only bandwidth ceiling"""
+
+    program = "..\\x64\\Release\\Reduction.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "reduction_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for exponent in range(16, 29, 2):
+        elements = 1 << exponent
+        for type in TYPES:
+            for op in OPS:
+                for algorithm in ALGORITHMS:
+                    # The ceiling does not depend on the op; measure it once per size and type.
+                    if algorithm == 5 and op != 0:
+                        continue
+                    print(f"\nRunning {ALGORITHMS[algorithm]} {OPS[op]} {TYPES[type]} elements {elements}...")
+                    for i in range(tryCount):
+                        time.sleep(0.01)
+                        try:
+                            result = subprocess.run([
+                                program,
+                                str(algorithm),
+                                str(op),
+                                str(type),
+                                str(elements)
+                            ], capture_output=True, text=True)
+                            if result.returncode != 0:
+                                print(f"  Run {i+1}: failed or mismatched (exit {result.returncode})")
+                            else:
+                                print(f"  Run {i+1}: {result.stdout.strip()}")
+                        except Exception as e:
+                            print(f"  Run {i+1}: Error - {e}")
+
+def plot_reduction_results(filename, op = "Sum", type = "Float"):
+    series = {}
+    cpu = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            if parts[3] != type or (parts[2] != op and parts[1] != "ReadCeiling"):
+                continue
+            elements = int(parts[4])
+            series.setdefault(parts[1], ([], []))
+            series[parts[1]][0].append(elements)
+            series[parts[1]][1].append(float(parts[7]))
+            cpu.setdefault(elements, []).append(float(parts[10]))
+
+    for name, (elements, gbs) in sorted(series.items()):
+        style = '--' if name == "ReadCeiling" else ''
+        plt.plot(elements, gbs, marker='o', linestyle=style, label=name)
+    cpu_sizes = sorted(cpu)
+    plt.plot(cpu_sizes, [max(cpu[n]) for n in cpu_sizes], marker='x', linestyle=':', label="CPU SIMD (best)")
+    plt.xscale('log', base=2)
+    plt.xlabel('Elements')
+    plt.ylabel('Effective Read Bandwidth (GB/s)')
+    plt.title(f'Reduction {op} {type} vs Read Ceiling')
+    plt.legend(fontsize=7)
+    plt.grid(True)
+    plt.savefig('Reduction.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_reduction_results("reduction_results.csv")
@@ -0,0 +1,328 @@
+// Compiled with DXC (cs_6_0 for the wave intrinsics). Variants are selected by defines:
+//   ALGORITHM        0=MultiPassNaive, 1=GroupSharedTree, 2=WaveIntrinsic, 3=AtomicSinglePass,
+//                    4=DecoupledLookback, 5=ReadCeiling
+//   OP               0=Sum, 1=Min, 2=Max
+//   TYPE_INT         0=float, 1=int
+//   SOURCE_PARTIALS  1=later pass of a multi-pass reduction, reading the previous pass' partials
+
+#if TYPE_INT
+typedef int value_t;
+static const value_t SumIdentity = 0;
+static const value_t MinIdentity = 0x7FFFFFFF;
+static const value_t MaxIdentity = (int)0x80000000;
+#define AS_VALUE asint
+#else
+typedef float value_t;
+static const value_t SumIdentity = 0.0f;
+static const value_t MinIdentity = 3.402823466e+38f;
+static const value_t MaxIdentity = -3.402823466e+38f;
+#define AS_VALUE asfloat
+#endif
+
+StructuredBuffer<value_t>              Input      : register(t0);
+RWStructuredBuffer<value_t>            Output     : register(u0);
+// [0] result, [4] partition counter, then 16 bytes per look-back partition: flag, aggregate, inclusive.
+globallycoherent RWByteAddressBuffer   State      : register(u1);
+RWStructuredBuffer<value_t>            PartialsIn : register(u2);
+
+cbuffer params : register(b0)
+{
+    uint Count;       // elements read by this pass
+    uint GroupsX;
+    uint GroupCount;  // groups of the grid-stride loop, or look-back partitions
+    uint Sentinel;    // ReadCeiling: a bit pattern the input never contains
+}
+
+static const uint NumThreads      = 256;
+static const uint ItemsPerThread  = 16;           // look-back tile = NumThreads * ItemsPerThread
+static const uint StateHeaderSize = 16;
+static const uint PartitionSize   = 16;
+static const uint FlagAggregate   = 1;
+static const uint FlagInclusive   = 2;
+
+#if SOURCE_PARTIALS
+#define LOAD(i) PartialsIn[i]
+#else
+#define LOAD(i) Input[i]
+#endif
+
+value_t Identity()
+{
+#if OP == 0
+    return SumIdentity;
+#elif OP == 1
+    return MinIdentity;
+#else
+    return MaxIdentity;
+#endif
+}
+
+value_t Combine(value_t a, value_t b)
+{
+#if OP == 0
+    return a + b;
+#elif OP == 1
+    return min(a, b);
+#else
+    return max(a, b);
+#endif
+}
+
+value_t WaveReduce(value_t v)
+{
+#if OP == 0
+    return WaveActiveSum(v);
+#elif OP == 1
+    return WaveActiveMin(v);
+#else
+    return WaveActiveMax(v);
+#endif
+}
+
+uint GroupIndex(uint3 groupId)
+{
+    return groupId.y * GroupsX + groupId.x;
+}
+
+groupshared value_t sData[NumThreads];
+
+// Reduces one value per thread to the group total in thread 0: one wave reduction per wave, then
+// the per-wave totals (at most NumThreads / 4 of them) reduced by the first wave.
+value_t GroupReduceWave(value_t v, uint threadIndex)
+{
+    uint laneCount = WaveGetLaneCount();
+    uint waveCount = (NumThreads + laneCount - 1) / laneCount;
+
+    v = WaveReduce(v);
+    if (WaveIsFirstLane())
+    {
+        sData[threadIndex / laneCount] = v;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    value_t total = Identity();
+    if (threadIndex < laneCount)
+    {
+        for (uint w = threadIndex; w < waveCount; w += laneCount)
+        {
+            total = Combine(total, sData[w]);
+        }
+        total = WaveReduce(total);
+    }
+    return total;
+}
+
+// Each thread folds a grid-strided slice of the input into a private accumulator first, so the
+// cross-thread part of the reduction runs once per group rather than once per element.
+value_t ThreadAccumulate(uint globalIndex)
+{
+    value_t acc = Identity();
+    uint stride = GroupCount * NumThreads;
+    for (uint i = globalIndex; i < Count; i += stride)
+    {
+        acc = Combine(acc, LOAD(i));
+    }
+    return acc;
+}
+
+void AtomicCombine(uint address, value_t v)
+{
+#if TYPE_INT
+#if OP == 0
+    State.InterlockedAdd(address, asuint(v));
+#elif OP == 1
+    State.InterlockedMin(address, v);
+#else
+    State.InterlockedMax(address, v);
+#endif
+#else
+    // No float atomics on raw buffers: compare-exchange the bit pattern until it sticks.
+    uint expected = State.Load(address);
+    [allow_uav_condition]
+    for (;;)
+    {
+        uint desired = asuint(Combine(asfloat(expected), v));
+        if (desired == expected)
+        {
+            break;
+        }
+        uint original;
+        State.InterlockedCompareExchange(address, expected, desired, original);
+        if (original == expected)
+        {
+            break;
+        }
+        expected = original;
+    }
+#endif
+}
+
+[numthreads(NumThreads, 1, 1)]
+void ResetState(uint3 dispatchId : SV_DispatchThreadID)
+{
+    if (dispatchId.x == 0)
+    {
+        State.Store(0, asuint(Identity()));
+        State.Store(4, 0);
+    }
+    if (dispatchId.x < GroupCount)
+    {
+        State.Store(StateHeaderSize + dispatchId.x * PartitionSize, 0);
+    }
+}
+
+#if ALGORITHM == 4
+groupshared uint sPartition;
+#endif
+
+[numthreads(NumThreads, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    const uint threadIndex = threadId.x;
+    const uint group       = GroupIndex(groupId);
+
+#if ALGORITHM == 0 || ALGORITHM == 5
+    // Dispatches wider than 65535 groups spill into Y and round up; drop the overhang.
+    if (group >= GroupCount)
+    {
+        return;
+    }
+#endif
+
+#if ALGORITHM == 0
+    // Classic first-attempt reduction: one element per thread and interleaved addressing, whose
+    // modulo test leaves most lanes of every wave idle. One pass per factor of 256.
+    uint index = group * NumThreads + threadIndex;
+    sData[threadIndex] = index < Count ? LOAD(index) : Identity();
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint s = 1; s < NumThreads; s *= 2)
+    {
+        if (threadIndex % (2 * s) == 0)
+        {
+            sData[threadIndex] = Combine(sData[threadIndex], sData[threadIndex + s]);
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+    if (threadIndex == 0)
+    {
+        Output[group] = sData[0];
+    }
+
+#elif ALGORITHM == 1
+    // Grid-stride accumulation followed by a sequential-addressing groupshared tree.
+    sData[threadIndex] = ThreadAccumulate(group * NumThreads + threadIndex);
+    GroupMemoryBarrierWithGroupSync();
+
+    [unroll]
+    for (uint s = NumThreads / 2; s > 0; s >>= 1)
+    {
+        if (threadIndex < s)
+        {
+            sData[threadIndex] = Combine(sData[threadIndex], sData[threadIndex + s]);
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+    if (threadIndex == 0)
+    {
+        Output[group] = sData[0];
+    }
+
+#elif ALGORITHM == 2
+    // Grid-stride accumulation followed by wave intrinsics; groupshared only carries per-wave totals.
+    value_t total = GroupReduceWave(ThreadAccumulate(group * NumThreads + threadIndex), threadIndex);
+    if (threadIndex == 0)
+    {
+        Output[group] = total;
+    }
+
+#elif ALGORITHM == 3
+    // Single pass: every group folds its total into State[0] with one atomic.
+    value_t total = GroupReduceWave(ThreadAccumulate(group * NumThreads + threadIndex), threadIndex);
+    if (threadIndex == 0)
+    {
+        AtomicCombine(0, total);
+    }
+
+#elif ALGORITHM == 4
+    // Single pass with decoupled look-back as in a chained scan: partitions are handed out in launch
+    // order, each publishes its aggregate, then walks back over its predecessors until it meets an
+    // inclusive prefix. The last partition's inclusive value is the result. The look-back is done
+    // serially by thread 0.
+    if (threadIndex == 0)
+    {
+        State.InterlockedAdd(4, 1, sPartition);
+    }
+    GroupMemoryBarrierWithGroupSync();
+    const uint partition = sPartition;
+    if (partition >= GroupCount)
+    {
+        return;
+    }
+
+    value_t acc = Identity();
+    const uint tileStart = partition * NumThreads * ItemsPerThread;
+    [unroll]
+    for (uint k = 0; k < ItemsPerThread; ++k)
+    {
+        uint index = tileStart + k * NumThreads + threadIndex;
+        if (index < Count)
+        {
+            acc = Combine(acc, LOAD(index));
+        }
+    }
+    value_t aggregate = GroupReduceWave(acc, threadIndex);
+
+    if (threadIndex == 0)
+    {
+        uint flagAddress = StateHeaderSize + partition * PartitionSize;
+        value_t inclusive = aggregate;
+        if (partition != 0)
+        {
+            State.Store(flagAddress + 4, asuint(aggregate));
+            DeviceMemoryBarrier();
+            State.Store(flagAddress, FlagAggregate);
+
+            value_t prefix = Identity();
+            uint predecessor = partition - 1;
+            [allow_uav_condition]
+            for (;;)
+            {
+                uint predecessorAddress = StateHeaderSize + predecessor * PartitionSize;
+                uint flag;
+                State.InterlockedOr(predecessorAddress, 0, flag);
+                if (flag == 0)
+                {
+                    continue;
+                }
+                DeviceMemoryBarrier();
+                if (flag == FlagInclusive)
+                {
+                    prefix = Combine(AS_VALUE(State.Load(predecessorAddress + 8)), prefix);
+                    break;
+                }
+                prefix = Combine(AS_VALUE(State.Load(predecessorAddress + 4)), prefix);
+                --predecessor;
+            }
+            inclusive = Combine(prefix, aggregate);
+        }
+        State.Store(flagAddress + 8, asuint(inclusive));
+        DeviceMemoryBarrier();
+        State.Store(flagAddress, FlagInclusive);
+
+        if (partition == GroupCount - 1)
+        {
+            State.Store(0, asuint(inclusive));
+        }
+    }
+
+#else
+    // Read-bandwidth ceiling: LinearCopy's access pattern without the store. The compare against a
+    // runtime sentinel keeps the loads alive.
+    uint index = group * NumThreads + threadIndex;
+    if (index < Count && asuint(LOAD(index)) == Sentinel)
+    {
+        Output[0] = LOAD(index);
+    }
+#endif
+}
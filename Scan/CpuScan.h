@@ -0,0 +1,89 @@
+#pragma once
+
+// Parallel host scan and stream compaction: the reference the GPU kernels are validated against
+// and the host baseline they are reported next to. Same two-level scheme as reduce-then-scan:
+// per-thread chunk totals, a serial scan of those, then every chunk scanned from its offset.
+// No D3D dependency.
+
+#include "ParallelFor.h"
+#include <vector>
+#include <cstdint>
+
+enum ScanMode : uint32_t {
+    InclusiveScan = 0,
+    ExclusiveScan = 1,
+    StreamCompact = 2,
+    ScanModeCount
+};
+
+inline const char* ScanModeName(ScanMode mode)
+{
+    switch (mode)
+    {
+    case ScanMode::InclusiveScan: return "Inclusive";
+    case ScanMode::ExclusiveScan: return "Exclusive";
+    case ScanMode::StreamCompact: return "Compact";
+    default:                      return "Unknown";
+    }
+}
+
+namespace CpuScan
+{
+    // Same predicate as Scan/Shaders/Scan.hlsl.
+    inline bool Keep(uint32_t element, uint32_t keepPercent) { return element % 100 < keepPercent; }
+
+    // Scans (or compacts) `input` into `output` and returns the total: the wrapped sum of the input
+    // for scans, the number of kept elements for compaction. `output` must hold input.size() values.
+    inline uint32_t Run(ScanMode mode, const std::vector<uint32_t>& input, std::vector<uint32_t>& output,
+        uint32_t keepPercent, uint32_t threads)
+    {
+        const size_t count = input.size();
+        std::vector<uint32_t> chunkTotals(threads, 0);
+        auto value = [&](size_t i) -> uint32_t {
+            return mode == ScanMode::StreamCompact ? (Keep(input[i], keepPercent) ? 1u : 0u) : input[i];
+        };
+
+        ParallelFor(count, threads, [&](uint32_t worker, size_t begin, size_t end) {
+            uint32_t total = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                total += value(i);
+            }
+            chunkTotals[worker] = total;
+        });
+
+        uint32_t running = 0;
+        for (auto& total : chunkTotals)
+        {
+            uint32_t t = total;
+            total = running;
+            running += t;
+        }
+
+        ParallelFor(count, threads, [&](uint32_t worker, size_t begin, size_t end) {
+            uint32_t carry = chunkTotals[worker];
+            for (size_t i = begin; i < end; ++i)
+            {
+                uint32_t v = value(i);
+                switch (mode)
+                {
+                case ScanMode::InclusiveScan:
+                    carry += v;
+                    output[i] = carry;
+                    break;
+                case ScanMode::ExclusiveScan:
+                    output[i] = carry;
+                    carry += v;
+                    break;
+                default:
+                    if (v != 0)
+                    {
+                        output[carry++] = input[i];
+                    }
+                    break;
+                }
+            }
+        });
+        return running;
+    }
+}
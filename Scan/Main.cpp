@@ -0,0 +1,140 @@
+#include "d3dAppSimplified.h"
+#include "Scan.h"
+#include "CpuScan.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	ScanAlgorithm algorithm   = ScanAlgorithm::DecoupledLookback;
+	ScanMode      mode        = ScanMode::ExclusiveScan;
+	int           elements    = 1 << 24;
+	int           keepPercent = 50;
+	int           validate    = 1;
+	int           cpuThreads  = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <algorithm> <mode> <elements> <keepPercent> <validate> <cpuThreads>
+	// algorithm: 0=ReduceThenScan, 1=ReduceThenScanWave, 2=DecoupledLookback, 3=Copy
+	// mode: 0=Inclusive, 1=Exclusive, 2=Compact
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			algorithm = static_cast<ScanAlgorithm>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			mode = static_cast<ScanMode>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			elements = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			keepPercent = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			validate = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			cpuThreads = _wtoi(argv[6]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: algorithm=%d, mode=%d, elements=%d, keepPercent=%d, validate=%d, cpuThreads=%d\n",
+			static_cast<int>(algorithm), static_cast<int>(mode), elements, keepPercent, validate, cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (algorithm >= ScanAlgorithm::ScanAlgorithmCount || mode >= ScanMode::ScanModeCount)
+	{
+		OutputDebugStringA("ERROR: Unknown algorithm or mode!\n");
+		return 1;
+	}
+	// 2^29 uints is 2 GB, the D3D12 limit for a single buffer.
+	if (elements <= 0 || elements > (1 << 29) || keepPercent < 0 || keepPercent > 100 || cpuThreads <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	Scan test(hInstance, algorithm, mode, static_cast<uint32_t>(elements), static_cast<uint32_t>(keepPercent));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Scan needs shader model 6.0 (and wave operations for the wave variants)!\n");
+		return 1;
+	}
+
+	// Host reference, warmed once so page faults on the output are not timed.
+	std::vector<uint32_t> cpuOutput(static_cast<size_t>(elements));
+	CpuScan::Run(mode, test.HostData(), cpuOutput, static_cast<uint32_t>(keepPercent), static_cast<uint32_t>(cpuThreads));
+	CpuTimer timer;
+	timer.Start();
+	uint32_t cpuTotal = CpuScan::Run(mode, test.HostData(), cpuOutput, static_cast<uint32_t>(keepPercent), static_cast<uint32_t>(cpuThreads));
+	double cpuSeconds = timer.Stop();
+
+	int mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		if (validate == 0 || !test.HasResult())
+		{
+			return;
+		}
+		std::vector<uint32_t> gpuOutput;
+		uint32_t gpuTotal = test.ReadResults(gpuOutput);
+		size_t compared = mode == ScanMode::StreamCompact ? (std::min)(static_cast<size_t>(cpuTotal), gpuOutput.size()) : gpuOutput.size();
+		for (size_t i = 0; i < compared; ++i)
+		{
+			mismatches += gpuOutput[i] != cpuOutput[i] ? 1 : 0;
+		}
+		mismatches += gpuTotal != cpuTotal ? 1 : 0;
+	});
+	double gpuElementsPerS  = elements / gpuSeconds;
+	double gpuGBs           = test.MinimumBytes(cpuTotal) / gpuSeconds / 1e9;
+	double cpuElementsPerS  = elements / cpuSeconds;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Algorithm: " << ScanAlgorithmName(algorithm) << " Mode: " << ScanModeName(mode) << " Elements: " << elements
+		<< " Passes: " << test.Passes() << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuElementsPerS / 1e9 << " Gelements/s, " << gpuGBs << " GB/s)\n";
+	debugOutput << "CPU (" << cpuThreads << " threads): " << cpuSeconds << " seconds (" << cpuElementsPerS / 1e9 << " Gelements/s)\n";
+	if (mode == ScanMode::StreamCompact)
+	{
+		debugOutput << "Kept: " << cpuTotal << " of " << elements << "\n";
+	}
+	if (validate != 0 && test.HasResult())
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("scan_results.csv", "Algorithm,AlgorithmName,Mode,Elements,KeepPercent,Passes,Gpu_s,GpuElementsPerSecond,Gpu_GBs,CpuThreads,Cpu_s,CpuElementsPerSecond,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(algorithm), ScanAlgorithmName(algorithm), ScanModeName(mode), elements, keepPercent, test.Passes(),
+		gpuSeconds, gpuElementsPerS, gpuGBs, cpuThreads, cpuSeconds, cpuElementsPerS, validate != 0 && test.HasResult() ? 1 : 0, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+ALGORITHMS = {
+    0: "ReduceThenScan",
+    1: "ReduceThenScanWave",
+    2: "DecoupledLookback",
+    3: "Copy",
+}
+
+MODES = {
+    0: "Inclusive",
+    1: "Exclusive",
+    2: "Compact",
+}
+
+def run_simple_test(tryCount = 4):
+    """Sweeps scan and compaction from 1K elements to 2^29 uints (2 GB, the D3D12 single-buffer limit)"""
+
+    program = "..\\x64\\Release\\Scan.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "scan_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    keep_percent = 50
+    for exponent in range(10, 30):
+        elements = 1 << exponent
+        for mode in MODES:
+            for algorithm in ALGORITHMS:
+                # Copy does not depend on the mode; measure it once per size.
+                if algorithm == 3 and mode != 0:
+                    continue
+                print(f"\nRunning {ALGORITHMS[algorithm]} {MODES[mode]} elements {elements}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(algorithm),
+                            str(mode),
+                            str(elements),
+                            str(keep_percent),
+                            # Validate the first run of each configuration only.
+                            "1" if i == 0 else "0"
+                        ], capture_output=True, text=True)
+                        if result.returncode != 0:
+                            print(f"  Run {i+1}: failed or mismatched (exit {result.returncode})")
+                        else:
+                            print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_scan_results(filename, mode = "Exclusive"):
+    gpu = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            if parts[2] != mode and parts[1] != "Copy":
+                continue
+            elements = int(parts[3])
+            gpu.setdefault(parts[1], {}).setdefault(elements, []).append(float(parts[6]))
+
+    copy = {n: min(t) for n, t in gpu.get("Copy", {}).items()}
+    fig, (ax_rate, ax_copy) = plt.subplots(1, 2, figsize=(12, 5))
+    for name, runs in sorted(gpu.items()):
+        sizes = sorted(runs)
+        best = [min(runs[n]) for n in sizes]
+        ax_rate.plot(sizes, [n / t / 1e9 for n, t in zip(sizes, best)], marker='o', label=name)
+        if name != "Copy":
+            # Scan moves the same bytes as a copy, so time ratio = fraction of copy bandwidth.
+            fraction = [copy[n] / t for n, t in zip(sizes, best) if n in copy]
+            ax_copy.plot([n for n in sizes if n in copy], fraction, marker='o', label=name)
+
+    ax_rate.set_xscale('log', base=2)
+    ax_rate.set_xlabel('Elements')
+    ax_rate.set_ylabel('Gelements/s')
+    ax_rate.set_title(f'{mode} Scan Throughput')
+    ax_rate.grid(True)
+    ax_rate.legend(fontsize=7)
+    ax_copy.set_xscale('log', base=2)
+    ax_copy.set_xlabel('Elements')
+    ax_copy.set_ylabel('Fraction of Copy Bandwidth')
+    ax_copy.set_title(f'{mode} Scan vs GpuCopy')
+    ax_copy.grid(True)
+    ax_copy.legend(fontsize=7)
+    plt.savefig('Scan.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_scan_results("scan_results.csv")
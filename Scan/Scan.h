@@ -0,0 +1,266 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuScan.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum ScanAlgorithm : uint32_t {
+    ReduceThenScan     = 0,  // tile sums, scan of sums, tile scans; groupshared Hillis-Steele rows
+    ReduceThenScanWave = 1,  // same three passes with WavePrefixSum rows
+    DecoupledLookback  = 2,  // single pass, WavePrefixSum rows + look-back
+    Copy               = 3,  // GpuCopy's linear kernel on the same buffers: the bandwidth reference
+    ScanAlgorithmCount
+};
+
+inline const char* ScanAlgorithmName(ScanAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case ScanAlgorithm::ReduceThenScan:     return "ReduceThenScan";
+    case ScanAlgorithm::ReduceThenScanWave: return "ReduceThenScanWave";
+    case ScanAlgorithm::DecoupledLookback:  return "DecoupledLookback";
+    case ScanAlgorithm::Copy:               return "Copy";
+    default:                                return "Unknown";
+    }
+}
+
+// Scans or compacts `elements` uints with the kernels in Shaders/Scan.hlsl. All passes (and the
+// look-back state reset) are recorded in DoAction; copying the output back for validation is only
+// recorded while SetCopyResults(true), so the timed run does not include it.
+class Scan : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Count;
+		uint32_t GroupsX;
+		uint32_t TileCount;
+		uint32_t KeepPercent;
+	};
+
+    static const uint32_t NumThreads      = 256;
+    static const uint32_t ItemsPerThread  = 16;
+    static const uint32_t TileSize        = NumThreads * ItemsPerThread;
+    static const uint32_t StateHeaderSize = 16;
+    static const uint32_t PartitionSize   = 16;
+
+    Scan(HINSTANCE hInstance, ScanAlgorithm algorithm, ScanMode mode, uint32_t elements, uint32_t keepPercent) :
+		D3DAppSimplified(hInstance),
+		m_algorithm(algorithm),
+		m_mode(mode),
+		m_elements(elements),
+		m_keepPercent(keepPercent)
+	{
+		mHostData.resize(m_elements);
+		for (uint32_t i = 0; i < m_elements; ++i)
+		{
+			mHostData[i] = (i * 2654435761u) >> 16;
+		}
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		UINT64 bytes = static_cast<UINT64>(m_elements) * sizeof(uint32_t);
+		mInputBuffer    = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostData.data(), bytes);
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, bytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mTileSums       = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>(TileCount()) * sizeof(uint32_t),
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mStateBuffer    = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, StateHeaderSize + static_cast<UINT64>(TileCount()) * PartitionSize,
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		// The total has its own readback so the output readback can use the whole 2 GB buffer limit.
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, bytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+		mTotalReadback  = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, sizeof(uint32_t), D3D12_RESOURCE_FLAG_NONE,
+			D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		switch (m_algorithm)
+		{
+		case ScanAlgorithm::ReduceThenScan:
+		case ScanAlgorithm::ReduceThenScanWave:
+			for (uint32_t pass = 0; pass < 3; ++pass)
+			{
+				mShaders[pass] = D3DUtil::CompileShaderDxc(L"Shaders\\Scan.hlsl", Defines(pass), L"main", L"cs_6_0");
+			}
+			break;
+		case ScanAlgorithm::DecoupledLookback:
+			mShaders[0] = D3DUtil::CompileShaderDxc(L"Shaders\\Scan.hlsl", Defines(0), L"main", L"cs_6_0");
+			mResetShader = D3DUtil::CompileShaderDxc(L"Shaders\\Scan.hlsl", Defines(0), L"ResetState", L"cs_6_0");
+			break;
+		default:
+			mShaders[0] = D3DUtil::CompileShaderDxc(L"Shaders\\Scan.hlsl", Defines(0), L"main", L"cs_6_0");
+			break;
+		}
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[5];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+		slotRootParameter[3].InitAsUnorderedAccessView(1);
+		slotRootParameter[4].InitAsUnorderedAccessView(2);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(5, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		for (int i = 0; i < 3; ++i)
+		{
+			if (mShaders[i])
+			{
+				mPSOs[i] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[i].Get());
+			}
+		}
+		if (mResetShader)
+		{
+			mResetPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mResetShader.Get());
+		}
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(3, mStateBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(4, mTileSums->GetGPUVirtualAddress());
+
+		uint32_t tiles = TileCount();
+		switch (m_algorithm)
+		{
+		case ScanAlgorithm::ReduceThenScan:
+		case ScanAlgorithm::ReduceThenScanWave:
+			SetConstantsAndDispatch(mPSOs[0].Get(), tiles);
+			UavBarrier();
+			SetConstantsAndDispatch(mPSOs[1].Get(), 1);
+			UavBarrier();
+			SetConstantsAndDispatch(mPSOs[2].Get(), tiles);
+			break;
+		case ScanAlgorithm::DecoupledLookback:
+			SetConstantsAndDispatch(mResetPSO.Get(), DivideRoundUp(tiles, NumThreads));
+			UavBarrier();
+			SetConstantsAndDispatch(mPSOs[0].Get(), tiles);
+			break;
+		default:
+			SetConstantsAndDispatch(mPSOs[0].Get(), (std::max)(DivideRoundUp(m_elements, NumThreads), 1u));
+			break;
+		}
+
+		if (CopyResults() && HasResult())
+		{
+			D3D12_RESOURCE_BARRIER barriers[] = {
+				CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE),
+				CD3DX12_RESOURCE_BARRIER::Transition(mStateBuffer.Get(),  D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE)
+			};
+			commandList->ResourceBarrier(_countof(barriers), barriers);
+			UINT64 bytes = static_cast<UINT64>(m_elements) * sizeof(uint32_t);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, bytes);
+			commandList->CopyBufferRegion(mTotalReadback.Get(), 0, mStateBuffer.Get(), 0, sizeof(uint32_t));
+		}
+    }
+
+	bool     Supported() const { return m_supported; }
+	bool     HasResult() const { return m_algorithm != ScanAlgorithm::Copy; }
+	uint32_t TileCount() const { return (std::max)(DivideRoundUp(m_elements, TileSize), 1u); }
+	uint32_t Passes()    const { return m_algorithm == ScanAlgorithm::ReduceThenScan || m_algorithm == ScanAlgorithm::ReduceThenScanWave ? 3 : 1; }
+	// Bytes a perfect implementation must move: read the input once, write the output once
+	// (compaction only writes the kept elements).
+	UINT64   MinimumBytes(uint32_t kept) const
+	{
+		UINT64 written = m_mode == ScanMode::StreamCompact && HasResult() ? kept : m_elements;
+		return (static_cast<UINT64>(m_elements) + written) * sizeof(uint32_t);
+	}
+	const std::vector<uint32_t>& HostData() const { return mHostData; }
+
+	// Output and total from the last Dispatch() recorded with SetCopyResults(true).
+	uint32_t ReadResults(std::vector<uint32_t>& output)
+	{
+		size_t bytes = static_cast<size_t>(m_elements) * sizeof(uint32_t);
+		uint8_t* mapped = nullptr;
+		D3D12_RANGE readRange  = { 0, bytes };
+		D3D12_RANGE writeRange = { 0, 0 };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		output.resize(m_elements);
+		memcpy(output.data(), mapped, bytes);
+		mReadbackBuffer->Unmap(0, &writeRange);
+
+		uint32_t total;
+		D3D12_RANGE totalRange = { 0, sizeof(uint32_t) };
+		AssertIfFailed(mTotalReadback->Map(0, &totalRange, reinterpret_cast<void**>(&mapped)));
+		memcpy(&total, mapped, sizeof(total));
+		mTotalReadback->Unmap(0, &writeRange);
+		return total;
+	}
+
+private:
+
+	void SetConstantsAndDispatch(ID3D12PipelineState* pso, uint32_t groups)
+	{
+		auto commandList = GraphicsCommandList();
+		RootConstants constants = { m_elements, GroupsX(groups), TileCount(), m_keepPercent };
+		commandList->SetPipelineState(pso);
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		DispatchGroups(groups);
+	}
+
+	std::vector<std::wstring> Defines(uint32_t pass) const
+	{
+		return {
+			L"ALGORITHM=" + std::to_wstring(static_cast<uint32_t>(m_algorithm)),
+			L"MODE=" + std::to_wstring(static_cast<uint32_t>(m_mode)),
+			L"PASS=" + std::to_wstring(pass)
+		};
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		if (m_algorithm == ScanAlgorithm::ReduceThenScan || m_algorithm == ScanAlgorithm::Copy)
+		{
+			return true;
+		}
+		D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+		if (FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) || !options1.WaveOps)
+		{
+			OutputDebugStringA("Wave operations not supported\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShaders[3];
+    ComPtr<ID3DBlob> mResetShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[3];    // reduce-then-scan passes; [0] alone otherwise
+	ComPtr<ID3D12PipelineState> mResetPSO;
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mTileSums;
+	ComPtr<ID3D12Resource> mStateBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+	ComPtr<ID3D12Resource> mTotalReadback;
+
+	std::vector<uint32_t> mHostData;
+
+	ScanAlgorithm m_algorithm;
+	ScanMode      m_mode;
+	uint32_t      m_elements;
+	uint32_t      m_keepPercent;
+	bool          m_supported = false;
+};
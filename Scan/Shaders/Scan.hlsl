@@ -0,0 +1,307 @@
+// Compiled with DXC (cs_6_0). Variants are selected by defines:
+//   ALGORITHM  0=ReduceThenScan (groupshared row scans), 1=ReduceThenScanWave (WavePrefixSum row
+//              scans), 2=DecoupledLookback (WavePrefixSum row scans, single pass), 3=Copy
+//   MODE       0=inclusive scan, 1=exclusive scan, 2=stream compaction
+//   PASS       reduce-then-scan only: 0=tile sums, 1=scan of tile sums, 2=tile scans
+//
+// A tile is ItemsPerThread rows of NumThreads elements. Rows are read coalesced and scanned one after
+// another with a running carry, so every variant shares the same load pattern.
+
+StructuredBuffer<uint>               Input    : register(t0);
+RWStructuredBuffer<uint>             Output   : register(u0);
+// [0] total (compaction: kept count), [4] partition counter, then 16 bytes per look-back
+// partition: flag, aggregate, inclusive prefix.
+globallycoherent RWByteAddressBuffer State    : register(u1);
+RWStructuredBuffer<uint>             TileSums : register(u2);
+
+cbuffer params : register(b0)
+{
+    uint Count;        // elements
+    uint GroupsX;
+    uint TileCount;    // tiles (= look-back partitions)
+    uint KeepPercent;  // compaction keeps elements with value % 100 < KeepPercent
+}
+
+static const uint NumThreads      = 256;
+static const uint ItemsPerThread  = 16;
+static const uint TileSize        = NumThreads * ItemsPerThread;
+static const uint StateHeaderSize = 16;
+static const uint PartitionSize   = 16;
+static const uint FlagAggregate   = 1;
+static const uint FlagInclusive   = 2;
+
+#if ALGORITHM == 0
+#define WAVE_SCAN 0
+#else
+#define WAVE_SCAN 1
+#endif
+
+uint GroupIndex(uint3 groupId)
+{
+    return groupId.y * GroupsX + groupId.x;
+}
+
+// The value that gets scanned: the element itself, or its keep flag when compacting.
+uint ScanValue(uint element)
+{
+#if MODE == 2
+    return (element % 100) < KeepPercent ? 1 : 0;
+#else
+    return element;
+#endif
+}
+
+#if WAVE_SCAN
+groupshared uint sWaveTotals[NumThreads];
+groupshared uint sGroupTotal;
+
+// Exclusive prefix of `value` across the group and the group total, from WavePrefixSum plus one
+// serial pass over the per-wave totals.
+uint GroupExclusiveScan(uint value, uint threadIndex, out uint total)
+{
+    uint laneCount = WaveGetLaneCount();
+    uint waveIndex = threadIndex / laneCount;
+    uint prefix    = WavePrefixSum(value);
+    uint waveTotal = WaveActiveSum(value);
+    if (WaveIsFirstLane())
+    {
+        sWaveTotals[waveIndex] = waveTotal;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (threadIndex == 0)
+    {
+        uint waveCount = (NumThreads + laneCount - 1) / laneCount;
+        uint running = 0;
+        for (uint w = 0; w < waveCount; ++w)
+        {
+            uint t = sWaveTotals[w];
+            sWaveTotals[w] = running;
+            running += t;
+        }
+        sGroupTotal = running;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    prefix += sWaveTotals[waveIndex];
+    total = sGroupTotal;
+    GroupMemoryBarrierWithGroupSync();
+    return prefix;
+}
+#else
+groupshared uint sScan[2][NumThreads];
+
+// Hillis-Steele scan in double-buffered groupshared memory: log2(NumThreads) barrier steps.
+uint GroupExclusiveScan(uint value, uint threadIndex, out uint total)
+{
+    uint source = 0;
+    sScan[source][threadIndex] = value;
+    GroupMemoryBarrierWithGroupSync();
+
+    [unroll]
+    for (uint offset = 1; offset < NumThreads; offset <<= 1)
+    {
+        uint sum = sScan[source][threadIndex];
+        if (threadIndex >= offset)
+        {
+            sum += sScan[source][threadIndex - offset];
+        }
+        sScan[source ^ 1][threadIndex] = sum;
+        source ^= 1;
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    uint inclusive = sScan[source][threadIndex];
+    total = sScan[source][NumThreads - 1];
+    GroupMemoryBarrierWithGroupSync();
+    return inclusive - value;
+}
+#endif
+
+// Loads one tile into registers (rows of NumThreads, coalesced); out-of-range elements scan as 0.
+void LoadTile(uint tileStart, uint threadIndex, out uint elements[ItemsPerThread], out uint threadSum)
+{
+    threadSum = 0;
+    [unroll]
+    for (uint k = 0; k < ItemsPerThread; ++k)
+    {
+        uint index = tileStart + k * NumThreads + threadIndex;
+        elements[k] = index < Count ? Input[index] : 0;
+        threadSum += index < Count ? ScanValue(elements[k]) : 0;
+    }
+}
+
+// Scans the tile row by row starting from `carry` (the exclusive prefix of the tile) and writes the
+// scan, or scatters kept elements when compacting.
+void ScanTile(uint tileStart, uint threadIndex, uint elements[ItemsPerThread], uint carry)
+{
+    [unroll]
+    for (uint k = 0; k < ItemsPerThread; ++k)
+    {
+        uint index = tileStart + k * NumThreads + threadIndex;
+        uint value = index < Count ? ScanValue(elements[k]) : 0;
+        uint rowTotal;
+        uint exclusive = carry + GroupExclusiveScan(value, threadIndex, rowTotal);
+        if (index < Count)
+        {
+#if MODE == 0
+            Output[index] = exclusive + value;
+#elif MODE == 1
+            Output[index] = exclusive;
+#else
+            if (value != 0)
+            {
+                Output[exclusive] = elements[k];
+            }
+#endif
+        }
+        carry += rowTotal;
+    }
+}
+
+[numthreads(NumThreads, 1, 1)]
+void ResetState(uint3 dispatchId : SV_DispatchThreadID)
+{
+    if (dispatchId.x == 0)
+    {
+        State.Store(0, 0);
+        State.Store(4, 0);
+    }
+    if (dispatchId.x < TileCount)
+    {
+        State.Store(StateHeaderSize + dispatchId.x * PartitionSize, 0);
+    }
+}
+
+#if ALGORITHM == 2
+groupshared uint sPartition;
+groupshared uint sPrefix;
+#endif
+
+[numthreads(NumThreads, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    const uint threadIndex = threadId.x;
+    const uint group       = GroupIndex(groupId);
+
+#if ALGORITHM == 3
+    // Copy ceiling: LinearCopy's kernel on the same buffers, one element per thread.
+    uint index = group * NumThreads + threadIndex;
+    if (index < Count)
+    {
+        Output[index] = Input[index];
+    }
+
+#elif ALGORITHM == 2
+    // Single pass: partitions are handed out in launch order; each publishes its aggregate, looks back
+    // over its predecessors (serially, thread 0) for its exclusive prefix, then scans its tile.
+    if (threadIndex == 0)
+    {
+        State.InterlockedAdd(4, 1, sPartition);
+    }
+    GroupMemoryBarrierWithGroupSync();
+    const uint partition = sPartition;
+    if (partition >= TileCount)
+    {
+        return;
+    }
+
+    const uint tileStart = partition * TileSize;
+    uint elements[ItemsPerThread];
+    uint threadSum;
+    LoadTile(tileStart, threadIndex, elements, threadSum);
+    uint aggregate;
+    GroupExclusiveScan(threadSum, threadIndex, aggregate);
+
+    if (threadIndex == 0)
+    {
+        uint flagAddress = StateHeaderSize + partition * PartitionSize;
+        uint prefix = 0;
+        if (partition != 0)
+        {
+            State.Store(flagAddress + 4, aggregate);
+            DeviceMemoryBarrier();
+            State.Store(flagAddress, FlagAggregate);
+
+            uint predecessor = partition - 1;
+            [allow_uav_condition]
+            for (;;)
+            {
+                uint predecessorAddress = StateHeaderSize + predecessor * PartitionSize;
+                uint flag;
+                State.InterlockedOr(predecessorAddress, 0, flag);
+                if (flag == 0)
+                {
+                    continue;
+                }
+                DeviceMemoryBarrier();
+                if (flag == FlagInclusive)
+                {
+                    prefix += State.Load(predecessorAddress + 8);
+                    break;
+                }
+                prefix += State.Load(predecessorAddress + 4);
+                --predecessor;
+            }
+        }
+        State.Store(flagAddress + 8, prefix + aggregate);
+        DeviceMemoryBarrier();
+        State.Store(flagAddress, FlagInclusive);
+
+        if (partition == TileCount - 1)
+        {
+            State.Store(0, prefix + aggregate);
+        }
+        sPrefix = prefix;
+    }
+    GroupMemoryBarrierWithGroupSync();
+    ScanTile(tileStart, threadIndex, elements, sPrefix);
+
+#elif PASS == 0
+    // Reduce-then-scan, pass 1: one sum per tile.
+    if (group >= TileCount)
+    {
+        return;
+    }
+    uint elements[ItemsPerThread];
+    uint threadSum;
+    LoadTile(group * TileSize, threadIndex, elements, threadSum);
+    uint tileSum;
+    GroupExclusiveScan(threadSum, threadIndex, tileSum);
+    if (threadIndex == 0)
+    {
+        TileSums[group] = tileSum;
+    }
+
+#elif PASS == 1
+    // Pass 2: a single group turns the tile sums into exclusive tile offsets, NumThreads at a time.
+    uint carry = 0;
+    for (uint start = 0; start < TileCount; start += NumThreads)
+    {
+        uint index = start + threadIndex;
+        uint value = index < TileCount ? TileSums[index] : 0;
+        uint rowTotal;
+        uint exclusive = carry + GroupExclusiveScan(value, threadIndex, rowTotal);
+        if (index < TileCount)
+        {
+            TileSums[index] = exclusive;
+        }
+        carry += rowTotal;
+    }
+    if (threadIndex == 0)
+    {
+        State.Store(0, carry);
+    }
+
+#else
+    // Pass 3: every tile is scanned again, starting from its offset.
+    if (group >= TileCount)
+    {
+        return;
+    }
+    uint elements[ItemsPerThread];
+    uint threadSum;
+    LoadTile(group * TileSize, threadIndex, elements, threadSum);
+    ScanTile(group * TileSize, threadIndex, elements, TileSums[group]);
+#endif
+}
@@ -0,0 +1,208 @@
+#include "d3dAppSimplified.h"
+#include "SpMV.h"
+#include "MatrixMarket.h"
+#include "SparseFormats.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+#include <cfloat>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	std::wstring  source     = L"laplace:1024";
+	SpmvAlgorithm algorithm  = SpmvAlgorithm::CsrVector;
+	int           sliceSize  = 32;
+	int           sigma      = 256;
+	int           validate   = 1;
+	int           cpuThreads = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <matrix> <algorithm> <sliceSize> <sigma> <validate> <cpuThreads>
+	// matrix: path to a Matrix Market (.mtx) coordinate file, or laplace:N (5-point Laplacian on an
+	// N x N grid) or powerlaw:N (N rows of Zipf-like length)
+	// algorithm: 0=CsrScalar, 1=CsrVector, 2=CsrMergePath, 3=Ell, 4=SellCSigma   sliceSize, sigma: SELL-C-sigma only
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			source = argv[1];
+		}
+		if (argc >= 3)
+		{
+			algorithm = static_cast<SpmvAlgorithm>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			sliceSize = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			sigma = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			validate = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			cpuThreads = _wtoi(argv[6]);
+		}
+
+		wchar_t buffer[1024];
+		swprintf_s(buffer, L"Params: matrix=%s, algorithm=%d, sliceSize=%d, sigma=%d, validate=%d, cpuThreads=%d\n",
+			source.c_str(), static_cast<int>(algorithm), sliceSize, sigma, validate, cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (algorithm >= SpmvAlgorithm::SpmvAlgorithmCount)
+	{
+		OutputDebugStringA("ERROR: Unknown algorithm!\n");
+		return 1;
+	}
+	if (sliceSize <= 0 || sliceSize > 1024 || sigma <= 0 || cpuThreads <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	// Synthetic matrices are generated, anything else is loaded from disk.
+	std::string matrixName(source.begin(), source.end());
+	CooMatrix   coo;
+	CpuTimer    timer;
+	timer.Start();
+	if (source.compare(0, 8, L"laplace:") == 0 || source.compare(0, 9, L"powerlaw:") == 0)
+	{
+		bool laplace = source[0] == L'l';
+		int  n       = _wtoi(source.c_str() + (laplace ? 8 : 9));
+		if (n <= 0 || (laplace && n > (1 << 13)) || (!laplace && n > (1 << 24)))
+		{
+			OutputDebugStringA("ERROR: Invalid synthetic matrix size!\n");
+			return 1;
+		}
+		coo = SparseFormats::MakeSynthetic(laplace ? SyntheticMatrix::Laplacian2D : SyntheticMatrix::PowerLaw, static_cast<uint32_t>(n));
+	}
+	else
+	{
+		std::string error;
+		if (!MatrixMarket::Load(source, coo, static_cast<uint32_t>(cpuThreads), error))
+		{
+			D3DUtil::PrintDebugString("ERROR: Cannot load " + matrixName + ": " + error + "\n");
+			return 1;
+		}
+		matrixName = matrixName.substr(matrixName.find_last_of("\\/") + 1);
+	}
+	double loadSeconds = timer.Stop();
+
+	timer.Start();
+	CsrMatrix csr = SparseFormats::ToCsr(coo);
+	double csrSeconds = timer.Stop();
+	CooMatrix().entries.swap(coo.entries);
+
+	// Every array has to fit one buffer (2 GB); ELL is checked before it is built.
+	const uint64_t maxEntries = 1ull << 29;
+	if (csr.Nnz() > maxEntries || csr.rows >= maxEntries || csr.cols > maxEntries ||
+		(algorithm == SpmvAlgorithm::Ell && SparseFormats::EllEntries(csr) > maxEntries))
+	{
+		OutputDebugStringA("ERROR: Matrix too large for this layout!\n");
+		return 1;
+	}
+	const uint32_t rows          = csr.rows;
+	const uint32_t cols          = csr.cols;
+	const uint32_t nnz           = csr.Nnz();
+	const uint32_t maxRowLength  = SparseFormats::MaxRowLength(csr);
+
+	SpMV test(hInstance, algorithm, std::move(csr), static_cast<uint32_t>(sliceSize), static_cast<uint32_t>(sigma));
+	if (test.StoredEntries() > maxEntries)
+	{
+		OutputDebugStringA("ERROR: Matrix too large for this layout!\n");
+		return 1;
+	}
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: SpMV needs shader model 6.0 (and wave operations for CsrVector)!\n");
+		return 1;
+	}
+
+	std::vector<float> gpuY;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		if (validate != 0)
+		{
+			gpuY = test.ReadY();
+		}
+	});
+	double gpuGflops  = test.Flops() / gpuSeconds / 1e9;
+	double gpuGBs     = test.ModelBytes() / gpuSeconds / 1e9;
+
+	// Host baseline, warmed once so page faults on y are not timed.
+	std::vector<float> cpuY;
+	SparseFormats::Multiply<float>(test.Csr(), test.HostX(), cpuY, static_cast<uint32_t>(cpuThreads));
+	timer.Start();
+	SparseFormats::Multiply<float>(test.Csr(), test.HostX(), cpuY, static_cast<uint32_t>(cpuThreads));
+	double cpuSeconds = timer.Stop();
+	double cpuGflops  = test.Flops() / cpuSeconds / 1e9;
+
+	// Every row may differ from the double-precision reference by the fp32 summation bound
+	// len * eps * sum |a_ij x_j|, whatever order the kernel added in.
+	uint32_t mismatches = 0;
+	double   maxError   = 0.0;
+	if (validate != 0)
+	{
+		std::vector<float> reference;
+		std::vector<float> rowAbs;
+		SparseFormats::Multiply<double>(test.Csr(), test.HostX(), reference, static_cast<uint32_t>(cpuThreads), &rowAbs);
+		const std::vector<uint32_t>& offsets = test.Csr().rowOffsets;
+		for (uint32_t row = 0; row < rows; ++row)
+		{
+			double error     = std::fabs(static_cast<double>(gpuY[row]) - reference[row]);
+			double tolerance = (offsets[row + 1] - offsets[row] + 1) * static_cast<double>(FLT_EPSILON) * rowAbs[row] + FLT_MIN;
+			maxError    = (std::max)(maxError, error);
+			mismatches += error > tolerance ? 1 : 0;
+		}
+	}
+
+	double padding = nnz > 0 ? static_cast<double>(test.StoredEntries()) / nnz : 1.0;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Matrix: " << matrixName << " (" << rows << " x " << cols << ", " << nnz << " nonzeros, longest row " << maxRowLength << ")\n";
+	debugOutput << "Algorithm: " << SpmvAlgorithmName(algorithm);
+	if (algorithm == SpmvAlgorithm::SellCSigma)
+	{
+		debugOutput << " C=" << sliceSize << " sigma=" << sigma;
+	}
+	debugOutput << " Stored entries: " << test.StoredEntries() << " (" << padding << "x nnz)\n";
+	debugOutput << "Host: load " << loadSeconds << " s, CSR build " << csrSeconds << " s, layout conversion " << test.ConversionSeconds() << " s\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGflops << " GFLOPS, " << gpuGBs << " GB/s effective)\n";
+	debugOutput << "CPU (" << cpuThreads << " threads): " << cpuSeconds << " seconds (" << cpuGflops << " GFLOPS)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " rows out of bound, max error " << maxError << ")\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("spmv_results.csv", "Matrix,Rows,Cols,Nnz,MaxRowLength,Algorithm,AlgorithmName,SliceSize,Sigma,StoredEntries,Padding,Load_s,Csr_s,Convert_s,Gpu_s,Gpu_GFLOPS,Gpu_GBs,CpuThreads,Cpu_s,Cpu_GFLOPS,Validated,Mismatches,MaxError", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(matrixName, rows, cols, nnz, maxRowLength, static_cast<int>(algorithm), SpmvAlgorithmName(algorithm), sliceSize, sigma,
+		test.StoredEntries(), padding, loadSeconds, csrSeconds, test.ConversionSeconds(), gpuSeconds, gpuGflops, gpuGBs,
+		cpuThreads, cpuSeconds, cpuGflops, validate, mismatches, maxError);
+    return mismatches == 0 ? 0 : 1;
+}
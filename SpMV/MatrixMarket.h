@@ -0,0 +1,358 @@
+#pragma once
+
+// Matrix Market (coordinate) reader: the file is memory-mapped, the entry section is split into one
+// chunk per thread at line boundaries and every thread parses its chunk into its own list, which are
+// then concatenated in order. Handles real/integer/pattern values and general/symmetric/
+// skew-symmetric storage (the mirrored half is generated). No D3D dependency.
+
+#include "ParallelFor.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cctype>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct CooEntry
+{
+    uint32_t row;
+    uint32_t col;
+    float    value;
+};
+
+struct CooMatrix
+{
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    std::vector<CooEntry> entries;
+};
+
+// Read-only view of a whole file.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    bool Open(const std::wstring& path)
+    {
+        Close();
+#if defined(_WIN32)
+        m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+        {
+            return false;
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping == nullptr)
+        {
+            return false;
+        }
+        m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+        std::string narrow(path.begin(), path.end());
+        m_fd = open(narrow.c_str(), O_RDONLY);
+        struct stat status;
+        if (m_fd < 0 || fstat(m_fd, &status) != 0 || status.st_size == 0)
+        {
+            return false;
+        }
+        m_size = static_cast<size_t>(status.st_size);
+        void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        m_data = view == MAP_FAILED ? nullptr : static_cast<const char*>(view);
+#endif
+        return m_data != nullptr;
+    }
+
+    void Close()
+    {
+#if defined(_WIN32)
+        if (m_data != nullptr)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr)
+        {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+        }
+        m_mapping = nullptr;
+        m_file    = INVALID_HANDLE_VALUE;
+#else
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+        m_fd = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const char* Data() const { return m_data; }
+    size_t      Size() const { return m_size; }
+
+private:
+#if defined(_WIN32)
+    HANDLE m_file    = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int    m_fd      = -1;
+#endif
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+};
+
+namespace MatrixMarket
+{
+    // Cursor over [p, end); all parsers stop at end instead of relying on a terminator.
+    struct Cursor
+    {
+        const char* p;
+        const char* end;
+
+        void SkipBlanks()
+        {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            {
+                ++p;
+            }
+        }
+
+        void SkipLine()
+        {
+            while (p < end && *p != '\n')
+            {
+                ++p;
+            }
+            if (p < end)
+            {
+                ++p;
+            }
+        }
+
+        bool ParseUnsigned(uint64_t& value)
+        {
+            SkipBlanks();
+            if (p >= end || *p < '0' || *p > '9')
+            {
+                return false;
+            }
+            value = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+            {
+                value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+            }
+            return true;
+        }
+
+        // Decimal or scientific notation. Mantissa digits beyond 19 only shift the exponent, which
+        // is plenty for single-precision values.
+        bool ParseFloat(float& value)
+        {
+            SkipBlanks();
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+'))
+            {
+                negative = *p++ == '-';
+            }
+            uint64_t mantissa = 0;
+            int      exponent = 0;
+            int      digits   = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+            {
+                if (digits < 19) { mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0'); ++digits; }
+                else             { ++exponent; }
+                ++p;
+            }
+            if (p < end && *p == '.')
+            {
+                ++p;
+                while (p < end && *p >= '0' && *p <= '9')
+                {
+                    if (digits < 19) { mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0'); ++digits; --exponent; }
+                    ++p;
+                }
+            }
+            if (p < end && (*p == 'e' || *p == 'E'))
+            {
+                ++p;
+                bool negativeExponent = false;
+                if (p < end && (*p == '-' || *p == '+'))
+                {
+                    negativeExponent = *p++ == '-';
+                }
+                uint64_t e = 0;
+                if (!ParseUnsigned(e))
+                {
+                    return false;
+                }
+                int magnitude = static_cast<int>((std::min)(e, static_cast<uint64_t>(1000)));
+                exponent += negativeExponent ? -magnitude : magnitude;
+            }
+            double result = static_cast<double>(mantissa);
+            double scale  = 1.0;
+            for (int i = 0; i < (exponent < 0 ? -exponent : exponent) && i < 400; ++i)
+            {
+                scale *= 10.0;
+            }
+            result = exponent < 0 ? result / scale : result * scale;
+            value = static_cast<float>(negative ? -result : result);
+            return true;
+        }
+    };
+
+    inline bool StartsWith(const std::string& text, const char* prefix)
+    {
+        return text.compare(0, strlen(prefix), prefix) == 0;
+    }
+
+    // Loads a coordinate-format file into `matrix` (1-based indices become 0-based). On failure
+    // returns false and describes the problem in `error`.
+    inline bool Load(const std::wstring& path, CooMatrix& matrix, uint32_t threads, std::string& error)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            error = "cannot open or map the file";
+            return false;
+        }
+        Cursor cursor = { file.Data(), file.Data() + file.Size() };
+
+        // Banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+        const char* lineEnd = static_cast<const char*>(memchr(cursor.p, '\n', file.Size()));
+        std::string banner(cursor.p, lineEnd != nullptr ? lineEnd : cursor.end);
+        std::transform(banner.begin(), banner.end(), banner.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+        if (!StartsWith(banner, "%%matrixmarket matrix coordinate"))
+        {
+            error = "not a coordinate Matrix Market file";
+            return false;
+        }
+        bool pattern   = banner.find(" pattern") != std::string::npos;
+        bool symmetric = banner.find(" symmetric") != std::string::npos;
+        bool skew      = banner.find(" skew-symmetric") != std::string::npos;
+        if (banner.find(" complex") != std::string::npos || banner.find(" hermitian") != std::string::npos)
+        {
+            error = "complex matrices are not supported";
+            return false;
+        }
+        cursor.SkipLine();
+
+        while (cursor.p < cursor.end && (*cursor.p == '%' || *cursor.p == '\n' || *cursor.p == '\r'))
+        {
+            cursor.SkipLine();
+        }
+        uint64_t rows = 0, cols = 0, stored = 0;
+        if (!cursor.ParseUnsigned(rows) || !cursor.ParseUnsigned(cols) || !cursor.ParseUnsigned(stored) ||
+            rows == 0 || cols == 0 || rows > 0xFFFFFFFFull || cols > 0xFFFFFFFFull)
+        {
+            error = "bad size line";
+            return false;
+        }
+        cursor.SkipLine();
+
+        // One chunk per thread, starts moved forward to the next line.
+        const char* body = cursor.p;
+        size_t bodySize = static_cast<size_t>(cursor.end - body);
+        threads = (std::max)(1u, (std::min)(threads, static_cast<uint32_t>(bodySize / 4096 + 1)));
+        std::vector<const char*> starts(threads + 1);
+        for (uint32_t t = 0; t <= threads; ++t)
+        {
+            Cursor split = { body + bodySize * t / threads, cursor.end };
+            if (t != 0 && t != threads && split.p > body && split.p[-1] != '\n')
+            {
+                split.SkipLine();
+            }
+            starts[t] = t == threads ? cursor.end : split.p;
+        }
+
+        std::vector<std::vector<CooEntry>> parts(threads);
+        std::vector<int> failed(threads, 0);
+        std::vector<uint64_t> lines(threads, 0);
+        ParallelFor(threads, threads, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t)
+            {
+                Cursor chunk = { starts[t], starts[t + 1] };
+                std::vector<CooEntry>& out = parts[t];
+                out.reserve(static_cast<size_t>(chunk.end - chunk.p) / 16);
+                while (chunk.p < chunk.end)
+                {
+                    chunk.SkipBlanks();
+                    if (chunk.p >= chunk.end || *chunk.p == '\n' || *chunk.p == '%')
+                    {
+                        chunk.SkipLine();
+                        continue;
+                    }
+                    uint64_t row = 0, col = 0;
+                    float value = 1.0f;
+                    if (!chunk.ParseUnsigned(row) || !chunk.ParseUnsigned(col) || (!pattern && !chunk.ParseFloat(value)) ||
+                        row == 0 || col == 0 || row > rows || col > cols)
+                    {
+                        failed[t] = 1;
+                        return;
+                    }
+                    out.push_back(CooEntry{ static_cast<uint32_t>(row - 1), static_cast<uint32_t>(col - 1), value });
+                    ++lines[t];
+                    if ((symmetric || skew) && row != col)
+                    {
+                        out.push_back(CooEntry{ static_cast<uint32_t>(col - 1), static_cast<uint32_t>(row - 1), skew ? -value : value });
+                    }
+                    chunk.SkipLine();
+                }
+            }
+        }, 1);
+
+        size_t   total = 0;
+        uint64_t read  = 0;
+        for (uint32_t t = 0; t < threads; ++t)
+        {
+            if (failed[t] != 0)
+            {
+                error = "malformed entry line";
+                return false;
+            }
+            total += parts[t].size();
+            read  += lines[t];
+        }
+        // A truncated or padded file: the size line's count has to match the entry lines.
+        if (read != stored)
+        {
+            error = "size line declares " + std::to_string(stored) + " entries, file has " + std::to_string(read);
+            return false;
+        }
+        matrix.rows = static_cast<uint32_t>(rows);
+        matrix.cols = static_cast<uint32_t>(cols);
+        matrix.entries.clear();
+        matrix.entries.reserve(total);
+        for (auto& part : parts)
+        {
+            matrix.entries.insert(matrix.entries.end(), part.begin(), part.end());
+            std::vector<CooEntry>().swap(part);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,88 @@
+import subprocess
+import os
+import sys
+import time
+import matplotlib.pyplot as plt
+
+ALGORITHMS = {
+    0: "CsrScalar",
+    1: "CsrVector",
+    2: "CsrMergePath",
+    3: "Ell",
+    4: "SellCSigma",
+}
+
+# Regular and irregular synthetic matrices; Matrix Market files given on the command line are
+# appended (e.g. from the SuiteSparse collection).
+MATRICES = [
+    "laplace:512",
+    "laplace:2048",
+    "powerlaw:1048576",
+    "powerlaw:4194304",
+]
+
+def run_simple_test(matrices, tryCount = 3):
+    """Runs every SpMV kernel over every matrix"""
+
+    program = "..\\x64\\Release\\SpMV.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "spmv_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for matrix in matrices:
+        for algorithm in ALGORITHMS:
+            print(f"\nRunning {ALGORITHMS[algorithm]} on {matrix}...")
+            for i in range(tryCount):
+                time.sleep(0.01)
+                try:
+                    result = subprocess.run([
+                        program,
+                        matrix,
+                        str(algorithm),
+                        "32",
+                        "256",
+                        # Validate the first run of each configuration only.
+                        "1" if i == 0 else "0"
+                    ], capture_output=True, text=True)
+                    if result.returncode != 0:
+                        print(f"  Run {i+1}: failed, too large or mismatched (exit {result.returncode})")
+                    else:
+                        print(f"  Run {i+1}: {result.stdout.strip()}")
+                except Exception as e:
+                    print(f"  Run {i+1}: Error - {e}")
+
+def plot_spmv_results(filename):
+    gflops = {}
+    cpu = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            matrix, algorithm = parts[0], parts[6]
+            gflops.setdefault(matrix, {}).setdefault(algorithm, []).append(float(parts[15]))
+            cpu.setdefault(matrix, []).append(float(parts[19]))
+
+    matrices = list(gflops)
+    width = 0.8 / (len(ALGORITHMS) + 1)
+    for a, algorithm in enumerate(ALGORITHMS.values()):
+        values = [max(gflops[m].get(algorithm, [0.0])) for m in matrices]
+        plt.bar([i + a * width for i in range(len(matrices))], values, width=width, label=algorithm)
+    plt.bar([i + len(ALGORITHMS) * width for i in range(len(matrices))], [max(cpu[m]) for m in matrices], width=width, label='CPU CSR')
+    plt.xticks([i + 0.4 for i in range(len(matrices))], matrices, rotation=30, ha='right', fontsize=7)
+    plt.ylabel('GFLOPS (2 * nnz / time)')
+    plt.title('SpMV by Kernel and Layout')
+    plt.legend(fontsize=7)
+    plt.grid(True, axis='y')
+    plt.tight_layout()
+    plt.savefig('SpMV.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test(MATRICES + sys.argv[1:])
+    plot_spmv_results("spmv_results.csv")
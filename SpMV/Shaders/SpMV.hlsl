@@ -0,0 +1,186 @@
+// Sparse matrix-vector multiply y = A x, fp32. Compiled with DXC (cs_6_0); the kernel is selected
+// by ALGORITHM:
+//   0  CsrScalar     one thread per row walks the row
+//   1  CsrVector     one wave per row, lanes stride the row and WaveActiveSum combines them
+//   2  CsrMergePath  every thread consumes ItemsPerThread items of the merged (row ends, nonzeros)
+//                    sequence, so work is even regardless of row lengths. Rows that straddle threads
+//                    leave a carry; the `fixup` entry point adds the carries after a UAV barrier
+//   3  Ell           one thread per row over the padded column-major rows
+//   4  SellCSigma    one thread per slot of a slice, writes through the row permutation
+//
+// Buffers per algorithm (unused slots are bound to something valid and never read):
+//   t0  CSR row offsets / SELL slice offsets
+//   t1  column indices    t2  values    t3  x    t4  SELL permutation
+//   u0  y                 u1  merge-path carries (row, asuint(partial sum))
+
+StructuredBuffer<uint>    Offsets     : register(t0);
+StructuredBuffer<uint>    Columns     : register(t1);
+StructuredBuffer<float>   Values      : register(t2);
+StructuredBuffer<float>   X           : register(t3);
+StructuredBuffer<uint>    Permutation : register(t4);
+RWStructuredBuffer<float> Y           : register(u0);
+RWStructuredBuffer<uint2> Carries     : register(u1);
+
+cbuffer params : register(b0)
+{
+    uint Rows;
+    uint Nnz;
+    uint Width;       // ELL row width, SELL slice size C
+    uint WorkItems;   // threads (rows, slots or merge-path threads) the dispatch has to cover
+    uint GroupsX;
+    uint Groups;      // groups in the dispatch, for the CsrVector row stride
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint NumThreads     = 256;
+static const uint ItemsPerThread = ITEMS_PER_THREAD;
+
+uint GlobalThread(uint3 threadId, uint3 groupId)
+{
+    return (groupId.y * GroupsX + groupId.x) * NumThreads + threadId.x;
+}
+
+#if ALGORITHM == 2
+
+// First row of merge-path diagonal `diagonal`: the number of row ends that precede it.
+uint MergePathSearch(uint diagonal)
+{
+    uint low  = diagonal > Nnz ? diagonal - Nnz : 0;
+    uint high = min(diagonal, Rows);
+    while (low < high)
+    {
+        uint pivot = (low + high) >> 1;
+        if (Offsets[pivot + 1] <= diagonal - pivot - 1)
+        {
+            low = pivot + 1;
+        }
+        else
+        {
+            high = pivot;
+        }
+    }
+    return low;
+}
+
+[numthreads(NumThreads, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint t = GlobalThread(threadId, groupId);
+    if (t >= WorkItems)
+    {
+        return;
+    }
+    uint begin = min(t * ItemsPerThread, Rows + Nnz);
+    uint end   = min(begin + ItemsPerThread, Rows + Nnz);
+    uint row   = MergePathSearch(begin);
+    uint nz    = begin - row;
+
+    float sum = 0.0f;
+    for (uint item = begin; item < end; ++item)
+    {
+        if (row < Rows && nz < Offsets[row + 1])
+        {
+            sum += Values[nz] * X[Columns[nz]];
+            ++nz;
+        }
+        else
+        {
+            // Row end: this thread saw the row's last nonzero (or the row is empty).
+            Y[row] = sum;
+            sum = 0.0f;
+            ++row;
+        }
+    }
+    Carries[t] = uint2(row, asuint(sum));
+}
+
+// The first thread of every run of carries with the same row adds the run into y; row == Rows is
+// the tail of the last thread and belongs to no row. Runs are as long as a row spans threads.
+[numthreads(NumThreads, 1, 1)]
+void fixup(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint t = GlobalThread(threadId, groupId);
+    if (t >= WorkItems)
+    {
+        return;
+    }
+    uint row = Carries[t].x;
+    if (row >= Rows || (t > 0 && Carries[t - 1].x == row))
+    {
+        return;
+    }
+    float sum = 0.0f;
+    for (uint u = t; u < WorkItems && Carries[u].x == row; ++u)
+    {
+        sum += asfloat(Carries[u].y);
+    }
+    Y[row] += sum;
+}
+
+#elif ALGORITHM == 1
+
+[numthreads(NumThreads, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    // The wave size is only known here; striding by the total wave count covers every row for
+    // any size the driver picks.
+    uint lanes         = WaveGetLaneCount();
+    uint wavesPerGroup = NumThreads / lanes;
+    uint lane          = WaveGetLaneIndex();
+    for (uint row = (groupId.y * GroupsX + groupId.x) * wavesPerGroup + threadId.x / lanes; row < Rows; row += Groups * wavesPerGroup)
+    {
+        float sum = 0.0f;
+        for (uint nz = Offsets[row] + lane; nz < Offsets[row + 1]; nz += lanes)
+        {
+            sum += Values[nz] * X[Columns[nz]];
+        }
+        sum = WaveActiveSum(sum);
+        if (WaveIsFirstLane())
+        {
+            Y[row] = sum;
+        }
+    }
+}
+
+#else
+
+[numthreads(NumThreads, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint i = GlobalThread(threadId, groupId);
+    if (i >= WorkItems)
+    {
+        return;
+    }
+    float sum = 0.0f;
+#if ALGORITHM == 0
+    for (uint nz = Offsets[i]; nz < Offsets[i + 1]; ++nz)
+    {
+        sum += Values[nz] * X[Columns[nz]];
+    }
+    Y[i] = sum;
+#elif ALGORITHM == 3
+    for (uint k = 0; k < Width; ++k)
+    {
+        uint entry = k * Rows + i;
+        sum += Values[entry] * X[Columns[entry]];
+    }
+    Y[i] = sum;
+#else
+    uint row = Permutation[i];
+    if (row >= Rows)
+    {
+        return;   // padding slot of the last slice
+    }
+    uint slice = i / Width;
+    uint lane  = i % Width;
+    for (uint entry = Offsets[slice] + lane; entry < Offsets[slice + 1]; entry += Width)
+    {
+        sum += Values[entry] * X[Columns[entry]];
+    }
+    Y[row] = sum;
+#endif
+}
+
+#endif
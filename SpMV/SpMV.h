@@ -0,0 +1,314 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuTimer.h"
+#include "SparseFormats.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum SpmvAlgorithm : uint32_t {
+    CsrScalar    = 0,
+    CsrVector    = 1,
+    CsrMergePath = 2,
+    Ell          = 3,
+    SellCSigma   = 4,
+    SpmvAlgorithmCount
+};
+
+inline const char* SpmvAlgorithmName(SpmvAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case SpmvAlgorithm::CsrScalar:    return "CsrScalar";
+    case SpmvAlgorithm::CsrVector:    return "CsrVector";
+    case SpmvAlgorithm::CsrMergePath: return "CsrMergePath";
+    case SpmvAlgorithm::Ell:          return "Ell";
+    case SpmvAlgorithm::SellCSigma:   return "SellCSigma";
+    default:                          return "Unknown";
+    }
+}
+
+// y = A x for one sparse matrix in the layout the algorithm reads (Shaders/SpMV.hlsl). The CSR
+// matrix is converted to ELL or SELL-C-sigma in the constructor (ConversionSeconds()); x is
+// deterministic so the host can rebuild the reference from HostX().
+class SpMV : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Rows;
+		uint32_t Nnz;
+		uint32_t Width;
+		uint32_t WorkItems;
+		uint32_t GroupsX;
+		uint32_t Groups;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t NumThreads     = 256;
+    static const uint32_t ItemsPerThread = 16;    // merge-path items (row ends + nonzeros) per thread
+
+    SpMV(HINSTANCE hInstance, SpmvAlgorithm algorithm, CsrMatrix csr, uint32_t sliceSize, uint32_t sigma) :
+		D3DAppSimplified(hInstance),
+		m_algorithm(algorithm),
+		mCsr(std::move(csr))
+	{
+		mHostX.resize(mCsr.cols);
+		for (uint32_t i = 0; i < mCsr.cols; ++i)
+		{
+			mHostX[i] = SparseFormats::RandomValue(0x5EED0000ull + i);
+		}
+
+		CpuTimer timer;
+		timer.Start();
+		if (algorithm == SpmvAlgorithm::Ell)
+		{
+			mEll = SparseFormats::ToEll(mCsr);
+		}
+		else if (algorithm == SpmvAlgorithm::SellCSigma)
+		{
+			mSell = SparseFormats::ToSell(mCsr, sliceSize, sigma);
+		}
+		m_conversionSeconds = algorithm == SpmvAlgorithm::Ell || algorithm == SpmvAlgorithm::SellCSigma ? timer.Stop() : 0.0;
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		switch (m_algorithm)
+		{
+		case SpmvAlgorithm::Ell:
+			mColumnBuffer = Upload(mEll.columns);
+			mValueBuffer  = Upload(mEll.values);
+			mOffsetBuffer = mColumnBuffer;
+			break;
+		case SpmvAlgorithm::SellCSigma:
+			mOffsetBuffer      = Upload(mSell.sliceOffsets);
+			mPermutationBuffer = Upload(mSell.permutation);
+			mColumnBuffer      = Upload(mSell.columns);
+			mValueBuffer       = Upload(mSell.values);
+			break;
+		default:
+			mOffsetBuffer = Upload(mCsr.rowOffsets);
+			mColumnBuffer = Upload(mCsr.columns);
+			mValueBuffer  = Upload(mCsr.values);
+			break;
+		}
+		if (mPermutationBuffer == nullptr)
+		{
+			mPermutationBuffer = mOffsetBuffer;
+		}
+		mXBuffer = Upload(mHostX);
+
+		mYBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, YBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mCarryBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, static_cast<UINT64>((std::max)(MergePathThreads(), 1u)) * 8,
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, YBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		std::vector<std::wstring> defines = {
+			L"ALGORITHM=" + std::to_wstring(static_cast<uint32_t>(m_algorithm)),
+			L"ITEMS_PER_THREAD=" + std::to_wstring(ItemsPerThread)
+		};
+		mShaders[0] = D3DUtil::CompileShaderDxc(L"Shaders\\SpMV.hlsl", defines, L"main", L"cs_6_0");
+		if (m_algorithm == SpmvAlgorithm::CsrMergePath)
+		{
+			mShaders[1] = D3DUtil::CompileShaderDxc(L"Shaders\\SpMV.hlsl", defines, L"fixup", L"cs_6_0");
+		}
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[8];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		for (UINT i = 0; i < 5; ++i)
+		{
+			slotRootParameter[1 + i].InitAsShaderResourceView(i);
+		}
+		slotRootParameter[6].InitAsUnorderedAccessView(0);
+		slotRootParameter[7].InitAsUnorderedAccessView(1);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(8, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		for (int i = 0; i < 2; ++i)
+		{
+			if (mShaders[i] != nullptr)
+			{
+				mPSOs[i] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[i].Get());
+			}
+		}
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetComputeRootShaderResourceView(1, mOffsetBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootShaderResourceView(2, mColumnBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootShaderResourceView(3, mValueBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootShaderResourceView(4, mXBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootShaderResourceView(5, mPermutationBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(6, mYBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(7, mCarryBuffer->GetGPUVirtualAddress());
+
+		uint32_t width     = m_algorithm == SpmvAlgorithm::Ell ? mEll.width : mSell.sliceSize;
+		uint32_t workItems = WorkItems();
+		uint32_t groups    = (std::max)(DivideRoundUp(workItems, NumThreads), 1u);
+		if (m_algorithm == SpmvAlgorithm::CsrVector)
+		{
+			// One row per wave at the narrowest wave the device reports; the kernel strides over
+			// the rows, so a wider wave just loops more.
+			groups = (std::max)(DivideRoundUp(mCsr.rows, NumThreads / m_waveLaneCountMin), 1u);
+		}
+		RootConstants constants = { mCsr.rows, mCsr.Nnz(), width, workItems, GroupsX(groups), groups, 0, 0 };
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+
+		commandList->SetPipelineState(mPSOs[0].Get());
+		DispatchGroups(groups);
+		if (m_algorithm == SpmvAlgorithm::CsrMergePath)
+		{
+			UavBarrier();
+			commandList->SetPipelineState(mPSOs[1].Get());
+			DispatchGroups(groups);
+		}
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mYBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mYBuffer.Get(), 0, YBytes());
+		}
+    }
+
+	bool   Supported()         const { return m_supported; }
+	double ConversionSeconds() const { return m_conversionSeconds; }
+	UINT64 YBytes()            const { return static_cast<UINT64>((std::max)(mCsr.rows, 1u)) * sizeof(float); }
+	double Flops()             const { return 2.0 * mCsr.Nnz(); }
+	const CsrMatrix&          Csr()   const { return mCsr; }
+	const std::vector<float>& HostX() const { return mHostX; }
+
+	// Stored entries of the layout, padding included (nnz for the CSR kernels).
+	uint64_t StoredEntries() const
+	{
+		switch (m_algorithm)
+		{
+		case SpmvAlgorithm::Ell:        return static_cast<uint64_t>(mEll.rows) * mEll.width;
+		case SpmvAlgorithm::SellCSigma: return mSell.sliceOffsets.back();
+		default:                        return mCsr.Nnz();
+		}
+	}
+
+	// Bytes the kernel has to move at minimum: every stored (column, value) pair and the layout's
+	// offsets once, x and y once each, plus the carries merge path writes and reads back.
+	double ModelBytes() const
+	{
+		double bytes = static_cast<double>(StoredEntries()) * 8.0 + (static_cast<double>(mCsr.cols) + mCsr.rows) * 4.0;
+		switch (m_algorithm)
+		{
+		case SpmvAlgorithm::Ell:
+			break;
+		case SpmvAlgorithm::SellCSigma:
+			bytes += (mSell.sliceOffsets.size() + mSell.permutation.size()) * 4.0;
+			break;
+		case SpmvAlgorithm::CsrMergePath:
+			bytes += mCsr.rowOffsets.size() * 4.0 + MergePathThreads() * 16.0;
+			break;
+		default:
+			bytes += mCsr.rowOffsets.size() * 4.0;
+			break;
+		}
+		return bytes;
+	}
+
+	// y from the last Dispatch() with SetCopyResults(true).
+	std::vector<float> ReadY()
+	{
+		std::vector<float> y(mCsr.rows);
+		float* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(YBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		std::copy(mapped, mapped + mCsr.rows, y.begin());
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return y;
+	}
+
+private:
+
+	uint32_t MergePathThreads() const
+	{
+		return static_cast<uint32_t>((static_cast<uint64_t>(mCsr.rows) + mCsr.Nnz() + ItemsPerThread - 1) / ItemsPerThread);
+	}
+
+	uint32_t WorkItems() const
+	{
+		switch (m_algorithm)
+		{
+		case SpmvAlgorithm::CsrMergePath: return MergePathThreads();
+		case SpmvAlgorithm::SellCSigma:   return static_cast<uint32_t>(mSell.permutation.size());
+		default:                          return mCsr.rows;
+		}
+	}
+
+	// Default-heap copy of a host array; empty arrays still get one element so the root
+	// descriptor points at a real allocation.
+	template <typename T>
+	ComPtr<ID3D12Resource> Upload(const std::vector<T>& data)
+	{
+		static const T zero = T();
+		return D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), data.empty() ? &zero : data.data(),
+			static_cast<UINT64>((std::max)(data.size(), static_cast<size_t>(1))) * sizeof(T));
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		D3D12_FEATURE_DATA_D3D12_OPTIONS1 options1 = {};
+		if (m_algorithm == SpmvAlgorithm::CsrVector &&
+			(FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS1, &options1, sizeof(options1))) || !options1.WaveOps ||
+			 options1.WaveLaneCountMin == 0 || options1.WaveLaneCountMin > NumThreads))
+		{
+			OutputDebugStringA("Wave operations not supported\n");
+			return false;
+		}
+		m_waveLaneCountMin = (std::max)(options1.WaveLaneCountMin, 1u);
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShaders[2];
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[2];   // [0] main kernel, [1] merge-path carry fix-up
+
+	ComPtr<ID3D12Resource> mOffsetBuffer;
+	ComPtr<ID3D12Resource> mColumnBuffer;
+	ComPtr<ID3D12Resource> mValueBuffer;
+	ComPtr<ID3D12Resource> mPermutationBuffer;
+	ComPtr<ID3D12Resource> mXBuffer;
+	ComPtr<ID3D12Resource> mYBuffer;
+	ComPtr<ID3D12Resource> mCarryBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	SpmvAlgorithm      m_algorithm;
+	CsrMatrix          mCsr;
+	EllMatrix          mEll;
+	SellMatrix         mSell;
+	std::vector<float> mHostX;
+	double             m_conversionSeconds = 0.0;
+	uint32_t           m_waveLaneCountMin  = 1;
+	bool               m_supported         = false;
+};
@@ -0,0 +1,270 @@
+#pragma once
+
+// Host-side sparse formats for the SpMV benchmark: synthetic matrices, COO -> CSR / ELL /
+// SELL-C-sigma conversion and a parallel CSR SpMV (the reference and the host baseline). All
+// layouts are what Shaders/SpMV.hlsl reads, uploaded as-is. No D3D dependency.
+
+#include "Hash.h"
+#include "MatrixMarket.h"
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+struct CsrMatrix
+{
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    std::vector<uint32_t> rowOffsets;   // rows + 1
+    std::vector<uint32_t> columns;
+    std::vector<float>    values;
+
+    uint32_t Nnz() const { return static_cast<uint32_t>(values.size()); }
+};
+
+// Column-major padded rows: entry k of row r at [k * rows + r]. Padding is column 0, value 0.
+struct EllMatrix
+{
+    uint32_t rows  = 0;
+    uint32_t width = 0;
+    std::vector<uint32_t> columns;
+    std::vector<float>    values;
+};
+
+// SELL-C-sigma: rows sorted by length inside windows of sigma rows, cut into slices of C rows,
+// each slice padded to its longest row and stored column-major. slot = slice * C + lane holds
+// original row permutation[slot] (rows or more for the padding slots of the last slice).
+struct SellMatrix
+{
+    uint32_t rows       = 0;
+    uint32_t sliceSize  = 0;   // C
+    uint32_t sigma      = 0;
+    std::vector<uint32_t> sliceOffsets;  // slices + 1, in entries
+    std::vector<uint32_t> permutation;   // slices * C
+    std::vector<uint32_t> columns;
+    std::vector<float>    values;
+
+    uint32_t Slices() const { return static_cast<uint32_t>(sliceOffsets.size() - 1); }
+};
+
+enum SyntheticMatrix : uint32_t {
+    Laplacian2D = 0,   // 5-point Laplacian on an n x n grid: regular, at most 5 entries per row
+    PowerLaw    = 1,   // n rows with Zipf-like lengths (1 .. n / 8) and random columns: very irregular
+    SyntheticMatrixCount
+};
+
+inline const char* SyntheticMatrixName(SyntheticMatrix matrix)
+{
+    switch (matrix)
+    {
+    case SyntheticMatrix::Laplacian2D: return "Laplacian2D";
+    case SyntheticMatrix::PowerLaw:    return "PowerLaw";
+    default:                           return "Unknown";
+    }
+}
+
+namespace SparseFormats
+{
+    inline float RandomValue(uint64_t seed)
+    {
+        return static_cast<float>(Hash64(seed) >> 40) / static_cast<float>(1ull << 24) * 2.0f - 1.0f;
+    }
+
+    inline CooMatrix MakeSynthetic(SyntheticMatrix kind, uint32_t n)
+    {
+        CooMatrix coo;
+        if (kind == SyntheticMatrix::Laplacian2D)
+        {
+            coo.rows = coo.cols = n * n;
+            coo.entries.reserve(static_cast<size_t>(coo.rows) * 5);
+            for (uint32_t y = 0; y < n; ++y)
+            {
+                for (uint32_t x = 0; x < n; ++x)
+                {
+                    uint32_t row = y * n + x;
+                    if (y > 0)     coo.entries.push_back(CooEntry{ row, row - n, -1.0f });
+                    if (x > 0)     coo.entries.push_back(CooEntry{ row, row - 1, -1.0f });
+                    coo.entries.push_back(CooEntry{ row, row, 4.0f });
+                    if (x + 1 < n) coo.entries.push_back(CooEntry{ row, row + 1, -1.0f });
+                    if (y + 1 < n) coo.entries.push_back(CooEntry{ row, row + n, -1.0f });
+                }
+            }
+            return coo;
+        }
+
+        coo.rows = coo.cols = n;
+        uint32_t longest = (std::max)(n / 8, 1u);
+        for (uint32_t row = 0; row < n; ++row)
+        {
+            // Length ~ longest / rank for a random rank: a few very long rows, most short.
+            uint32_t rank   = static_cast<uint32_t>(Hash64(row) % n) + 1;
+            uint32_t length = (std::max)(longest / rank, 1u);
+            for (uint32_t k = 0; k < length; ++k)
+            {
+                uint64_t seed = (static_cast<uint64_t>(row) << 32) | k;
+                coo.entries.push_back(CooEntry{ row, static_cast<uint32_t>(Hash64(seed) % n), RandomValue(seed) });
+            }
+        }
+        return coo;
+    }
+
+    // Sorts by (row, column) and sums duplicate coordinates, then builds the row offsets.
+    inline CsrMatrix ToCsr(CooMatrix& coo)
+    {
+        std::sort(coo.entries.begin(), coo.entries.end(), [](const CooEntry& a, const CooEntry& b) {
+            return a.row != b.row ? a.row < b.row : a.col < b.col;
+        });
+
+        CsrMatrix csr;
+        csr.rows = coo.rows;
+        csr.cols = coo.cols;
+        csr.rowOffsets.assign(static_cast<size_t>(coo.rows) + 1, 0);
+        csr.columns.reserve(coo.entries.size());
+        csr.values.reserve(coo.entries.size());
+        for (size_t i = 0; i < coo.entries.size(); ++i)
+        {
+            const CooEntry& entry = coo.entries[i];
+            if (i > 0 && entry.row == coo.entries[i - 1].row && entry.col == coo.entries[i - 1].col)
+            {
+                csr.values.back() += entry.value;
+                continue;
+            }
+            csr.columns.push_back(entry.col);
+            csr.values.push_back(entry.value);
+            ++csr.rowOffsets[entry.row + 1];
+        }
+        for (uint32_t row = 0; row < csr.rows; ++row)
+        {
+            csr.rowOffsets[row + 1] += csr.rowOffsets[row];
+        }
+        return csr;
+    }
+
+    inline uint32_t MaxRowLength(const CsrMatrix& csr)
+    {
+        uint32_t longest = 0;
+        for (uint32_t row = 0; row < csr.rows; ++row)
+        {
+            longest = (std::max)(longest, csr.rowOffsets[row + 1] - csr.rowOffsets[row]);
+        }
+        return longest;
+    }
+
+    // Padded entries ELL needs; callers check it against their memory budget before converting.
+    inline uint64_t EllEntries(const CsrMatrix& csr)
+    {
+        return static_cast<uint64_t>(csr.rows) * MaxRowLength(csr);
+    }
+
+    inline EllMatrix ToEll(const CsrMatrix& csr)
+    {
+        EllMatrix ell;
+        ell.rows  = csr.rows;
+        ell.width = MaxRowLength(csr);
+        ell.columns.assign(static_cast<size_t>(ell.rows) * ell.width, 0);
+        ell.values.assign(static_cast<size_t>(ell.rows) * ell.width, 0.0f);
+        for (uint32_t row = 0; row < csr.rows; ++row)
+        {
+            for (uint32_t k = 0; k < csr.rowOffsets[row + 1] - csr.rowOffsets[row]; ++k)
+            {
+                size_t slot = static_cast<size_t>(k) * ell.rows + row;
+                ell.columns[slot] = csr.columns[csr.rowOffsets[row] + k];
+                ell.values[slot]  = csr.values[csr.rowOffsets[row] + k];
+            }
+        }
+        return ell;
+    }
+
+    inline SellMatrix ToSell(const CsrMatrix& csr, uint32_t sliceSize, uint32_t sigma)
+    {
+        SellMatrix sell;
+        sell.rows      = csr.rows;
+        sell.sliceSize = sliceSize;
+        sell.sigma     = (std::max)(sigma, 1u);
+
+        auto length = [&](uint32_t row) { return csr.rowOffsets[row + 1] - csr.rowOffsets[row]; };
+
+        // Longest rows first inside every sigma window; stable so equal rows keep their order.
+        uint32_t slices = (csr.rows + sliceSize - 1) / sliceSize;
+        sell.permutation.resize(static_cast<size_t>(slices) * sliceSize);
+        std::iota(sell.permutation.begin(), sell.permutation.begin() + csr.rows, 0u);
+        for (uint32_t begin = 0; begin < csr.rows; begin += sell.sigma)
+        {
+            uint32_t end = (std::min)(begin + sell.sigma, csr.rows);
+            std::stable_sort(sell.permutation.begin() + begin, sell.permutation.begin() + end,
+                [&](uint32_t a, uint32_t b) { return length(a) > length(b); });
+        }
+        for (size_t slot = csr.rows; slot < sell.permutation.size(); ++slot)
+        {
+            sell.permutation[slot] = csr.rows;   // padding slot, no row
+        }
+
+        sell.sliceOffsets.assign(static_cast<size_t>(slices) + 1, 0);
+        for (uint32_t slice = 0; slice < slices; ++slice)
+        {
+            uint32_t width = 0;
+            for (uint32_t lane = 0; lane < sliceSize; ++lane)
+            {
+                uint32_t row = sell.permutation[static_cast<size_t>(slice) * sliceSize + lane];
+                width = row < csr.rows ? (std::max)(width, length(row)) : width;
+            }
+            sell.sliceOffsets[slice + 1] = sell.sliceOffsets[slice] + width * sliceSize;
+        }
+
+        sell.columns.assign(sell.sliceOffsets.back(), 0);
+        sell.values.assign(sell.sliceOffsets.back(), 0.0f);
+        for (uint32_t slice = 0; slice < slices; ++slice)
+        {
+            for (uint32_t lane = 0; lane < sliceSize; ++lane)
+            {
+                uint32_t row = sell.permutation[static_cast<size_t>(slice) * sliceSize + lane];
+                if (row >= csr.rows)
+                {
+                    continue;
+                }
+                for (uint32_t k = 0; k < length(row); ++k)
+                {
+                    size_t entry = sell.sliceOffsets[slice] + static_cast<size_t>(k) * sliceSize + lane;
+                    sell.columns[entry] = csr.columns[csr.rowOffsets[row] + k];
+                    sell.values[entry]  = csr.values[csr.rowOffsets[row] + k];
+                }
+            }
+        }
+        return sell;
+    }
+
+    // y = A x over rows split across threads. Accum = float for the baseline, double for the
+    // reference; `rowAbs`, if non-null, receives sum |a_ij x_j| per row for the error bound.
+    template <typename Accum>
+    void Multiply(const CsrMatrix& csr, const std::vector<float>& x, std::vector<float>& y, uint32_t threads, std::vector<float>* rowAbs = nullptr)
+    {
+        y.resize(csr.rows);
+        if (rowAbs != nullptr)
+        {
+            rowAbs->resize(csr.rows);
+        }
+        ParallelFor(csr.rows, threads, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t row = begin; row < end; ++row)
+            {
+                Accum sum = 0;
+                for (uint32_t k = csr.rowOffsets[row]; k < csr.rowOffsets[row + 1]; ++k)
+                {
+                    sum += static_cast<Accum>(csr.values[k]) * x[csr.columns[k]];
+                }
+                y[row] = static_cast<float>(sum);
+            }
+            // Kept out of the loop above so the timed baseline does not pay for it.
+            for (size_t row = begin; rowAbs != nullptr && row < end; ++row)
+            {
+                Accum abs = 0;
+                for (uint32_t k = csr.rowOffsets[row]; k < csr.rowOffsets[row + 1]; ++k)
+                {
+                    Accum product = static_cast<Accum>(csr.values[k]) * x[csr.columns[k]];
+                    abs += product < 0 ? -product : product;
+                }
+                (*rowAbs)[row] = static_cast<float>(abs);
+            }
+        });
+    }
+}
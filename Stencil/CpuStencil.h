@@ -0,0 +1,190 @@
+#pragma once
+
+// Multithreaded SIMD host stencils with clamp-to-edge addressing: the reference the GPU kernels are
+// validated against and the host baseline they are reported next to. Rows are split across threads;
+// every tap is a vectorised multiply-add of a shifted source row into the output row, with the
+// columns whose tap falls outside the image done in scalar code. Separable blurs run as a
+// horizontal then a vertical pass, like on the GPU. No D3D dependency.
+
+#include "ParallelFor.h"
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STENCIL_SIMD_X86 1
+#endif
+
+enum StencilKind : uint32_t {
+    FivePoint         = 0,  // centre 1/2, four neighbours 1/8
+    NinePoint         = 1,  // 3x3 binomial: centre 1/4, edges 1/8, corners 1/16
+    GaussianSeparable = 2,  // (2r+1) taps horizontally, then vertically
+    GaussianFull      = 3,  // the same blur as one (2r+1)^2-tap pass
+    StencilKindCount
+};
+
+inline const char* StencilKindName(StencilKind kind)
+{
+    switch (kind)
+    {
+    case StencilKind::FivePoint:         return "FivePoint";
+    case StencilKind::NinePoint:         return "NinePoint";
+    case StencilKind::GaussianSeparable: return "GaussianSeparable";
+    case StencilKind::GaussianFull:      return "GaussianFull";
+    default:                             return "Unknown";
+    }
+}
+
+inline bool StencilIsGaussian(StencilKind kind)
+{
+    return kind == StencilKind::GaussianSeparable || kind == StencilKind::GaussianFull;
+}
+
+namespace CpuStencil
+{
+    struct Tap
+    {
+        int   dx;
+        int   dy;
+        float weight;
+    };
+
+#if STENCIL_SIMD_X86
+#if defined(__AVX2__)
+    struct Lanes
+    {
+        typedef __m256 V;
+        static const int Width = 8;
+        static V    Set(float v)            { return _mm256_set1_ps(v); }
+        static V    Load(const float* p)    { return _mm256_loadu_ps(p); }
+        static void Store(float* p, V v)    { _mm256_storeu_ps(p, v); }
+        static V    Mad(V a, V b, V c)      { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+    };
+#else
+    struct Lanes
+    {
+        typedef __m128 V;
+        static const int Width = 4;
+        static V    Set(float v)            { return _mm_set1_ps(v); }
+        static V    Load(const float* p)    { return _mm_loadu_ps(p); }
+        static void Store(float* p, V v)    { _mm_storeu_ps(p, v); }
+        static V    Mad(V a, V b, V c)      { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    };
+#endif
+#else
+    struct Lanes
+    {
+        typedef float V;
+        static const int Width = 1;
+        static V    Set(float v)            { return v; }
+        static V    Load(const float* p)    { return *p; }
+        static void Store(float* p, V v)    { *p = v; }
+        static V    Mad(V a, V b, V c)      { return a * b + c; }
+    };
+#endif
+
+    // 1D weights, 2 * radius + 1 of them, as uploaded to the GPU. Unused by the five-point stencil.
+    inline std::vector<float> Weights1D(StencilKind kind, uint32_t radius)
+    {
+        if (!StencilIsGaussian(kind))
+        {
+            return { 0.25f, 0.5f, 0.25f };
+        }
+        double sigma = (std::max)(radius / 2.0, 0.5);
+        std::vector<double> weights(2 * radius + 1);
+        double total = 0.0;
+        for (int i = -static_cast<int>(radius); i <= static_cast<int>(radius); ++i)
+        {
+            weights[i + radius] = std::exp(-(i * i) / (2.0 * sigma * sigma));
+            total += weights[i + radius];
+        }
+        std::vector<float> result(weights.size());
+        for (size_t i = 0; i < weights.size(); ++i)
+        {
+            result[i] = static_cast<float>(weights[i] / total);
+        }
+        return result;
+    }
+
+    // Taps of one pass in the order the GPU kernels accumulate them (dy-major).
+    inline std::vector<Tap> Taps(StencilKind kind, uint32_t radius, const std::vector<float>& weights, int pass)
+    {
+        std::vector<Tap> taps;
+        int r = static_cast<int>(radius);
+        switch (kind)
+        {
+        case StencilKind::FivePoint:
+            taps = { { 0, -1, 0.125f }, { -1, 0, 0.125f }, { 0, 0, 0.5f }, { 1, 0, 0.125f }, { 0, 1, 0.125f } };
+            break;
+        case StencilKind::GaussianSeparable:
+            for (int d = -r; d <= r; ++d)
+            {
+                taps.push_back(pass == 0 ? Tap{ d, 0, weights[d + r] } : Tap{ 0, d, weights[d + r] });
+            }
+            break;
+        default:
+            for (int dy = -r; dy <= r; ++dy)
+            {
+                for (int dx = -r; dx <= r; ++dx)
+                {
+                    taps.push_back(Tap{ dx, dy, weights[dy + r] * weights[dx + r] });
+                }
+            }
+            break;
+        }
+        return taps;
+    }
+
+    inline void ApplyTaps(const std::vector<Tap>& taps, const float* input, float* output, int width, int height, uint32_t threads)
+    {
+        ParallelFor(static_cast<size_t>(height), threads, [&](uint32_t, size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y)
+            {
+                float* out = output + y * width;
+                std::fill(out, out + width, 0.0f);
+                for (const Tap& tap : taps)
+                {
+                    int sourceY = (std::min)((std::max)(static_cast<int>(y) + tap.dy, 0), height - 1);
+                    const float* source = input + static_cast<size_t>(sourceY) * width;
+
+                    // Columns whose tap stays inside the row: [max(0, -dx), min(width, width - dx)).
+                    int first = (std::min)((std::max)(0, -tap.dx), width);
+                    int last  = (std::max)((std::min)(width, width - tap.dx), first);
+                    for (int x = 0; x < first; ++x)
+                    {
+                        out[x] += tap.weight * source[(std::min)((std::max)(x + tap.dx, 0), width - 1)];
+                    }
+                    Lanes::V w = Lanes::Set(tap.weight);
+                    int x = first;
+                    for (; x + Lanes::Width <= last; x += Lanes::Width)
+                    {
+                        Lanes::Store(out + x, Lanes::Mad(w, Lanes::Load(source + x + tap.dx), Lanes::Load(out + x)));
+                    }
+                    for (; x < width; ++x)
+                    {
+                        out[x] += tap.weight * source[(std::min)((std::max)(x + tap.dx, 0), width - 1)];
+                    }
+                }
+            }
+        }, 1);
+    }
+
+    inline void Run(StencilKind kind, uint32_t radius, const std::vector<float>& input, std::vector<float>& output,
+        int width, int height, uint32_t threads)
+    {
+        std::vector<float> weights = Weights1D(kind, radius);
+        output.resize(input.size());
+        if (kind == StencilKind::GaussianSeparable)
+        {
+            std::vector<float> intermediate(input.size());
+            ApplyTaps(Taps(kind, radius, weights, 0), input.data(), intermediate.data(), width, height, threads);
+            ApplyTaps(Taps(kind, radius, weights, 1), intermediate.data(), output.data(), width, height, threads);
+        }
+        else
+        {
+            ApplyTaps(Taps(kind, radius, weights, 0), input.data(), output.data(), width, height, threads);
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#include "d3dAppSimplified.h"
+#include "Stencil.h"
+#include "CpuStencil.h"
+#include "CpuTimer.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+#include <cmath>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	StencilKind kind       = StencilKind::GaussianSeparable;
+	int         radius     = 4;
+	int         tiled      = 1;
+	int         texture    = 0;
+	int         width      = 4096;
+	int         height     = 4096;
+	int         validate   = 1;
+	int         cpuThreads = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <kind> <radius> <tiled> <texture> <width> <height> <validate> <cpuThreads>
+	// kind: 0=FivePoint, 1=NinePoint, 2=GaussianSeparable, 3=GaussianFull (radius only applies to the Gaussians)
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			kind = static_cast<StencilKind>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			radius = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			tiled = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			texture = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			width = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			height = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			validate = _wtoi(argv[7]);
+		}
+		if (argc >= 9)
+		{
+			cpuThreads = _wtoi(argv[8]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: kind=%d, radius=%d, tiled=%d, texture=%d, width=%d, height=%d, validate=%d, cpuThreads=%d\n",
+			static_cast<int>(kind), radius, tiled, texture, width, height, validate, cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (kind >= StencilKind::StencilKindCount)
+	{
+		OutputDebugStringA("ERROR: Unknown stencil!\n");
+		return 1;
+	}
+	// Buffers are limited to 2 GB, textures to 16384 texels per side.
+	const int maxSide = texture != 0 ? static_cast<int>(Stencil::MaxTextureSize) : 65536;
+	if (radius < 1 || radius > static_cast<int>(Stencil::MaxRadius) || width <= 0 || height <= 0 || width > maxSide || height > maxSide ||
+		static_cast<uint64_t>(width) * height > (1ull << 29) || cpuThreads <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	Stencil test(hInstance, kind, static_cast<uint32_t>(radius), tiled != 0, texture != 0, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Stencil needs shader model 6.0!\n");
+		return 1;
+	}
+
+	double cpuSeconds = 0.0;
+	double maxError   = 0.0;
+	int    mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		if (validate == 0)
+		{
+			return;
+		}
+		std::vector<float> gpu;
+		test.ReadResults(gpu);
+
+		std::vector<float> host;
+		CpuTimer timer;
+		timer.Start();
+		CpuStencil::Run(kind, test.Radius(), test.HostInput(), host, width, height, static_cast<uint32_t>(cpuThreads));
+		cpuSeconds = timer.Stop();
+
+		// Inputs are in [0, 1) and the weights sum to one, so an absolute tolerance works.
+		for (size_t i = 0; i < host.size(); ++i)
+		{
+			double error = std::fabs(static_cast<double>(gpu[i]) - host[i]);
+			maxError = (std::max)(maxError, error);
+			mismatches += error > 1e-4 || error != error ? 1 : 0;
+		}
+	});
+	double pixels      = static_cast<double>(width) * height;
+	double gpuMpixels  = pixels / gpuSeconds / 1e6;
+	// Effective bandwidth counts each pass reading and writing the image once (perfect tap reuse).
+	double gpuGBs      = 2.0 * test.Passes() * test.ImageBytes() / gpuSeconds / 1e9;
+	double cpuMpixels  = cpuSeconds > 0.0 ? pixels / cpuSeconds / 1e6 : 0.0;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Stencil: " << StencilKindName(kind) << " Radius: " << test.Radius() << " Passes: " << test.Passes()
+		<< (tiled ? " Tiled" : " Naive") << (texture ? " Texture2D" : " Buffer") << " Image: " << width << "x" << height << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuMpixels << " Mpixels/s, " << gpuGBs << " GB/s effective)\n";
+	if (validate != 0)
+	{
+		debugOutput << "CPU (" << cpuThreads << " threads): " << cpuSeconds << " seconds (" << cpuMpixels << " Mpixels/s)\n";
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (max error " << maxError << ", " << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("stencil_results.csv", "Kind,KindName,Radius,Tiled,Texture,Width,Height,Passes,Gpu_s,GpuMpixelsPerSecond,Gpu_GBs,CpuThreads,Cpu_s,CpuMpixelsPerSecond,Validated,MaxError,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(static_cast<int>(kind), StencilKindName(kind), test.Radius(), tiled, texture, width, height, test.Passes(),
+		gpuSeconds, gpuMpixels, gpuGBs, cpuThreads, cpuSeconds, cpuMpixels, validate, maxError, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+KINDS = {
+    0: "FivePoint",
+    1: "NinePoint",
+    2: "GaussianSeparable",
+    3: "GaussianFull",
+}
+
+RADII = [1, 2, 4, 8, 12, 16]
+
+def run_simple_test(width = 4096, height = 4096, tryCount = 3):
+    """Runs every stencil in naive and tiled form over buffers and textures, Gaussians over all radii"""
+
+    program = "..\\x64\\Release\\Stencil.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "stencil_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for kind in KINDS:
+        radii = RADII if kind >= 2 else [1]
+        for radius in radii:
+            for texture in [0, 1]:
+                for tiled in [0, 1]:
+                    print(f"\nRunning {KINDS[kind]} r={radius} texture={texture} tiled={tiled}...")
+                    for i in range(tryCount):
+                        time.sleep(0.01)
+                        try:
+                            result = subprocess.run([
+                                program,
+                                str(kind),
+                                str(radius),
+                                str(tiled),
+                                str(texture),
+                                str(width),
+                                str(height),
+                                # Validate the first run of each configuration only.
+                                "1" if i == 0 else "0"
+                            ], capture_output=True, text=True)
+                            if result.returncode != 0:
+                                print(f"  Run {i+1}: failed or mismatched (exit {result.returncode})")
+                            else:
+                                print(f"  Run {i+1}: {result.stdout.strip()}")
+                        except Exception as e:
+                            print(f"  Run {i+1}: Error - {e}")
+
+def plot_stencil_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            kind = parts[1]
+            if kind not in ("GaussianSeparable", "GaussianFull"):
+                continue
+            key = f"{kind} {'tiled' if parts[3] == '1' else 'naive'} {'tex' if parts[4] == '1' else 'buf'}"
+            series.setdefault(key, {}).setdefault(int(parts[2]), []).append(float(parts[9]))
+
+    for key, runs in sorted(series.items()):
+        radii = sorted(runs)
+        style = '--' if "Full" in key else '-'
+        plt.plot(radii, [max(runs[r]) for r in radii], marker='o', linestyle=style, label=key)
+    plt.yscale('log')
+    plt.xlabel('Blur radius')
+    plt.ylabel('Mpixels/s (best run)')
+    plt.title('Gaussian Blur Throughput by Radius')
+    plt.legend(fontsize=7)
+    plt.grid(True)
+    plt.savefig('Stencil.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_stencil_results("stencil_results.csv")
@@ -0,0 +1,137 @@
+// 2D stencils over a Width x Height fp32 image with clamp-to-edge addressing. Compiled with DXC
+// (cs_6_0); variants are selected by defines:
+//   STENCIL  0=5-point, 1=9-point (3x3 binomial), 2=separable Gaussian, 3=non-separable Gaussian
+//   RADIUS   stencil radius (1 for the 5- and 9-point stencils)
+//   PASS     separable Gaussian only: 0=horizontal, 1=vertical
+//   TILED    0=every tap loads from memory, 1=the group stages its 16x16 tile plus halo in groupshared
+//            memory first and the taps read that
+//   TEXTURE  0=input in a StructuredBuffer, 1=input in a Texture2D (read with Load, same addressing);
+//            the intermediate image of the separable blur follows the input
+//
+// Weights holds 2 * RADIUS + 1 1D weights; 2D weights are products of two of them, exactly as on
+// the host, so both sides sum the same taps in the same (dy-major) order.
+
+StructuredBuffer<float>   InputBuffer   : register(t0);
+StructuredBuffer<float>   Weights       : register(t1);
+Texture2D<float>          InputTexture  : register(t2);
+RWStructuredBuffer<float> Output        : register(u0);
+RWTexture2D<float>        OutputTexture : register(u1);
+
+cbuffer params : register(b0)
+{
+    uint Width;
+    uint Height;
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint TileSize = 16;
+static const int  Radius   = RADIUS;
+
+#if STENCIL == 2
+static const int HaloX = PASS == 0 ? Radius : 0;
+static const int HaloY = PASS == 0 ? 0 : Radius;
+#else
+static const int HaloX = Radius;
+static const int HaloY = Radius;
+#endif
+
+// The horizontal pass of a texture-based separable blur writes the intermediate texture.
+#define WRITE_TEXTURE (TEXTURE && STENCIL == 2 && PASS == 0)
+
+float TapWeight(int dx, int dy)
+{
+#if STENCIL == 0
+    return dx == 0 && dy == 0 ? 0.5f : (dx == 0 || dy == 0 ? 0.125f : 0.0f);
+#elif STENCIL == 2
+    return Weights[dx + dy + Radius];
+#else
+    return Weights[dy + Radius] * Weights[dx + Radius];
+#endif
+}
+
+float LoadClamped(int x, int y)
+{
+    uint cx = (uint)clamp(x, 0, (int)Width - 1);
+    uint cy = (uint)clamp(y, 0, (int)Height - 1);
+#if TEXTURE
+    return InputTexture.Load(int3(cx, cy, 0));
+#else
+    return InputBuffer[cy * Width + cx];
+#endif
+}
+
+void Store(uint x, uint y, float value)
+{
+#if WRITE_TEXTURE
+    OutputTexture[uint2(x, y)] = value;
+#else
+    Output[y * Width + x] = value;
+#endif
+}
+
+#if TILED
+
+static const int TileW = TileSize + 2 * HaloX;
+static const int TileH = TileSize + 2 * HaloY;
+
+groupshared float sTile[TileW * TileH];
+
+[numthreads(TileSize, TileSize, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID, uint3 dispatchId : SV_DispatchThreadID)
+{
+    // Every thread helps load the tile, including those outside the image.
+    const int originX = (int)(groupId.x * TileSize) - HaloX;
+    const int originY = (int)(groupId.y * TileSize) - HaloY;
+    for (int i = threadId.y * TileSize + threadId.x; i < TileW * TileH; i += TileSize * TileSize)
+    {
+        sTile[i] = LoadClamped(originX + i % TileW, originY + i / TileW);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (dispatchId.x >= Width || dispatchId.y >= Height)
+    {
+        return;
+    }
+    float sum = 0.0f;
+    for (int dy = -HaloY; dy <= HaloY; ++dy)
+    {
+        for (int dx = -HaloX; dx <= HaloX; ++dx)
+        {
+            float w = TapWeight(dx, dy);
+            if (w != 0.0f)
+            {
+                sum += w * sTile[(threadId.y + HaloY + dy) * TileW + threadId.x + HaloX + dx];
+            }
+        }
+    }
+    Store(dispatchId.x, dispatchId.y, sum);
+}
+
+#else
+
+[numthreads(TileSize, TileSize, 1)]
+void main(uint3 dispatchId : SV_DispatchThreadID)
+{
+    if (dispatchId.x >= Width || dispatchId.y >= Height)
+    {
+        return;
+    }
+    const int x = (int)dispatchId.x;
+    const int y = (int)dispatchId.y;
+    float sum = 0.0f;
+    for (int dy = -HaloY; dy <= HaloY; ++dy)
+    {
+        for (int dx = -HaloX; dx <= HaloX; ++dx)
+        {
+            float w = TapWeight(dx, dy);
+            if (w != 0.0f)
+            {
+                sum += w * LoadClamped(x + dx, y + dy);
+            }
+        }
+    }
+    Store(dispatchId.x, dispatchId.y, sum);
+}
+
+#endif
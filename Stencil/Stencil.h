@@ -0,0 +1,282 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuStencil.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// 2D stencils from Shaders/Stencil.hlsl over a width x height fp32 image held in a buffer or a
+// Texture2D. The separable blur is two dispatches through an intermediate image of the same kind
+// as the input; the result always lands in a buffer so every variant is read back the same way.
+// Texture SRVs/UAVs need a descriptor table, so the root signature has both root descriptors
+// (buffers) and two one-entry tables (textures); the side a variant does not use points at the
+// weights buffer or at null descriptors.
+class Stencil : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t TileSize       = 16;
+    static const uint32_t MaxRadius      = 16;
+    static const uint32_t MaxTextureSize = D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION;
+
+    Stencil(HINSTANCE hInstance, StencilKind kind, uint32_t radius, bool tiled, bool texture, uint32_t width, uint32_t height) :
+		D3DAppSimplified(hInstance),
+		m_kind(kind),
+		m_radius(StencilIsGaussian(kind) ? radius : 1),
+		m_tiled(tiled),
+		m_texture(texture),
+		m_width(width),
+		m_height(height)
+	{
+		mHostInput.resize(static_cast<size_t>(m_width) * m_height);
+		for (size_t i = 0; i < mHostInput.size(); ++i)
+		{
+			mHostInput[i] = static_cast<float>((static_cast<uint32_t>(i) * 2654435761u) >> 16) / 65536.0f;
+		}
+		mHostWeights = CpuStencil::Weights1D(m_kind, m_radius);
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		UINT64 imageBytes = static_cast<UINT64>(m_width) * m_height * sizeof(float);
+		mWeights = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostWeights.data(), mHostWeights.size() * sizeof(float));
+		mOutputBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, imageBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, imageBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+
+		if (m_texture)
+		{
+			mInputTexture = D3DUtil::CreateDefaultTexture2D(Device(), GraphicsCommandList(), mHostInput.data(), m_width, m_height,
+				DXGI_FORMAT_R32_FLOAT, sizeof(float));
+			if (Passes() == 2)
+			{
+				D3D12_HEAP_PROPERTIES heapProps   = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+				D3D12_RESOURCE_DESC   textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R32_FLOAT, m_width, m_height, 1, 1, 1, 0,
+					D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+				AssertIfFailed(Device()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &textureDesc,
+					D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&mIntermediateTexture)));
+			}
+		}
+		else
+		{
+			mInputBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostInput.data(), imageBytes);
+			if (Passes() == 2)
+			{
+				mIntermediateBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, imageBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+			}
+		}
+		BuildDescriptors();
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		for (uint32_t pass = 0; pass < Passes(); ++pass)
+		{
+			std::vector<std::wstring> defines = {
+				L"STENCIL=" + std::to_wstring(static_cast<uint32_t>(m_kind)),
+				L"RADIUS=" + std::to_wstring(m_radius),
+				L"PASS=" + std::to_wstring(pass),
+				L"TILED=" + std::to_wstring(m_tiled ? 1 : 0),
+				L"TEXTURE=" + std::to_wstring(m_texture ? 1 : 0)
+			};
+			mShaders[pass] = D3DUtil::CompileShaderDxc(L"Shaders\\Stencil.hlsl", defines, L"main", L"cs_6_0");
+		}
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_DESCRIPTOR_RANGE srvRange;
+		srvRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 2);
+		CD3DX12_DESCRIPTOR_RANGE uavRange;
+		uavRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 1);
+
+		CD3DX12_ROOT_PARAMETER slotRootParameter[6];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsShaderResourceView(1);
+		slotRootParameter[3].InitAsUnorderedAccessView(0);
+		slotRootParameter[4].InitAsDescriptorTable(1, &srvRange);
+		slotRootParameter[5].InitAsDescriptorTable(1, &uavRange);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(6, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		for (uint32_t pass = 0; pass < Passes(); ++pass)
+		{
+			mPSOs[pass] = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders[pass].Get());
+		}
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		ID3D12DescriptorHeap* heaps[] = { mDescriptorHeap.Get() };
+		commandList->SetDescriptorHeaps(_countof(heaps), heaps);
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+
+		RootConstants constants = { m_width, m_height, 0, 0 };
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(2, mWeights->GetGPUVirtualAddress());
+		commandList->SetComputeRootDescriptorTable(5, GpuHandle(IntermediateUav));
+
+		for (uint32_t pass = 0; pass < Passes(); ++pass)
+		{
+			bool last = pass + 1 == Passes();
+			if (m_texture)
+			{
+				commandList->SetComputeRootShaderResourceView(1, mWeights->GetGPUVirtualAddress());
+				commandList->SetComputeRootDescriptorTable(4, GpuHandle(pass == 0 ? InputSrv : IntermediateSrv));
+			}
+			else
+			{
+				ID3D12Resource* input = pass == 0 ? mInputBuffer.Get() : mIntermediateBuffer.Get();
+				commandList->SetComputeRootShaderResourceView(1, input->GetGPUVirtualAddress());
+				commandList->SetComputeRootDescriptorTable(4, GpuHandle(InputSrv));
+			}
+			ID3D12Resource* output = last || m_texture ? mOutputBuffer.Get() : mIntermediateBuffer.Get();
+			commandList->SetComputeRootUnorderedAccessView(3, output->GetGPUVirtualAddress());
+
+			commandList->SetPipelineState(mPSOs[pass].Get());
+			commandList->Dispatch(DivideRoundUp(m_width, TileSize), DivideRoundUp(m_height, TileSize), 1);
+
+			if (!last)
+			{
+				D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(Intermediate(),
+					D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+				commandList->ResourceBarrier(1, &barrier);
+			}
+		}
+
+		std::vector<D3D12_RESOURCE_BARRIER> barriers;
+		if (Passes() == 2)
+		{
+			// Back to UAV for the next run (the texture keeps its state across command lists).
+			barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(Intermediate(),
+				D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+		}
+		if (CopyResults())
+		{
+			barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE));
+		}
+		if (!barriers.empty())
+		{
+			commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+		}
+		if (CopyResults())
+		{
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, ImageBytes());
+		}
+    }
+
+	bool     Supported() const { return m_supported; }
+	uint32_t Radius()    const { return m_radius; }
+	uint32_t Passes()    const { return m_kind == StencilKind::GaussianSeparable ? 2 : 1; }
+	UINT64   ImageBytes() const { return static_cast<UINT64>(m_width) * m_height * sizeof(float); }
+	const std::vector<float>& HostInput() const { return mHostInput; }
+
+	// Output of the last Dispatch() with SetCopyResults(true).
+	void ReadResults(std::vector<float>& output)
+	{
+		float* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(ImageBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		output.assign(mapped, mapped + static_cast<size_t>(m_width) * m_height);
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+	}
+
+private:
+
+	enum Descriptor { InputSrv = 0, IntermediateSrv, IntermediateUav, DescriptorCount };
+
+	ID3D12Resource* Intermediate() const
+	{
+		return m_texture ? mIntermediateTexture.Get() : mIntermediateBuffer.Get();
+	}
+
+	// Null descriptors wherever this variant has no texture; tables must still point at valid entries.
+	void BuildDescriptors()
+	{
+		D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+		heapDesc.NumDescriptors = DescriptorCount;
+		heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		AssertIfFailed(Device()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mDescriptorHeap)));
+
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.Format                  = DXGI_FORMAT_R32_FLOAT;
+		srvDesc.ViewDimension           = D3D12_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.Texture2D.MipLevels     = 1;
+		Device()->CreateShaderResourceView(mInputTexture.Get(), &srvDesc, CpuHandle(InputSrv));
+		Device()->CreateShaderResourceView(mIntermediateTexture.Get(), &srvDesc, CpuHandle(IntermediateSrv));
+
+		D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format        = DXGI_FORMAT_R32_FLOAT;
+		uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+		Device()->CreateUnorderedAccessView(mIntermediateTexture.Get(), nullptr, &uavDesc, CpuHandle(IntermediateUav));
+	}
+
+	CD3DX12_CPU_DESCRIPTOR_HANDLE CpuHandle(Descriptor descriptor) const
+	{
+		return CD3DX12_CPU_DESCRIPTOR_HANDLE(mDescriptorHeap->GetCPUDescriptorHandleForHeapStart(), descriptor, DescriptorSize());
+	}
+
+	CD3DX12_GPU_DESCRIPTOR_HANDLE GpuHandle(Descriptor descriptor) const
+	{
+		return CD3DX12_GPU_DESCRIPTOR_HANDLE(mDescriptorHeap->GetGPUDescriptorHandleForHeapStart(), descriptor, DescriptorSize());
+	}
+
+	UINT DescriptorSize() const
+	{
+		return Device()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShaders[2];
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSOs[2];   // [1] is the vertical pass of the separable blur
+	ComPtr<ID3D12DescriptorHeap> mDescriptorHeap;
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mInputTexture;
+	ComPtr<ID3D12Resource> mIntermediateBuffer;
+	ComPtr<ID3D12Resource> mIntermediateTexture;
+	ComPtr<ID3D12Resource> mWeights;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<float> mHostInput;
+	std::vector<float> mHostWeights;
+
+	StencilKind m_kind;
+	uint32_t    m_radius;
+	bool        m_tiled;
+	bool        m_texture;
+	uint32_t    m_width;
+	uint32_t    m_height;
+	bool        m_supported = false;
+};
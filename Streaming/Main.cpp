@@ -0,0 +1,152 @@
+#include "d3dAppSimplified.h"
+#include "StreamingPipeline.h"
+#include "CpuStreamBackend.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+#include <string>
+
+enum StreamingBackend : int {
+    D3D12Queues = 0,  // COPY -> COMPUTE -> COPY queues with ID3D12Fence waits
+    CpuThreads  = 1,  // CpuStreamBackend: one worker thread per queue
+};
+
+// 'value' as the summary/CSV prints it, or 'unknown' when the backend could not measure it.
+static std::string FormatIfKnown(bool known, double value, const char* unknown)
+{
+	if (!known)
+	{
+		return unknown;
+	}
+	std::ostringstream text;
+	text << value;
+	return text.str();
+}
+
+// Runs the serialized baseline and the pipelined schedule on the same backend, prints the summary
+// and appends one row to streaming_results.csv.
+template <typename Backend>
+static void RunAndReport(Backend& backend, const char* backendName, const std::string& deviceCaps, int totalMB, int chunkMB, int slots, int iterations)
+{
+	// Warm-up: first submission on each queue pays for residency and shader/driver setup.
+	StreamScheduler::Run(backend, false);
+
+	StreamRunResult serialized = StreamScheduler::Run(backend, true);
+	StreamRunResult pipelined  = StreamScheduler::Run(backend, false);
+	uint64_t mismatches = backend.Verify();
+
+	uint64_t bytes      = backend.TotalBytes();
+	double serialGBs    = serialized.ThroughputGBs(bytes);
+	double pipelinedGBs = pipelined.ThroughputGBs(bytes);
+	double speedup      = pipelined.seconds > 0.0 ? serialized.seconds / pipelined.seconds : 0.0;
+	double efficiency   = 0.0;
+	bool   overlapKnown = StreamOverlapEfficiency(serialized, pipelined, efficiency);
+	std::string busy[3];
+	std::string busyCsv[3];
+	for (uint32_t q = 0; q < 3; ++q)
+	{
+		busy[q]    = FormatIfKnown(pipelined.busySeconds[q] >= 0.0, pipelined.busySeconds[q], "N/A");
+		busyCsv[q] = FormatIfKnown(pipelined.busySeconds[q] >= 0.0, pipelined.busySeconds[q], "");
+	}
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Backend: " << backendName << " Total: " << totalMB << " MB Chunk: " << chunkMB << " MB Slots: " << slots << " Iterations: " << iterations << "\n";
+	debugOutput << "Chunks: " << backend.ChunkCount() << "\n";
+	debugOutput << "Serialized: " << serialized.seconds << " seconds, " << serialGBs << " GB/s\n";
+	debugOutput << "Pipelined:  " << pipelined.seconds << " seconds, " << pipelinedGBs << " GB/s\n";
+	debugOutput << "Queue busy (upload/compute/readback): " << busy[0] << " / " << busy[1] << " / " << busy[2] << " seconds\n";
+	debugOutput << "Speedup: " << speedup << "x Overlap Efficiency: " << FormatIfKnown(overlapKnown, efficiency, "N/A") << "\n";
+	debugOutput << "Mismatches: " << mismatches << "\n";
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("streaming_results.csv",
+		"Backend,TotalMB,ChunkMB,Slots,Iterations,Chunks,Serialized_s,Pipelined_s,Serialized_GBs,Pipelined_GBs,Speedup,OverlapEfficiency,UploadBusy_s,ComputeBusy_s,ReadbackBusy_s,Mismatches", deviceCaps);
+	csv.Row(backendName, totalMB, chunkMB, slots, iterations, backend.ChunkCount(),
+		serialized.seconds, pipelined.seconds, serialGBs, pipelinedGBs, speedup, FormatIfKnown(overlapKnown, efficiency, ""),
+		busyCsv[0], busyCsv[1], busyCsv[2], mismatches);
+}
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	int totalMB    = 256;
+	int chunkMB    = 16;
+	int slots      = 3;
+	int backend    = StreamingBackend::D3D12Queues;
+	int iterations = 16;
+
+	// Usage: program.exe <totalMB> <chunkMB> <slots> <backend> <iterations>
+	// backend: 0=D3D12 queues, 1=CPU threads
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			totalMB = _wtoi(argv[1]);
+		}
+		if (argc >= 3)
+		{
+			chunkMB = _wtoi(argv[2]);
+		}
+		if (argc >= 4)
+		{
+			slots = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			backend = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			iterations = _wtoi(argv[5]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: totalMB=%d, chunkMB=%d, slots=%d, backend=%d, iterations=%d\n", totalMB, chunkMB, slots, backend, iterations);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (totalMB <= 0 || chunkMB <= 0 || slots <= 0 || iterations < 0)
+	{
+		OutputDebugStringA("ERROR: Invalid streaming parameters!\n");
+		return 1;
+	}
+
+	uint64_t totalElements = static_cast<uint64_t>(totalMB) * 1024 * 1024 / sizeof(float);
+	uint64_t chunkElements = static_cast<uint64_t>(chunkMB) * 1024 * 1024 / sizeof(float);
+
+	if (backend == StreamingBackend::D3D12Queues)
+	{
+		StreamingPipeline test(hInstance, totalElements, chunkElements, static_cast<uint32_t>(slots), static_cast<uint32_t>(iterations));
+		test.Initialize();
+		RunAndReport(test, "D3D12", QueryDeviceCaps(test.Device()).Describe(), totalMB, chunkMB, slots, iterations);
+	}
+	else if (backend == StreamingBackend::CpuThreads)
+	{
+		CpuStreamBackend test(totalElements, chunkElements, static_cast<uint32_t>(slots), static_cast<uint32_t>(iterations));
+		RunAndReport(test, "CPU", "None", totalMB, chunkMB, slots, iterations);
+	}
+	else
+	{
+		OutputDebugStringA("ERROR: Unknown streaming backend!\n");
+		return 1;
+	}
+    return 0;
+}
@@ -0,0 +1,70 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+BACKENDS = {
+    0: "D3D12",
+    1: "CPU",
+}
+
+def run_simple_test(tryCount = 3):
+    """Sweeps chunk size and slot count for a fixed streamed dataset on both backends"""
+
+    program = "..\\x64\\Release\\Streaming.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "streaming_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    total_mb = 256
+    iterations = 16
+    for backend in BACKENDS:
+        for chunk_mb in [1, 4, 16, 64]:
+            for slots in [1, 2, 3, 4]:
+                print(f"\nRunning {BACKENDS[backend]} chunk {chunk_mb} MB slots {slots}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(total_mb),
+                            str(chunk_mb),
+                            str(slots),
+                            str(backend),
+                            str(iterations)
+                        ], capture_output=True, text=True)
+                        print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_streaming_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = (parts[0], int(parts[3]))
+            series.setdefault(key, ([], []))
+            series[key][0].append(int(parts[2]))
+            series[key][1].append(float(parts[9]))
+
+    for (backend, slots), (chunk, throughput) in sorted(series.items()):
+        plt.plot(chunk, throughput, marker='o', linestyle='', label=f"{backend} {slots} slots")
+    plt.xscale('log', base=2)
+    plt.xlabel('Chunk Size (MB)')
+    plt.ylabel('Pipelined Throughput (GB/s)')
+    plt.title('Streaming Upload-Compute-Readback Throughput')
+    plt.legend()
+    plt.grid(True)
+    plt.savefig('StreamingThroughput.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_streaming_results("streaming_results.csv")
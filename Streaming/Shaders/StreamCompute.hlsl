@@ -0,0 +1,28 @@
+
+StructuredBuffer<float>   Input  : register(t0);
+RWStructuredBuffer<float> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint ElementCount;
+    uint DispatchThreads;   // grid stride
+    uint Iterations;        // dependent FMAs per element, scales the compute stage
+    uint Pad0;
+}
+
+static const uint NumThreads = 64;
+
+// Must match CpuStreamBackend::Kernel.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    for (uint id = groupId.x * NumThreads + threadId.x; id < ElementCount; id += DispatchThreads)
+    {
+        float value = Input[id];
+        for (uint i = 0; i < Iterations; ++i)
+        {
+            value = value * 0.999f + 0.5f;
+        }
+        Output[id] = value;
+    }
+}
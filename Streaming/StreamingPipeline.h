@@ -0,0 +1,236 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "CommandContext.h"
+#include "StreamScheduler.h"
+#include "CpuStreamBackend.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+// D3D12 implementation of StreamBackend: uploads on a COPY queue, computes on a COMPUTE queue and
+// reads back on a second COPY queue, with ID3D12Fence waits between them. Every slot has its own
+// staging and device buffers so no buffer is ever in two states on two queues at once; all device
+// buffers stay in COMMON and rely on implicit promotion/decay at ExecuteCommandLists boundaries.
+class StreamingPipeline : public D3DAppSimplified, public StreamBackend
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t ElementCount;
+		uint32_t DispatchThreads;
+		uint32_t Iterations;
+		uint32_t Pad0;
+	};
+
+    static const uint32_t NumThreads = 64;
+
+    StreamingPipeline(HINSTANCE hInstance, uint64_t totalElements, uint64_t chunkElements, uint32_t slotCount, uint32_t iterations) :
+		D3DAppSimplified(hInstance),
+		m_slotCount(slotCount),
+		m_iterations(iterations)
+	{
+		m_chunking.totalElements = totalElements;
+		m_chunking.chunkElements = chunkElements;
+    }
+
+	~StreamingPipeline()
+	{
+		for (uint32_t s = 0; s < m_slotCount && s < mUploadStaging.size(); ++s)
+		{
+			mUploadStaging[s]->Unmap(0, nullptr);
+			mReadbackStaging[s]->Unmap(0, nullptr);
+		}
+	}
+
+    void BuildResourcesAndHeaps() override {
+		mHostInput.resize(static_cast<size_t>(m_chunking.totalElements));
+		mHostOutput.resize(static_cast<size_t>(m_chunking.totalElements));
+		for (size_t i = 0; i < mHostInput.size(); ++i)
+		{
+			mHostInput[i] = static_cast<float>(i % 1024) * 0.25f;
+		}
+
+		UINT64 chunkBytes = m_chunking.chunkElements * sizeof(float);
+		mUploadStaging.resize(m_slotCount);
+		mDeviceInput.resize(m_slotCount);
+		mDeviceOutput.resize(m_slotCount);
+		mReadbackStaging.resize(m_slotCount);
+		mUploadMapped.resize(m_slotCount);
+		mReadbackMapped.resize(m_slotCount);
+
+		for (uint32_t s = 0; s < m_slotCount; ++s)
+		{
+			mUploadStaging[s]   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_UPLOAD, chunkBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_GENERIC_READ);
+			mDeviceInput[s]     = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, chunkBytes);
+			mDeviceOutput[s]    = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, chunkBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+			mReadbackStaging[s] = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, chunkBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+
+			D3D12_RANGE noRead = { 0, 0 };
+			AssertIfFailed(mUploadStaging[s]->Map(0, &noRead, reinterpret_cast<void**>(&mUploadMapped[s])));
+			AssertIfFailed(mReadbackStaging[s]->Map(0, nullptr, reinterpret_cast<void**>(&mReadbackMapped[s])));
+		}
+
+		// Two timestamps per chunk per queue, one allocator per slot.
+		UINT timestampCount = 2 * m_chunking.Count();
+		mContexts[0].Initialize(Device(), D3D12_COMMAND_LIST_TYPE_COPY,    timestampCount, m_slotCount);
+		mContexts[1].Initialize(Device(), D3D12_COMMAND_LIST_TYPE_COMPUTE, timestampCount, m_slotCount);
+		mContexts[2].Initialize(Device(), D3D12_COMMAND_LIST_TYPE_COPY,    timestampCount, m_slotCount);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		mShaders = D3DUtil::CompileShader(L"Shaders\\StreamCompute.hlsl", nullptr, "main", "cs_5_0");
+	}
+
+    void BuildPSOs() override {
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO           = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders.Get());
+    }
+
+	// All work goes through StreamScheduler::Run on the three queues below.
+    void DoAction() override { }
+
+	// StreamBackend ---------------------------------------------------------------------------
+
+	uint32_t ChunkCount() const override { return m_chunking.Count(); }
+	uint32_t SlotCount()  const override { return m_slotCount; }
+	uint64_t TotalBytes() const override { return m_chunking.totalElements * sizeof(float); }
+
+	void Upload(uint32_t slot, uint32_t chunk) override
+	{
+		UINT64 bytes = m_chunking.Elements(chunk) * sizeof(float);
+		memcpy(mUploadMapped[slot], mHostInput.data() + m_chunking.Offset(chunk), static_cast<size_t>(bytes));
+
+		CommandContext& context = Context(StreamQueue::Upload);
+		context.Reset(slot);
+		context.Timestamp(2 * chunk);
+		context.CommandList()->CopyBufferRegion(mDeviceInput[slot].Get(), 0, mUploadStaging[slot].Get(), 0, bytes);
+		context.Timestamp(2 * chunk + 1);
+		context.ResolveTimestamps(2, 2 * chunk);
+		context.Submit();
+	}
+
+	void Compute(uint32_t slot, uint32_t chunk) override
+	{
+		uint32_t elements = static_cast<uint32_t>(m_chunking.Elements(chunk));
+		uint32_t groups   = (elements + NumThreads - 1) / NumThreads;
+		groups = groups < MaxGroupsX ? groups : MaxGroupsX;
+		RootConstants constants = { elements, groups * NumThreads, m_iterations, 0 };
+
+		CommandContext& context = Context(StreamQueue::Compute);
+		auto commandList = context.CommandList();
+		context.Reset(slot, mPSO.Get());
+		context.Timestamp(2 * chunk);
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(1, mDeviceInput[slot]->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mDeviceOutput[slot]->GetGPUVirtualAddress());
+		commandList->Dispatch(groups, 1, 1);
+		context.Timestamp(2 * chunk + 1);
+		context.ResolveTimestamps(2, 2 * chunk);
+		context.Submit();
+	}
+
+	void Readback(uint32_t slot, uint32_t chunk) override
+	{
+		UINT64 bytes = m_chunking.Elements(chunk) * sizeof(float);
+
+		CommandContext& context = Context(StreamQueue::Readback);
+		context.Reset(slot);
+		context.Timestamp(2 * chunk);
+		context.CommandList()->CopyBufferRegion(mReadbackStaging[slot].Get(), 0, mDeviceOutput[slot].Get(), 0, bytes);
+		context.Timestamp(2 * chunk + 1);
+		context.ResolveTimestamps(2, 2 * chunk);
+		context.Submit();
+	}
+
+	void Retire(uint32_t slot, uint32_t chunk) override
+	{
+		UINT64 bytes = m_chunking.Elements(chunk) * sizeof(float);
+		memcpy(mHostOutput.data() + m_chunking.Offset(chunk), mReadbackMapped[slot], static_cast<size_t>(bytes));
+	}
+
+	uint64_t Signal(StreamQueue queue) override
+	{
+		return Context(queue).Signal();
+	}
+
+	void QueueWait(StreamQueue waiter, StreamQueue signaller, uint64_t value) override
+	{
+		Context(waiter).GpuWait(Context(signaller).Fence(), value);
+	}
+
+	void HostWait(StreamQueue queue, uint64_t value) override
+	{
+		Context(queue).CpuWait(value);
+	}
+
+	void EndRun() override
+	{
+		for (uint32_t q = 0; q < static_cast<uint32_t>(StreamQueue::Count); ++q)
+		{
+			CommandContext& context = mContexts[q];
+			m_busySeconds[q] = context.TimestampsSupported() ? 0.0 : StreamUnknownSeconds;
+			if (!context.TimestampsSupported())
+			{
+				continue;
+			}
+			std::vector<UINT64> ticks = context.ReadTimestamps(2 * ChunkCount());
+			double frequency = static_cast<double>(context.TimestampFrequency());
+			for (uint32_t c = 0; c < ChunkCount(); ++c)
+			{
+				m_busySeconds[q] += (ticks[2 * c + 1] - ticks[2 * c]) / frequency;
+			}
+		}
+	}
+
+	double BusySeconds(StreamQueue queue) const override { return m_busySeconds[static_cast<uint32_t>(queue)]; }
+
+	// Mismatch count against the host reference kernel.
+	uint64_t Verify() const
+	{
+		uint64_t mismatches = 0;
+		for (size_t i = 0; i < mHostInput.size(); ++i)
+		{
+			float expected = CpuStreamBackend::Kernel(mHostInput[i], m_iterations);
+			if (std::fabs(mHostOutput[i] - expected) > 1e-4f * (std::max)(1.0f, std::fabs(expected)))
+			{
+				++mismatches;
+			}
+		}
+		return mismatches;
+	}
+
+private:
+
+	CommandContext& Context(StreamQueue queue) { return mContexts[static_cast<uint32_t>(queue)]; }
+
+    ComPtr<ID3DBlob> mShaders;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	std::vector<ComPtr<ID3D12Resource>> mUploadStaging;
+	std::vector<ComPtr<ID3D12Resource>> mDeviceInput;
+	std::vector<ComPtr<ID3D12Resource>> mDeviceOutput;
+	std::vector<ComPtr<ID3D12Resource>> mReadbackStaging;
+	std::vector<uint8_t*>               mUploadMapped;
+	std::vector<uint8_t*>               mReadbackMapped;
+
+	std::vector<float> mHostInput;
+	std::vector<float> mHostOutput;
+
+	// Indexed by StreamQueue: upload (COPY), compute (COMPUTE), readback (COPY).
+	CommandContext mContexts[3];
+
+	StreamChunking m_chunking;
+	uint32_t       m_slotCount;
+	uint32_t       m_iterations;
+	double         m_busySeconds[3] = {};
+};
@@ -0,0 +1,125 @@
+#include "d3dAppSimplified.h"
+#include "Swizzle.h"
+#include "MemoryLayouts.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	MemoryLayout     layout     = MemoryLayout::MortonLayout;
+	SwizzleDirection direction  = SwizzleDirection::ToLayout;
+	int              width      = 4096;
+	int              height     = 4096;
+	int              tile       = 16;
+	int              validate   = 1;
+	int              cpuThreads = static_cast<int>(HardwareThreadCount());
+
+	// Usage: program.exe <layout> <direction> <width> <height> <tile> <validate> <cpuThreads>
+	// layout: 0=Linear (plain copy), 1=Morton, 2=Tiled, 3=StandardSwizzle64KB (32bpp, 128x128 tiles)
+	// direction: 0=linear -> layout, 1=layout -> linear   tile: power-of-two edge of the Tiled layout
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			layout = static_cast<MemoryLayout>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			direction = static_cast<SwizzleDirection>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			width = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			height = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			tile = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			validate = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			cpuThreads = _wtoi(argv[7]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: layout=%d, direction=%d, width=%d, height=%d, tile=%d, validate=%d, cpuThreads=%d\n",
+			static_cast<int>(layout), static_cast<int>(direction), width, height, tile, validate, cpuThreads);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (layout >= MemoryLayout::MemoryLayoutCount || direction >= SwizzleDirection::SwizzleDirectionCount)
+	{
+		OutputDebugStringA("ERROR: Unknown layout or direction!\n");
+		return 1;
+	}
+	// Z-order spreads 16 bits per coordinate; 2^26 elements keeps the three host copies reasonable.
+	if (width <= 0 || height <= 0 || width > 16384 || height > 16384 || static_cast<uint64_t>(width) * height > (1u << 26) ||
+		tile <= 0 || tile > 256 || cpuThreads <= 0 ||
+		!MemoryLayouts::Fits(layout, static_cast<uint32_t>(width), static_cast<uint32_t>(height), static_cast<uint32_t>(tile)))
+	{
+		OutputDebugStringA("ERROR: Invalid parameters, or the image is not a whole number of tiles!\n");
+		return 1;
+	}
+
+	Swizzle test(hInstance, layout, direction, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+		static_cast<uint32_t>(tile), static_cast<uint32_t>(cpuThreads));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Shader model 6.0 not supported on this device!\n");
+		return 1;
+	}
+
+	uint64_t mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		mismatches = validate != 0 ? test.Validate() : 0;
+	});
+	double gpuGBs      = 2.0 * test.ImageBytes() / gpuSeconds / 1e9;
+	double hostSeconds = direction == SwizzleDirection::ToLayout ? test.HostSwizzleSeconds() : test.HostUnswizzleSeconds();
+	double hostGBs     = 2.0 * test.ImageBytes() / hostSeconds / 1e9;
+	uint32_t tileEdge  = 1u << MemoryLayouts::TileShift(layout, static_cast<uint32_t>(width), static_cast<uint32_t>(height), static_cast<uint32_t>(tile));
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Layout: " << MemoryLayoutName(layout) << " (" << tileEdge << "x" << tileEdge << " tiles) Direction: " << SwizzleDirectionName(direction)
+		<< " Image: " << width << "x" << height << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGBs << " GB/s)\n";
+	debugOutput << "Host " << MemoryLayouts::HostSwizzlerName() << " (" << cpuThreads << " threads): " << hostSeconds << " seconds (" << hostGBs << " GB/s)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("swizzle_results.csv", "Layout,Direction,Width,Height,TileEdge,Gpu_s,Gpu_GBs,HostSwizzler,CpuThreads,Host_s,Host_GBs,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(MemoryLayoutName(layout), SwizzleDirectionName(direction), width, height, tileEdge, gpuSeconds, gpuGBs,
+		MemoryLayouts::HostSwizzlerName(), cpuThreads, hostSeconds, hostGBs, validate, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
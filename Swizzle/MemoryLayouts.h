@@ -0,0 +1,183 @@
+#pragma once
+
+// 2D element layouts of a width x height image of 32-bit elements, and multithreaded host
+// swizzlers between them and plain row-major order: used to prepare pre-swizzled uploads and to
+// validate the GPU conversion kernels (Shaders/Swizzle.hlsl computes the same addresses). Every
+// non-linear layout is a row-major grid of 2^s x 2^s tiles whose texels are stored row-major
+// (Tiled) or in Z-order (Morton, StandardSwizzle). With BMI2 the Z-order bits are spread with
+// pdep/pext, otherwise with shift-and-mask sequences. No D3D dependency.
+
+#include "ParallelFor.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define SWIZZLE_BMI2 1
+#endif
+
+enum MemoryLayout : uint32_t {
+    LinearLayout          = 0,   // row-major, the copy baseline
+    MortonLayout          = 1,   // Z-order over min(width, height)^2 squares
+    TiledLayout           = 2,   // tile x tile blocks, row-major inside
+    StandardSwizzleLayout = 3,   // D3D12 64KB standard swizzle of a 32bpp 2D texture: 128x128 Z-order tiles
+    MemoryLayoutCount
+};
+
+enum SwizzleDirection : uint32_t {
+    ToLayout   = 0,   // linear -> layout
+    FromLayout = 1,   // layout -> linear
+    SwizzleDirectionCount
+};
+
+inline const char* MemoryLayoutName(MemoryLayout layout)
+{
+    switch (layout)
+    {
+    case MemoryLayout::LinearLayout:          return "Linear";
+    case MemoryLayout::MortonLayout:          return "Morton";
+    case MemoryLayout::TiledLayout:           return "Tiled";
+    case MemoryLayout::StandardSwizzleLayout: return "StandardSwizzle64KB";
+    default:                                  return "Unknown";
+    }
+}
+
+inline const char* SwizzleDirectionName(SwizzleDirection direction)
+{
+    return direction == SwizzleDirection::FromLayout ? "FromLayout" : "ToLayout";
+}
+
+namespace MemoryLayouts
+{
+    // log2 of the square tile edge of a layout; 0 for linear, where every element is its own tile.
+    inline uint32_t TileShift(MemoryLayout layout, uint32_t width, uint32_t height, uint32_t tile)
+    {
+        uint32_t edge = 1;
+        switch (layout)
+        {
+        case MemoryLayout::MortonLayout:          edge = (std::min)(width, height); break;
+        case MemoryLayout::TiledLayout:           edge = tile; break;
+        case MemoryLayout::StandardSwizzleLayout: edge = 128; break;
+        default:                                  break;
+        }
+        uint32_t shift = 0;
+        while ((1u << (shift + 1)) <= edge)
+        {
+            ++shift;
+        }
+        return shift;
+    }
+
+    inline bool IsZOrder(MemoryLayout layout)
+    {
+        return layout == MemoryLayout::MortonLayout || layout == MemoryLayout::StandardSwizzleLayout;
+    }
+
+    // Whether the image is a whole number of tiles (and, for Morton, of power-of-two size).
+    inline bool Fits(MemoryLayout layout, uint32_t width, uint32_t height, uint32_t tile)
+    {
+        if (layout == MemoryLayout::MortonLayout && ((width & (width - 1)) != 0 || (height & (height - 1)) != 0))
+        {
+            return false;
+        }
+        if (layout == MemoryLayout::TiledLayout && (tile == 0 || (tile & (tile - 1)) != 0))
+        {
+            return false;
+        }
+        uint32_t edge = 1u << TileShift(layout, width, height, tile);
+        return width % edge == 0 && height % edge == 0;
+    }
+
+    // Bits of v (low 16) moved to the even bit positions.
+    inline uint32_t SpreadBits(uint32_t v)
+    {
+#if SWIZZLE_BMI2
+        return _pdep_u32(v, 0x55555555u);
+#else
+        v &= 0x0000FFFFu;
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+#endif
+    }
+
+    // Inverse of SpreadBits: the even bits of v packed into the low 16.
+    inline uint32_t CompactBits(uint32_t v)
+    {
+#if SWIZZLE_BMI2
+        return _pext_u32(v, 0x55555555u);
+#else
+        v &= 0x55555555u;
+        v = (v | (v >> 1)) & 0x33333333u;
+        v = (v | (v >> 2)) & 0x0F0F0F0Fu;
+        v = (v | (v >> 4)) & 0x00FF00FFu;
+        v = (v | (v >> 8)) & 0x0000FFFFu;
+        return v;
+#endif
+    }
+
+    inline const char* HostSwizzlerName()
+    {
+#if SWIZZLE_BMI2
+        return "BMI2";
+#else
+        return "Scalar";
+#endif
+    }
+
+    // Element offset of (x, y) in the layout with tile edge 2^shift.
+    inline uint32_t Address(uint32_t x, uint32_t y, uint32_t width, uint32_t shift, bool zOrder)
+    {
+        uint32_t mask = (1u << shift) - 1;
+        uint32_t tile = ((y >> shift) * (width >> shift) + (x >> shift)) << (2 * shift);
+        uint32_t inner = zOrder ? (SpreadBits(x & mask) | (SpreadBits(y & mask) << 1)) : (((y & mask) << shift) | (x & mask));
+        return tile + inner;
+    }
+
+    // Inverse of Address.
+    inline void Coordinates(uint32_t address, uint32_t width, uint32_t shift, bool zOrder, uint32_t& x, uint32_t& y)
+    {
+        uint32_t mask  = (1u << shift) - 1;
+        uint32_t tile  = address >> (2 * shift);
+        uint32_t inner = address & ((1u << (2 * shift)) - 1);
+        uint32_t tilesX = width >> shift;
+        x = ((tile % tilesX) << shift) | (zOrder ? CompactBits(inner) : (inner & mask));
+        y = ((tile / tilesX) << shift) | (zOrder ? CompactBits(inner >> 1) : (inner >> shift));
+    }
+
+    // Moves a row-major image into the layout (ToLayout) or back (FromLayout). Rows are split
+    // across threads; the row-major side is walked sequentially and the y part of every address is
+    // computed once per row.
+    inline void Swizzle(const uint32_t* source, uint32_t* destination, MemoryLayout layout, SwizzleDirection direction,
+        uint32_t width, uint32_t height, uint32_t tile, uint32_t threads)
+    {
+        const uint32_t shift  = TileShift(layout, width, height, tile);
+        const bool     zOrder = IsZOrder(layout);
+        const uint32_t mask   = (1u << shift) - 1;
+        ParallelFor(height, threads, [&](uint32_t, size_t begin, size_t end)
+        {
+            for (uint32_t y = static_cast<uint32_t>(begin); y < end; ++y)
+            {
+                uint32_t rowBase = (y >> shift) * (width >> shift) << (2 * shift);
+                uint32_t rowPart = zOrder ? SpreadBits(y & mask) << 1 : (y & mask) << shift;
+                const size_t linear = static_cast<size_t>(y) * width;
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    uint32_t address = rowBase + ((x >> shift) << (2 * shift)) + rowPart + (zOrder ? SpreadBits(x & mask) : (x & mask));
+                    if (direction == SwizzleDirection::ToLayout)
+                    {
+                        destination[address] = source[linear + x];
+                    }
+                    else
+                    {
+                        destination[linear + x] = source[address];
+                    }
+                }
+            }
+        }, 1);
+    }
+}
@@ -0,0 +1,95 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+LAYOUTS = {
+    0: "Linear",
+    1: "Morton",
+    2: "Tiled",
+    3: "StandardSwizzle64KB",
+}
+
+DIRECTIONS = {
+    0: "ToLayout",
+    1: "FromLayout",
+}
+
+TILES = [8, 16, 32]
+
+def run_simple_test(sizes = [1024, 2048, 4096, 8192], tryCount = 3):
+    """Runs every layout conversion in both directions over square images"""
+
+    program = "..\\x64\\Release\\Swizzle.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "swizzle_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for size in sizes:
+        for direction in DIRECTIONS:
+            for layout in LAYOUTS:
+                # Only the Tiled layout uses the tile argument.
+                for tile in (TILES if layout == 2 else [TILES[0]]):
+                    print(f"\nRunning {LAYOUTS[layout]} {DIRECTIONS[direction]} {size}x{size} tile {tile}...")
+                    for i in range(tryCount):
+                        time.sleep(0.01)
+                        try:
+                            result = subprocess.run([
+                                program,
+                                str(layout),
+                                str(direction),
+                                str(size),
+                                str(size),
+                                str(tile),
+                                # Validate the first run of each configuration only.
+                                "1" if i == 0 else "0"
+                            ], capture_output=True, text=True)
+                            if result.returncode != 0:
+                                print(f"  Run {i+1}: failed (exit {result.returncode})")
+                            else:
+                                print(f"  Run {i+1}: {result.stdout.strip()}")
+                        except Exception as e:
+                            print(f"  Run {i+1}: Error - {e}")
+
+def plot_swizzle_results(filename):
+    gpu = {}
+    host = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            name = parts[0] if parts[0] != "Tiled" else f"Tiled{parts[4]}"
+            key = (parts[1], name)
+            pixels = int(parts[2]) * int(parts[3])
+            gpu.setdefault(key, {}).setdefault(pixels, []).append(float(parts[6]))
+            host.setdefault(key, {}).setdefault(pixels, []).append(float(parts[10]))
+
+    fig, axes = plt.subplots(1, len(DIRECTIONS), figsize=(14, 5), sharey=True)
+    for ax, direction in zip(axes, DIRECTIONS.values()):
+        for (d, name), values in sorted(gpu.items()):
+            if d != direction:
+                continue
+            pixels = sorted(values.keys())
+            line, = ax.plot(pixels, [max(values[p]) for p in pixels], marker='o', label=f"{name} GPU")
+            hostValues = host[(d, name)]
+            ax.plot(pixels, [max(hostValues[p]) for p in pixels], marker='x', linestyle='--', color=line.get_color(), label=f"{name} host")
+        ax.set_xscale('log', base=2)
+        ax.set_xlabel('Elements')
+        ax.set_ylabel('GB/s')
+        ax.set_title(direction)
+        ax.grid(True)
+        ax.legend(fontsize=6)
+    plt.suptitle('Layout Conversion: GPU Kernel vs Host Swizzler')
+    plt.tight_layout()
+    plt.savefig('Swizzle.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_swizzle_results("swizzle_results.csv")
@@ -0,0 +1,59 @@
+// Converts a width x height image of 32-bit elements between row-major order and a tiled layout
+// (MemoryLayouts.h computes the same addresses on the host). Compiled with DXC (cs_6_0); variants
+// are selected by defines:
+//   ZORDER      0=texels row-major inside each tile (Linear with TileShift 0, Tiled), 1=Z-order
+//               inside each tile (Morton, StandardSwizzle)
+//   DIRECTION   0=linear -> layout (row-major reads, scattered writes), 1=layout -> linear
+//
+// One thread per element in 16x16 groups, so a group covers a 2D block of either side.
+
+StructuredBuffer<uint>   Input  : register(t0);
+RWStructuredBuffer<uint> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Width;
+    uint Height;
+    uint TileShift;   // tiles are 2^TileShift x 2^TileShift, laid out row-major
+    uint Pad0;
+}
+
+static const uint GroupSize = 16;
+
+// Bits of v (low 16) moved to the even bit positions; HLSL has no pdep.
+uint SpreadBits(uint v)
+{
+    v &= 0x0000FFFFu;
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+uint Address(uint x, uint y)
+{
+    uint mask = (1u << TileShift) - 1;
+    uint tile = ((y >> TileShift) * (Width >> TileShift) + (x >> TileShift)) << (2 * TileShift);
+#if ZORDER
+    return tile + (SpreadBits(x & mask) | (SpreadBits(y & mask) << 1));
+#else
+    return tile + (((y & mask) << TileShift) | (x & mask));
+#endif
+}
+
+[numthreads(GroupSize, GroupSize, 1)]
+void main(uint3 dispatchId : SV_DispatchThreadID)
+{
+    uint x = dispatchId.x;
+    uint y = dispatchId.y;
+    if (x >= Width || y >= Height)
+    {
+        return;
+    }
+#if DIRECTION == 0
+    Output[Address(x, y)] = Input[y * Width + x];
+#else
+    Output[y * Width + x] = Input[Address(x, y)];
+#endif
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuTimer.h"
+#include "MemoryLayouts.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// GPU conversion of a width x height image of 32-bit elements between row-major order and one
+// MemoryLayout (Shaders/Swizzle.hlsl), next to the host swizzlers doing the same conversion before
+// upload. The host side is timed once in each direction in the constructor and also produces the
+// GPU input (pre-swizzled for FromLayout) and the expected output.
+class Swizzle : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t TileShift;
+		uint32_t Pad0;
+	};
+
+    static const uint32_t GroupSize = 16;
+
+    Swizzle(HINSTANCE hInstance, MemoryLayout layout, SwizzleDirection direction, uint32_t width, uint32_t height, uint32_t tile, uint32_t cpuThreads) :
+		D3DAppSimplified(hInstance),
+		m_layout(layout),
+		m_direction(direction),
+		m_width(width),
+		m_height(height),
+		m_tile(tile),
+		m_cpuThreads(cpuThreads)
+	{
+		std::vector<uint32_t> linear(Elements());
+		for (size_t i = 0; i < linear.size(); ++i)
+		{
+			linear[i] = static_cast<uint32_t>(i) * 2654435761u;
+		}
+		std::vector<uint32_t> swizzled(Elements());
+		std::vector<uint32_t> roundTrip(Elements());
+
+		CpuTimer timer;
+		timer.Start();
+		MemoryLayouts::Swizzle(linear.data(), swizzled.data(), m_layout, SwizzleDirection::ToLayout, m_width, m_height, m_tile, m_cpuThreads);
+		m_hostSwizzleSeconds = timer.Stop();
+		timer.Start();
+		MemoryLayouts::Swizzle(swizzled.data(), roundTrip.data(), m_layout, SwizzleDirection::FromLayout, m_width, m_height, m_tile, m_cpuThreads);
+		m_hostUnswizzleSeconds = timer.Stop();
+		m_hostRoundTripExact = roundTrip == linear;
+
+		mHostInput    = m_direction == SwizzleDirection::ToLayout ? linear : swizzled;
+		mHostExpected = m_direction == SwizzleDirection::ToLayout ? swizzled : linear;
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		mInputBuffer    = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostInput.data(), ImageBytes());
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, ImageBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, ImageBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		mShader = D3DUtil::CompileShaderDxc(L"Shaders\\Swizzle.hlsl", {
+			L"ZORDER=" + std::to_wstring(MemoryLayouts::IsZOrder(m_layout) ? 1 : 0),
+			L"DIRECTION=" + std::to_wstring(static_cast<uint32_t>(m_direction))
+		}, L"main", L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShader.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		RootConstants constants = { m_width, m_height, MemoryLayouts::TileShift(m_layout, m_width, m_height, m_tile), 0 };
+
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootShaderResourceView(1, mInputBuffer->GetGPUVirtualAddress());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		commandList->Dispatch(DivideRoundUp(m_width, GroupSize), DivideRoundUp(m_height, GroupSize), 1);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, ImageBytes());
+		}
+    }
+
+	bool   Supported()            const { return m_supported; }
+	size_t Elements()             const { return static_cast<size_t>(m_width) * m_height; }
+	UINT64 ImageBytes()           const { return Elements() * sizeof(uint32_t); }
+	double HostSwizzleSeconds()   const { return m_hostSwizzleSeconds; }
+	double HostUnswizzleSeconds() const { return m_hostUnswizzleSeconds; }
+
+	// Output elements of the last Dispatch() with SetCopyResults(true) that differ from the host
+	// conversion; every element also counts if the host swizzle/unswizzle round trip was not exact
+	// or the host layout disagrees with the closed-form inverse (MemoryLayouts::Coordinates), which
+	// catches a mistake the incremental forward and inverse passes share.
+	uint64_t Validate()
+	{
+		if (!m_hostRoundTripExact || !HostLayoutMatchesCoordinates())
+		{
+			return Elements();
+		}
+		uint32_t* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(ImageBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint64_t mismatches = 0;
+		for (size_t i = 0; i < Elements(); ++i)
+		{
+			mismatches += mapped[i] != mHostExpected[i] ? 1 : 0;
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	bool HostLayoutMatchesCoordinates() const
+	{
+		const std::vector<uint32_t>& linear   = m_direction == SwizzleDirection::ToLayout ? mHostInput : mHostExpected;
+		const std::vector<uint32_t>& swizzled = m_direction == SwizzleDirection::ToLayout ? mHostExpected : mHostInput;
+		const uint32_t shift  = MemoryLayouts::TileShift(m_layout, m_width, m_height, m_tile);
+		const bool     zOrder = MemoryLayouts::IsZOrder(m_layout);
+		for (size_t address = 0; address < Elements(); ++address)
+		{
+			uint32_t x, y;
+			MemoryLayouts::Coordinates(static_cast<uint32_t>(address), m_width, shift, zOrder, x, y);
+			if (swizzled[address] != linear[static_cast<size_t>(y) * m_width + x])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	ComPtr<ID3D12Resource> mInputBuffer;
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	std::vector<uint32_t> mHostInput;
+	std::vector<uint32_t> mHostExpected;
+
+	MemoryLayout     m_layout;
+	SwizzleDirection m_direction;
+	uint32_t         m_width;
+	uint32_t         m_height;
+	uint32_t         m_tile;
+	uint32_t         m_cpuThreads;
+	double           m_hostSwizzleSeconds   = 0.0;
+	double           m_hostUnswizzleSeconds = 0.0;
+	bool             m_hostRoundTripExact   = false;
+	bool             m_supported            = false;
+};
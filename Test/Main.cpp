@@ -2,7 +2,13 @@
 #include "Test.h"
 #include "d3dAppSimplified.h"
 #include "TestSimplified.h"
+#include "VectorLayouts.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
 #include <iostream>
+#include <sstream>
+#include <cstdlib>
+
 int WINAPI WinMain(
     _In_ HINSTANCE hInstance,
     _In_opt_ HINSTANCE hPrevInstance,
@@ -13,12 +19,110 @@ int WINAPI WinMain(
     bool simplified = true;
     if (simplified)
     {
-		TestSimplified test(hInstance);
+		VectorLayout layout     = VectorLayout::AoS;
+		BufferView   view       = BufferView::StructuredView;
+		int          count      = 1 << 22;
+		int          block      = 32;
+		int          validate   = 1;
+		int          cpuThreads = static_cast<int>(HardwareThreadCount());
+
+		// Usage: program.exe <layout> <view> <count> <block> <validate> <cpuThreads>
+		// layout: 0=AoS, 1=PaddedAoS, 2=SoA, 3=AoSoA   view: 0=Structured, 1=Typed, 2=ByteAddress
+		// block: AoSoA vectors per block (multiple of 4)
+		int argc;
+		LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+		if (argv)
+		{
+			if (argc >= 2)
+			{
+				layout = static_cast<VectorLayout>(_wtoi(argv[1]));
+			}
+			if (argc >= 3)
+			{
+				view = static_cast<BufferView>(_wtoi(argv[2]));
+			}
+			if (argc >= 4)
+			{
+				count = _wtoi(argv[3]);
+			}
+			if (argc >= 5)
+			{
+				block = _wtoi(argv[4]);
+			}
+			if (argc >= 6)
+			{
+				validate = _wtoi(argv[5]);
+			}
+			if (argc >= 7)
+			{
+				cpuThreads = _wtoi(argv[6]);
+			}
+
+			wchar_t buffer[512];
+			swprintf_s(buffer, L"Params: layout=%d, view=%d, count=%d, block=%d, validate=%d, cpuThreads=%d\n",
+				static_cast<int>(layout), static_cast<int>(view), count, block, validate, cpuThreads);
+			OutputDebugStringW(buffer);
+
+			LocalFree(argv);
+		}
+		else
+		{
+			OutputDebugStringA("Failed to parse command line, using defaults\n");
+		}
+
+		if (layout >= VectorLayout::VectorLayoutCount || view >= BufferView::BufferViewCount)
+		{
+			OutputDebugStringA("ERROR: Unknown layout or view!\n");
+			return 1;
+		}
+		// 2^25 vectors keeps every typed view under the 2^27-element buffer view limit.
+		if (count <= 0 || count > (1 << 25) || block < 4 || block > 1024 || block % 4 != 0 || cpuThreads <= 0)
+		{
+			OutputDebugStringA("ERROR: Invalid parameters!\n");
+			return 1;
+		}
+
+		TestSimplified test(hInstance, static_cast<uint32_t>(count), layout, view, static_cast<uint32_t>(block), static_cast<uint32_t>(cpuThreads));
 		test.Initialize();
-		test.Dispatch();
-		auto duration = test.GetDuration();
+
+		if (!test.Supported())
+		{
+			OutputDebugStringA("ERROR: Layout/view combination not supported on this device!\n");
+			return 1;
+		}
+
+		uint32_t mismatches = 0;
+		double duration = test.RunWarmedAndTimed(validate != 0, [&]() {
+			mismatches = validate != 0 ? test.Validate() : 0;
+		});
+		double usefulGBs  = test.UsefulBytes() / duration / 1e9;
+		double fetchedGBs = (test.InputBytes() + test.OutputBytes()) / duration / 1e9;
+		double convertGBs = test.InputBytes() / test.ConversionSeconds() / 1e9;
+
+		std::ostringstream debugOutput;
+		debugOutput << "**************************Summary**************************\n";
+		debugOutput << "Layout: " << VectorLayoutName(layout);
+		if (layout == VectorLayout::AoSoA)
+		{
+			debugOutput << " (block " << block << ")";
+		}
+		debugOutput << " View: " << BufferViewName(view) << " Vectors: " << count << "\n";
+		debugOutput << "GPU: " << duration << " seconds (" << usefulGBs << " GB/s useful, " << fetchedGBs << " GB/s stored)\n";
+		debugOutput << "Host AoS conversion (" << cpuThreads << " threads): " << test.ConversionSeconds() << " seconds (" << convertGBs << " GB/s written)\n";
+		if (validate != 0)
+		{
+			debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+		}
+		debugOutput << "**************************EndEnd**************************\n";
+		D3DUtil::PrintDebugString(debugOutput.str());
+
+		ResultsCsv csv("vector_layout_results.csv", "Layout,View,Count,Block,InputBytes,Gpu_s,Useful_GBs,Stored_GBs,CpuThreads,Convert_s,Convert_GBs,Validated,Mismatches", QueryDeviceCaps(test.Device()).Describe());
+		csv.Row(VectorLayoutName(layout), BufferViewName(view), count, block, test.InputBytes(), duration, usefulGBs, fetchedGBs,
+			cpuThreads, test.ConversionSeconds(), convertGBs, validate, mismatches);
+		return mismatches == 0 ? 0 : 1;
     }
-    else 
+    else
     {
 		Test test(hInstance, L"PerformanceTestCase:Sample", 800, 600);
 		test.Initialize();
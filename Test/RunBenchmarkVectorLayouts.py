@@ -0,0 +1,86 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+LAYOUTS = {
+    0: "AoS",
+    1: "PaddedAoS",
+    2: "SoA",
+    3: "AoSoA",
+}
+
+VIEWS = {
+    0: "Structured",
+    1: "Typed",
+    2: "ByteAddress",
+}
+
+# AoSoA block sizes; the other layouts ignore it.
+BLOCKS = [8, 32, 64]
+
+def run_simple_test(tryCount = 3):
+    """Runs the vector-length kernel for every layout and buffer view over a range of sizes"""
+
+    program = "..\\x64\\Release\\Test.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "vector_layout_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for exponent in range(16, 26, 3):
+        count = 1 << exponent
+        for layout in LAYOUTS:
+            for view in VIEWS:
+                blocks = BLOCKS if layout == 3 else [32]
+                for block in blocks:
+                    print(f"\nRunning {LAYOUTS[layout]} {VIEWS[view]} count {count} block {block}...")
+                    for i in range(tryCount):
+                        time.sleep(0.01)
+                        try:
+                            result = subprocess.run([
+                                program,
+                                str(layout),
+                                str(view),
+                                str(count),
+                                str(block),
+                                # Validate the first run of each configuration only.
+                                "1" if i == 0 else "0"
+                            ], capture_output=True, text=True)
+                            if result.returncode != 0:
+                                print(f"  Run {i+1}: failed, unsupported or mismatched (exit {result.returncode})")
+                            else:
+                                print(f"  Run {i+1}: {result.stdout.strip()}")
+                        except Exception as e:
+                            print(f"  Run {i+1}: Error - {e}")
+
+def plot_vector_layout_results(filename):
+    results = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            label = f"{parts[0]} {parts[1]}" + (f" B{parts[3]}" if parts[0] == "AoSoA" else "")
+            results.setdefault(label, {}).setdefault(int(parts[2]), []).append(float(parts[6]))
+
+    for label, points in results.items():
+        counts = sorted(points)
+        plt.plot(counts, [max(points[c]) for c in counts], marker='o', label=label)
+    plt.xscale('log', base=2)
+    plt.xlabel('Vectors')
+    plt.ylabel('Useful GB/s (16 bytes per vector)')
+    plt.title('Vector Length by Layout and Buffer View')
+    plt.legend(fontsize=6, ncol=2)
+    plt.grid(True)
+    plt.tight_layout()
+    plt.savefig('VectorLayouts.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_vector_layout_results("vector_layout_results.csv")
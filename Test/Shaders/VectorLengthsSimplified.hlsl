@@ -1,3 +1,11 @@
+// Length of Count 3D vectors, the input stored in one of four layouts and read through one of three
+// buffer views. Compiled with DXC (cs_6_0); variants are selected by defines:
+//   LAYOUT  0=AoS (12 bytes per vector), 1=padded AoS (float4), 2=SoA (x[Count] y[Count] z[Count]),
+//           3=AoSoA (blocks of BLOCK vectors, each x[BLOCK] y[BLOCK] z[BLOCK])
+//   VIEW    0=StructuredBuffer, 1=typed Buffer (R32G32B32 / R32G32B32A32 / R32 float formats),
+//           2=ByteAddressBuffer
+//   BLOCK   AoSoA block size
+
 struct Vector3D
 {
     float x;
@@ -5,17 +13,71 @@ struct Vector3D
     float z;
 };
 
-StructuredBuffer<Vector3D> InputVectors : register(t0);
-RWStructuredBuffer<float> OutputLengths   : register(u0);
+#if VIEW == 2
+ByteAddressBuffer                  InputVectors : register(t0);
+#elif LAYOUT == 0 && VIEW == 0
+StructuredBuffer<Vector3D>         InputVectors : register(t0);
+#elif LAYOUT == 0
+Buffer<float3>                     InputVectors : register(t0);
+#elif LAYOUT == 1 && VIEW == 0
+StructuredBuffer<float4>           InputVectors : register(t0);
+#elif LAYOUT == 1
+Buffer<float4>                     InputVectors : register(t0);
+#elif VIEW == 0
+StructuredBuffer<float>            InputVectors : register(t0);
+#else
+Buffer<float>                      InputVectors : register(t0);
+#endif
+RWStructuredBuffer<float>          OutputLengths : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Count;
+    uint GroupsX;
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint NumThreads = 256;
+
+float LoadComponent(uint index)
+{
+#if VIEW == 2
+    return asfloat(InputVectors.Load(index * 4));
+#else
+    return InputVectors[index];
+#endif
+}
+
+float3 LoadVector(uint i)
+{
+#if LAYOUT == 0 && VIEW == 2
+    return asfloat(InputVectors.Load3(i * 12));
+#elif LAYOUT == 0 && VIEW == 0
+    Vector3D vec = InputVectors[i];
+    return float3(vec.x, vec.y, vec.z);
+#elif LAYOUT == 0
+    return InputVectors[i];
+#elif LAYOUT == 1 && VIEW == 2
+    return asfloat(InputVectors.Load4(i * 16)).xyz;
+#elif LAYOUT == 1
+    return InputVectors[i].xyz;
+#elif LAYOUT == 2
+    return float3(LoadComponent(i), LoadComponent(Count + i), LoadComponent(2 * Count + i));
+#else
+    uint base = (i / BLOCK) * (3 * BLOCK) + i % BLOCK;
+    return float3(LoadComponent(base), LoadComponent(base + BLOCK), LoadComponent(base + 2 * BLOCK));
+#endif
+}
 
-[numthreads(64 ,1 ,1)]
-void CSMain(uint3 tid : SV_DispatchThreadID)
+[numthreads(NumThreads, 1, 1)]
+void CSMain(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
 {
-    if(tid.x < 64)
+    uint i = (groupId.y * GroupsX + groupId.x) * NumThreads + threadId.x;
+    if (i < Count)
     {
-        Vector3D vec = InputVectors[tid.x];
+        float3 vec = LoadVector(i);
         float length = sqrt(vec.x * vec.x + vec.y * vec.y + vec.z * vec.z);
-        OutputLengths[tid.x] = length;
+        OutputLengths[i] = length;
     }
 }
-    
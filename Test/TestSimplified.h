@@ -1,132 +1,237 @@
 #pragma once
 #include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CpuTimer.h"
+#include "VectorLayouts.h"
 #include <unordered_map>
 #include <string>
 #include <vector>
 #include <random>
 
+// Lengths of `count` 3D vectors (Shaders/VectorLengthsSimplified.hlsl) with the input in one of the
+// VectorLayout layouts, read through one of the BufferView views. The input SRV sits in a descriptor
+// table for every view, since typed buffers cannot be bound as root descriptors; the output is a
+// root UAV. The default constructor is the original 64-vector AoS / structured test.
 class TestSimplified : public D3DAppSimplified
 {
 public:
 
-    struct Vector3D
-    {
-        float x, y, z;
-    };
-
-    TestSimplified(HINSTANCE hInstance) : D3DAppSimplified(hInstance) { } 
+	struct RootConstants
+	{
+		uint32_t Count;
+		uint32_t GroupsX;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t NumThreads = 256;
+
+    TestSimplified(HINSTANCE hInstance) : TestSimplified(hInstance, 64, VectorLayout::AoS, BufferView::StructuredView, 32, 1) { }
+
+    TestSimplified(HINSTANCE hInstance, uint32_t count, VectorLayout layout, BufferView view, uint32_t block, uint32_t cpuThreads) :
+		D3DAppSimplified(hInstance),
+		m_count(count),
+		m_layout(layout),
+		m_view(view),
+		m_block(block),
+		m_cpuThreads(cpuThreads)
+	{
+		mInputVectors = VectorLayouts::MakeVectors(count);
+	}
 
     void BuildResourcesAndHeaps() override {
-        std::vector<Vector3D> inputVectors(64);
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> magnitudeDist(1.0f, 10.0f);
-        std::uniform_real_distribution<float> angleDist(0.0f, DirectX::XM_2PI);
-		for (auto& vec : inputVectors)
-		{
-			float magnitude = magnitudeDist(gen);
-			float theta = angleDist(gen);    // azimuthal angle
-			float phi = angleDist(gen);       // polar angle
-
-			vec.x = magnitude * sinf(phi) * cosf(theta);
-			vec.y = magnitude * sinf(phi) * sinf(theta);
-			vec.z = magnitude * cosf(phi);
-		}
-
-        mDefaultBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), inputVectors.data(), inputVectors.size() * sizeof(Vector3D));
-		
-		UINT byteSize = 36 * sizeof(float);
-		auto temp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
-		auto temp1 = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
-		auto temp3 = CD3DX12_RESOURCE_DESC::Buffer(byteSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-		auto temp4 = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
-
-		AssertIfFailed(Device()->CreateCommittedResource(
-			&temp,
-			D3D12_HEAP_FLAG_NONE,
-			&temp3,
-			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-			nullptr,
-			IID_PPV_ARGS(&mOutputBuffer)));
-	
-		AssertIfFailed(Device()->CreateCommittedResource(
-			&temp1,
-			D3D12_HEAP_FLAG_NONE,
-			&temp4,
-			D3D12_RESOURCE_STATE_COPY_DEST,
-			nullptr,
-			IID_PPV_ARGS(&mReadBackBuffer)));
-	
+		m_supported = CheckSupport();
+
+		// Host conversion from AoS, timed once warm so page faults on the output are not counted.
+		std::vector<float> input = VectorLayouts::Convert(mInputVectors, m_layout, m_block, m_cpuThreads);
+		CpuTimer timer;
+		timer.Start();
+		input = VectorLayouts::Convert(mInputVectors, m_layout, m_block, m_cpuThreads);
+		m_conversionSeconds = timer.Stop();
+
+        mDefaultBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), input.data(), InputBytes());
+		mOutputBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, OutputBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadBackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, OutputBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+
+		D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+		heapDesc.NumDescriptors = 1;
+		heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		AssertIfFailed(Device()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mDescriptorHeap)));
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = InputViewDesc();
+		Device()->CreateShaderResourceView(mDefaultBuffer.Get(), &srvDesc, mDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
 	}
 
     void BuildShadersAndInputLayout() override {
-        mShaders = D3DUtil::CompileShader(L"Shaders\\VectorLengthsSimplified.hlsl", nullptr, "CSMain", "cs_5_0");
+		if (!m_supported)
+		{
+			return;
+		}
+        mShaders = D3DUtil::CompileShaderDxc(L"Shaders\\VectorLengthsSimplified.hlsl", {
+			L"LAYOUT=" + std::to_wstring(static_cast<uint32_t>(m_layout)),
+			L"VIEW=" + std::to_wstring(static_cast<uint32_t>(m_view)),
+			L"BLOCK=" + std::to_wstring(m_block)
+		}, L"CSMain", L"cs_6_0");
     }
 
     void BuildPSOs() override {
-		CD3DX12_ROOT_PARAMETER slotRootParameter[2];
-
-		// Perfomance TIP: Order from most frequent to least frequent.
-		slotRootParameter[0].InitAsShaderResourceView(0);
-		slotRootParameter[1].InitAsUnorderedAccessView(0);
-
-		// A root signature is an array of root parameters.
-		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(2, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
-
-		// create a root signature with a single slot which points to a descriptor range consisting of a single constant buffer
-		ComPtr<ID3DBlob> serializedRootSig = nullptr;
-		ComPtr<ID3DBlob> errorBlob = nullptr;
-		HRESULT hr = D3D12SerializeRootSignature(&rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, serializedRootSig.GetAddressOf(), errorBlob.GetAddressOf()); 
-		if(errorBlob != nullptr)
+		if (!m_supported)
 		{
-			::OutputDebugStringA((char*)errorBlob->GetBufferPointer());
+			return;
 		}
-		AssertIfFailed(hr);
+		CD3DX12_DESCRIPTOR_RANGE srvRange;
+		srvRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
 
-		AssertIfFailed(Device()->CreateRootSignature(
-			0,
-			serializedRootSig->GetBufferPointer(),
-			serializedRootSig->GetBufferSize(),
-			IID_PPV_ARGS(mRootSignature.GetAddressOf())));
-
-		D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {};
-		computePsoDesc.pRootSignature = mRootSignature.Get();
-		computePsoDesc.CS =
-		{
-			reinterpret_cast<BYTE*>(mShaders->GetBufferPointer()),
-			mShaders->GetBufferSize()
-		};
-		computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
-		AssertIfFailed(Device()->CreateComputePipelineState(&computePsoDesc, IID_PPV_ARGS(&mPSO)));
+		// Perfomance TIP: Order from most frequent to least frequent.
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsDescriptorTable(1, &srvRange);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders.Get());
     }
 
     void DoAction() override {
 	   // Dispatch compute shader
 		auto commandList = GraphicsCommandList();
+		uint32_t groups  = DivideRoundUp(m_count, NumThreads);
+		RootConstants constants = { m_count, GroupsX(groups), 0, 0 };
+
+		ID3D12DescriptorHeap* heaps[] = { mDescriptorHeap.Get() };
+		commandList->SetDescriptorHeaps(_countof(heaps), heaps);
 		commandList->SetComputeRootSignature(mRootSignature.Get());
 		commandList->SetPipelineState(mPSO.Get());
-		commandList->SetComputeRootShaderResourceView(0, mDefaultBuffer->GetGPUVirtualAddress());
-		commandList->SetComputeRootUnorderedAccessView(1, mOutputBuffer->GetGPUVirtualAddress());
-		commandList->Dispatch(1, 1, 1);
-
-		// Barrier to transition output buffer to copy source
-		D3D12_RESOURCE_BARRIER outputBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-			mOutputBuffer.Get(),
-			D3D12_RESOURCE_STATE_UNORDERED_ACCESS, 
-			D3D12_RESOURCE_STATE_COPY_SOURCE);
-		commandList->ResourceBarrier(1, &outputBarrier);
-
-		// Copy results to readback buffer
-		commandList->CopyResource(mReadBackBuffer.Get(), mOutputBuffer.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootDescriptorTable(1, mDescriptorHeap->GetGPUDescriptorHandleForHeapStart());
+		commandList->SetComputeRootUnorderedAccessView(2, mOutputBuffer->GetGPUVirtualAddress());
+		DispatchGroups(groups);
+
+		if (CopyResults())
+		{
+			// Barrier to transition output buffer to copy source
+			D3D12_RESOURCE_BARRIER outputBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
+				mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+				D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &outputBarrier);
+
+			// Copy results to readback buffer
+			commandList->CopyBufferRegion(mReadBackBuffer.Get(), 0, mOutputBuffer.Get(), 0, OutputBytes());
+		}
     }
 
+	bool   Supported()         const { return m_supported; }
+	double ConversionSeconds() const { return m_conversionSeconds; }
+	UINT64 InputBytes()        const { return VectorLayouts::StoredFloats(m_layout, m_count, m_block) * sizeof(float); }
+	UINT64 OutputBytes()       const { return static_cast<UINT64>(m_count) * sizeof(float); }
+	// 12 bytes of vector in and a 4-byte length out, whatever the layout stores.
+	UINT64 UsefulBytes()       const { return static_cast<UINT64>(m_count) * (sizeof(Vector3D) + sizeof(float)); }
+
+	// Lengths of the last Dispatch() with SetCopyResults(true) off the reference by more than a few
+	// ulps (the GPU sqrt is not required to be correctly rounded).
+	uint32_t Validate()
+	{
+		std::vector<float> reference = VectorLayouts::Lengths(mInputVectors);
+		float* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(OutputBytes()) };
+		AssertIfFailed(mReadBackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < m_count; ++i)
+		{
+			mismatches += std::fabs(mapped[i] - reference[i]) > 1e-5f * reference[i] ? 1 : 0;
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadBackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	DXGI_FORMAT TypedFormat() const
+	{
+		switch (m_layout)
+		{
+		case VectorLayout::AoS:       return DXGI_FORMAT_R32G32B32_FLOAT;
+		case VectorLayout::PaddedAoS: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		default:                      return DXGI_FORMAT_R32_FLOAT;
+		}
+	}
+
+	UINT ElementBytes() const
+	{
+		switch (m_layout)
+		{
+		case VectorLayout::AoS:       return sizeof(Vector3D);
+		case VectorLayout::PaddedAoS: return 4 * sizeof(float);
+		default:                      return sizeof(float);
+		}
+	}
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC InputViewDesc() const
+	{
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.ViewDimension           = D3D12_SRV_DIMENSION_BUFFER;
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.Buffer.FirstElement     = 0;
+		switch (m_view)
+		{
+		case BufferView::StructuredView:
+			srvDesc.Format                     = DXGI_FORMAT_UNKNOWN;
+			srvDesc.Buffer.NumElements         = static_cast<UINT>(InputBytes() / ElementBytes());
+			srvDesc.Buffer.StructureByteStride = ElementBytes();
+			srvDesc.Buffer.Flags               = D3D12_BUFFER_SRV_FLAG_NONE;
+			break;
+		case BufferView::TypedView:
+			srvDesc.Format               = TypedFormat();
+			srvDesc.Buffer.NumElements   = static_cast<UINT>(InputBytes() / ElementBytes());
+			srvDesc.Buffer.Flags         = D3D12_BUFFER_SRV_FLAG_NONE;
+			break;
+		default:
+			srvDesc.Format               = DXGI_FORMAT_R32_TYPELESS;
+			srvDesc.Buffer.NumElements   = static_cast<UINT>(InputBytes() / sizeof(uint32_t));
+			srvDesc.Buffer.Flags         = D3D12_BUFFER_SRV_FLAG_RAW;
+			break;
+		}
+		return srvDesc;
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		// Typed buffer loads of the three-channel format are optional.
+		D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = { TypedFormat() };
+		if (m_view == BufferView::TypedView &&
+			(FAILED(Device()->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport))) ||
+			 (formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_BUFFER) == 0 || (formatSupport.Support1 & D3D12_FORMAT_SUPPORT1_SHADER_LOAD) == 0))
+		{
+			OutputDebugStringA("Typed buffer loads of this format not supported\n");
+			return false;
+		}
+		return true;
+	}
+
     ComPtr<ID3DBlob> mShaders;
-    Microsoft::WRL::ComPtr<ID3D12Resource> mUploadBuffer;
     Microsoft::WRL::ComPtr<ID3D12Resource> mDefaultBuffer;
 	ComPtr<ID3D12Resource> mOutputBuffer = nullptr;
 	ComPtr<ID3D12Resource> mReadBackBuffer = nullptr;
+	ComPtr<ID3D12DescriptorHeap> mDescriptorHeap;
 
 	ComPtr<ID3D12RootSignature> mRootSignature;
 	ComPtr<ID3D12PipelineState> mPSO;
-};
 
+	std::vector<Vector3D> mInputVectors;
+
+	uint32_t     m_count;
+	VectorLayout m_layout;
+	BufferView   m_view;
+	uint32_t     m_block;
+	uint32_t     m_cpuThreads;
+	double       m_conversionSeconds = 0.0;
+	bool         m_supported         = false;
+};
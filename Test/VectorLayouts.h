@@ -0,0 +1,203 @@
+#pragma once
+
+// Host side of the vector-length layout benchmark: the test vectors, the AoS -> padded AoS / SoA /
+// AoSoA converters (SSE 3x4 transposes, multithreaded, scalar on other targets) and the reference
+// lengths. The converted arrays are exactly what Shaders/VectorLengthsSimplified.hlsl reads for
+// each LAYOUT. No D3D dependency.
+
+#include "ParallelFor.h"
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VECTOR_LAYOUTS_SSE 1
+#endif
+
+struct Vector3D
+{
+    float x, y, z;
+};
+
+enum VectorLayout : uint32_t {
+    AoS       = 0,   // x y z x y z ...                    12 bytes per vector
+    PaddedAoS = 1,   // x y z 0 x y z 0 ...                16 bytes per vector
+    SoA       = 2,   // x x x ... y y y ... z z z ...       one stream per component
+    AoSoA     = 3,   // blocks of B vectors, each x[B] y[B] z[B]
+    VectorLayoutCount
+};
+
+enum BufferView : uint32_t {
+    StructuredView  = 0,   // StructuredBuffer<Vector3D / float4 / float>
+    TypedView       = 1,   // Buffer<float3 / float4 / float>, DXGI_FORMAT_R32G32B32[A32]_FLOAT / R32_FLOAT
+    ByteAddressView = 2,   // ByteAddressBuffer, Load3 / Load4 / Load
+    BufferViewCount
+};
+
+inline const char* VectorLayoutName(VectorLayout layout)
+{
+    switch (layout)
+    {
+    case VectorLayout::AoS:       return "AoS";
+    case VectorLayout::PaddedAoS: return "PaddedAoS";
+    case VectorLayout::SoA:       return "SoA";
+    case VectorLayout::AoSoA:     return "AoSoA";
+    default:                      return "Unknown";
+    }
+}
+
+inline const char* BufferViewName(BufferView view)
+{
+    switch (view)
+    {
+    case BufferView::StructuredView:  return "Structured";
+    case BufferView::TypedView:       return "Typed";
+    case BufferView::ByteAddressView: return "ByteAddress";
+    default:                          return "Unknown";
+    }
+}
+
+namespace VectorLayouts
+{
+    // Same distribution as the original 64-vector test (magnitude 1..10, random direction), seeded
+    // so runs are comparable.
+    inline std::vector<Vector3D> MakeVectors(uint32_t count)
+    {
+        std::vector<Vector3D> vectors(count);
+        std::mt19937 gen(count);
+        std::uniform_real_distribution<float> magnitudeDist(1.0f, 10.0f);
+        std::uniform_real_distribution<float> angleDist(0.0f, 6.28318530718f);
+        for (auto& vec : vectors)
+        {
+            float magnitude = magnitudeDist(gen);
+            float theta = angleDist(gen);    // azimuthal angle
+            float phi = angleDist(gen);      // polar angle
+
+            vec.x = magnitude * sinf(phi) * cosf(theta);
+            vec.y = magnitude * sinf(phi) * sinf(theta);
+            vec.z = magnitude * cosf(phi);
+        }
+        return vectors;
+    }
+
+    // Vectors the layout stores: AoSoA rounds up to whole blocks (the tail is zero).
+    inline uint64_t StoredVectors(VectorLayout layout, uint32_t count, uint32_t block)
+    {
+        return layout == VectorLayout::AoSoA ? (static_cast<uint64_t>(count) + block - 1) / block * block : count;
+    }
+
+    inline uint64_t StoredFloats(VectorLayout layout, uint32_t count, uint32_t block)
+    {
+        return StoredVectors(layout, count, block) * (layout == VectorLayout::PaddedAoS ? 4 : 3);
+    }
+
+#if VECTOR_LAYOUTS_SSE
+    // Four AoS vectors (three loads) to one register per component.
+    inline void Deinterleave4(const float* aos, __m128& x, __m128& y, __m128& z)
+    {
+        __m128 a = _mm_loadu_ps(aos);       // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps(aos + 4);   // y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps(aos + 8);   // z2 x3 y3 z3
+        x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+#endif
+
+    // Vectors [begin, end) into component streams x, y, z (vector i of the range to x[i - begin]).
+    inline void ToStreams(const Vector3D* aos, size_t begin, size_t end, float* x, float* y, float* z)
+    {
+        size_t i = begin;
+#if VECTOR_LAYOUTS_SSE
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 vx, vy, vz;
+            Deinterleave4(&aos[i].x, vx, vy, vz);
+            _mm_storeu_ps(x + i - begin, vx);
+            _mm_storeu_ps(y + i - begin, vy);
+            _mm_storeu_ps(z + i - begin, vz);
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            x[i - begin] = aos[i].x;
+            y[i - begin] = aos[i].y;
+            z[i - begin] = aos[i].z;
+        }
+    }
+
+    inline void ToPadded(const Vector3D* aos, size_t begin, size_t end, float* padded)
+    {
+        size_t i = begin;
+#if VECTOR_LAYOUTS_SSE
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 vx, vy, vz, vw = _mm_setzero_ps();
+            Deinterleave4(&aos[i].x, vx, vy, vz);
+            _MM_TRANSPOSE4_PS(vx, vy, vz, vw);
+            _mm_storeu_ps(padded + i * 4, vx);
+            _mm_storeu_ps(padded + i * 4 + 4, vy);
+            _mm_storeu_ps(padded + i * 4 + 8, vz);
+            _mm_storeu_ps(padded + i * 4 + 12, vw);
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            padded[i * 4 + 0] = aos[i].x;
+            padded[i * 4 + 1] = aos[i].y;
+            padded[i * 4 + 2] = aos[i].z;
+            padded[i * 4 + 3] = 0.0f;
+        }
+    }
+
+    // AoS -> `layout` as a flat float array of StoredFloats() entries. `block` is the AoSoA block
+    // size; threads split the vectors on block boundaries.
+    inline std::vector<float> Convert(const std::vector<Vector3D>& aos, VectorLayout layout, uint32_t block, uint32_t threads)
+    {
+        const uint32_t count = static_cast<uint32_t>(aos.size());
+        std::vector<float> out(StoredFloats(layout, count, block), 0.0f);
+        float* data = out.data();
+        switch (layout)
+        {
+        case VectorLayout::AoS:
+            ParallelFor(count, threads, [&](uint32_t, size_t begin, size_t end) {
+                std::copy(&aos[0].x + begin * 3, &aos[0].x + end * 3, data + begin * 3);
+            });
+            break;
+        case VectorLayout::PaddedAoS:
+            ParallelFor(count, threads, [&](uint32_t, size_t begin, size_t end) {
+                ToPadded(aos.data(), begin, end, data);
+            });
+            break;
+        case VectorLayout::SoA:
+            ParallelFor(count, threads, [&](uint32_t, size_t begin, size_t end) {
+                ToStreams(aos.data(), begin, end, data + begin, data + count + begin, data + 2 * static_cast<size_t>(count) + begin);
+            });
+            break;
+        default:
+            ParallelFor(count, threads, [&](uint32_t, size_t begin, size_t end) {
+                for (size_t first = begin; first < end; first += block)
+                {
+                    float* x = data + first * 3;
+                    ToStreams(aos.data(), first, (std::min)(first + block, end), x, x + block, x + 2 * block);
+                }
+            }, block);
+            break;
+        }
+        return out;
+    }
+
+    inline std::vector<float> Lengths(const std::vector<Vector3D>& aos)
+    {
+        std::vector<float> lengths(aos.size());
+        for (size_t i = 0; i < aos.size(); ++i)
+        {
+            double x = aos[i].x, y = aos[i].y, z = aos[i].z;
+            lengths[i] = static_cast<float>(std::sqrt(x * x + y * y + z * z));
+        }
+        return lengths;
+    }
+}
@@ -0,0 +1,143 @@
+#include "d3dAppSimplified.h"
+#include "TextureCopy.h"
+#include "DataPatterns.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	ImageStorage   storage   = ImageStorage::TiledTexture;
+	ReadMode       read      = ReadMode::LoadRead;
+	TexelFormat    format    = TexelFormat::TexelR8G8B8A8Unorm;
+	ImageOperation operation = ImageOperation::CopyImage;
+	int            width     = 4096;
+	int            height    = 4096;
+	int            validate  = 1;
+	DataPattern    pattern   = DataPattern::RandomPattern;
+	std::wstring   capturePath;
+
+	// Usage: program.exe <storage> <read> <format> <operation> <width> <height> <validate> <pattern> <capturePath>
+	// storage: 0=Buffer, 1=Texture UNKNOWN layout, 2=Texture ROW_MAJOR, 3=Texture 64KB_STANDARD_SWIZZLE
+	// read: 0=Load, 1=SampleLevel point, 2=SampleLevel bilinear (textures only)
+	// format: 0=R8_UNORM, 1=R8G8B8A8_UNORM, 2=R32_FLOAT, 3=R16G16B16A16_FLOAT, 4=R32G32B32A32_FLOAT
+	// operation: 0=Copy, 1=Transpose
+	// pattern: 0=Zero, 1=Constant, 2=Gradient, 3=LowEntropy, 4=Random, 5=Captured (raw float32 file at capturePath)
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			storage = static_cast<ImageStorage>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			read = static_cast<ReadMode>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			format = static_cast<TexelFormat>(_wtoi(argv[3]));
+		}
+		if (argc >= 5)
+		{
+			operation = static_cast<ImageOperation>(_wtoi(argv[4]));
+		}
+		if (argc >= 6)
+		{
+			width = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			height = _wtoi(argv[6]);
+		}
+		if (argc >= 8)
+		{
+			validate = _wtoi(argv[7]);
+		}
+		if (argc >= 9)
+		{
+			pattern = static_cast<DataPattern>(_wtoi(argv[8]));
+		}
+		if (argc >= 10)
+		{
+			capturePath = argv[9];
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: storage=%d, read=%d, format=%d, operation=%d, width=%d, height=%d, validate=%d, pattern=%d\n",
+			static_cast<int>(storage), static_cast<int>(read), static_cast<int>(format), static_cast<int>(operation), width, height, validate,
+			static_cast<int>(pattern));
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (storage >= ImageStorage::ImageStorageCount || read >= ReadMode::ReadModeCount ||
+		format >= TexelFormat::TexelFormatCount || operation >= ImageOperation::ImageOperationCount)
+	{
+		OutputDebugStringA("ERROR: Unknown storage, read mode, format or operation!\n");
+		return 1;
+	}
+	// 16384 is the Texture2D dimension limit; 2^27 texels is the typed buffer view limit.
+	if (width <= 0 || height <= 0 || width > 16384 || height > 16384 || static_cast<int64_t>(width) * height > (1 << 27))
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	std::vector<float> captured;
+	if (pattern >= DataPattern::DataPatternCount ||
+		(pattern == DataPattern::CapturedPattern && !DataPatterns::LoadCaptured(capturePath, captured)))
+	{
+		OutputDebugStringA("ERROR: Unknown data pattern or unreadable capture file!\n");
+		return 1;
+	}
+
+	TextureCopy test(hInstance, storage, read, format, operation, static_cast<uint32_t>(width), static_cast<uint32_t>(height), pattern, captured);
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Storage/read/format combination not supported on this device!\n");
+		return 1;
+	}
+
+	uint64_t mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(validate != 0, [&]() {
+		mismatches = validate != 0 ? test.Validate() : 0;
+	});
+	double gpuGBs     = 2.0 * test.ImageBytes() / gpuSeconds / 1e9;
+	double texelsPerSecond = static_cast<double>(width) * height / gpuSeconds;
+
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << ImageOperationName(operation) << " " << width << "x" << height << " " << TexelFormatName(format) << " (" << test.BytesPerTexel()
+		<< " bytes) Storage: " << ImageStorageName(storage) << " Read: " << ReadModeName(read)
+		<< " Pattern: " << DataPatternName(pattern) << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gpuGBs << " GB/s, " << texelsPerSecond / 1e9 << " G texels/s)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("texture_copy_results.csv", "Operation,Storage,Read,Format,BytesPerTexel,Width,Height,Gpu_s,Gpu_GBs,GTexels_s,Validated,Mismatches,Pattern", QueryDeviceCaps(test.Device()).Describe());
+	csv.Row(ImageOperationName(operation), ImageStorageName(storage), ReadModeName(read), TexelFormatName(format), test.BytesPerTexel(),
+		width, height, gpuSeconds, gpuGBs, texelsPerSecond / 1e9, validate, mismatches, DataPatternName(pattern));
+    return mismatches == 0 ? 0 : 1;
+}
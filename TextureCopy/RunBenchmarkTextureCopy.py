@@ -0,0 +1,174 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+STORAGES = {
+    0: "Buffer",
+    1: "TextureUnknown",
+    2: "TextureRowMajor",
+    3: "TextureStdSwizzle64KB",
+}
+
+READS = {
+    0: "Load",
+    1: "SamplePoint",
+    2: "SampleBilinear",
+}
+
+FORMATS = {
+    0: "R8_UNORM",
+    1: "R8G8B8A8_UNORM",
+    2: "R32_FLOAT",
+    3: "R16G16B16A16_FLOAT",
+    4: "R32G32B32A32_FLOAT",
+}
+
+OPERATIONS = {
+    0: "Copy",
+    1: "Transpose",
+}
+
+PATTERNS = {
+    0: "Zero",
+    1: "Constant",
+    2: "Gradient",
+    3: "LowEntropy",
+    4: "Random",
+    5: "Captured",
+}
+
+def run_program(program, args, tryCount):
+    for i in range(tryCount):
+        time.sleep(0.01)
+        try:
+            # Validate the first run of each configuration only.
+            result = subprocess.run([program] + [str(a) for a in args[:6]] + ["1" if i == 0 else "0"] + [str(a) for a in args[6:]],
+                                    capture_output=True, text=True)
+            if result.returncode != 0:
+                print(f"  Run {i+1}: failed, unsupported or mismatched (exit {result.returncode})")
+            else:
+                print(f"  Run {i+1}: {result.stdout.strip()}")
+        except Exception as e:
+            print(f"  Run {i+1}: Error - {e}")
+
+def run_simple_test(width = 4096, height = 4096, tryCount = 3):
+    """Runs copy and transpose for every storage, read mode and format"""
+
+    program = "..\\x64\\Release\\TextureCopy.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "texture_copy_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for operation in OPERATIONS:
+        for format in FORMATS:
+            for storage in STORAGES:
+                # Buffers are only read with Load.
+                for read in (READS if storage != 0 else [0]):
+                    print(f"\nRunning {OPERATIONS[operation]} {FORMATS[format]} {STORAGES[storage]} {READS[read]}...")
+                    run_program(program, [storage, read, format, operation, width, height, 4], tryCount)
+
+def run_pattern_test(width = 4096, height = 4096, tryCount = 3, capturePath = None):
+    """Copies compressible and incompressible data through buffers and UNKNOWN-layout textures (Load),
+    appending to the results of run_simple_test"""
+
+    program = "..\\x64\\Release\\TextureCopy.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    patterns = [0, 1, 2, 3, 4] + ([5] if capturePath is not None else [])
+    for pattern in patterns:
+        # R8G8B8A8_UNORM and R16G16B16A16_FLOAT are the usual colour-compressed UAV/render-target formats.
+        for format in [1, 3]:
+            for storage in [0, 1]:
+                print(f"\nRunning {FORMATS[format]} {STORAGES[storage]} {PATTERNS[pattern]}...")
+                run_program(program, [storage, 0, format, 0, width, height, pattern, capturePath if capturePath is not None else ""], tryCount)
+
+def plot_texture_copy_results(filename):
+    results = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            if parts[12] != "Random":
+                continue
+            key = (parts[0], parts[3])
+            results.setdefault(key, {}).setdefault(f"{parts[1]} {parts[2]}", []).append(float(parts[8]))
+
+    variants = [f"{s} {r}" for s in STORAGES.values() for r in READS.values() if s != "Buffer" or r == "Load"]
+    fig, axes = plt.subplots(2, len(OPERATIONS), figsize=(15, 9), sharey='row')
+    for col, operation in enumerate(OPERATIONS.values()):
+        formats = [f for f in FORMATS.values() if (operation, f) in results]
+        width = 0.8 / len(variants)
+        ax = axes[0][col]
+        for v, variant in enumerate(variants):
+            values = [max(results[(operation, f)].get(variant, [0.0])) for f in formats]
+            ax.bar([i + v * width for i in range(len(formats))], values, width=width, label=variant)
+        ax.set_xticks([i + 0.4 for i in range(len(formats))])
+        ax.set_xticklabels(formats, rotation=45, ha='right', fontsize=7)
+        ax.set_title(f"{operation} bandwidth")
+        ax.set_ylabel('GB/s')
+        ax.grid(True, axis='y')
+
+        # Texture bandwidth relative to the row-major buffer baseline of the same format.
+        ax = axes[1][col]
+        textureVariants = [v for v in variants if not v.startswith("Buffer")]
+        width = 0.8 / len(textureVariants)
+        for v, variant in enumerate(textureVariants):
+            values = []
+            for f in formats:
+                baseline = max(results[(operation, f)].get("Buffer Load", [0.0]))
+                value = max(results[(operation, f)].get(variant, [0.0]))
+                values.append(value / baseline if baseline > 0 else 0.0)
+            ax.bar([i + v * width for i in range(len(formats))], values, width=width, label=variant)
+        ax.axhline(1.0, color='black', linewidth=0.8)
+        ax.set_xticks([i + 0.4 for i in range(len(formats))])
+        ax.set_xticklabels(formats, rotation=45, ha='right', fontsize=7)
+        ax.set_title(f"{operation}: texture / buffer")
+        ax.set_ylabel('Ratio')
+        ax.grid(True, axis='y')
+    axes[0][0].legend(fontsize=6)
+    axes[1][0].legend(fontsize=6)
+    plt.suptitle('Texture vs Buffer Copy and Transpose')
+    plt.tight_layout()
+    plt.savefig('TextureCopy.pdf')   # PDF format
+    plt.show()
+
+def plot_pattern_results(filename):
+    results = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            if parts[0] != "Copy" or parts[2] != "Load" or parts[1] not in ("Buffer", "TextureUnknown") or \
+               parts[3] not in ("R8G8B8A8_UNORM", "R16G16B16A16_FLOAT"):
+                continue
+            key = f"{parts[3]} {parts[1]}"
+            results.setdefault(key, {}).setdefault(parts[12], []).append(float(parts[8]))
+
+    patterns = [p for p in PATTERNS.values() if any(p in r for r in results.values())]
+    width = 0.8 / max(1, len(results))
+    for v, (key, values) in enumerate(sorted(results.items())):
+        plt.bar([i + v * width for i in range(len(patterns))], [max(values.get(p, [0.0])) for p in patterns], width=width, label=key)
+    plt.xticks([i + 0.4 for i in range(len(patterns))], patterns)
+    plt.ylabel('GB/s (nominal bytes)')
+    plt.title('Copy Bandwidth by Data Pattern')
+    plt.legend(fontsize=7)
+    plt.grid(True, axis='y')
+    plt.savefig('TextureCopyPatterns.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    run_pattern_test()
+    plot_texture_copy_results("texture_copy_results.csv")
+    plot_pattern_results("texture_copy_results.csv")
@@ -0,0 +1,70 @@
+// Image copy or transpose with the image in a typed buffer (row-major, the baseline) or in a
+// Texture2D (whatever layout the resource was created with). Compiled with DXC (cs_6_0); variants
+// are selected by defines:
+//   RESOURCE    0=Buffer<T> / RWBuffer<T> indexed y * Width + x, 1=Texture2D<T> / RWTexture2D<T>
+//   READ        0=Load, 1=SampleLevel with a point sampler, 2=SampleLevel with a bilinear sampler
+//               (textures only; sampled at texel centres, so all three read the same values)
+//   TRANSPOSE   0=Out(x, y) = In(x, y), 1=Out(x, y) = In(y, x)
+//   COMPONENTS  1 or 4, the shader-side type of the format
+//
+// One thread per destination texel in 8x8 groups, like the buffer TransposeCopy but in 2D.
+
+#define TEXEL vector<float, COMPONENTS>
+
+#if RESOURCE == 0
+Buffer<TEXEL>      Input  : register(t0);
+RWBuffer<TEXEL>    Output : register(u0);
+#else
+Texture2D<TEXEL>   Input  : register(t0);
+RWTexture2D<TEXEL> Output : register(u0);
+SamplerState       PointClamp  : register(s0);
+SamplerState       LinearClamp : register(s1);
+#endif
+
+cbuffer params : register(b0)
+{
+    uint SrcWidth;
+    uint SrcHeight;
+    uint DstWidth;
+    uint DstHeight;
+}
+
+static const uint TileSize = 8;
+
+TEXEL Read(uint x, uint y)
+{
+#if RESOURCE == 0
+    return Input[y * SrcWidth + x];
+#elif READ == 0
+    return Input.Load(int3(x, y, 0));
+#else
+    float2 uv = float2((x + 0.5f) / SrcWidth, (y + 0.5f) / SrcHeight);
+#if READ == 1
+    return Input.SampleLevel(PointClamp, uv, 0);
+#else
+    return Input.SampleLevel(LinearClamp, uv, 0);
+#endif
+#endif
+}
+
+[numthreads(TileSize, TileSize, 1)]
+void main(uint3 dispatchId : SV_DispatchThreadID)
+{
+    uint x = dispatchId.x;
+    uint y = dispatchId.y;
+    if (x >= DstWidth || y >= DstHeight)
+    {
+        return;
+    }
+#if TRANSPOSE
+    TEXEL value = Read(y, x);
+#else
+    TEXEL value = Read(x, y);
+#endif
+
+#if RESOURCE == 0
+    Output[y * DstWidth + x] = value;
+#else
+    Output[uint2(x, y)] = value;
+#endif
+}
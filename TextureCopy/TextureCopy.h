@@ -0,0 +1,402 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "DataPatterns.h"
+#include <DirectXPackedVector.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+
+enum ImageStorage : uint32_t {
+    BufferStorage          = 0,   // typed buffer, row-major: the TransposeCopy-style baseline
+    TiledTexture           = 1,   // Texture2D, D3D12_TEXTURE_LAYOUT_UNKNOWN (driver swizzle)
+    RowMajorTexture        = 2,   // Texture2D, D3D12_TEXTURE_LAYOUT_ROW_MAJOR (cross-adapter heap)
+    StandardSwizzleTexture = 3,   // Texture2D, D3D12_TEXTURE_LAYOUT_64KB_STANDARD_SWIZZLE
+    ImageStorageCount
+};
+
+enum ReadMode : uint32_t {
+    LoadRead     = 0,
+    PointSample  = 1,
+    BilinearSample = 2,
+    ReadModeCount
+};
+
+enum TexelFormat : uint32_t {
+    TexelR8Unorm          = 0,
+    TexelR8G8B8A8Unorm    = 1,
+    TexelR32Float         = 2,
+    TexelR16G16B16A16Float = 3,
+    TexelR32G32B32A32Float = 4,
+    TexelFormatCount
+};
+
+enum ImageOperation : uint32_t {
+    CopyImage      = 0,
+    TransposeImage = 1,
+    ImageOperationCount
+};
+
+inline const char* ImageStorageName(ImageStorage storage)
+{
+    switch (storage)
+    {
+    case ImageStorage::BufferStorage:          return "Buffer";
+    case ImageStorage::TiledTexture:           return "TextureUnknown";
+    case ImageStorage::RowMajorTexture:        return "TextureRowMajor";
+    case ImageStorage::StandardSwizzleTexture: return "TextureStdSwizzle64KB";
+    default:                                   return "Unknown";
+    }
+}
+
+inline const char* ReadModeName(ReadMode mode)
+{
+    switch (mode)
+    {
+    case ReadMode::LoadRead:       return "Load";
+    case ReadMode::PointSample:    return "SamplePoint";
+    case ReadMode::BilinearSample: return "SampleBilinear";
+    default:                       return "Unknown";
+    }
+}
+
+inline const char* TexelFormatName(TexelFormat format)
+{
+    switch (format)
+    {
+    case TexelFormat::TexelR8Unorm:           return "R8_UNORM";
+    case TexelFormat::TexelR8G8B8A8Unorm:     return "R8G8B8A8_UNORM";
+    case TexelFormat::TexelR32Float:          return "R32_FLOAT";
+    case TexelFormat::TexelR16G16B16A16Float: return "R16G16B16A16_FLOAT";
+    case TexelFormat::TexelR32G32B32A32Float: return "R32G32B32A32_FLOAT";
+    default:                                  return "Unknown";
+    }
+}
+
+inline const char* ImageOperationName(ImageOperation operation)
+{
+    return operation == ImageOperation::TransposeImage ? "Transpose" : "Copy";
+}
+
+// Copies or transposes a width x height image (Shaders/TextureCopy.hlsl) held either in typed
+// buffers or in Texture2D resources of a chosen D3D12_TEXTURE_LAYOUT; source and destination use
+// the same storage. Every path reads exactly the values it writes (loads, point samples and
+// bilinear samples at texel centres), so the result is checked byte for byte.
+class TextureCopy : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t SrcWidth;
+		uint32_t SrcHeight;
+		uint32_t DstWidth;
+		uint32_t DstHeight;
+	};
+
+    static const uint32_t TileSize = 8;
+
+    TextureCopy(HINSTANCE hInstance, ImageStorage storage, ReadMode read, TexelFormat format, ImageOperation operation, uint32_t width, uint32_t height,
+		DataPattern pattern = DataPattern::RandomPattern, const std::vector<float>& captured = std::vector<float>()) :
+		D3DAppSimplified(hInstance),
+		m_storage(storage),
+		m_read(read),
+		m_format(format),
+		m_operation(operation),
+		m_width(width),
+		m_height(height),
+		m_pattern(pattern)
+	{
+		mHostImage = MakeImage(captured);
+    }
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+		if (!m_supported)
+		{
+			return;
+		}
+
+		D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+		heapDesc.NumDescriptors = 2;
+		heapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		heapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+		AssertIfFailed(Device()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&mDescriptorHeap)));
+		CD3DX12_CPU_DESCRIPTOR_HANDLE srvHandle(mDescriptorHeap->GetCPUDescriptorHandleForHeapStart(), 0, DescriptorSize());
+		CD3DX12_CPU_DESCRIPTOR_HANDLE uavHandle(mDescriptorHeap->GetCPUDescriptorHandleForHeapStart(), 1, DescriptorSize());
+
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.Format                  = DxgiFormat();
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = DxgiFormat();
+
+		if (m_storage == ImageStorage::BufferStorage)
+		{
+			mInput  = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), mHostImage.data(), ImageBytes());
+			mOutput = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, ImageBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+			srvDesc.ViewDimension      = D3D12_SRV_DIMENSION_BUFFER;
+			srvDesc.Buffer.NumElements = m_width * m_height;
+			uavDesc.ViewDimension      = D3D12_UAV_DIMENSION_BUFFER;
+			uavDesc.Buffer.NumElements = m_width * m_height;
+			mReadbackPitch = DstWidth() * BytesPerTexel();
+			mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, ImageBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+		}
+		else
+		{
+			D3D12_RESOURCE_FLAGS crossAdapter = m_storage == ImageStorage::RowMajorTexture ? D3D12_RESOURCE_FLAG_ALLOW_CROSS_ADAPTER : D3D12_RESOURCE_FLAG_NONE;
+			D3D12_HEAP_FLAGS     heapFlags    = m_storage == ImageStorage::RowMajorTexture ?
+				D3D12_HEAP_FLAG_SHARED | D3D12_HEAP_FLAG_SHARED_CROSS_ADAPTER : D3D12_HEAP_FLAG_NONE;
+			mInput = D3DUtil::CreateDefaultTexture2D(Device(), GraphicsCommandList(), mHostImage.data(), m_width, m_height, DxgiFormat(),
+				BytesPerTexel(), crossAdapter, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, Layout(), heapFlags);
+
+			D3D12_HEAP_PROPERTIES defaultHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+			D3D12_RESOURCE_DESC   outputDesc  = CD3DX12_RESOURCE_DESC::Tex2D(DxgiFormat(), DstWidth(), DstHeight(), 1, 1, 1, 0,
+				D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS | crossAdapter, Layout());
+			AssertIfFailed(Device()->CreateCommittedResource(&defaultHeap, heapFlags, &outputDesc,
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&mOutput)));
+			srvDesc.ViewDimension       = D3D12_SRV_DIMENSION_TEXTURE2D;
+			srvDesc.Texture2D.MipLevels = 1;
+			uavDesc.ViewDimension       = D3D12_UAV_DIMENSION_TEXTURE2D;
+
+			UINT64 readbackBytes = 0;
+			Device()->GetCopyableFootprints(&outputDesc, 0, 1, 0, &mFootprint, nullptr, nullptr, &readbackBytes);
+			mReadbackPitch  = mFootprint.Footprint.RowPitch;
+			mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, readbackBytes, D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+		}
+		Device()->CreateShaderResourceView(mInput.Get(), &srvDesc, srvHandle);
+		Device()->CreateUnorderedAccessView(mOutput.Get(), nullptr, &uavDesc, uavHandle);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		mShader = D3DUtil::CompileShaderDxc(L"Shaders\\TextureCopy.hlsl", {
+			L"RESOURCE=" + std::to_wstring(m_storage == ImageStorage::BufferStorage ? 0 : 1),
+			L"READ=" + std::to_wstring(static_cast<uint32_t>(m_read)),
+			L"TRANSPOSE=" + std::to_wstring(m_operation == ImageOperation::TransposeImage ? 1 : 0),
+			L"COMPONENTS=" + std::to_wstring(Components())
+		}, L"main", L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_DESCRIPTOR_RANGE srvRange;
+		srvRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+		CD3DX12_DESCRIPTOR_RANGE uavRange;
+		uavRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 1, 0);
+
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsDescriptorTable(1, &srvRange);
+		slotRootParameter[2].InitAsDescriptorTable(1, &uavRange);
+
+		CD3DX12_STATIC_SAMPLER_DESC samplers[2] = {
+			CD3DX12_STATIC_SAMPLER_DESC(0, D3D12_FILTER_MIN_MAG_MIP_POINT, D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+				D3D12_TEXTURE_ADDRESS_MODE_CLAMP, D3D12_TEXTURE_ADDRESS_MODE_CLAMP),
+			CD3DX12_STATIC_SAMPLER_DESC(1, D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP,
+				D3D12_TEXTURE_ADDRESS_MODE_CLAMP, D3D12_TEXTURE_ADDRESS_MODE_CLAMP)
+		};
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 2, samplers, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShader.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		RootConstants constants = { m_width, m_height, DstWidth(), DstHeight() };
+
+		ID3D12DescriptorHeap* heaps[] = { mDescriptorHeap.Get() };
+		commandList->SetDescriptorHeaps(_countof(heaps), heaps);
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootDescriptorTable(1, CD3DX12_GPU_DESCRIPTOR_HANDLE(mDescriptorHeap->GetGPUDescriptorHandleForHeapStart(), 0, DescriptorSize()));
+		commandList->SetComputeRootDescriptorTable(2, CD3DX12_GPU_DESCRIPTOR_HANDLE(mDescriptorHeap->GetGPUDescriptorHandleForHeapStart(), 1, DescriptorSize()));
+		commandList->Dispatch(DivideRoundUp(DstWidth(), TileSize), DivideRoundUp(DstHeight(), TileSize), 1);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutput.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			if (m_storage == ImageStorage::BufferStorage)
+			{
+				commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutput.Get(), 0, ImageBytes());
+			}
+			else
+			{
+				CD3DX12_TEXTURE_COPY_LOCATION destination(mReadbackBuffer.Get(), mFootprint);
+				CD3DX12_TEXTURE_COPY_LOCATION source(mOutput.Get(), 0);
+				commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+				// Textures do not decay back to COMMON; later runs expect the UAV state.
+				barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutput.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+				commandList->ResourceBarrier(1, &barrier);
+			}
+		}
+    }
+
+	bool   Supported()     const { return m_supported; }
+	UINT   BytesPerTexel() const
+	{
+		switch (m_format)
+		{
+		case TexelFormat::TexelR8Unorm:           return 1;
+		case TexelFormat::TexelR16G16B16A16Float: return 8;
+		case TexelFormat::TexelR32G32B32A32Float: return 16;
+		default:                                  return 4;
+		}
+	}
+	UINT64 ImageBytes()    const { return static_cast<UINT64>(m_width) * m_height * BytesPerTexel(); }
+
+	// Destination texels that differ from the host copy/transpose of the input, from the last
+	// Dispatch() with SetCopyResults(true).
+	uint64_t Validate()
+	{
+		const UINT bpp = BytesPerTexel();
+		uint8_t* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(static_cast<UINT64>(mReadbackPitch) * DstHeight()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint64_t mismatches = 0;
+		for (uint32_t y = 0; y < DstHeight(); ++y)
+		{
+			for (uint32_t x = 0; x < DstWidth(); ++x)
+			{
+				uint32_t sx = m_operation == ImageOperation::TransposeImage ? y : x;
+				uint32_t sy = m_operation == ImageOperation::TransposeImage ? x : y;
+				const uint8_t* expected = &mHostImage[(static_cast<size_t>(sy) * m_width + sx) * bpp];
+				mismatches += memcmp(mapped + static_cast<size_t>(y) * mReadbackPitch + static_cast<size_t>(x) * bpp, expected, bpp) != 0 ? 1 : 0;
+			}
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	uint32_t DstWidth()  const { return m_operation == ImageOperation::TransposeImage ? m_height : m_width; }
+	uint32_t DstHeight() const { return m_operation == ImageOperation::TransposeImage ? m_width : m_height; }
+	uint32_t Components() const { return m_format == TexelFormat::TexelR8Unorm || m_format == TexelFormat::TexelR32Float ? 1 : 4; }
+	UINT     DescriptorSize() const { return Device()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV); }
+
+	DXGI_FORMAT DxgiFormat() const
+	{
+		switch (m_format)
+		{
+		case TexelFormat::TexelR8Unorm:           return DXGI_FORMAT_R8_UNORM;
+		case TexelFormat::TexelR8G8B8A8Unorm:     return DXGI_FORMAT_R8G8B8A8_UNORM;
+		case TexelFormat::TexelR32Float:          return DXGI_FORMAT_R32_FLOAT;
+		case TexelFormat::TexelR16G16B16A16Float: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+		default:                                  return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		}
+	}
+
+	D3D12_TEXTURE_LAYOUT Layout() const
+	{
+		switch (m_storage)
+		{
+		case ImageStorage::RowMajorTexture:        return D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+		case ImageStorage::StandardSwizzleTexture: return D3D12_TEXTURE_LAYOUT_64KB_STANDARD_SWIZZLE;
+		default:                                   return D3D12_TEXTURE_LAYOUT_UNKNOWN;
+		}
+	}
+
+	// The DataPattern laid out one value per component, encoded so that every texel survives a
+	// load/store round trip unchanged: UNORM takes the fractional part, floats are flushed to
+	// normal (or zero) values of the format.
+	std::vector<uint8_t> MakeImage(const std::vector<float>& captured) const
+	{
+		std::vector<float>   values = DataPatterns::MakeFloats(m_pattern, m_width * Components(), m_height, captured);
+		std::vector<uint8_t> image(static_cast<size_t>(ImageBytes()));
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			float value = std::isfinite(values[i]) ? values[i] : 0.0f;
+			switch (m_format)
+			{
+			case TexelFormat::TexelR8Unorm:
+			case TexelFormat::TexelR8G8B8A8Unorm:
+				image[i] = static_cast<uint8_t>((std::min)(255.0f, (value - std::floor(value)) * 255.0f + 0.5f));
+				break;
+			case TexelFormat::TexelR16G16B16A16Float:
+			{
+				value = std::fabs(value) < 6.103515625e-05f ? 0.0f : (std::max)(-65504.0f, (std::min)(65504.0f, value));
+				uint16_t half = DirectX::PackedVector::XMConvertFloatToHalf(value);
+				memcpy(&image[i * sizeof(half)], &half, sizeof(half));
+				break;
+			}
+			default:
+				value = std::fabs(value) < FLT_MIN ? 0.0f : value;
+				memcpy(&image[i * sizeof(value)], &value, sizeof(value));
+				break;
+			}
+		}
+		return image;
+	}
+
+	bool CheckSupport()
+	{
+		if (QueryHighestShaderModel(Device()) < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		if (m_storage == ImageStorage::BufferStorage && m_read != ReadMode::LoadRead)
+		{
+			OutputDebugStringA("Buffers can only be read with Load\n");
+			return false;
+		}
+
+		D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+		AssertIfFailed(Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)));
+		if ((m_storage == ImageStorage::RowMajorTexture && !options.CrossAdapterRowMajorTextureSupported) ||
+			(m_storage == ImageStorage::StandardSwizzleTexture && !options.StandardSwizzle64KBSupported))
+		{
+			OutputDebugStringA("Texture layout not supported\n");
+			return false;
+		}
+
+		D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = { DxgiFormat() };
+		AssertIfFailed(Device()->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &formatSupport, sizeof(formatSupport)));
+		UINT required1 = D3D12_FORMAT_SUPPORT1_SHADER_LOAD | D3D12_FORMAT_SUPPORT1_TYPED_UNORDERED_ACCESS_VIEW |
+			(m_storage == ImageStorage::BufferStorage ? D3D12_FORMAT_SUPPORT1_BUFFER : D3D12_FORMAT_SUPPORT1_TEXTURE2D) |
+			(m_read != ReadMode::LoadRead ? D3D12_FORMAT_SUPPORT1_SHADER_SAMPLE : 0);
+		if ((formatSupport.Support1 & required1) != required1 || (formatSupport.Support2 & D3D12_FORMAT_SUPPORT2_UAV_TYPED_STORE) == 0)
+		{
+			OutputDebugStringA("Format not supported for this storage/read mode\n");
+			return false;
+		}
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+	ComPtr<ID3D12DescriptorHeap> mDescriptorHeap;   // [0] input SRV, [1] output UAV
+
+	ComPtr<ID3D12Resource> mInput;
+	ComPtr<ID3D12Resource> mOutput;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT mFootprint = {};
+	UINT                               mReadbackPitch = 0;
+
+	std::vector<uint8_t> mHostImage;
+
+	ImageStorage   m_storage;
+	ReadMode       m_read;
+	TexelFormat    m_format;
+	ImageOperation m_operation;
+	uint32_t       m_width;
+	uint32_t       m_height;
+	DataPattern    m_pattern;
+	bool           m_supported = false;
+};
@@ -0,0 +1,69 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+MODES = {
+    0: "ComputeShader (DIRECT)",
+    1: "CopyBufferRegion (DIRECT)",
+    2: "CopyBufferRegion (COPY)",
+    3: "CopyTextureRegion (DIRECT)",
+    4: "CopyTextureRegion (COPY)",
+}
+
+def run_simple_test(tryCount = 4):
+    """Runs every transfer mode over a range of square sizes"""
+
+    program = "..\\x64\\Release\\TransferCopy.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "transfer_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for size in [256, 512, 1024, 2048, 4096, 8192]:
+        for mode in MODES:
+            print(f"\nRunning size {size} mode {MODES[mode]}...")
+            for i in range(tryCount):
+                time.sleep(0.01)
+                try:
+                    result = subprocess.run([
+                        program,
+                        str(size),
+                        str(size),
+                        str(mode)
+                    ], capture_output=True, text=True)
+                    print(f"  Run {i+1}: {result.stdout.strip()}")
+                except Exception as e:
+                    print(f"  Run {i+1}: Error - {e}")
+
+def plot_transfer_results(filename):
+    series = {}
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            mode = int(parts[2])
+            megabytes = int(parts[0]) * int(parts[1]) * 4 / (1024 * 1024)
+            series.setdefault(mode, ([], []))
+            series[mode][0].append(megabytes)
+            series[mode][1].append(float(parts[6]))
+
+    for mode, (size, bandwidth) in sorted(series.items()):
+        plt.plot(size, bandwidth, marker='o', linestyle='', label=MODES.get(mode, str(mode)))
+    plt.xscale('log', base=2)
+    plt.xlabel('Transfer Size (MB)')
+    plt.ylabel('Bandwidth (GB/s)')
+    plt.title('Copy Engine vs Compute Copy Bandwidth')
+    plt.legend()
+    plt.grid(True)
+    plt.savefig('TransferCopyBandwidth.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_transfer_results("transfer_results.csv")
@@ -0,0 +1,24 @@
+
+StructuredBuffer<float>   Input  : register(t0);
+RWStructuredBuffer<float> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint ElementCount;
+    uint DispatchThreads;   // total threads launched, used as the grid stride
+    uint Pad0;
+    uint Pad1;
+}
+
+static const uint NumThreads = 64;
+
+// Grid-stride linear copy. Same access pattern as LinearCopy.hlsl, but the dispatch is capped at
+// 65535 groups so large transfers stay within the X dimension limit.
+[numthreads(64 ,1 ,1)]
+void main(uint3 threadId : SV_GroupThreadID, uint groupId : SV_GroupID)
+{
+    for (uint id = groupId.x * NumThreads + threadId.x; id < ElementCount; id += DispatchThreads)
+    {
+        Output[id] = Input[id];
+    }
+}
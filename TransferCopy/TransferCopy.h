@@ -0,0 +1,251 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "CommandContext.h"
+#include "CpuTimer.h"
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+// The ways of moving the same block of data that we compare for large transfers.
+enum TransferMode : uint32_t {
+    ComputeShader           = 0,  // LinearCopy-style compute kernel on the DIRECT queue
+    CopyBufferRegionDirect  = 1,  // CopyBufferRegion on the DIRECT queue
+    CopyBufferRegionCopy    = 2,  // CopyBufferRegion on a dedicated COPY queue (DMA engine)
+    CopyTextureRegionDirect = 3,  // CopyTextureRegion of a 2D R32_FLOAT texture on the DIRECT queue
+    CopyTextureRegionCopy   = 4,  // CopyTextureRegion of a 2D R32_FLOAT texture on the COPY queue
+    TransferModeCount
+};
+
+inline const char* TransferModeName(TransferMode mode)
+{
+    switch (mode)
+    {
+    case TransferMode::ComputeShader:           return "ComputeShader";
+    case TransferMode::CopyBufferRegionDirect:  return "CopyBufferRegion";
+    case TransferMode::CopyBufferRegionCopy:    return "CopyBufferRegion";
+    case TransferMode::CopyTextureRegionDirect: return "CopyTextureRegion";
+    case TransferMode::CopyTextureRegionCopy:   return "CopyTextureRegion";
+    default:                                    return "Unknown";
+    }
+}
+
+inline bool UsesCopyQueue(TransferMode mode)
+{
+    return mode == TransferMode::CopyBufferRegionCopy || mode == TransferMode::CopyTextureRegionCopy;
+}
+
+class TransferCopy : public D3DAppSimplified
+{
+public:
+
+	struct ConstBuffer
+	{
+		uint32_t ElementCount;
+		uint32_t DispatchThreads;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t NumThreads = 64;
+
+    TransferCopy(HINSTANCE hInstance, uint32_t width, uint32_t height, TransferMode mode) :
+		D3DAppSimplified(hInstance),
+        m_width(width),
+		m_height(height),
+		m_mode(mode)
+	{
+    }
+
+    void BuildResourcesAndHeaps() override {
+        std::vector<float> inputData(ElementCount());
+        std::mt19937 gen(1234);
+        std::uniform_real_distribution<float> valueDist(-10.0f, 10.0f);
+		for (auto& value : inputData)
+		{
+			value = valueDist(gen);
+		}
+
+		// Buffers live in COMMON so that they can be implicitly promoted on either queue type and
+		// decay back to COMMON at the end of every ExecuteCommandLists. CreateDefaultBuffer leaves the
+		// source in GENERIC_READ, which the copy queue cannot use, so move it back to COMMON.
+        mSourceBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), inputData.data(), ByteSize());
+        mDestBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, ByteSize(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		auto toCommon = CD3DX12_RESOURCE_BARRIER::Transition(mSourceBuffer.Get(), D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_COMMON);
+		GraphicsCommandList()->ResourceBarrier(1, &toCommon);
+
+		uint32_t groups = (ElementCount() + NumThreads - 1) / NumThreads;
+		m_groups = groups < MaxGroupsX ? groups : MaxGroupsX;
+		ConstBuffer cb = { ElementCount(), m_groups * NumThreads, 0, 0 };
+        mConstBuffer = D3DUtil::CreateDefaultBuffer(Device(), GraphicsCommandList(), &cb, sizeof(cb));
+
+		BuildTextures(inputData);
+
+		mCopyContext.Initialize(Device(), D3D12_COMMAND_LIST_TYPE_COPY);
+		if (UsesCopyQueue(m_mode) && !mCopyContext.TimestampsSupported())
+		{
+			OutputDebugStringA("WARNING: falling back to CPU wall time for the COPY queue\n");
+		}
+	}
+
+    void BuildShadersAndInputLayout() override {
+		mShaders = D3DUtil::CompileShader(L"Shaders\\ComputeCopy.hlsl", nullptr, "main", "cs_5_0");
+	}
+
+    void BuildPSOs() override {
+		CD3DX12_ROOT_PARAMETER slotRootParameter[3];
+		slotRootParameter[0].InitAsConstantBufferView(0);
+		slotRootParameter[1].InitAsShaderResourceView(0);
+		slotRootParameter[2].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(3, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO           = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShaders.Get());
+    }
+
+	// Direct-queue variants are recorded here and timed by D3DAppSimplified::Dispatch.
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		switch (m_mode)
+		{
+		case TransferMode::ComputeShader:
+			commandList->SetComputeRootSignature(mRootSignature.Get());
+			commandList->SetPipelineState(mPSO.Get());
+			commandList->SetComputeRootConstantBufferView(0, mConstBuffer->GetGPUVirtualAddress());
+			commandList->SetComputeRootShaderResourceView(1, mSourceBuffer->GetGPUVirtualAddress());
+			commandList->SetComputeRootUnorderedAccessView(2, mDestBuffer->GetGPUVirtualAddress());
+			commandList->Dispatch(m_groups, 1, 1);
+			break;
+
+		case TransferMode::CopyBufferRegionDirect:
+			commandList->CopyBufferRegion(mDestBuffer.Get(), 0, mSourceBuffer.Get(), 0, ByteSize());
+			break;
+
+		case TransferMode::CopyTextureRegionDirect:
+			RecordTextureCopy(commandList);
+			break;
+
+		default:
+			break;
+		}
+    }
+
+	// Runs the configured transfer once and returns its duration in seconds.
+	double Run()
+	{
+		if (!UsesCopyQueue(m_mode))
+		{
+			Dispatch();
+			m_usedGpuTimestamps = true;
+			return GetDuration();
+		}
+
+		auto commandList = mCopyContext.CommandList();
+		mCopyContext.Reset();
+		mCopyContext.Timestamp(0);
+		if (m_mode == TransferMode::CopyBufferRegionCopy)
+		{
+			commandList->CopyBufferRegion(mDestBuffer.Get(), 0, mSourceBuffer.Get(), 0, ByteSize());
+		}
+		else
+		{
+			RecordTextureCopy(commandList);
+		}
+		mCopyContext.Timestamp(1);
+		mCopyContext.ResolveTimestamps(2);
+
+		CpuTimer timer;
+		timer.Start();
+		mCopyContext.SubmitAndFlush();
+		double wallTime = timer.Stop();
+
+		m_usedGpuTimestamps = mCopyContext.TimestampsSupported();
+		return m_usedGpuTimestamps ? mCopyContext.ElapsedSeconds(0, 1) : wallTime;
+	}
+
+	uint32_t ElementCount() const { return m_width * m_height; }
+	UINT64   ByteSize()     const { return static_cast<UINT64>(ElementCount()) * sizeof(float); }
+	bool     UsedGpuTimestamps() const { return m_usedGpuTimestamps; }
+
+private:
+
+	void BuildTextures(const std::vector<float>& inputData)
+	{
+		auto defaultHeap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+		auto uploadHeap  = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+		auto textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R32_FLOAT, m_width, m_height, 1, 1);
+
+		AssertIfFailed(Device()->CreateCommittedResource(
+			&defaultHeap,
+			D3D12_HEAP_FLAG_NONE,
+			&textureDesc,
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			nullptr,
+			IID_PPV_ARGS(&mSourceTexture)));
+
+		AssertIfFailed(Device()->CreateCommittedResource(
+			&defaultHeap,
+			D3D12_HEAP_FLAG_NONE,
+			&textureDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			IID_PPV_ARGS(&mDestTexture)));
+
+		UINT64 uploadSize = GetRequiredIntermediateSize(mSourceTexture.Get(), 0, 1);
+		auto uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(uploadSize);
+		AssertIfFailed(Device()->CreateCommittedResource(
+			&uploadHeap,
+			D3D12_HEAP_FLAG_NONE,
+			&uploadDesc,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(&mTextureUploadBuffer)));
+
+		D3D12_SUBRESOURCE_DATA subResourceData = {};
+		subResourceData.pData      = inputData.data();
+		subResourceData.RowPitch   = static_cast<LONG_PTR>(m_width) * sizeof(float);
+		subResourceData.SlicePitch = subResourceData.RowPitch * m_height;
+		UpdateSubresources<1>(GraphicsCommandList(), mSourceTexture.Get(), mTextureUploadBuffer.Get(), 0, 0, 1, &subResourceData);
+
+		auto toCommon = CD3DX12_RESOURCE_BARRIER::Transition(mSourceTexture.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_COMMON);
+		GraphicsCommandList()->ResourceBarrier(1, &toCommon);
+	}
+
+	// Both textures start in COMMON. The source is promoted to COPY_SOURCE (read-only, decays on its
+	// own); the destination is promoted to COPY_DEST and on the DIRECT queue has to be returned to
+	// COMMON explicitly, while the COPY queue decays it at the end of ExecuteCommandLists.
+	void RecordTextureCopy(ID3D12GraphicsCommandList* commandList)
+	{
+		CD3DX12_TEXTURE_COPY_LOCATION dst(mDestTexture.Get(), 0);
+		CD3DX12_TEXTURE_COPY_LOCATION src(mSourceTexture.Get(), 0);
+		commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+		if (commandList == GraphicsCommandList())
+		{
+			auto toCommon = CD3DX12_RESOURCE_BARRIER::Transition(mDestTexture.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_COMMON);
+			commandList->ResourceBarrier(1, &toCommon);
+		}
+	}
+
+public:
+
+    ComPtr<ID3DBlob> mShaders;
+
+    ComPtr<ID3D12Resource> mSourceBuffer;
+    ComPtr<ID3D12Resource> mDestBuffer;
+    ComPtr<ID3D12Resource> mConstBuffer;
+    ComPtr<ID3D12Resource> mSourceTexture;
+    ComPtr<ID3D12Resource> mDestTexture;
+    ComPtr<ID3D12Resource> mTextureUploadBuffer;
+
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	CommandContext mCopyContext;
+
+	uint32_t     m_width;
+	uint32_t     m_height;
+	uint32_t     m_groups = 1;
+	TransferMode m_mode;
+	bool         m_usedGpuTimestamps = false;
+};
@@ -0,0 +1,136 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+// Cross-lane operations of the WaveOps benchmark and the host emulation of the kernel loop
+// (Shaders/WaveOps.hlsl). Portable: lanes are threads t of a group with lane = t % waveSize, the
+// same mapping the LDS implementation uses and the wave implementation gets from the hardware.
+
+enum CrossLaneOp : uint32_t {
+    ReadLaneAtOp = 0,             // WaveReadLaneAt(v, i % lanes)
+    ActiveSumOp,                  // WaveActiveSum(v)
+    PrefixSumOp,                  // WavePrefixSum(v) (exclusive)
+    QuadReadAcrossXOp,            // QuadReadAcrossX(v): lane ^ 1
+    QuadReadAcrossYOp,            // QuadReadAcrossY(v): lane ^ 2
+    QuadReadAcrossDiagonalOp,     // QuadReadAcrossDiagonal(v): lane ^ 3
+    BallotOp,                     // WaveActiveBallot(v & 1), the mask words xor-ed together
+    CrossLaneOpCount
+};
+
+inline const char* CrossLaneOpName(CrossLaneOp op)
+{
+    switch (op)
+    {
+    case CrossLaneOp::ReadLaneAtOp:             return "ReadLaneAt";
+    case CrossLaneOp::ActiveSumOp:              return "ActiveSum";
+    case CrossLaneOp::PrefixSumOp:              return "PrefixSum";
+    case CrossLaneOp::QuadReadAcrossXOp:        return "QuadReadAcrossX";
+    case CrossLaneOp::QuadReadAcrossYOp:        return "QuadReadAcrossY";
+    case CrossLaneOp::QuadReadAcrossDiagonalOp: return "QuadReadAcrossDiagonal";
+    case CrossLaneOp::BallotOp:                 return "Ballot";
+    default:                                    return "Unknown";
+    }
+}
+
+enum CrossLaneImpl : uint32_t {
+    WaveImpl = 0,  // the wave intrinsic
+    LdsImpl,       // the same result through groupshared memory and group barriers
+    CrossLaneImplCount
+};
+
+inline const char* CrossLaneImplName(CrossLaneImpl impl)
+{
+    switch (impl)
+    {
+    case CrossLaneImpl::WaveImpl: return "Wave";
+    case CrossLaneImpl::LdsImpl:  return "LDS";
+    default:                      return "Unknown";
+    }
+}
+
+namespace CrossLaneOps
+{
+    // The per-iteration update every lane applies to its value after the operation.
+    inline uint32_t Next(uint32_t value, uint32_t result, uint32_t lane)
+    {
+        return (value ^ result) * 1664525u + 1013904223u + lane;
+    }
+
+    // Result of `op` for every lane of one wave in iteration `iteration`.
+    inline void Apply(CrossLaneOp op, const uint32_t* values, uint32_t* results, uint32_t lanes, uint32_t iteration)
+    {
+        switch (op)
+        {
+        case CrossLaneOp::ReadLaneAtOp:
+            std::fill(results, results + lanes, values[iteration & (lanes - 1)]);
+            break;
+        case CrossLaneOp::ActiveSumOp:
+        {
+            uint32_t sum = 0;
+            for (uint32_t l = 0; l < lanes; ++l)
+            {
+                sum += values[l];
+            }
+            std::fill(results, results + lanes, sum);
+            break;
+        }
+        case CrossLaneOp::PrefixSumOp:
+        {
+            uint32_t sum = 0;
+            for (uint32_t l = 0; l < lanes; ++l)
+            {
+                results[l] = sum;
+                sum += values[l];
+            }
+            break;
+        }
+        case CrossLaneOp::QuadReadAcrossXOp:
+        case CrossLaneOp::QuadReadAcrossYOp:
+        case CrossLaneOp::QuadReadAcrossDiagonalOp:
+        {
+            uint32_t mask = op == CrossLaneOp::QuadReadAcrossXOp ? 1u : op == CrossLaneOp::QuadReadAcrossYOp ? 2u : 3u;
+            for (uint32_t l = 0; l < lanes; ++l)
+            {
+                results[l] = values[l ^ mask];
+            }
+            break;
+        }
+        default:
+        {
+            uint32_t words[4] = { 0, 0, 0, 0 };
+            for (uint32_t l = 0; l < lanes; ++l)
+            {
+                words[l / 32] |= (values[l] & 1u) << (l % 32);
+            }
+            std::fill(results, results + lanes, words[0] ^ words[1] ^ words[2] ^ words[3]);
+            break;
+        }
+        }
+    }
+
+    // Final values of `threads` threads (a multiple of lanes, lanes a power of two from 4 to 128)
+    // after `iterations` iterations; thread t starts from t.
+    inline std::vector<uint32_t> Reference(CrossLaneOp op, uint32_t lanes, uint32_t threads, uint32_t iterations)
+    {
+        std::vector<uint32_t> values(threads);
+        std::vector<uint32_t> results(lanes);
+        for (uint32_t first = 0; first < threads; first += lanes)
+        {
+            uint32_t* wave = values.data() + first;
+            for (uint32_t l = 0; l < lanes; ++l)
+            {
+                wave[l] = first + l;
+            }
+            for (uint32_t i = 0; i < iterations; ++i)
+            {
+                Apply(op, wave, results.data(), lanes, i);
+                for (uint32_t l = 0; l < lanes; ++l)
+                {
+                    wave[l] = Next(wave[l], results[l], l);
+                }
+            }
+        }
+        return values;
+    }
+}
@@ -0,0 +1,118 @@
+#include "d3dAppSimplified.h"
+#include "WaveOps.h"
+#include "CrossLaneOps.h"
+#include "FeatureSupport.h"
+#include "ResultsCsv.h"
+#include <iostream>
+#include <sstream>
+#include <d3dUtil.h>
+#include <cstdlib>
+
+int WINAPI WinMain(
+    _In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPSTR lpCmdLine,
+    _In_ int nCmdShow
+)
+{
+	CrossLaneOp   op         = CrossLaneOp::ActiveSumOp;
+	CrossLaneImpl impl       = CrossLaneImpl::WaveImpl;
+	int           waveSize   = 0;
+	int           groups     = 4096;
+	int           iterations = 256;
+	int           validate   = 1;
+
+	// Usage: program.exe <op> <impl> <waveSize> <groups> <iterations> <validate>
+	// op: 0=ReadLaneAt, 1=ActiveSum, 2=PrefixSum, 3=QuadReadAcrossX, 4=QuadReadAcrossY, 5=QuadReadAcrossDiagonal, 6=Ballot
+	// impl: 0=Wave intrinsic, 1=LDS equivalent
+	// waveSize: 0 = driver's choice (LDS: narrowest device wave), else 4..128 ([WaveSize] for the wave intrinsic, SM 6.6)
+	int argc;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+
+	if (argv)
+	{
+		if (argc >= 2)
+		{
+			op = static_cast<CrossLaneOp>(_wtoi(argv[1]));
+		}
+		if (argc >= 3)
+		{
+			impl = static_cast<CrossLaneImpl>(_wtoi(argv[2]));
+		}
+		if (argc >= 4)
+		{
+			waveSize = _wtoi(argv[3]);
+		}
+		if (argc >= 5)
+		{
+			groups = _wtoi(argv[4]);
+		}
+		if (argc >= 6)
+		{
+			iterations = _wtoi(argv[5]);
+		}
+		if (argc >= 7)
+		{
+			validate = _wtoi(argv[6]);
+		}
+
+		wchar_t buffer[512];
+		swprintf_s(buffer, L"Params: op=%d, impl=%d, waveSize=%d, groups=%d, iterations=%d, validate=%d\n",
+			static_cast<int>(op), static_cast<int>(impl), waveSize, groups, iterations, validate);
+		OutputDebugStringW(buffer);
+
+		LocalFree(argv);
+	}
+	else
+	{
+		OutputDebugStringA("Failed to parse command line, using defaults\n");
+	}
+
+	if (op >= CrossLaneOp::CrossLaneOpCount || impl >= CrossLaneImpl::CrossLaneImplCount)
+	{
+		OutputDebugStringA("ERROR: Unknown op or implementation!\n");
+		return 1;
+	}
+	if ((waveSize != 0 && (waveSize < 4 || waveSize > 128 || (waveSize & (waveSize - 1)) != 0)) || groups <= 0 || groups > 65535 || iterations <= 0)
+	{
+		OutputDebugStringA("ERROR: Invalid parameters!\n");
+		return 1;
+	}
+
+	WaveOps test(hInstance, op, impl, static_cast<uint32_t>(waveSize), static_cast<uint32_t>(groups), static_cast<uint32_t>(iterations));
+	test.Initialize();
+
+	if (!test.Supported())
+	{
+		OutputDebugStringA("ERROR: Op/implementation/wave size not supported on this device!\n");
+		return 1;
+	}
+
+	// The warm-up run always copies the output back: it carries the probed lane count.
+	uint32_t lanes      = 0;
+	uint32_t mismatches = 0;
+	double gpuSeconds = test.RunWarmedAndTimed(true, [&]() {
+		lanes      = test.ProbedLanes();
+		mismatches = validate != 0 ? test.Validate(lanes) : 0;
+	});
+	double gopsPerSecond = test.Operations() / gpuSeconds / 1e9;
+
+	std::string caps = test.Caps().Describe();
+	std::ostringstream debugOutput;
+	debugOutput << "**************************Summary**************************\n";
+	debugOutput << "Device caps: " << caps << "\n";
+	debugOutput << "Op: " << CrossLaneOpName(op) << " Impl: " << CrossLaneImplName(impl) << " Requested wave: " << waveSize
+		<< " Lanes: " << lanes << "\n";
+	debugOutput << "GPU: " << gpuSeconds << " seconds (" << gopsPerSecond << " G lane-ops/s)\n";
+	if (validate != 0)
+	{
+		debugOutput << "Validation: " << (mismatches == 0 ? "passed" : "FAILED") << " (" << mismatches << " mismatches)\n";
+	}
+	debugOutput << "**************************EndEnd**************************\n";
+	D3DUtil::PrintDebugString(debugOutput.str());
+
+	ResultsCsv csv("wave_ops_results.csv", "Device,Op,Impl,RequestedWaveSize,Lanes,Groups,Iterations,Gpu_s,GLaneOps_s,Validated,Mismatches", caps);
+	csv.Row(QueryAdapterKey(test.Device()), CrossLaneOpName(op), CrossLaneImplName(impl), waveSize, lanes, groups, iterations, gpuSeconds,
+		gopsPerSecond, validate, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+import subprocess
+import os
+import time
+import matplotlib.pyplot as plt
+
+OPS = {
+    0: "ReadLaneAt",
+    1: "ActiveSum",
+    2: "PrefixSum",
+    3: "QuadReadAcrossX",
+    4: "QuadReadAcrossY",
+    5: "QuadReadAcrossDiagonal",
+    6: "Ballot",
+}
+
+IMPLS = {
+    0: "Wave",
+    1: "LDS",
+}
+
+# 0 lets the driver choose; 32 and 64 force [WaveSize] and are skipped (exit 1) where unsupported.
+WAVE_SIZES = [0, 32, 64]
+
+def run_simple_test(tryCount = 3, groups = 4096, iterations = 256):
+    """Every op as the wave intrinsic and as its LDS equivalent, at every wave size"""
+
+    program = "..\\x64\\Release\\WaveOps.exe"
+
+    if not os.path.exists(program):
+        print(f"Error: {program} not found!")
+        return
+
+    csv_file = "wave_ops_results.csv"
+    if os.path.exists(csv_file):
+        os.remove(csv_file)
+
+    for waveSize in WAVE_SIZES:
+        for op in OPS:
+            for impl in IMPLS:
+                print(f"\nRunning {OPS[op]} {IMPLS[impl]} wave {waveSize}...")
+                for i in range(tryCount):
+                    time.sleep(0.01)
+                    try:
+                        result = subprocess.run([
+                            program,
+                            str(op),
+                            str(impl),
+                            str(waveSize),
+                            str(groups),
+                            str(iterations),
+                            # Validate the first run of each configuration only.
+                            "1" if i == 0 else "0"
+                        ], capture_output=True, text=True)
+                        if result.returncode != 0:
+                            print(f"  Run {i+1}: failed (exit {result.returncode})")
+                        else:
+                            print(f"  Run {i+1}: {result.stdout.strip()}")
+                    except Exception as e:
+                        print(f"  Run {i+1}: Error - {e}")
+
+def plot_wave_ops_results(filename):
+    results = {}
+    caps = set()
+    with open(filename, "r") as f:
+        # skip first line
+        f.readline()
+        for line in f.readlines():
+            parts = line.strip().split(',')
+            key = (int(parts[3]), parts[4], parts[1], parts[2])
+            results[key] = max(results.get(key, 0.0), float(parts[8]))
+            caps.add(parts[11])
+
+    configs = sorted(set((k[0], k[1]) for k in results))
+    fig, axes = plt.subplots(1, len(configs), figsize=(6 * len(configs), 5), squeeze=False)
+    for ax, (waveSize, lanes) in zip(axes[0], configs):
+        width = 0.4
+        for j, impl in enumerate(IMPLS.values()):
+            values = [results.get((waveSize, lanes, op, impl), 0.0) for op in OPS.values()]
+            ax.bar([x + (j - 0.5) * width for x in range(len(OPS))], values, width, label=impl)
+        ax.set_xticks(range(len(OPS)))
+        ax.set_xticklabels(OPS.values(), rotation=45, ha='right', fontsize=7)
+        ax.set_ylabel('G lane-ops/s')
+        ax.set_title(f"Requested wave {waveSize if waveSize else 'default'}, {lanes} lanes")
+        ax.grid(True, axis='y')
+        ax.legend(fontsize=7)
+    plt.suptitle('Cross-Lane Operations: Wave Intrinsics vs LDS\n' + ' | '.join(sorted(caps)), fontsize=9)
+    plt.tight_layout()
+    plt.savefig('WaveOps.pdf')   # PDF format
+    plt.show()
+
+if __name__ == "__main__":
+    run_simple_test()
+    plot_wave_ops_results("wave_ops_results.csv")
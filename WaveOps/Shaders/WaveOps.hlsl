@@ -0,0 +1,139 @@
+// Cross-lane operation loop: thread t starts from v = t and for Iterations iterations computes
+// r = OP(v) across its wave and updates v = (v ^ r) * 1664525 + 1013904223 + lane; Out[t] = v.
+// CrossLaneOps::Reference is the host emulation. Compiled with DXC; variants are selected by defines:
+//   OP         CrossLaneOp: 0=ReadLaneAt, 1=ActiveSum, 2=PrefixSum, 3..5=QuadReadAcrossX/Y/Diagonal, 6=Ballot
+//   IMPL       0=wave intrinsic, 1=groupshared memory + group barriers over segments of LANES threads
+//   LANES      lanes the LDS implementation emulates (power of two, 4..128)
+//   WAVE_SIZE  0=driver's choice, else [WaveSize(WAVE_SIZE)] (cs_6_6)
+//
+// Thread 0 of group 0 also writes the lane count the kernel ran with to Out[Threads].
+
+#define GROUP_SIZE 256
+
+RWStructuredBuffer<uint> Output : register(u0);
+
+cbuffer params : register(b0)
+{
+    uint Iterations;
+    uint Threads;  // groups * GROUP_SIZE
+    uint Pad0;
+    uint Pad1;
+}
+
+#if IMPL == 1
+
+static const uint MaskWords = LANES >= 32 ? LANES / 32 : 1;
+
+groupshared uint Lanes[GROUP_SIZE];
+groupshared uint Masks[GROUP_SIZE / LANES * MaskWords];
+
+uint CrossLane(uint v, uint tid, uint i)
+{
+    uint lane  = tid % LANES;
+    uint first = tid - lane;
+    uint r     = 0;
+#if OP == 6
+    uint words = tid / LANES * MaskWords;
+    if (lane < MaskWords)
+    {
+        Masks[words + lane] = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+    if ((v & 1) != 0)
+    {
+        InterlockedOr(Masks[words + lane / 32], 1u << (lane % 32));
+    }
+    GroupMemoryBarrierWithGroupSync();
+    [unroll]
+    for (uint w = 0; w < MaskWords; ++w)
+    {
+        r ^= Masks[words + w];
+    }
+#else
+    Lanes[tid] = v;
+    GroupMemoryBarrierWithGroupSync();
+#if OP == 0
+    r = Lanes[first + (i & (LANES - 1))];
+#elif OP == 1
+    // Tree reduction; the sum ends up in the segment's first entry.
+    [unroll]
+    for (uint s = LANES / 2; s > 0; s >>= 1)
+    {
+        if (lane < s)
+        {
+            Lanes[tid] += Lanes[tid + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+    r = Lanes[first];
+#elif OP == 2
+    // Inclusive Hillis-Steele scan, made exclusive by subtracting the lane's own value.
+    [unroll]
+    for (uint o = 1; o < LANES; o <<= 1)
+    {
+        uint x = lane >= o ? Lanes[tid - o] : 0;
+        GroupMemoryBarrierWithGroupSync();
+        Lanes[tid] += x;
+        GroupMemoryBarrierWithGroupSync();
+    }
+    r = Lanes[tid] - v;
+#else
+    r = Lanes[tid ^ (OP - 2)];
+#endif
+#endif
+    // The next iteration overwrites the entries the others may still be reading.
+    GroupMemoryBarrierWithGroupSync();
+    return r;
+}
+
+uint LaneIndex(uint tid) { return tid % LANES; }
+uint LaneCount()         { return LANES; }
+
+#else
+
+uint CrossLane(uint v, uint tid, uint i)
+{
+#if OP == 0
+    return WaveReadLaneAt(v, i & (WaveGetLaneCount() - 1));
+#elif OP == 1
+    return WaveActiveSum(v);
+#elif OP == 2
+    return WavePrefixSum(v);
+#elif OP == 3
+    return QuadReadAcrossX(v);
+#elif OP == 4
+    return QuadReadAcrossY(v);
+#elif OP == 5
+    return QuadReadAcrossDiagonal(v);
+#else
+    uint4 ballot = WaveActiveBallot((v & 1) != 0);
+    return ballot.x ^ ballot.y ^ ballot.z ^ ballot.w;
+#endif
+}
+
+uint LaneIndex(uint tid) { return WaveGetLaneIndex(); }
+uint LaneCount()         { return WaveGetLaneCount(); }
+
+#endif
+
+#if IMPL == 0 && WAVE_SIZE > 0
+[WaveSize(WAVE_SIZE)]
+#endif
+[numthreads(GROUP_SIZE, 1, 1)]
+void main(uint3 threadId : SV_GroupThreadID, uint3 groupId : SV_GroupID)
+{
+    uint t    = groupId.x * GROUP_SIZE + threadId.x;
+    uint lane = LaneIndex(threadId.x);
+    uint v    = t;
+    [loop]
+    for (uint i = 0; i < Iterations; ++i)
+    {
+        uint r = CrossLane(v, threadId.x, i);
+        v = (v ^ r) * 1664525u + 1013904223u + lane;
+    }
+    Output[t] = v;
+    if (t == 0)
+    {
+        Output[Threads] = LaneCount();
+    }
+}
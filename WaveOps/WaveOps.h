@@ -0,0 +1,174 @@
+#pragma once
+#include "d3dAppSimplified.h"
+#include "FeatureSupport.h"
+#include "CrossLaneOps.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Runs one cross-lane operation (Shaders/WaveOps.hlsl) either as the wave intrinsic or as its
+// groupshared-memory equivalent. The kernel also reports the lane count it ran with, which makes
+// every run a probe of the wave size the driver picked (or [WaveSize] forced).
+class WaveOps : public D3DAppSimplified
+{
+public:
+
+	struct RootConstants
+	{
+		uint32_t Iterations;
+		uint32_t Threads;
+		uint32_t Pad0;
+		uint32_t Pad1;
+	};
+
+    static const uint32_t NumThreads = 256;
+
+    WaveOps(HINSTANCE hInstance, CrossLaneOp op, CrossLaneImpl impl, uint32_t waveSize, uint32_t groups, uint32_t iterations) :
+		D3DAppSimplified(hInstance),
+		m_op(op),
+		m_impl(impl),
+		m_waveSize(waveSize),
+		m_groups(groups),
+		m_iterations(iterations)
+	{
+	}
+
+    void BuildResourcesAndHeaps() override {
+		m_supported = CheckSupport();
+
+		mOutputBuffer   = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_DEFAULT, OutputBytes(), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		mReadbackBuffer = D3DUtil::CreateBuffer(Device(), D3D12_HEAP_TYPE_READBACK, OutputBytes(), D3D12_RESOURCE_FLAG_NONE, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+
+    void BuildShadersAndInputLayout() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		// [WaveSize] is a shader model 6.6 attribute; everything else compiles as cs_6_0.
+		bool forced = m_impl == CrossLaneImpl::WaveImpl && m_waveSize != 0;
+		mShader = D3DUtil::CompileShaderDxc(L"Shaders\\WaveOps.hlsl", {
+			L"OP=" + std::to_wstring(static_cast<uint32_t>(m_op)),
+			L"IMPL=" + std::to_wstring(static_cast<uint32_t>(m_impl)),
+			L"LANES=" + std::to_wstring(m_lanes),
+			L"WAVE_SIZE=" + std::to_wstring(forced ? m_waveSize : 0)
+		}, L"main", forced ? L"cs_6_6" : L"cs_6_0");
+	}
+
+    void BuildPSOs() override {
+		if (!m_supported)
+		{
+			return;
+		}
+		CD3DX12_ROOT_PARAMETER slotRootParameter[2];
+		slotRootParameter[0].InitAsConstants(sizeof(RootConstants) / sizeof(uint32_t), 0);
+		slotRootParameter[1].InitAsUnorderedAccessView(0);
+
+		CD3DX12_ROOT_SIGNATURE_DESC rootSigDesc(2, slotRootParameter, 0, nullptr, D3D12_ROOT_SIGNATURE_FLAG_NONE);
+		mRootSignature = D3DUtil::CreateRootSignature(Device(), rootSigDesc);
+		mPSO = D3DUtil::CreateComputePSO(Device(), mRootSignature.Get(), mShader.Get());
+    }
+
+    void DoAction() override {
+		auto commandList = GraphicsCommandList();
+		RootConstants constants = { m_iterations, Threads(), 0, 0 };
+
+		commandList->SetComputeRootSignature(mRootSignature.Get());
+		commandList->SetPipelineState(mPSO.Get());
+		commandList->SetComputeRoot32BitConstants(0, sizeof(RootConstants) / sizeof(uint32_t), &constants, 0);
+		commandList->SetComputeRootUnorderedAccessView(1, mOutputBuffer->GetGPUVirtualAddress());
+		// Main keeps the group count within the 65535 limit of one dimension.
+		commandList->Dispatch(m_groups, 1, 1);
+
+		if (CopyResults())
+		{
+			D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(mOutputBuffer.Get(),
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &barrier);
+			commandList->CopyBufferRegion(mReadbackBuffer.Get(), 0, mOutputBuffer.Get(), 0, OutputBytes());
+		}
+    }
+
+	bool     Supported()   const { return m_supported; }
+	const DeviceCaps& Caps() const { return m_caps; }
+	uint32_t Threads()     const { return m_groups * NumThreads; }
+	UINT64   OutputBytes() const { return (static_cast<UINT64>(Threads()) + 1) * sizeof(uint32_t); }
+	double   Operations()  const { return static_cast<double>(Threads()) * m_iterations; }
+
+	// Lane count the kernel reported in the last Dispatch() with SetCopyResults(true).
+	uint32_t ProbedLanes()
+	{
+		uint32_t* mapped = nullptr;
+		D3D12_RANGE readRange = { static_cast<SIZE_T>(Threads()) * sizeof(uint32_t), static_cast<SIZE_T>(OutputBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t lanes = mapped[Threads()];
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return lanes;
+	}
+
+	// Outputs of the last Dispatch() with SetCopyResults(true) that differ from the host emulation
+	// with `lanes` lanes per wave (the probed lane count).
+	uint32_t Validate(uint32_t lanes)
+	{
+		if (lanes < 4 || lanes > 128 || (lanes & (lanes - 1)) != 0 || NumThreads % lanes != 0)
+		{
+			return Threads();
+		}
+		std::vector<uint32_t> reference = CrossLaneOps::Reference(m_op, lanes, Threads(), m_iterations);
+		uint32_t* mapped = nullptr;
+		D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(OutputBytes()) };
+		AssertIfFailed(mReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+		uint32_t mismatches = 0;
+		for (uint32_t t = 0; t < Threads(); ++t)
+		{
+			mismatches += mapped[t] != reference[t] ? 1 : 0;
+		}
+		D3D12_RANGE writeRange = { 0, 0 };
+		mReadbackBuffer->Unmap(0, &writeRange);
+		return mismatches;
+	}
+
+private:
+
+	bool CheckSupport()
+	{
+		m_caps = QueryDeviceCaps(Device());
+		if (m_caps.ShaderModel < D3D_SHADER_MODEL_6_0)
+		{
+			OutputDebugStringA("Shader model 6.0 not supported\n");
+			return false;
+		}
+		if (m_impl == CrossLaneImpl::WaveImpl && !m_caps.WaveOps)
+		{
+			OutputDebugStringA("Wave operations not supported\n");
+			return false;
+		}
+		if (m_impl == CrossLaneImpl::WaveImpl && m_waveSize != 0 && !m_caps.SupportsWaveSize(m_waveSize))
+		{
+			OutputDebugStringA("[WaveSize] with this lane count not supported\n");
+			return false;
+		}
+		// The LDS implementation emulates the requested wave size, or the narrowest one the device runs
+		// (32 lanes without wave operations).
+		m_lanes = m_waveSize != 0 ? m_waveSize : m_caps.WaveLaneCountMin != 0 ? m_caps.WaveLaneCountMin : 32;
+		return true;
+	}
+
+    ComPtr<ID3DBlob> mShader;
+	ComPtr<ID3D12RootSignature> mRootSignature;
+	ComPtr<ID3D12PipelineState> mPSO;
+
+	ComPtr<ID3D12Resource> mOutputBuffer;
+	ComPtr<ID3D12Resource> mReadbackBuffer;
+
+	DeviceCaps    m_caps;
+	CrossLaneOp   m_op;
+	CrossLaneImpl m_impl;
+	uint32_t      m_waveSize;
+	uint32_t      m_lanes       = 32;
+	uint32_t      m_groups;
+	uint32_t      m_iterations;
+	bool          m_supported = false;
+};